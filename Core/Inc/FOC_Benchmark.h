@@ -0,0 +1,55 @@
+#ifndef FOC_BENCHMARK_H_
+#define FOC_BENCHMARK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_Driver.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+// FOC_Bench_Current_Loop'un handle kopyasında çalıştıramadığı ISR adımları için bütçeden düşülen pay (170 MHz):
+// FOC_Param_Apply (en kötü: tüm parametreler + MTPA tablosu), FOC_CAN_Consume (setpoint), FOC_Scope_Sample
+// (8 kanal + tetik), FOC_Estimator_Sample (halka tampon) ve FOC_Scheduler_Tick. Bunlar modül durumunu
+// (yayınlanan banka / setpoint, scope ve tahmin tamponu, PendSV) değiştirdiği için ölçümde çağrılamaz.
+// Komut sayımından üst sınırdır; hedefte akım ISR'ının tamamı FOC_Bench_Start / Stop ile sarılıp max değeri
+// (bütçe Ts) ile FOC_Bench_Current_Loop max + bu pay karşılaştırılarak güncellenmelidir.
+#define FOC_BENCH_ISR_HOOK_CYCLES 800U
+
+// DWT çevrim sayacı ile ölçülen bir kod bloğunun istatistikleri
+typedef struct{
+    uint32_t start;         // Son ölçümün başlangıç değeri (DWT->CYCCNT)
+    uint32_t last;          // Son ölçülen çevrim sayısı
+    uint32_t max;           // Görülen en kötü durum çevrim sayısı
+    uint32_t budget;        // İzin verilen maksimum çevrim sayısı
+    uint32_t overrun_count; // Bütçenin aşıldığı ölçüm sayısı
+    uint32_t count;         // Toplam ölçüm sayısı
+} FOC_Bench_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_Bench_Init(void); // DWT çevrim sayacını açar
+void FOC_Bench_Reset(FOC_Bench_t *pBench, float period_s); // İstatistikleri sıfırlar, bütçeyi periyottan hesaplar
+bool FOC_Bench_Current_Loop(const FOC_Handle_t *pHandle, FOC_Bench_t *pBench, uint32_t iterations); // Handle'ın kopyasında, Ts bütçesi
+bool FOC_Bench_Regulator(const FOC_Handle_t *pHandle, FOC_Current_Regulator_t regulator, FOC_Bench_t *pBench, uint32_t iterations);
+bool FOC_Bench_FCS_MPC(const FOC_Handle_t *pHandle, FOC_Bench_t *pBench, uint32_t iterations); // FOC_FCS_MPC_MAX_CYCLES kontrolü
+bool FOC_Bench_FCS_MPC_Config(const FOC_Handle_t *pHandle, const FOC_Driver_Config_t *pConfig, FOC_Bench_t *pBench, uint32_t iterations); // Handle'ın ayarı yerine pConfig ile
+
+// Ölçümler ISR içinde kullanıldığı için çağrı maliyeti olmaması adına inline tanımlanmıştır
+static inline void FOC_Bench_Start(FOC_Bench_t *pBench){
+    pBench->start = DWT->CYCCNT;
+}
+
+static inline void FOC_Bench_Stop(FOC_Bench_t *pBench){
+    uint32_t cycles = DWT->CYCCNT - pBench->start;
+
+    pBench->last = cycles;
+    if(cycles > pBench->max) pBench->max = cycles;
+    if(cycles > pBench->budget) pBench->overrun_count++;
+    pBench->count++;
+}
+
+#endif /* FOC_BENCHMARK_H_ */
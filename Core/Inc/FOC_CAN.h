@@ -0,0 +1,129 @@
+#ifndef FOC_CAN_H_
+#define FOC_CAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_Driver.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+// 11 bit standart ID'ler (düşük ID = yüksek öncelik)
+#define FOC_CAN_ID_SYNC       0x080U // Bus master -> tüm sürücüler, tick hizalama ve setpoint mandallama
+#define FOC_CAN_ID_SETPOINT   0x100U // + grup (node_id / FOC_CAN_AXES_PER_FRAME), host -> sürücüler
+#define FOC_CAN_ID_PVT        0x180U // + node_id, host -> sürücü, PVT yörünge noktaları
+#define FOC_CAN_ID_COMMAND    0x200U // + node_id, host -> sürücü
+#define FOC_CAN_ID_BROADCAST  0x2FFU // Tüm sürücülere komut
+#define FOC_CAN_ID_TELEMETRY  0x300U // + node_id, sürücü -> host
+#define FOC_CAN_ID_FLOW       0x380U // + node_id, sürücü -> host, PVT akış kontrolü (FOC_Traj_Status_t)
+#define FOC_CAN_ID_SCOPE      0x400U // + node_id, sürücü -> host, scope yanıtı (FOC_Scope_Header_t + veri)
+#define FOC_CAN_ID_PARAM      0x440U // + node_id, sürücü -> host, parametre yanıtı (FOC_Param_Msg_t + veri)
+#define FOC_CAN_ID_STREAM     0x480U // + node_id, sürücü -> host, abonelik telemetrisi (FOC_Telem_Header_t + veri)
+
+#define FOC_CAN_MAX_NODES      16U
+#define FOC_CAN_AXES_PER_FRAME 4U  // Bir setpoint çerçevesinde taşınan eksen sayısı
+#define FOC_CAN_FRAME_SIZE     64U
+#define FOC_CAN_SYNC_SIZE      8U
+
+// SYNC faz kilidi (PLL) ayarları
+#define FOC_CAN_SYNC_KP        0.5f   // Bir SYNC aralığında düzeltilecek faz hatası oranı
+#define FOC_CAN_SYNC_KI        0.05f  // Saat frekansı farkı (kristal ppm) integratörü
+#define FOC_CAN_SYNC_TRIM_MAX  0.01f  // Tick uzunluğunun en fazla bu oranı kadar trim yapılır
+#define FOC_CAN_SYNC_MAX_TICKS 10000U // Bu kadar tick'ten seyrek gelen SYNC integratörü beslemez
+#define FOC_CAN_SYNC_LOCK      0.05f  // Yakalama: faz hatası ilk kez tick uzunluğunun bu oranının altına inene kadar integratör kapalı
+#define FOC_CAN_TS_PRESCALER   2U     // TIM3 (FDCAN dış timestamp) bölücüsü: 85 MHz, ~771 us taşma
+
+// Setpoint modları
+#define FOC_CAN_MODE_DISABLE  0U
+#define FOC_CAN_MODE_TORQUE   1U
+#define FOC_CAN_MODE_SPEED    2U
+#define FOC_CAN_MODE_POSITION 3U
+
+// PVT çerçevesi: 4 byte başlık + 5 x FOC_Traj_Point_t
+#define FOC_CAN_PVT_POINTS    5U
+#define FOC_CAN_PVT_START     0x01U // Yörünge bu çerçevenin ilk noktasıyla yeniden başlar
+
+// Komutlar
+#define FOC_CAN_CMD_ENABLE    0x01U
+#define FOC_CAN_CMD_DISABLE   0x02U
+#define FOC_CAN_CMD_SCOPE     0x03U // Byte 4 ... 63: FOC_Scope isteği, yanıt FOC_CAN_ID_SCOPE ile
+#define FOC_CAN_CMD_SUBSCRIBE 0x04U // Byte 4 ... 63: FOC_Telem_Subscribe_t + girişler (en fazla 10)
+#define FOC_CAN_CMD_PARAM     0x05U // Byte 4 ... 63: FOC_Param isteği, yanıt FOC_CAN_ID_PARAM ile
+
+// SYNC çerçevesi (8 byte, little endian). SYNC'in SOF anı tüm node'larda tick sınırına hizalanır.
+typedef struct __attribute__((packed)){
+    uint32_t master_tick; // SOF anındaki bus tick numarası
+    uint32_t apply_tick;  // Mandallanan setpoint'lerin uygulanacağı bus tick'i (master_tick + 2 önerilir)
+} FOC_CAN_Sync_t;
+
+typedef struct __attribute__((packed)){
+    uint16_t seq;   // İlk noktanın sıra numarası, sonraki noktalar seq + i
+    uint8_t count;  // Geçerli nokta sayısı (1 ... FOC_CAN_PVT_POINTS)
+    uint8_t flags;  // FOC_CAN_PVT_x
+} FOC_CAN_Pvt_Header_t;
+
+// Setpoint çerçevesindeki bir eksenin yeri (16 byte, little endian)
+typedef struct __attribute__((packed)){
+    uint8_t mode;        // FOC_CAN_MODE_x
+    uint8_t sequence;    // Host tarafından her çerçevede artırılır
+    uint16_t reserved;
+    float torque_ref;    // Nm
+    float speed_ref;     // Mekanik rad/s
+    float position_ref;  // Mekanik rad
+} FOC_CAN_Setpoint_t;
+
+// Telemetri çerçevesi (64 byte, little endian)
+typedef struct __attribute__((packed)){
+    uint16_t sequence;
+    uint8_t node_id;
+    uint8_t status;      // bit0: akım, bit1: hız, bit2: pozisyon döngüsü açık
+    float i_d;
+    float i_q;
+    float i_d_ref;
+    float i_q_ref;
+    float u_d;
+    float u_q;
+    float w_rad_s;
+    float electrical_angle;
+    float T_mot_ref;
+    float U_bat;
+    float position_rad;
+    float speed_ref;
+    float fw_i_d;
+    float sync_phase_error; // Son SYNC'te ölçülen tick fazı hatası (us)
+    uint32_t sample_tick;   // Örneğin alındığı bus tick'i (SYNC ile hizalı)
+} FOC_CAN_Telemetry_t;
+
+typedef struct{
+    uint32_t rx_setpoint;   // Alınan setpoint çerçevesi
+    uint32_t rx_command;    // Alınan komut çerçevesi
+    uint32_t tx_telemetry;  // Kuyruğa eklenen telemetri çerçevesi
+    uint32_t tx_dropped;    // TX FIFO dolu olduğu için atılan telemetri
+    uint32_t rx_overrun;    // Akım ISR'ı okumadan üzerine yazılan setpoint
+    uint32_t rx_sync;       // Alınan SYNC çerçevesi
+    uint32_t sync_late;     // apply_tick geçtikten sonra işlenen SYNC
+    uint32_t rx_pvt;        // Kuyruğa eklenen PVT noktası
+    uint32_t rx_pvt_reject; // Kuyruk dolu veya sıra hatası nedeniyle reddedilen PVT noktası
+    uint32_t tx_flow;       // Gönderilen akış kontrol çerçevesi
+    uint32_t tx_scope;      // Gönderilen scope yanıtı
+    uint32_t tx_stream;     // Gönderilen abonelik telemetrisi paketi
+    uint32_t tx_param;      // Gönderilen parametre yanıtı
+} FOC_CAN_Stats_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+bool FOC_CAN_Init(FOC_Handle_t *pHandle, uint8_t node_id); // Filtreleri kurar, RX kesmesini açar ve FDCAN'i başlatır
+void FOC_CAN_IRQHandler(void);               // FDCAN1_IT0_IRQHandler: RX FIFO0 -> setpoint yuvası
+// Akım ISR'ının başında, FOC_Current_Controller'dan önce. Komut -> gerilim gecikmesi en fazla 1.5 PWM periyodu;
+// 1 periyodun altı (en fazla 0.75) sadece config.pwm_double_update açıkken sağlanır. Mandallı modda apply_tick beklenir.
+void FOC_CAN_Consume(FOC_Handle_t *pHandle);
+void FOC_CAN_Set_Sync_Latch(bool enable);    // true: setpoint'ler SYNC'e kadar bekletilir, apply_tick'te uygulanır
+void FOC_CAN_Telemetry_Task(FOC_Handle_t *pHandle); // FOC_Scheduler görevi olarak eklenir
+bool FOC_CAN_Stream_Sink(const uint8_t *pData, uint16_t length); // FOC_Telemetry çıkışı, PendSV'den
+bool FOC_CAN_Loopback_Test(void);            // Dahili loopback ile filtre + BRS + 64 byte testi
+const FOC_CAN_Stats_t *FOC_CAN_Get_Stats(void);
+
+#endif /* FOC_CAN_H_ */
@@ -0,0 +1,35 @@
+#ifndef FOC_CAN_SYNC_H_
+#define FOC_CAN_SYNC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_CAN.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+// SYNC faz kilidi durumu (bir node). Süreler TIM1 sayımıdır.
+typedef struct{
+    float integrator;          // Tick başına frekans düzeltmesi
+    float error;               // Son SYNC'te ölçülen faz hatası
+    uint32_t last_master_tick;
+    uint32_t tick_offset;      // Bus tick - yerel tick
+    bool valid;                // En az bir SYNC işlendi
+    bool locked;               // Faz hatası bir kez FOC_CAN_SYNC_LOCK altına indi, integratör açık
+} FOC_CAN_PLL_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_CAN_PLL_Reset(FOC_CAN_PLL_t *pPll);
+// Bir SYNC işlenir. Dönüş true ise *pArr_Trim ARR'nin nominal değere göre trim'idir (FOC_PWM_Trim_Period)
+bool FOC_CAN_PLL_Update(FOC_CAN_PLL_t *pPll, float now_phase, float elapsed, float tick_len, uint32_t period,
+                        uint32_t tick, uint32_t master_tick, int32_t *pArr_Trim);
+
+static inline uint32_t FOC_CAN_PLL_Local_Tick(const FOC_CAN_PLL_t *pPll, uint32_t bus_tick){
+    return bus_tick - pPll->tick_offset;
+}
+
+#endif /* FOC_CAN_SYNC_H_ */
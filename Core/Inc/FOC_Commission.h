@@ -0,0 +1,87 @@
+#ifndef FOC_COMMISSION_H_
+#define FOC_COMMISSION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_Driver.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+// Parametrelerin saklandığı flash sayfası (son 2 KB, linker script'te FLASH'tan çıkarılmıştır)
+#define FOC_COMM_FLASH_ADDR  0x0801F800U
+#define FOC_COMM_FLASH_PAGE  63U
+
+#define FOC_COMM_SETTLE_S    0.3f // Her ölçüm öncesi oturma süresi (sn)
+#define FOC_COMM_AVERAGE_S   0.2f // Ortalama alma süresi (sn)
+#define FOC_COMM_RAMP_S      2.0f // Açık çevrim hız rampası süresi (sn)
+#define FOC_COMM_POLE_REVS   3U   // Hall kontrolü için döndürülecek elektriksel tur sayısı
+
+typedef enum{
+    FOC_COMM_IDLE = 0,
+    FOC_COMM_R_LOW,       // DC enjeksiyon, I_test / 2
+    FOC_COMM_R_HIGH,      // DC enjeksiyon, I_test -> R = dU / dI (inverter düşümü iptal olur)
+    FOC_COMM_L_D,         // Kilitli rotor, d ekseninde gerilim darbesi
+    FOC_COMM_L_Q,         // Kilitli rotor, q ekseninde çift yönlü gerilim darbesi
+    FOC_COMM_POLE_PAIRS,  // Yavaş açık çevrim dönüş, Hall kenarları ve mekanik yol ile kutup çifti
+    FOC_COMM_FLUX_RAMP,   // Açık çevrim hız rampası
+    FOC_COMM_FLUX,        // Sabit hızda back-EMF'ten akı
+    FOC_COMM_STOP,        // Rampa ile durma
+    FOC_COMM_DONE,
+    FOC_COMM_ERROR
+} FOC_Comm_Phase_t;
+
+typedef enum{
+    FOC_COMM_OK = 0,
+    FOC_COMM_ERR_NO_CURRENT, // Test akımına ulaşılamadı (faz bağlantısı / sürücü)
+    FOC_COMM_ERR_R,          // Direnç negatif veya sıfır
+    FOC_COMM_ERR_L,          // Darbe sırasında akım değişmedi
+    FOC_COMM_ERR_HALL,       // Geçersiz Hall durumu veya elektriksel tur başına 6 kenar görülmedi
+    FOC_COMM_ERR_FLUX,       // Back-EMF ölçülemedi
+    FOC_COMM_ERR_FLASH,      // Flash yazma hatası
+    FOC_COMM_ERR_POLE_PAIRS, // Mekanik tur başına Hall kenarı config.pole_pairs ile uyuşmuyor
+    FOC_COMM_ERR_ABORTED     // FOC_Commission_Abort ile kesildi
+} FOC_Comm_Error_t;
+
+// Kullanıcı tarafından doldurulan test ayarları
+typedef struct{
+    float I_test;         // Test akımı (A)
+    float U_pulse;        // Endüktans darbe gerilimi (V), d akımı darbe sonunda sıfırı geçmemeli
+    uint16_t pulse_ticks; // Darbe süresi (akım döngüsü tick'i)
+    float ramp_gain;      // R ölçümünde gerilim rampası kazancı (V / (A * s))
+    float w_slow;         // Hall kontrolü elektriksel hızı (rad/s)
+    float w_flux;         // Akı ölçümü elektriksel hızı (rad/s)
+    float bandwidth;      // İstenen akım döngüsü bant genişliği (rad/s)
+} FOC_Comm_Settings_t;
+
+typedef struct{
+    float R_phase;
+    float L_d;
+    float L_q;
+    float flux_linkage;
+    float Kp_d;
+    float Ki_d;
+    float Kp_q;
+    float Ki_q;
+    uint32_t hall_edges;  // FOC_COMM_POLE_REVS elektriksel turda sayılan Hall kenarı
+    uint8_t pole_pairs_meas; // Elektriksel açı / mekanik yoldan kutup çifti (0: position_rad ilerlemedi, kontrol yok)
+    FOC_Comm_Phase_t phase;
+    FOC_Comm_Error_t error;
+    bool saved;           // Sonuçlar flash'a yazıldı
+} FOC_Comm_Result_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_Commission_Start(FOC_Handle_t *pHandle, const FOC_Comm_Settings_t *pSettings);
+void FOC_Commission_Step(FOC_Handle_t *pHandle, uint8_t hall_sector); // Akım ISR'ında FOC_Current_Controller yerine
+void FOC_Commission_Process(void);                // main while(1) içinde, bitince sonucu flash'a yazar
+void FOC_Commission_Abort(void);                  // Sekansı keser, kapatılan eklentileri geri yükler
+bool FOC_Commission_Busy(void);
+const FOC_Comm_Result_t *FOC_Commission_Get_Result(void);
+bool FOC_Commission_Save(FOC_Handle_t *pHandle);  // PWM kapalıyken çağrılmalı (silme sırasında CPU bekler)
+bool FOC_Commission_Load(FOC_Handle_t *pHandle);  // Açılışta: geçerli kayıt varsa config'e yükler
+
+#endif /* FOC_COMMISSION_H_ */
@@ -10,8 +10,70 @@
 // <<----------- Değişken tanımlamaları ----------->>
 // <<---------------------------------------------->>
 
-#define CONST_SCALE 683565276.4f
-#define CONST_UNSCALE 0.000000001463f
+#define CONST_SCALE 683565276.4f       // rad -> CORDIC q1.31 açı girişi (2^31 / pi)
+#define CONST_UNSCALE 0.0000000004656613f // CORDIC q1.31 cos / sin sonucu -> float (1 / 2^31)
+
+// Aşırı modülasyon sınırları (faz gerilimi temel bileşeni / U_DC)
+#define FOC_OVM_M_LINEAR   0.5773503f // Lineer bölge sonu (altıgenin iç dairesi, 1/sqrt(3))
+#define FOC_OVM_M_MODE_II  0.6056967f // Mod I sonu, Mod II başlangıcı
+#define FOC_OVM_M_SIX_STEP 0.6366198f // Six-step (2/pi)
+#define FOC_OVM_MI_LINEAR  0.9068997f // Lineer bölge sonu, modülasyon indeksi cinsinden (m / (2/pi))
+#define FOC_OVM_TABLE_SIZE 9
+
+// MTPA tablosundaki nokta sayısı (tork ekseninde eşit aralıklı)
+#define FOC_MTPA_TABLE_SIZE 32
+
+// Doyum haritası boyutları (i_d: i_d_min ... 0, |i_q|: 0 ... i_q_max, eşit aralıklı)
+#define FOC_SAT_MAP_ID_POINTS 5
+#define FOC_SAT_MAP_IQ_POINTS 8
+
+// FCS-MPC: FOC_FCS_MPC_Control için en kötü durum çevrim bütçesi (170 MHz, FPU açık). Komut sayımından
+// tahmin edilmiştir; hedefte ilk açılışta FOC_PWM_Get_FCS_Bench()->max ile ölçülen değere göre güncellenmelidir.
+// Bütçe zorunludur: FOC_PWM_Init aşımda FOC_REG_PI'ye döner, FOC_Param_Process FCS-MPC'ye geçiren commit'i
+// reddeder (FOC_PARAM_ERR_BUDGET). Aday döngüsü sabit 8 iterasyon ve veri bağımlı dal içermez, süre girişten bağımsızdır.
+#define FOC_FCS_MPC_MAX_CYCLES 400U
+
+// DPWM otomatik seçimi: bu modülasyon indeksinin altında sürekli SVPWM kullanılır
+#define FOC_DPWM_AUTO_MIN_MI 0.5f
+// DPWM otomatik seçimi: ±15 derecelik pencere sınırında histerezis (DPWM1'den çıkış 18, geri dönüş 12 derece)
+#define FOC_DPWM_AUTO_TAN_ENTER 0.3249197f // tan(18 derece)
+#define FOC_DPWM_AUTO_TAN_LEAVE 0.2125566f // tan(12 derece)
+
+// Q önceliğinde u_d için ayrılan zarf oranı (decoupling + gecikme kaynaklı d gerilimi buna sığmalı)
+#define FOC_VLIM_D_RESERVE 0.5f
+
+#define FOC_CLAMP_NONE 3U // state.clamp_phase: raya kenetlenen faz yok (SVPWM)
+
+// Modülasyon stratejisi (sıfır bileşen seçimi)
+typedef enum{
+    FOC_MOD_SVPWM = 0,  // Midpoint clamp, sürekli (varsayılan)
+    FOC_MOD_DPWMMIN,    // En düşük faz her zaman alt raya kenetlenir (120 derece)
+    FOC_MOD_DPWMMAX,    // En yüksek faz her zaman üst raya kenetlenir (120 derece)
+    FOC_MOD_DPWM0,      // Kenetleme penceresi DPWM1'e göre 30 derece geride (akım gerilimden geride)
+    FOC_MOD_DPWM1,      // Faz gerilimi tepe noktası etrafında 60 derece kenetleme (PF ~ 1)
+    FOC_MOD_DPWM2,      // Kenetleme penceresi DPWM1'e göre 30 derece ileride (akım gerilimden ileride)
+    FOC_MOD_DPWM3,      // 30 derecelik dört pencerede kenetleme (DPWM1'in tümleyeni)
+    FOC_MOD_DPWM_AUTO   // Güç faktörü ve modülasyon indeksine göre otomatik seçim
+} FOC_Modulation_t;
+
+// Akım regülatörü seçimi
+typedef enum{
+    FOC_REG_PI = 0,          // Ayrık d/q PI + decoupling feedforward (varsayılan)
+    FOC_REG_COMPLEX_VECTOR,  // Senkron eksende ayrık zamanlı complex-vector PI + gecikme kompanzasyonu
+    FOC_REG_DEADBEAT,        // Model tabanlı deadbeat öngörülü akım kontrolü
+    FOC_REG_FCS_MPC          // Sonlu kontrol kümeli MPC (8 anahtarlama durumu, SVPWM devre dışı)
+} FOC_Current_Regulator_t;
+
+// PI çıkışı için gerilim vektörü limitleme önceliği (d_q_max_voltage dairesi)
+typedef enum{
+    FOC_VLIM_D_PRIORITY = 0, // Önce u_d limitlenir, u_q kalan gerilimi kullanır (varsayılan)
+    FOC_VLIM_Q_PRIORITY,     // Önce u_q limitlenir, u_d kalan gerilimi kullanır (tork önceliği).
+                             // u_d zarfın FOC_VLIM_D_RESERVE oranına kadar yine önceliklidir. Akı zayıflatma
+                             // bölgesinde i_d referansı korunamaz ve tork d önceliğinden düşük kalır,
+                             // orada d önceliği kullanılmalıdır (bkz. Tools/foc_hostsim/sim_aw).
+    FOC_VLIM_PROPORTIONAL    // Vektör yönü korunarak orantılı ölçeklenir. Back-calculation ile kalıcı
+                             // doygunlukta integraller limitli vektöre çekilir, i_d pozitife kayıp tork düşer.
+} FOC_Voltage_Priority_t;
 
 // FOC Algortimasının giriş yapıları
 typedef struct{
@@ -35,8 +97,44 @@ typedef struct{
     float Kp_q;
     float Ki_q;
     float Ts; // Örnekleme süresi (PID için sn cinsinden, örn: 0.0001)
+    float deadbeat_gain; // Deadbeat kazancı (1.0: tek periyotta, 0.5: ~iki periyotta referansa ulaşır)
+    float fcs_switch_weight; // FCS-MPC maliyetinde anahtarlama sayısı ağırlığı (A^2 / anahtarlama)
+
+//  << ---- İnverter / PWM Parametreleri ---- >>
+    float pwm_frequency; // PWM taşıyıcı frekansı (Hz, örn: 20000)
+    float dead_time;     // Köprü ölü zamanı (sn cinsinden, örn: 0.0000005)
+    float V_switch_drop; // Anahtar (MOSFET) iletim gerilim düşümü (V)
+    float V_diode_drop;  // Ters paralel diyot iletim gerilim düşümü (V)
+    float dtc_current_band; // Ölü zaman kompanzasyonu yumuşak işaret bandı (A)
+
+//  << ---- Akı Zayıflatma Parametreleri ---- >>
+    float fw_Ki;             // Gerilim geri besleme döngüsü integral kazancı (A / (V*s))
+    float fw_voltage_margin; // Kullanılacak gerilim oranı (örn: 0.95 -> d_q_max_voltage'ın %95'i)
+    float fw_i_d_min;        // İzin verilen en negatif d akımı (A, negatif değer)
+    uint8_t fw_decimation;   // Akı zayıflatma kaç akım döngüsünde bir çalışır (örn: 10)
+
+//  << ---- Hız / Pozisyon Döngüsü Parametreleri (FOC_Scheduler ile PendSV'de çalışır) ---- >>
+    float Kp_speed;            // Hız PI oransal kazancı (Nm / (rad/s))
+    float Ki_speed;            // Hız PI integral kazancı (Nm / rad)
+    float Kp_position;         // Pozisyon P kazancı ((rad/s) / rad)
+    float speed_torque_limit;  // Hız döngüsünün üretebileceği maksimum tork (Nm)
+    uint8_t speed_decimation;    // Hız döngüsü kaç akım döngüsünde bir çalışır (örn: 10 -> 20 kHz / 2 kHz)
+    uint8_t position_decimation; // Pozisyon döngüsü kaç akım döngüsünde bir çalışır (örn: 20 -> 1 kHz)
 
     bool current_ctrl_mode;  // FOC algoritmasını aktif/deaktif etmek için
+    bool speed_ctrl_mode;    // Hız döngüsü input.T_mot_ref'i üretir
+    bool position_ctrl_mode; // Pozisyon döngüsü hız referansını üretir (speed_ctrl_mode gerekir)
+    bool flux_weakening;     // Akı zayıflatmayı aktif/deaktif etmek için
+    bool mtpa;               // MTPA referans üretimini aktif/deaktif etmek için (FOC_MTPA_Init gerekir)
+    bool saturation_maps;    // Doyum haritalarına göre L_d, L_q, flux ve Kp zamanlaması (FOC_Sat_Map_Init true dönmüş olmalı)
+    bool dead_time_comp;     // Ölü zaman kompanzasyonunu aktif/deaktif etmek için
+    bool online_estimation;  // FOC_Estimator R, L_d, L_q, flux tahminlerini config'e yayınlar
+    bool pwm_double_update;  // PWM periyodunda iki örnekleme/güncelleme (tepe + vadi)
+    float max_mod_index;     // Maksimum modülasyon indeksi (<= 0.907: sadece lineer, 1.0: six-step'e kadar)
+    FOC_Modulation_t modulation; // Sıfır bileşen stratejisi (SVPWM / DPWM)
+    FOC_Current_Regulator_t current_regulator; // Akım regülatörü (PI / complex-vector)
+    FOC_Voltage_Priority_t voltage_priority;   // PI çıkışı vektör limitleme önceliği
+    bool back_calc_aw;       // PI anti-windup: false -> integral kırpma, true -> back-calculation (Kb = Ki / Kp)
 
 } FOC_Driver_Config_t;
 
@@ -48,8 +146,12 @@ typedef struct{
     float i_b_meas;             // Ölçülen faz B akımı
     float w_rad_s;              // Motorun açısal hızı
     float Electrical_Angle_rad; // Elektriksel açı
-    float T_mot_ref;            // Referans tork
+    float T_mot_ref;            // Referans tork (speed_ctrl_mode açıksa hız döngüsü yazar)
     float U_bat;                // Batarya voltajı
+    float speed_ref_rad_s;      // Mekanik hız referansı (rad/s, pozisyon döngüsü kapalıyken)
+    float position_rad;         // Ölçülen mekanik pozisyon (rad, çok turlu)
+    float position_ref_rad;     // Mekanik pozisyon referansı (rad, çok turlu)
+    float speed_ff_rad_s;       // Pozisyon döngüsü hız ileri beslemesi (rad/s, örn: PVT interpolatörü)
 
 } FOC_Driver_Input_t;
 
@@ -66,17 +168,42 @@ typedef struct{
     float i_q;
     float i_d;
 
+    // Her döngüde zamanlanan (doyum haritası kapalıysa config'ten kopyalanan) parametreler
+    float L_d_sched;
+    float L_q_sched;
+    float flux_sched;
+    float Kp_d_sched;
+    float Kp_q_sched;
+
     float u_d_decoupling;
     float u_q_decoupling;
 
     float d_q_max_voltage;
 
+    float fw_i_d;         // Akı zayıflatmanın ürettiği d akımı referansı
+    float fw_integrator;  // Gerilim geri besleme integrali
+    float i_q_limit;      // I_s_max bütçesinden q eksenine kalan akım
+    uint8_t fw_counter;   // Decimation sayacı
+
+    float speed_ref;        // Hız döngüsünün kullandığı mekanik hız referansı (rad/s)
+    float speed_integrator; // Hız PI integral birikimi (Nm)
+
+    float u_d_applied; // Deadbeat: bir önceki periyotta hesaplanan (şu an uygulanan) d gerilimi
+    float u_q_applied; // Deadbeat: bir önceki periyotta hesaplanan (şu an uygulanan) q gerilimi
+    uint8_t fcs_state; // FCS-MPC: şu an uygulanan anahtarlama durumu (bit0: A, bit1: B, bit2: C)
+
+    uint8_t clamp_phase;        // SVPWM'in bu periyotta raya kenetlediği faz (0: A, 1: B, 2: C, FOC_CLAMP_NONE)
+    FOC_Modulation_t dpwm_auto; // DPWM_AUTO'nun son seçimi (histerezis)
+
     float i_d_memory; // Integral birikimi D
     float i_q_memory; // Integral birikimi Q
 
     float u_d;
     float u_q;
  
+    float cos_theta; // Park / Inverse Park'ta kullanılan açının kosinüsü
+    float sin_theta; // Park / Inverse Park'ta kullanılan açının sinüsü
+
     float u_x; // Alpha (Inverse Park sonrası)
     float u_y; // Beta  (Inverse Park sonrası)
 
@@ -97,26 +224,67 @@ typedef struct{
 
 // ------------------------------------------------------------------------------
 
+// ------------------------------------------------------------------------------
+
+typedef struct{
+// << ---- MTPA tablosu (FOC_MTPA_Init ile motor parametrelerinden hesaplanır) ---- >>
+    float i_d[FOC_MTPA_TABLE_SIZE]; // |T| = k * T_max / (N - 1) için d akımı
+    float i_q[FOC_MTPA_TABLE_SIZE]; // |T| = k * T_max / (N - 1) için q akımı (pozitif)
+    float T_max;                    // I_s_max ile üretilebilecek maksimum tork
+    float inv_step;                 // (N - 1) / T_max
+
+} FOC_MTPA_Table_t;
+
+// ------------------------------------------------------------------------------
+
+typedef struct{
+// << ---- Manyetik doyum haritaları (FOC_Sat_Map_Init eksenleri kurar, değerler ölçümle doldurulur) ---- >>
+    float L_d[FOC_SAT_MAP_ID_POINTS][FOC_SAT_MAP_IQ_POINTS]; // L_d(i_d, |i_q|)
+    float L_q[FOC_SAT_MAP_ID_POINTS][FOC_SAT_MAP_IQ_POINTS]; // L_q(i_d, |i_q|)
+    float flux[FOC_SAT_MAP_ID_POINTS];                       // flux(i_d)
+    float i_d_min;      // i_d ekseninin başlangıcı (negatif)
+    float inv_step_d;   // (N_d - 1) / -i_d_min
+    float inv_step_q;   // (N_q - 1) / i_q_max
+    float inv_L_d_nom;  // 1 / config.L_d (Kp_d ölçekleme)
+    float inv_L_q_nom;  // 1 / config.L_q (Kp_q ölçekleme)
+
+} FOC_Sat_Map_t;
+
+// ------------------------------------------------------------------------------
+
 // FOC Ana Nesnesi
 typedef struct{
     FOC_Driver_Config_t config;
     FOC_Driver_Input_t input;
     FOC_Driver_State_t state;
     FOC_Driver_Output_t output;
+    FOC_MTPA_Table_t mtpa;
+    FOC_Sat_Map_t sat_map;
 } FOC_Handle_t;
 
 // <<---------------------------------------------->>
 // <<------------- Fonksiyon Tanımlamaları -------->>
 // <<---------------------------------------------->>
 
-void FOC_Driver_Init(FOC_Handle_t *pHandle);
+void FOC_Driver_Init(FOC_Handle_t *pHandle); // Config doldurulduktan sonra çağrılmalıdır (zamanlanan parametreler config ile başlar)
 void FOC_Clark_Park_Transform(FOC_Handle_t *pHandle);
 void FOC_Torq_Reference_Transform(FOC_Handle_t *pHandle);
+void FOC_Flux_Weakening(FOC_Handle_t *pHandle);
+void FOC_MTPA_Init(FOC_Handle_t *pHandle); // Config doldurulduktan sonra, ISR başlamadan çağrılmalıdır
+void FOC_MTPA_Compute(const FOC_Driver_Config_t *pConfig, FOC_MTPA_Table_t *pTable); // Ayrı hedefe hesaplar
 void FOC_Current_Controller(FOC_Handle_t *pHandle); // Ana kontrol döngüsü
+void FOC_Speed_Controller(FOC_Handle_t *pHandle);    // config.speed_decimation akım döngüsünde bir
+void FOC_Position_Controller(FOC_Handle_t *pHandle); // config.position_decimation akım döngüsünde bir
+bool FOC_Sat_Map_Init(FOC_Handle_t *pHandle, float i_d_min, float i_q_max); // Haritaları sabit config değerleriyle doldurur, L <= 0 ise false
+void FOC_Parameter_Schedule(FOC_Handle_t *pHandle);
 void FOC_Voltage_Decoupling(FOC_Handle_t *pHandle);
 void FOC_Max_Voltage(FOC_Handle_t *pHandle);
 void FOC_Direct_Current_Control_d(FOC_Handle_t *pHandle); 
 void FOC_Direct_Current_Control_q(FOC_Handle_t *pHandle); 
+void FOC_Voltage_Vector_Limit(FOC_Handle_t *pHandle); // PI çıkışını önceliğe göre limitler, back-calculation uygular
+void FOC_Complex_Vector_Current_Control(FOC_Handle_t *pHandle);
+void FOC_Deadbeat_Current_Control(FOC_Handle_t *pHandle);
+void FOC_FCS_MPC_Control(FOC_Handle_t *pHandle); // Doğrudan output.duty_x üretir (0 / 1)
 void FOC_Inverse_Clark_Park_Transform(FOC_Handle_t *pHandle);
 void FOC_SVPWM_Calculation(FOC_Handle_t *pHandle);
 void FOC_G4_Cos_Sin_Calculate(float angle_rad, float *cos_value, float *sin_value);
@@ -0,0 +1,59 @@
+#ifndef FOC_ESTIMATOR_H_
+#define FOC_ESTIMATOR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_Driver.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+#define FOC_EST_BUFFER_SIZE 32U // ISR -> idle halka tamponu (2'nin kuvveti olmalı)
+
+// Yayınlanacak tahminlerin nominal değere (Init anındaki config) oranı için sınırlar
+#define FOC_EST_R_MIN    0.5f  // Bakır direnci sıcaklıkla ~%40 değişir
+#define FOC_EST_R_MAX    2.0f
+#define FOC_EST_L_MIN    0.5f
+#define FOC_EST_L_MAX    1.5f
+#define FOC_EST_FLUX_MIN 0.7f  // Mıknatıs sıcaklıkla zayıflar
+#define FOC_EST_FLUX_MAX 1.1f
+
+#define FOC_EST_PUBLISH_MS 100U // FOC_Param üzerinden yayın aralığı (her commit MTPA tablosunu yeniden hesaplar)
+
+#define FOC_EST_P_TRACE_MAX 100.0f // Kovaryans izi bunu aşarsa unutma faktörü uygulanmaz (uyarım yokken patlamaz)
+
+// ISR'dan idle döngüye aktarılan örnek (ardışık iki kontrol tick'i)
+typedef struct{
+    float u_d;      // [k-1, k] aralığında uygulanan d gerilimi
+    float u_q;      // [k-1, k] aralığında uygulanan q gerilimi
+    float i_d_prev; // i_d[k-1]
+    float i_q_prev; // i_q[k-1]
+    float i_d;      // i_d[k]
+    float i_q;      // i_q[k]
+    float w_rad_s;  // Elektriksel hız
+} FOC_Est_Sample_t;
+
+// Tahmin sonuçları ve sayaçlar (debugger ile izlenebilir)
+typedef struct{
+    float R_phase;
+    float L_d;
+    float L_q;
+    float flux_linkage;
+    uint32_t sample_count;  // İşlenen örnek sayısı
+    uint32_t overflow_count; // Tampon dolu olduğu için ISR'da atılan örnek sayısı
+    uint32_t reject_count;  // Sınır dışında kaldığı için yayınlanmayan güncelleme sayısı
+    uint32_t publish_count; // FOC_Param'a commit edilen güncelleme sayısı
+    uint32_t defer_count;   // Host'un bekleyen gölge ayarı yüzünden ertelenen yayın sayısı
+} FOC_Est_Result_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_Estimator_Init(FOC_Handle_t *pHandle, uint8_t decimation, float forgetting); // Nominal değerler config'ten alınır
+void FOC_Estimator_Sample(FOC_Handle_t *pHandle); // Akım ISR'ında FOC_Current_Controller'dan sonra çağrılır
+void FOC_Estimator_Process(void);                 // main while(1) içinde (idle) çağrılır
+const FOC_Est_Result_t *FOC_Estimator_Get_Result(void);
+
+#endif /* FOC_ESTIMATOR_H_ */
@@ -0,0 +1,86 @@
+#ifndef FOC_LOG_H_
+#define FOC_LOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+#define FOC_LOG_RING_WORDS 256U // Kayıt halkası (word, 2'nin kuvveti): 1 KB
+#define FOC_LOG_TEXT_MAX   120U // Bir metin kaydının en fazla byte'ı, uzun yazmalar bölünür
+#define FOC_LOG_MAX_ARGS   4U   // Ertelenmiş kayıtta en fazla argüman
+
+// Seviyeler. PRINT: printf / _write çıktısı, seviye filtresine girmez
+#define FOC_LOG_LEVEL_PRINT 0U
+#define FOC_LOG_LEVEL_ERROR 1U
+#define FOC_LOG_LEVEL_WARN  2U
+#define FOC_LOG_LEVEL_INFO  3U
+#define FOC_LOG_LEVEL_DEBUG 4U
+
+// Derlemeye alınacak en ayrıntılı seviye (üstündeki LOG_x çağrıları kod üretmez)
+#ifndef FOC_LOG_LEVEL
+#define FOC_LOG_LEVEL FOC_LOG_LEVEL_INFO
+#endif
+
+// FOC_UART_TYPE_LOG çerçeve verisi: başlık + metin (sonunda '\0' yok)
+typedef struct __attribute__((packed)){
+    uint32_t tick;  // Kaydın alındığı tick (FOC_Scheduler_Get_Tick)
+    uint8_t level;
+} FOC_Log_Header_t;
+
+typedef struct{
+    uint32_t records;   // FOC_UART'a çerçeve olarak verilen kayıt
+    uint32_t dropped;   // Halka dolu olduğu için atılan kayıt
+    uint32_t truncated; // FOC_LOG_TEXT_MAX'a kısaltılan ertelenmiş biçimleme
+    uint32_t tx_busy;   // TX halkası dolu, kayıt bir sonraki idle turunda tekrar denendi
+} FOC_Log_Stats_t;
+
+// <<---------------------------------------------->>
+// <<------------------ Makrolar ------------------>>
+// <<---------------------------------------------->>
+
+// LOG_x(format, en fazla 4 tamsayı / işaretçi argüman): her bağlamdan çağrılabilir (akım ISR'ı dahil), beklemez.
+// Sadece format işaretçisi ve argümanlar halkaya yazılır (~30-40 döngü), biçimleme idle'da yapılır.
+// Format string literal olmalıdır (flash'ta kalır). float desteklenmez: ölçeklenmiş tamsayı verilmeli (ör. mA).
+#define FOC_LOG_COUNT_(_0, _1, _2, _3, _4, _5, N, ...) N
+#define FOC_LOG_COUNT(...) FOC_LOG_COUNT_(__VA_ARGS__, 5, 4, 3, 2, 1, 0, 0)
+#define FOC_LOG_ARGS_(_0, a, b, c, d, ...) (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d)
+#define FOC_LOG_EMIT(level, fmt, ...) \
+    ((void)sizeof(char[(FOC_LOG_COUNT(0, ##__VA_ARGS__) <= FOC_LOG_MAX_ARGS) ? 1 : -1]), \
+     FOC_Log_Deferred((level) | ((uint32_t)FOC_LOG_COUNT(0, ##__VA_ARGS__) << 4), (fmt), \
+                      FOC_LOG_ARGS_(0, ##__VA_ARGS__, 0, 0, 0, 0)))
+
+#if FOC_LOG_LEVEL >= FOC_LOG_LEVEL_ERROR
+#define LOG_E(fmt, ...) FOC_LOG_EMIT(FOC_LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_E(fmt, ...) ((void)0)
+#endif
+#if FOC_LOG_LEVEL >= FOC_LOG_LEVEL_WARN
+#define LOG_W(fmt, ...) FOC_LOG_EMIT(FOC_LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOG_W(fmt, ...) ((void)0)
+#endif
+#if FOC_LOG_LEVEL >= FOC_LOG_LEVEL_INFO
+#define LOG_I(fmt, ...) FOC_LOG_EMIT(FOC_LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define LOG_I(fmt, ...) ((void)0)
+#endif
+#if FOC_LOG_LEVEL >= FOC_LOG_LEVEL_DEBUG
+#define LOG_D(fmt, ...) FOC_LOG_EMIT(FOC_LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_D(fmt, ...) ((void)0)
+#endif
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_Log_Init(void);    // FOC_UART_Init sonrası: stdout'a sabit tampon verir, idle boşaltmayı açar
+void FOC_Log_Process(void); // main while(1): halkayı FOC_UART çerçevelerine boşaltır
+void FOC_Log_Deferred(uint32_t info, const char *pFormat, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3); // LOG_x
+bool FOC_Log_Write(uint8_t level, const char *pText, uint32_t length); // Hazır metin, her bağlamdan; sığmazsa false
+const FOC_Log_Stats_t *FOC_Log_Get_Stats(void);
+
+#endif /* FOC_LOG_H_ */
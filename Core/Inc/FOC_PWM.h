@@ -0,0 +1,36 @@
+#ifndef FOC_PWM_H_
+#define FOC_PWM_H_
+
+#include <stdint.h>
+#include "FOC_Driver.h"
+#include "FOC_Benchmark.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+// ADC tetiğinin PWM tepe noktasından kaç timer tick önce üretileceği
+// (ADC örnekleme süresini tepe noktasına ortalamak için kullanılır)
+#define FOC_PWM_ADC_TRIGGER_ADVANCE 0U
+
+// DMA burst ile yazılan register sayısı (CCR1, CCR2, CCR3, CCR4)
+#define FOC_PWM_BURST_LENGTH 4U
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_PWM_Init(FOC_Handle_t *pHandle); // TIM1 + DMA burst yapılandırması, config.Ts'i de ayarlar
+void FOC_PWM_Start(void);                 // Sayacı ve çıkışları (MOE) açar
+void FOC_PWM_Stop(void);                  // Çıkışları güvenli duruma alır
+void FOC_PWM_Update(FOC_Handle_t *pHandle); // output.duty_x -> CCR1..CCR4 (tek DMA burst)
+void FOC_PWM_Compute(const FOC_Handle_t *pHandle, uint32_t *pBurst); // FOC_PWM_Update hesabı, TIM1'e yazmadan
+const FOC_Bench_t *FOC_PWM_Get_Bench(void); // FOC_PWM_Init'teki double-update bütçe ölçümü
+const FOC_Bench_t *FOC_PWM_Get_FCS_Bench(void); // FOC_PWM_Init'teki FCS-MPC çevrim ölçümü
+const FOC_Bench_t *FOC_PWM_Get_Regulator_Bench(FOC_Current_Regulator_t regulator); // FOC_REG_PI / FOC_REG_DEADBEAT, diğerleri 0
+uint32_t FOC_PWM_Get_Period(void);        // ARR değeri (timer tick)
+uint32_t FOC_PWM_Get_Tick_Length(void);   // Bir kontrol tick'inin timer tick cinsinden uzunluğu
+uint32_t FOC_PWM_Get_Tick_Phase(void);    // Son update olayından (tick sınırı) bu yana geçen timer tick
+void FOC_PWM_Trim_Period(int32_t delta);  // ARR = nominal + delta, bir sonraki update'te devreye girer (faz kilidi)
+
+#endif /* FOC_PWM_H_ */
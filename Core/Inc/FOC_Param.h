@@ -0,0 +1,126 @@
+#ifndef FOC_PARAM_H_
+#define FOC_PARAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_Driver.h"
+#include "FOC_Benchmark.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+#define FOC_PARAM_IRQ_PRIORITY 5U  // Set / Commit'i çağırabilecek en yüksek öncelik (FOC_UART)
+#define FOC_PARAM_NAME_SIZE    12U
+
+// Parametre ID'leri: tablo indeksi ile aynı (O(1) erişim). Host ID ile adresler, sıra değiştirilmemelidir.
+typedef enum{
+    FOC_PARAM_KP_D = 0,
+    FOC_PARAM_KI_D,
+    FOC_PARAM_KP_Q,
+    FOC_PARAM_KI_Q,
+    FOC_PARAM_CURRENT_LIMIT,
+    FOC_PARAM_I_S_MAX,
+    FOC_PARAM_VOLTAGE_LIMIT,
+    FOC_PARAM_MAX_SPEED,
+    FOC_PARAM_R_PHASE,
+    FOC_PARAM_L_D,
+    FOC_PARAM_L_Q,
+    FOC_PARAM_FLUX_LINKAGE,
+    FOC_PARAM_POLE_PAIRS,
+    FOC_PARAM_DEADBEAT_GAIN,
+    FOC_PARAM_FCS_SWITCH_WEIGHT,
+    FOC_PARAM_V_SWITCH_DROP,
+    FOC_PARAM_V_DIODE_DROP,
+    FOC_PARAM_DTC_CURRENT_BAND,
+    FOC_PARAM_FW_KI,
+    FOC_PARAM_FW_VOLTAGE_MARGIN,
+    FOC_PARAM_FW_I_D_MIN,
+    FOC_PARAM_FW_DECIMATION,
+    FOC_PARAM_KP_SPEED,
+    FOC_PARAM_KI_SPEED,
+    FOC_PARAM_KP_POSITION,
+    FOC_PARAM_SPEED_TORQUE_LIMIT,
+    FOC_PARAM_MAX_MOD_INDEX,
+    FOC_PARAM_FLUX_WEAKENING,
+    FOC_PARAM_MTPA,
+    FOC_PARAM_DEAD_TIME_COMP,
+    FOC_PARAM_ONLINE_ESTIMATION,
+    FOC_PARAM_BACK_CALC_AW,
+    FOC_PARAM_MODULATION,
+    FOC_PARAM_VOLTAGE_PRIORITY,
+    FOC_PARAM_CURRENT_REGULATOR,
+    FOC_PARAM_COUNT
+} FOC_Param_Id_t;
+
+// Gölge ayar, uygulama bankası ve türetme kopyasının üst sınırı (FOC_Scope RAM bütçesi)
+#define FOC_PARAM_RAM_BYTES ((FOC_PARAM_COUNT * 12U) + sizeof(FOC_MTPA_Table_t) + sizeof(FOC_Driver_Config_t) + sizeof(FOC_Bench_t) + 32U)
+
+// Değer tipleri
+#define FOC_PARAM_TYPE_FLOAT 0U
+#define FOC_PARAM_TYPE_UINT  1U // uint8_t veya enum alanı (boyut tanımlayıcıda)
+#define FOC_PARAM_TYPE_BOOL  2U
+
+// Tanımlayıcı bayrakları
+#define FOC_PARAM_FLAG_HOT  0x01U // Akım döngüsü çalışırken değiştirilebilir
+#define FOC_PARAM_FLAG_MTPA 0x02U // Değişince MTPA tablosu yeniden hesaplanır
+
+// İstek kodları (UART / CAN üzerinden FOC_Param_Request)
+#define FOC_PARAM_OP_GET     0x01U // Canlı (uygulanmış) değer
+#define FOC_PARAM_OP_SET     0x02U // Gölge ayara yazar, Commit'e kadar etkisi yok
+#define FOC_PARAM_OP_COMMIT  0x03U // Gölge ayarı bir sonraki uygun tick'te uygular
+#define FOC_PARAM_OP_DISCARD 0x04U // Gölge ayardaki değişiklikleri atar
+#define FOC_PARAM_OP_INFO    0x05U // Yanıt verisi: FOC_Param_Info_t
+#define FOC_PARAM_OP_STATUS  0x06U // Yanıt verisi: FOC_Param_Status_t
+
+// Yanıt durumları
+#define FOC_PARAM_OK          0x00U
+#define FOC_PARAM_ERR_ID      0x01U // Bilinmeyen parametre
+#define FOC_PARAM_ERR_RANGE   0x02U // Değer aralık dışında
+#define FOC_PARAM_ERR_RUNNING 0x03U // HOT olmayan parametre, akım döngüsü açıkken değiştirilemez
+#define FOC_PARAM_ERR_BUSY    0x04U // Önceki commit henüz uygulanmadı
+#define FOC_PARAM_ERR_OP      0x05U // Bilinmeyen / kısa istek
+#define FOC_PARAM_ERR_BUDGET  0x06U // FCS-MPC, FOC_FCS_MPC_MAX_CYCLES bütçesine sığmıyor (commit reddedildi)
+
+// İstek ve yanıt başlığı (8 byte, little endian)
+typedef struct __attribute__((packed)){
+    uint8_t op;
+    uint8_t status;   // Yanıtta FOC_PARAM_OK / FOC_PARAM_ERR_x
+    uint16_t id;      // FOC_Param_Id_t
+    float value;      // Host birimiyle (ayar değeri * scale)
+} FOC_Param_Msg_t;
+
+typedef struct __attribute__((packed)){
+    uint8_t type;     // FOC_PARAM_TYPE_x
+    uint8_t flags;    // FOC_PARAM_FLAG_x
+    uint8_t size;     // Ayar alanının byte boyutu
+    uint8_t count;    // Toplam parametre sayısı (FOC_PARAM_COUNT)
+    float min;        // Host birimiyle
+    float max;
+    float scale;      // Host değeri = ayar değeri * scale (örn: L_d H -> uH için 1e6)
+    char name[FOC_PARAM_NAME_SIZE];
+} FOC_Param_Info_t;
+
+typedef struct __attribute__((packed)){
+    uint32_t committed;  // Kabul edilen commit sayısı
+    uint32_t applied;    // Akım ISR'ında uygulanan commit sayısı
+    uint8_t staged;      // Gölge ayarda bekleyen parametre sayısı
+    uint8_t last_error;  // Son commit hazırlığının hatası (FOC_PARAM_ERR_RUNNING / FOC_PARAM_ERR_BUDGET)
+    uint16_t reserved;
+} FOC_Param_Status_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_Param_Init(FOC_Handle_t *pHandle);
+uint8_t FOC_Param_Set(uint16_t id, float value);   // Host birimiyle, gölge ayara
+uint8_t FOC_Param_Get(uint16_t id, float *pValue); // Canlı değer
+uint8_t FOC_Param_Commit(void);
+void FOC_Param_Discard(void);
+const FOC_Param_Status_t *FOC_Param_Get_Status(void);
+uint16_t FOC_Param_Request(const uint8_t *pRequest, uint16_t length, uint8_t *pResponse, uint16_t max_length);
+void FOC_Param_Process(void);               // main while(1) içinde: commit'i hazırlar (türetilmiş değerler)
+void FOC_Param_Apply(FOC_Handle_t *pHandle); // Akım ISR'ının başında, FOC_Current_Controller'dan önce
+
+#endif /* FOC_PARAM_H_ */
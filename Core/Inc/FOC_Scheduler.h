@@ -0,0 +1,39 @@
+#ifndef FOC_SCHEDULER_H_
+#define FOC_SCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_Driver.h"
+#include "FOC_Benchmark.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+#define FOC_SCHED_MAX_TASKS 6U  // Kayıt edilebilecek maksimum görev sayısı
+#define FOC_SCHED_MAX_SLOTS 64U // Tick bazında ölçüm tutulan dilim sayısı (hiperperiyot bundan büyükse katlanır)
+
+// Zamanlayıcı görevi (PendSV içinde, akım ISR'ından düşük öncelikte çalışır)
+typedef void (*FOC_Sched_Task_t)(FOC_Handle_t *pHandle);
+
+typedef struct{
+    FOC_Sched_Task_t task;
+    uint16_t period; // Kaç tick'te bir çalışır (tick = bir akım döngüsü)
+    uint16_t phase;  // Periyot içindeki tick (0 ... period - 1)
+    uint16_t remaining; // Bir sonraki çalışmaya kalan tick (1 ... period), FOC_Scheduler_Run geri sayar
+} FOC_Sched_Entry_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_Scheduler_Init(FOC_Handle_t *pHandle); // Hız ve pozisyon döngülerini faz kaydırmalı kaydeder
+bool FOC_Scheduler_Add_Task(FOC_Sched_Task_t task, uint16_t period, uint16_t phase);
+void FOC_Scheduler_Tick(void); // Akım ISR'ının sonunda çağrılır, PendSV'yi tetikler
+void FOC_Scheduler_Run(void);  // PendSV_Handler içinden çağrılır
+uint32_t FOC_Scheduler_Get_Tick(void);        // Akım ISR'ının son tamamladığı tick
+uint32_t FOC_Scheduler_Get_Hyperperiod(void); // Görev periyotlarının EKOK'u (tick)
+uint32_t FOC_Scheduler_Get_Missed_Ticks(void); // PendSV bir sonraki tick'e yetişemediğinde artar
+const FOC_Bench_t *FOC_Scheduler_Get_Slot_Bench(uint32_t slot); // slot: Init'ten beri tick sayısı % hiperperiyot
+
+#endif /* FOC_SCHEDULER_H_ */
@@ -0,0 +1,92 @@
+#ifndef FOC_SCOPE_H_
+#define FOC_SCOPE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "FOC_Driver.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+#define FOC_SCOPE_MAX_CHANNELS 8U
+#define FOC_SCOPE_BUFFER_BYTES (12U * 1024U) // Örnek tamponu, RAM bütçesi FOC_Scope.c'de derleme anında kontrol edilir
+
+// Kanal / tetik sinyali seçimi: FOC_Handle_t alanının byte ofseti. Alan telemetri kataloğunda olmalıdır
+// (FOC_Telem_Signals), tipi oradan alınır ve U8 / BOOL alanlar float'a çevrilerek kaydedilir.
+#define FOC_SCOPE_SIGNAL(field) ((uint16_t)offsetof(FOC_Handle_t, field))
+
+// Tetik modları (FOC_Scope_Fault() her modda tetikler)
+#define FOC_SCOPE_TRIG_AUTO    0U // Ön tetik dolunca hemen
+#define FOC_SCOPE_TRIG_RISING  1U // Sinyal seviyeyi aşağıdan yukarı keserse
+#define FOC_SCOPE_TRIG_FALLING 2U // Sinyal seviyeyi yukarıdan aşağı keserse
+#define FOC_SCOPE_TRIG_EDGE    3U // İki yönden biri
+#define FOC_SCOPE_TRIG_ABOVE   4U // Sinyal >= seviye
+#define FOC_SCOPE_TRIG_BELOW   5U // Sinyal <= seviye
+#define FOC_SCOPE_TRIG_FAULT   6U // Sadece FOC_Scope_Fault()
+
+// Durumlar
+#define FOC_SCOPE_STATE_IDLE       0U
+#define FOC_SCOPE_STATE_PRETRIGGER 1U // Ön tetik örnekleri toplanıyor
+#define FOC_SCOPE_STATE_ARMED      2U // Tetik bekleniyor
+#define FOC_SCOPE_STATE_TRIGGERED  3U // Son tetik örnekleri toplanıyor
+#define FOC_SCOPE_STATE_DONE       4U // Kayıt hazır, indirilebilir
+
+// İstek kodları (UART / CAN üzerinden FOC_Scope_Request)
+#define FOC_SCOPE_OP_CONFIG 0x01U // Veri: FOC_Scope_Config_t
+#define FOC_SCOPE_OP_ARM    0x02U
+#define FOC_SCOPE_OP_STOP   0x03U
+#define FOC_SCOPE_OP_FORCE  0x04U // Yazılımsal tetik
+#define FOC_SCOPE_OP_INFO   0x05U // Yanıt verisi: FOC_Scope_Info_t
+#define FOC_SCOPE_OP_READ   0x06U // offset: word ofseti, count: word sayısı, yanıt verisi: float[count]
+
+// Yanıt durumları
+#define FOC_SCOPE_OK        0x00U
+#define FOC_SCOPE_ERR_OP    0x01U // Bilinmeyen istek
+#define FOC_SCOPE_ERR_ARG   0x02U // Geçersiz ayar veya ofset
+#define FOC_SCOPE_ERR_STATE 0x03U // Kayıt hazır değil
+
+typedef struct __attribute__((packed)){
+    uint8_t channel_count;   // 1 ... FOC_SCOPE_MAX_CHANNELS
+    uint8_t trigger_mode;    // FOC_SCOPE_TRIG_x
+    uint16_t decimation;     // 1: her tick
+    uint16_t trigger_signal; // FOC_SCOPE_SIGNAL(...)
+    uint16_t pre_samples;    // Tetikten önceki örnek sayısı (derinlikten küçük olmalı)
+    float trigger_level;
+    uint16_t channel[FOC_SCOPE_MAX_CHANNELS]; // FOC_SCOPE_SIGNAL(...)
+} FOC_Scope_Config_t;
+
+typedef struct __attribute__((packed)){
+    uint8_t state;           // FOC_SCOPE_STATE_x
+    uint8_t channel_count;
+    uint16_t decimation;
+    uint16_t depth;          // Kanal başına örnek sayısı
+    uint16_t trigger_sample; // Kayıtta tetik örneğinin indeksi (hata tetiğinde ön tetikten az olabilir)
+    uint32_t trigger_tick;   // Tetik anındaki FOC_Scheduler tick'i
+} FOC_Scope_Info_t;
+
+// İstek ve yanıt başlığı (8 byte, little endian), ardından veri
+typedef struct __attribute__((packed)){
+    uint8_t op;       // FOC_SCOPE_OP_x
+    uint8_t status;   // Yanıtta FOC_SCOPE_OK / FOC_SCOPE_ERR_x, istekte 0
+    uint8_t count;    // READ: word sayısı
+    uint8_t reserved;
+    uint32_t offset;  // READ: kayıttaki word ofseti (örnek * kanal sayısı + kanal)
+} FOC_Scope_Header_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_Scope_Init(void);
+bool FOC_Scope_Configure(const FOC_Scope_Config_t *pConfig); // Kaydı durdurur, ayarları doğrular
+bool FOC_Scope_Arm(void);                   // Yeni kayıt başlatır (ön tetik toplanmaya başlar)
+void FOC_Scope_Stop(void);
+void FOC_Scope_Fault(void);                 // Her bağlamdan çağrılabilir, kurulu kaydı hemen tetikler
+void FOC_Scope_Sample(const FOC_Handle_t *pHandle); // Akım ISR'ında her tick, FOC_Current_Controller'dan sonra
+void FOC_Scope_Get_Info(FOC_Scope_Info_t *pInfo);
+uint32_t FOC_Scope_Read(uint32_t offset, float *pDst, uint32_t count); // Kopyalanan word sayısı (sadece DONE)
+uint16_t FOC_Scope_Request(const uint8_t *pRequest, uint16_t length, uint8_t *pResponse, uint16_t max_length);
+
+#endif /* FOC_SCOPE_H_ */
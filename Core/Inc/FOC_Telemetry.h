@@ -0,0 +1,83 @@
+#ifndef FOC_TELEMETRY_H_
+#define FOC_TELEMETRY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_Driver.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+#define FOC_TELEM_MAX_SUBS    16U  // Aynı anda abone olunabilecek sinyal sayısı
+#define FOC_TELEM_MAX_PACKET  240U // En büyük paket (FOC_UART_MAX_PAYLOAD)
+#define FOC_TELEM_NAME_SIZE   12U
+#define FOC_TELEM_IRQ_PRIORITY 1U  // Subscribe'ı çağırabilecek en yüksek öncelik (FDCAN ISR)
+#define FOC_TELEM_RAM_BYTES   (FOC_TELEM_MAX_PACKET + (FOC_TELEM_MAX_SUBS * 32U)) // Modül tamponlarının üst sınırı (FOC_Scope RAM bütçesi)
+
+// Sinyal tipleri
+#define FOC_TELEM_TYPE_FLOAT 0U // value * scale en yakın tamsayıya yuvarlanır
+#define FOC_TELEM_TYPE_U8    1U
+#define FOC_TELEM_TYPE_BOOL  2U
+
+// Abonelik isteği (little endian): başlık + count x giriş
+typedef struct __attribute__((packed)){
+    uint8_t count;           // 0: tüm abonelikler kaldırılır
+    uint8_t runs_per_packet; // Paket başına en fazla çalışma (gecikme sınırı), 0: paket dolana kadar
+    uint16_t reserved;
+} FOC_Telem_Subscribe_t;
+
+typedef struct __attribute__((packed)){
+    uint8_t signal;      // Sinyal kataloğundaki indeks
+    uint8_t reserved;
+    uint16_t decimation; // Görevin kaç çalışmasında bir örneklenir (1: her çalışma)
+} FOC_Telem_Sub_Entry_t;
+
+// Abonelik yanıtı (UART)
+typedef struct __attribute__((packed)){
+    uint8_t status;      // 0: kabul edildi, 1: geçersiz istek / çıkışın paketine sığmıyor, 2: önceki istek henüz uygulanmadı
+    uint8_t generation;  // Aboneliğin uygulanacağı nesil (paket başlığında görülür)
+    uint16_t period;     // Görev periyodu (akım döngüsü tick'i)
+} FOC_Telem_Ack_t;
+
+// Paket başlığı (10 byte), ardından zigzag + varint kodlanmış farklar
+typedef struct __attribute__((packed)){
+    uint32_t tick;       // İlk çalışmanın FOC_Scheduler tick'i
+    uint32_t run;        // İlk çalışmanın abonelikten bu yana sırası (decimation fazı: run % decimation == 0)
+    uint8_t runs;        // Paketteki çalışma sayısı
+    uint8_t generation;  // Abonelik nesli
+} FOC_Telem_Header_t;
+
+// Katalog girişi (20 byte)
+typedef struct __attribute__((packed)){
+    uint8_t signal;
+    uint8_t type;        // FOC_TELEM_TYPE_x
+    uint16_t offset;     // FOC_Handle_t içindeki byte ofseti
+    float scale;         // Kodlanan tamsayı = değer * scale
+    char name[FOC_TELEM_NAME_SIZE];
+} FOC_Telem_Catalog_t;
+
+// Paket çıkışı (UART veya CAN), PendSV içinde çağrılır
+typedef bool (*FOC_Telem_Sink_t)(const uint8_t *pData, uint16_t length);
+
+typedef struct{
+    uint32_t packets;     // Gönderilen paket
+    uint32_t dropped;     // Çıkışın kabul etmediği paket
+    uint32_t samples;     // Kodlanan örnek
+    uint32_t bytes;       // Gönderilen paket byte'ı (başlık dahil)
+} FOC_Telem_Stats_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_Telemetry_Init(FOC_Handle_t *pHandle, uint16_t period); // period: görevin scheduler periyodu (tick)
+void FOC_Telemetry_Set_Sink(FOC_Telem_Sink_t sink, uint16_t max_packet);
+uint8_t FOC_Telemetry_Subscribe(const uint8_t *pRequest, uint16_t length, FOC_Telem_Ack_t *pAck); // FOC_TELEM_IRQ_PRIORITY ve altı
+uint16_t FOC_Telemetry_Catalog(uint8_t first, uint8_t *pDst, uint16_t max_length); // first'ten itibaren girişler
+uint8_t FOC_Telemetry_Signal_Count(void);
+bool FOC_Telemetry_Signal_Type(uint16_t offset, uint8_t *pType); // FOC_Handle_t ofseti katalogda yoksa false (FOC_Scope)
+void FOC_Telemetry_Task(FOC_Handle_t *pHandle); // FOC_Scheduler görevi olarak eklenir
+const FOC_Telem_Stats_t *FOC_Telemetry_Get_Stats(void);
+
+#endif /* FOC_TELEMETRY_H_ */
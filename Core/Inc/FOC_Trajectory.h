@@ -0,0 +1,54 @@
+#ifndef FOC_TRAJECTORY_H_
+#define FOC_TRAJECTORY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_Driver.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+#define FOC_TRAJ_QUEUE_SIZE  64U // PVT noktası halka tamponu (2'nin kuvveti olmalı)
+#define FOC_TRAJ_FLOW_POINTS 8U  // Bu kadar nokta tüketildikçe host'a akış kontrol durumu bildirilir
+
+// FOC_Traj_Point_t.dt_flags
+#define FOC_TRAJ_DT_MASK     0x00FFFFFFU  // Önceki noktadan bu noktaya süre (akım döngüsü tick'i)
+#define FOC_TRAJ_FLAG_END    (1UL << 24)  // Son nokta: ulaşıldığında yörünge biter, referans setpoint yoluna bırakılır
+
+// FOC_Traj_Status_t.flags
+#define FOC_TRAJ_STATUS_RUNNING   0x01U
+#define FOC_TRAJ_STATUS_UNDERRUN  0x02U // Kuyruk boşaldı, son noktada bekleniyor
+#define FOC_TRAJ_STATUS_DONE      0x04U // END noktasına ulaşıldı
+#define FOC_TRAJ_STATUS_SEQ_ERROR 0x08U // Beklenmeyen sıra numarası, host next_seq'ten tekrar göndermeli
+
+// PVT noktası (12 byte, little endian, CAN üzerinde de bu yerleşimle taşınır)
+typedef struct __attribute__((packed)){
+    float position;    // Mekanik rad (çok turlu)
+    float velocity;    // Mekanik rad/s
+    uint32_t dt_flags; // Süre (tick, FOC_TRAJ_DT_MASK) | FOC_TRAJ_FLAG_x
+} FOC_Traj_Point_t;
+
+// Akış kontrol durumu (8 byte, little endian)
+typedef struct __attribute__((packed)){
+    uint16_t next_seq;       // Beklenen bir sonraki nokta sıra numarası
+    uint8_t free;            // Kuyruktaki boş yer (host en fazla bu kadar nokta göndermeli)
+    uint8_t flags;           // FOC_TRAJ_STATUS_x
+    uint32_t underrun_count;
+} FOC_Traj_Status_t;
+
+typedef void (*FOC_Traj_Flow_Callback_t)(const FOC_Traj_Status_t *pStatus);
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+void FOC_Trajectory_Init(FOC_Handle_t *pHandle, uint16_t period); // period: FOC_Trajectory_Task'ın scheduler periyodu (tick)
+void FOC_Trajectory_Set_Flow_Callback(FOC_Traj_Flow_Callback_t callback);
+void FOC_Trajectory_Start(uint16_t first_seq);                          // Üretici: kuyruğu sıfırlar, ölçülen pozisyondan başlar
+void FOC_Trajectory_Stop(FOC_Handle_t *pHandle);                        // Setpoint yolu: yörüngeyi durdurur, referansı bırakır
+bool FOC_Trajectory_Push(uint16_t seq, const FOC_Traj_Point_t *pPoint); // Üretici (tek): false -> dolu veya sıra hatası
+void FOC_Trajectory_Task(FOC_Handle_t *pHandle);                        // FOC_Scheduler görevi: Hermite interpolasyonu
+void FOC_Trajectory_Get_Status(FOC_Traj_Status_t *pStatus);
+
+#endif /* FOC_TRAJECTORY_H_ */
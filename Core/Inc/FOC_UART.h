@@ -0,0 +1,81 @@
+#ifndef FOC_UART_H_
+#define FOC_UART_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FOC_Driver.h"
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+#define FOC_UART_BAUD          4000000U // USART2, OVER8 ile 170 MHz'den tam bölünür
+#define FOC_UART_IRQ_PRIORITY  5U       // USART2 + DMA kesmeleri, akım ISR'ı (0) ve FDCAN (1) etkilenmez
+
+#define FOC_UART_TX_SIZE       2048U    // TX halkası (2'nin kuvveti), COBS kodlanmış çerçeveler
+#define FOC_UART_RX_DMA_SIZE   512U     // Dairesel RX DMA tamponu (2'nin kuvveti)
+#define FOC_UART_MAX_PAYLOAD   240U     // Bir çerçevenin en fazla veri uzunluğu (byte)
+#define FOC_UART_MAX_HANDLERS  8U       // Kayıt edilebilecek RX çerçeve tipi sayısı
+
+// Çerçeve tipleri (0x00 kullanılmaz)
+#define FOC_UART_TYPE_TELEMETRY 0x01U // Sürücü -> host, FOC_UART_Telemetry_t
+#define FOC_UART_TYPE_COMMAND   0x02U // Host -> sürücü, 1 byte FOC_UART_CMD_x
+#define FOC_UART_TYPE_SETPOINT  0x03U // Host -> sürücü, FOC_CAN_Setpoint_t ile aynı 16 byte
+#define FOC_UART_TYPE_SCOPE     0x04U // İki yön, FOC_Scope_Header_t + veri (istek / yanıt)
+#define FOC_UART_TYPE_STREAM    0x05U // Sürücü -> host, FOC_Telem_Header_t + kodlanmış örnekler
+#define FOC_UART_TYPE_SUBSCRIBE 0x06U // Host -> sürücü FOC_Telem_Subscribe_t + girişler, yanıt FOC_Telem_Ack_t
+#define FOC_UART_TYPE_CATALOG   0x07U // Host -> sürücü 1 byte ilk indeks, yanıt sinyal kataloğu
+#define FOC_UART_TYPE_PARAM     0x08U // İki yön, FOC_Param_Msg_t + veri (istek / yanıt)
+#define FOC_UART_TYPE_LOG       0x09U // Sürücü -> host, FOC_Log_Header_t + metin (FOC_Log)
+
+// Komutlar
+#define FOC_UART_CMD_ENABLE  0x01U
+#define FOC_UART_CMD_DISABLE 0x02U
+
+// Telemetri çerçevesi verisi (48 byte, little endian)
+typedef struct __attribute__((packed)){
+    uint32_t tick;       // Örneğin alındığı yerel tick (FOC_Scheduler_Get_Tick)
+    uint8_t status;      // bit0: akım, bit1: hız, bit2: pozisyon döngüsü açık
+    uint8_t reserved[3];
+    float i_d;
+    float i_q;
+    float i_d_ref;
+    float i_q_ref;
+    float u_d;
+    float u_q;
+    float w_rad_s;
+    float electrical_angle;
+    float U_bat;
+    float position_rad;
+} FOC_UART_Telemetry_t;
+
+// RX çerçeve işleyicisi: UART kesme önceliğinde çalışır, kısa tutulmalıdır
+typedef void (*FOC_UART_Handler_t)(const uint8_t *pPayload, uint16_t length);
+
+typedef struct{
+    uint32_t tx_frames;      // TX halkasına eklenen çerçeve
+    uint32_t tx_dropped;     // Halka dolu olduğu için atılan çerçeve
+    uint32_t tx_rejected;    // UART önceliğinden yüksek bağlamdan çağrıldığı için reddedilen çerçeve
+    uint32_t rx_frames;      // CRC'si doğru alınan çerçeve
+    uint32_t rx_crc_error;   // CRC hatalı çerçeve
+    uint32_t rx_frame_error; // COBS çözme hatası veya çok kısa çerçeve
+    uint32_t rx_overflow;    // FOC_UART_MAX_PAYLOAD'dan uzun çerçeve
+    uint32_t rx_unknown;     // İşleyicisi olmayan çerçeve tipi
+    uint32_t line_error;     // USART overrun / framing / gürültü hatası
+} FOC_UART_Stats_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+bool FOC_UART_Init(FOC_Handle_t *pHandle); // MX_USART2_UART_Init sonrası: DMA, CRC ve kesmeleri kurar
+bool FOC_UART_Send(uint8_t type, const void *pPayload, uint16_t length); // Bloklamaz, yer yoksa false
+bool FOC_UART_Register_Handler(uint8_t type, FOC_UART_Handler_t handler);
+void FOC_UART_Telemetry_Task(FOC_Handle_t *pHandle); // FOC_Scheduler görevi olarak eklenir
+void FOC_UART_IRQHandler(void);        // USART2_IRQHandler: idle hattı ve hat hataları
+void FOC_UART_DMA_Rx_IRQHandler(void); // DMA1_Channel2_IRQHandler: RX yarım / tam
+void FOC_UART_DMA_Tx_IRQHandler(void); // DMA1_Channel3_IRQHandler: TX parçası bitti
+bool FOC_UART_Stream_Sink(const uint8_t *pData, uint16_t length); // FOC_Telemetry çıkışı
+const FOC_UART_Stats_t *FOC_UART_Get_Stats(void);
+
+#endif /* FOC_UART_H_ */
@@ -0,0 +1,161 @@
+// <<---------------------------------------------->>
+// <<-------------Kütüphane Tanımlamaları---------->>
+// <<---------------------------------------------->>
+
+// DWT çevrim sayacı ile ISR süresi ölçümü.
+// FOC_Bench_Start / FOC_Bench_Stop ölçülecek bloğun etrafına konur, sonuçlar debugger ile
+// FOC_Bench_t yapısından okunur. Bütçe, ISR'ın tamamlanması gereken süreden (Ts) hesaplanır.
+
+#include "FOC_Benchmark.h"
+#include "FOC_PWM.h"
+
+// <<---------------------------------------------->>
+// <<-------------Fonksiyon Tanımlamaları---------->>
+// <<---------------------------------------------->>
+
+void FOC_Bench_Init(void){
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Bench_Reset(FOC_Bench_t *pBench, float period_s){
+    pBench->start = 0;
+    pBench->last = 0;
+    pBench->max = 0;
+    pBench->budget = (uint32_t)(period_s * (float)SystemCoreClock);
+    pBench->overrun_count = 0;
+    pBench->count = 0;
+}
+
+// ------------------------------------------------------------------------------
+
+// Akım döngüsü ölçümleri handle'ın bu kopyası üzerinde yapılır: gerçek handle'ın state / output'u değişmez
+// ve ölçüm sırasında çalışan bir akım ISR'ı ile çakışmaz.
+static FOC_Handle_t FOC_Bench_Handle;
+
+// FOC_Bench_Handle ile akım döngüsünü (FOC_Current_Controller + FOC_PWM_Compute) sentetik girişlerle
+// 'iterations' kez çalıştırır. FOC_PWM_Compute, FOC_PWM_Update'in TIM1 / DMA'ya yazmayan eşidir,
+// bu yüzden ölçüm PWM çıkışları açıkken de güvenlidir.
+// Tork (±tepe tork), hız (0 ... 1.2 * max hız) ve U_bat (%60 ... %100) taranır: config'te açıksa akı zayıflatma,
+// OVM mode II, DPWM_AUTO ve ölü zaman kompanzasyonu (akım işareti değişir) dalları da ölçüme girer.
+// Ölçülen akımlar bir önceki tick'in referansından %10 sapmayla üretilir, regülatör sürekli çalışır.
+// Bütçe Ts'den FOC_BENCH_ISR_HOOK_CYCLES düşülerek uygulanır (ISR'ın burada çalıştırılamayan adımları).
+static bool FOC_Bench_Loop(FOC_Bench_t *pBench, uint32_t iterations){
+    FOC_Handle_t *pHandle = &FOC_Bench_Handle;
+    uint32_t burst[FOC_PWM_BURST_LENGTH];
+    float theta = -3.14159265f;
+
+    // Kapalı döngü erken döner ve ölçüm anlamsız olur
+    pHandle->config.current_ctrl_mode = true;
+    float U_bat = (pHandle->input.U_bat < 1.0f) ? 36.0f : pHandle->input.U_bat;
+    float w_max = 1.2f * pHandle->config.max_speed_rad_s * (float)pHandle->config.pole_pairs;
+    if(w_max < 1.0f) w_max = 3000.0f;
+    float T_max = 1.5f * (float)pHandle->config.pole_pairs * pHandle->config.flux_linkage * pHandle->config.current_limit;
+
+    FOC_Bench_Reset(pBench, pHandle->config.Ts);
+    pBench->budget = (pBench->budget > FOC_BENCH_ISR_HOOK_CYCLES) ? (pBench->budget - FOC_BENCH_ISR_HOOK_CYCLES) : 0U;
+
+    for(uint32_t i = 0; i < iterations; i++){
+        // Açı 360'ın katı olmayan bir adımla döner, her tork / hız / U_bat birleşimi farklı sektörde ölçülür
+        theta += 0.8652f;
+        if(theta > 3.14159265f) theta -= 6.2831853f;
+        pHandle->input.Electrical_Angle_rad = theta;
+        pHandle->input.T_mot_ref = T_max * ((float)((i / 40U) % 9U) - 4.0f) * 0.25f;
+        pHandle->input.w_rad_s = w_max * (float)((i / 5U) % 8U) * (1.0f / 7.0f);
+        pHandle->input.U_bat = U_bat * (0.6f + (0.1f * (float)(i % 5U)));
+
+        // Ölçülen akım: önceki referansın %90'ı, alfa-beta -> a, b
+        float c = cosf(theta);
+        float s = sinf(theta);
+        float i_alpha = 0.9f * ((pHandle->state.i_d_ref * c) - (pHandle->state.i_q_ref * s));
+        float i_beta = 0.9f * ((pHandle->state.i_d_ref * s) + (pHandle->state.i_q_ref * c));
+        pHandle->input.i_a_meas = i_alpha;
+        pHandle->input.i_b_meas = (-0.5f * i_alpha) + (0.8660254f * i_beta);
+
+        __disable_irq();
+        FOC_Bench_Start(pBench);
+        FOC_Current_Controller(pHandle);
+        FOC_PWM_Compute(pHandle, burst);
+        FOC_Bench_Stop(pBench);
+        __enable_irq();
+    }
+
+    return (pBench->overrun_count == 0U);
+}
+
+// ------------------------------------------------------------------------------
+
+// En kötü durumun config.Ts içine sığıp sığmadığını döner.
+// Double-update modunda Ts yarım PWM periyodudur, yani test yarım periyot bütçesini doğrular.
+// FOC_PWM_Init double-update istendiğinde bunu kendisi çağırır.
+bool FOC_Bench_Current_Loop(const FOC_Handle_t *pHandle, FOC_Bench_t *pBench, uint32_t iterations){
+    FOC_Bench_Handle = *pHandle;
+    return FOC_Bench_Loop(pBench, iterations);
+}
+
+// ------------------------------------------------------------------------------
+
+// Seçilen akım regülatörü ile akım döngüsünü ölçer, gerçek handle'ın regülatör seçimi değişmez.
+// FOC_PWM_Init PI ve deadbeat için bunu kendisi çağırır (FOC_PWM_Get_Regulator_Bench).
+bool FOC_Bench_Regulator(const FOC_Handle_t *pHandle, FOC_Current_Regulator_t regulator, FOC_Bench_t *pBench, uint32_t iterations){
+    FOC_Bench_Handle = *pHandle;
+    FOC_Bench_Handle.config.current_regulator = regulator;
+    return FOC_Bench_Loop(pBench, iterations);
+}
+
+// ------------------------------------------------------------------------------
+
+// Sadece FOC_FCS_MPC_Control'ü handle'ın kopyasında ölçer ve bütçeyi FOC_FCS_MPC_MAX_CYCLES olarak uygular.
+// Açı, hız, referans ve önceki anahtarlama durumu taranır; aday döngüsü sabit olduğu için
+// max değeri tüm girişler için en kötü durumu temsil eder. Başarısızsa sabit güncellenmelidir.
+// FOC_PWM_Init, FCS-MPC seçiliyse bunu kendisi çağırır; aşılırsa PI regülatörüne döner.
+static bool FOC_Bench_FCS_MPC_Loop(FOC_Bench_t *pBench, uint32_t iterations){
+    FOC_Handle_t *pCopy = &FOC_Bench_Handle;
+
+    if(pCopy->input.U_bat < 1.0f) pCopy->input.U_bat = 36.0f;
+
+    FOC_Bench_Reset(pBench, 0.0f);
+    pBench->budget = FOC_FCS_MPC_MAX_CYCLES;
+
+    FOC_Parameter_Schedule(pCopy);
+
+    for(uint32_t i = 0; i < iterations; i++){
+        pCopy->input.Electrical_Angle_rad = -3.14159265f + (6.2831853f * (float)(i % 360U) / 360.0f);
+        pCopy->input.w_rad_s = (float)(i % 7U) * 500.0f;
+        pCopy->input.i_a_meas = 0.5f;
+        pCopy->input.i_b_meas = -0.25f;
+        pCopy->state.i_d_ref = -(float)(i % 3U);
+        pCopy->state.i_q_ref = (float)(i % 11U) - 5.0f;
+        pCopy->state.fcs_state = (uint8_t)(i & 7U);
+
+        FOC_Clark_Park_Transform(pCopy);
+
+        __disable_irq();
+        FOC_Bench_Start(pBench);
+        FOC_FCS_MPC_Control(pCopy);
+        FOC_Bench_Stop(pBench);
+        __enable_irq();
+    }
+
+    return (pBench->overrun_count == 0U);
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Bench_FCS_MPC(const FOC_Handle_t *pHandle, FOC_Bench_t *pBench, uint32_t iterations){
+    FOC_Bench_Handle = *pHandle;
+    return FOC_Bench_FCS_MPC_Loop(pBench, iterations);
+}
+
+// ------------------------------------------------------------------------------
+
+// FOC_Param_Process: FCS-MPC seçen bir commit, yayınlanmadan önce commit edilecek ayarın kopyasıyla ölçülür.
+// Main döngüsünden çağrılır; her iterasyonda kesmeler sadece FOC_FCS_MPC_Control süresince kapalıdır.
+bool FOC_Bench_FCS_MPC_Config(const FOC_Handle_t *pHandle, const FOC_Driver_Config_t *pConfig, FOC_Bench_t *pBench, uint32_t iterations){
+    FOC_Bench_Handle = *pHandle;
+    FOC_Bench_Handle.config = *pConfig;
+    return FOC_Bench_FCS_MPC_Loop(pBench, iterations);
+}
@@ -0,0 +1,695 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül FDCAN1 üzerinde CAN-FD (1 Mbit/s arbitrasyon, 5 Mbit/s veri, BRS) komut ve telemetri protokolüdür.
+// Tüm çerçeveler 64 byte'tır. Bir setpoint çerçevesi 4 eksenin referanslarını birlikte taşır,
+// her sürücü kendi node_id'sine ait yeri okur. Her sürücü kendi telemetrisini 64 byte'lık tek çerçevede gönderir.
+// Kabul filtrelemesi yazılımda değil FDCAN mesaj RAM'indeki standart filtre elemanlarında yapılır.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// ID planı (11 bit, düşük ID yüksek öncelik):
+//   0x080           : SYNC (bus master), en yüksek öncelik
+//   0x100 + grup    : setpoint (grup = node_id / 4)
+//   0x200 + node_id : komut,  0x2FF: tüm sürücülere komut
+//   0x180 + node_id : PVT yörünge noktaları (FOC_Trajectory kuyruğuna)
+//   0x300 + node_id : telemetri
+//   0x380 + node_id : PVT akış kontrolü
+//   0x400 + node_id : scope yanıtı (kayıt indirme)
+//   0x440 + node_id : parametre yanıtı (FOC_Param)
+//   0x480 + node_id : abonelik telemetrisi (FOC_Telemetry paketleri), en düşük öncelik
+// Filtreler: eleman 0 -> kendi setpoint grubu, eleman 1 (dual) -> kendi komut ID'si ve broadcast, eleman 2 -> SYNC,
+// eleman 3 -> kendi PVT ID'si.
+// Eşleşmeyen standart / extended ve remote çerçeveler global filtrede reddedilir, CPU hiç görmez.
+// RX: FIFO0 yeni mesaj kesmesi (FDCAN1_IT0, öncelik 1) elemanı doğrudan mesaj RAM'inden okur.
+// Sadece bu node'a ait 16 byte'lık yer, iki yuvalı setpoint tamponunun boş yuvasına kopyalanır ve
+// yuva işaretçisi yayınlanır. Akım ISR'ı (öncelik 0) FOC_CAN_Consume() ile işaretçiyi alıp NULL yapar.
+// Tek üretici (FDCAN ISR) / tek tüketici (akım ISR): tüketici üreticiyi kesebilir ama tersi olamaz,
+// bu yüzden üretici yayınlanmamış yuvaya yazarken tüketici sadece yayınlanmış yuvayı okur; kilit gerekmez.
+// TX: telemetri HAL ara tamponu olmadan doğrudan TX FIFO elemanına (mesaj RAM) yazılır, TXBAR ile gönderilir.
+// Gecikme (mandallama kapalı): çerçeve sonu -> FDCAN ISR (~0.5 us) -> bir sonraki akım ISR'ı (en fazla 1 tick)
+// -> aynı ISR'da i_q_ref ve duty hesaplanır -> duty bir sonraki update olayında (yarım tick sonra) devreye girer.
+// Tek update modunda tick = 1 PWM periyodu: komut -> gerilim en fazla 1.5 periyot (ort. 1).
+// Double-update modunda (config.pwm_double_update) tick = yarım periyot: en fazla 0.75 periyot, 1 periyodun altı
+// sadece bu modda garanti edilir. HAL_FDCAN_GetRxMessage + idle döngüsü yolunda bu süre
+// main döngüsünün tur süresine bağlıydı (flash yazma / RLS sırasında ms mertebesi).
+// SYNC: FDCAN her çerçevenin SOF anını dış timestamp sayacından (TIM3_CNT) RX elemanına yazar.
+// (CAN-FD'de dahili sayaç bit süresi değiştiği için sabit zaman tabanı vermez.)
+// Akım ISR'ında SOF'tan bu yana geçen süre (TIM3) ve TIM1'in son tick sınırından bu yana geçen süre
+// okunur; ikisinin farkı SOF anının bu node'un tick ızgarasına göre fazıdır. Tüm node'lar aynı SOF'u
+// aynı anda gördüğü için (yayılım gecikmesi < 100 ns) bu faz her node'da sıfıra çekilir:
+// PI faz kilidi TIM1 ARR'sini nominal etrafında trim eder (P: faz hatası, I: kristal frekans farkı).
+// Yakalamada integratör kapalıdır, faz hatası ilk kez FOC_CAN_SYNC_LOCK altına inince açılır. Hesap register'sız
+// olarak FOC_CAN_Sync.c'dedir; birkaç node'un kilitlenmesi Tools/foc_hostsim/sim_sync ile kontrol edilir.
+// Aynı anda SOF'taki yerel tick ile SYNC'in taşıdığı master_tick arasındaki fark saklanır; telemetri
+// örnekleri bu farkla bus tick'ine çevrilerek gönderilir (sample_tick) ve faz hatası da telemetride taşınır.
+// Mandallama açıksa (FOC_CAN_Set_Sync_Latch) gelen setpoint uygulanmaz, SYNC gelince mandallanır ve
+// SYNC'in apply_tick'ine karşılık gelen yerel tick'te akım ISR'ında uygulanır -> tüm eksenler aynı tick'te.
+// Setpoint yuvaları: yayınlanan, mandallı, uygulanmayı bekleyen ve yazılan için 4 yuva; üretici
+// (FDCAN ISR) her zaman bu üçünde olmayan yuvaya yazar.
+// Bant genişliği: 64 byte BRS çerçeve ~29 bit @1M + ~600 bit @5M (CRC21 + stuff dahil) ~ 150 us.
+// 4 eksen x 1 kHz telemetri + 1 kHz setpoint ~ 5 x 150 us = 750 us / ms -> yük ~%75.
+// Daha fazla eksen veya hız için telemetri periyodu artırılmalı veya alanlar int16'ya indirilmelidir.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. MX_FDCAN1_Init() sonrası FOC_CAN_Init(&hfoc, node_id) çağrılır.
+// 2. Telemetri: FOC_Scheduler_Add_Task(FOC_CAN_Telemetry_Task, 20, 2); // 20 kHz / 20 = 1 kHz
+//    (faz, hız / pozisyon döngüleriyle çakışmayacak şekilde seçilmelidir)
+// 3. Akım ISR'ının başında FOC_CAN_Consume(&hfoc) çağrılır (akım ISR'ı FDCAN1_IT0'dan yüksek öncelikli olmalı).
+//    FDCAN1_IT0_IRQHandler içinden FOC_CAN_IRQHandler() çağrılır.
+//    FOC_PWM_Init ve FOC_Scheduler_Init'ten sonra çağrılmalıdır (tick fazı ve tick sayacı kullanılır).
+//    Çok eksenli senkron kullanım için FOC_CAN_Set_Sync_Latch(true); master SYNC'i sabit periyotla,
+//    kendi tick sınırında gönderir.
+//    Scope: komut çerçevesinde FOC_CAN_CMD_SCOPE + FOC_Scope isteği gönderilir, yanıt bir sonraki
+//    telemetri görevinde FOC_CAN_ID_SCOPE ile gelir (READ: 14 word / çerçeve).
+//    Abonelik telemetrisi: FOC_Telemetry_Set_Sink(FOC_CAN_Stream_Sink, FOC_CAN_FRAME_SIZE); abonelik isteği
+//    komut çerçevesinde FOC_CAN_CMD_SUBSCRIBE ile gelir (en fazla 10 sinyal). Yanıt çerçevesi yoktur,
+//    host kabulü FOC_CAN_ID_STREAM paketlerinin başlığındaki nesil numarasından görür.
+//    Parametre: komut çerçevesinde FOC_CAN_CMD_PARAM + FOC_Param isteği, yanıt FOC_CAN_ID_PARAM ile (scope gibi).
+// 4. FOC_CAN_Loopback_Test() devreye almada bus'a bağlı olmadan filtre / BRS / 64 byte yolunu doğrular.
+
+// Yapılması gereken MX Konfigürasyonlar (STM32G431CBU6):
+// FDCAN1: Frame Format FD_BRS, saat PCLK1 = 170 MHz.
+// Nominal: Prescaler 1, Seg1 135, Seg2 34, SJW 34 -> 1 Mbit/s, örnekleme %80
+// Data:    Prescaler 1, Seg1 26,  Seg2 7,  SJW 7  -> 5 Mbit/s, örnekleme %79.4 (TDC açık)
+// Std Filters Nbr: 4
+// TIM3 bu modül tarafından register seviyesinde serbest sayan timestamp sayacı olarak kurulur, başka iş için kullanılmamalıdır.
+// APB1 ve APB2 bölücüleri 1 kabul edilmiştir (TIM1 = PCLK2, TIM3 = PCLK1).
+// NVIC: FDCAN1 interrupt 0 -> Preemption Priority 1, HAL handler çağrısı kapalı
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_CAN.h"
+#include "FOC_CAN_Sync.h"
+#include "FOC_PWM.h"
+#include "FOC_Scheduler.h"
+#include "FOC_Trajectory.h"
+#include "FOC_Scope.h"
+#include "FOC_Telemetry.h"
+#include "FOC_Param.h"
+#include "fdcan.h"
+#include <string.h>
+#include <stddef.h>
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+_Static_assert(sizeof(FOC_CAN_Setpoint_t) * FOC_CAN_AXES_PER_FRAME == FOC_CAN_FRAME_SIZE, "Setpoint çerçevesi 64 byte olmalı");
+_Static_assert(sizeof(FOC_CAN_Telemetry_t) == FOC_CAN_FRAME_SIZE, "Telemetri çerçevesi 64 byte olmalı");
+_Static_assert(sizeof(FOC_CAN_Pvt_Header_t) + (FOC_CAN_PVT_POINTS * sizeof(FOC_Traj_Point_t)) == FOC_CAN_FRAME_SIZE, "PVT çerçevesi 64 byte olmalı");
+_Static_assert(sizeof(FOC_Traj_Status_t) == FOC_CAN_SYNC_SIZE, "Akış kontrol çerçevesi 8 byte olmalı");
+_Static_assert(offsetof(FOC_CAN_Telemetry_t, i_d) == 4U && offsetof(FOC_CAN_Telemetry_t, sample_tick) == 60U, "Telemetri TX word yerleşimi ile uyumsuz");
+
+#define FOC_CAN_LOOPBACK_TIMEOUT_MS 10U
+
+// Mesaj RAM yerleşimi (RM0440, FDCAN1: 28 std filtre, 8 ext filtre, 3+3 RX, 3 TX event, 3 TX eleman)
+#define FOC_CAN_RAM_RF0SA     0x0B0U
+#define FOC_CAN_RAM_TFQSA     0x278U
+#define FOC_CAN_RAM_ELEM_SIZE 72U     // 2 başlık + 16 veri word'ü
+#define FOC_CAN_RAM_ID_POS    18U     // Standart ID, R0 / T0 içinde
+#define FOC_CAN_RAM_DLC_POS   16U
+#define FOC_CAN_RAM_BRS       (1UL << 20)
+#define FOC_CAN_RAM_FDF       (1UL << 21)
+#define FOC_CAN_RAM_DLC_64    15U
+#define FOC_CAN_RAM_DLC_8     8U
+#define FOC_CAN_RAM_RXTS_MASK 0xFFFFU
+#define FOC_CAN_SETPOINT_SLOTS 4U
+
+static FOC_Handle_t *FOC_CAN_Handle = 0;
+static uint8_t FOC_CAN_Node_Id = 0;
+static uint16_t FOC_CAN_Tx_Sequence = 0;
+static FOC_CAN_Stats_t FOC_CAN_Stats;
+
+// Setpoint yuvaları: FDCAN ISR boş yuvaya yazar, akım ISR'ı yayınlananı / mandallananı okur
+typedef union{
+    FOC_CAN_Setpoint_t setpoint;
+    uint32_t word[sizeof(FOC_CAN_Setpoint_t) / 4U]; // Mesaj RAM'inden word word kopyalama için
+} FOC_CAN_Slot_t;
+
+static FOC_CAN_Slot_t FOC_CAN_Slot[FOC_CAN_SETPOINT_SLOTS];
+static FOC_CAN_Setpoint_t *volatile FOC_CAN_Published = 0;
+static FOC_CAN_Setpoint_t *volatile FOC_CAN_Armed = 0; // Sadece akım ISR'ı yazar
+static uint32_t FOC_CAN_Armed_Tick = 0;                // Yerel tick
+static bool FOC_CAN_Sync_Latch = false;
+
+// FDCAN ISR -> akım ISR'ı: son SYNC (Pending true iken sadece akım ISR'ı okur)
+typedef struct{
+    uint32_t master_tick;
+    uint32_t apply_tick;
+    uint16_t ts_rx;                 // SOF timestamp (TIM3_CNT)
+    FOC_CAN_Setpoint_t *pSetpoint;  // SYNC anında mandallanan setpoint (yoksa 0)
+} FOC_CAN_Sync_Rx_t;
+
+static FOC_CAN_Sync_Rx_t FOC_CAN_Sync_Rx;
+static volatile bool FOC_CAN_Sync_Pending = false;
+
+// FDCAN ISR -> telemetri görevi: bekleyen scope / parametre isteği (komut çerçevesinin byte 4 ... 63'ü)
+static uint32_t FOC_CAN_Request_Rx[(FOC_CAN_FRAME_SIZE / 4U) - 1U];
+static uint8_t FOC_CAN_Request_Command = 0;
+static volatile bool FOC_CAN_Request_Pending = false;
+
+// Faz kilidi
+static float FOC_CAN_TS_Scale = 1.0f;      // TIM3 sayımı başına TIM1 sayımı
+static float FOC_CAN_Tim_Clk_MHz = 170.0f; // TIM1 saati (us -> timer tick)
+static FOC_CAN_PLL_t FOC_CAN_Sync_PLL;
+static float FOC_CAN_Sync_Error_us = 0.0f;
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+static uint32_t FOC_CAN_Setpoint_Id(uint8_t node_id){
+    return FOC_CAN_ID_SETPOINT + (node_id / FOC_CAN_AXES_PER_FRAME);
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_CAN_Tx_Header(FDCAN_TxHeaderTypeDef *pHeader, uint32_t id){
+    pHeader->Identifier = id;
+    pHeader->IdType = FDCAN_STANDARD_ID;
+    pHeader->TxFrameType = FDCAN_DATA_FRAME;
+    pHeader->DataLength = FDCAN_DLC_BYTES_64;
+    pHeader->ErrorStateIndicator = FDCAN_ESI_ACTIVE;
+    pHeader->BitRateSwitch = FDCAN_BRS_ON;
+    pHeader->FDFormat = FDCAN_FD_CAN;
+    pHeader->TxEventFifoControl = FDCAN_NO_TX_EVENTS;
+    pHeader->MessageMarker = 0;
+}
+
+// ------------------------------------------------------------------------------
+
+// Mesaj RAM filtre elemanları + global filtre (hfdcan1 init modunda olmalı)
+static bool FOC_CAN_Config_Filters(void){
+    FDCAN_FilterTypeDef filter;
+
+    filter.IdType = FDCAN_STANDARD_ID;
+    filter.FilterIndex = 0;
+    filter.FilterType = FDCAN_FILTER_MASK;
+    filter.FilterConfig = FDCAN_FILTER_TO_RXFIFO0;
+    filter.FilterID1 = FOC_CAN_Setpoint_Id(FOC_CAN_Node_Id);
+    filter.FilterID2 = 0x7FFU;
+    if(HAL_FDCAN_ConfigFilter(&hfdcan1, &filter) != HAL_OK) return false;
+
+    filter.FilterIndex = 1;
+    filter.FilterType = FDCAN_FILTER_DUAL;
+    filter.FilterID1 = FOC_CAN_ID_COMMAND + FOC_CAN_Node_Id;
+    filter.FilterID2 = FOC_CAN_ID_BROADCAST;
+    if(HAL_FDCAN_ConfigFilter(&hfdcan1, &filter) != HAL_OK) return false;
+
+    filter.FilterIndex = 2;
+    filter.FilterID1 = FOC_CAN_ID_SYNC;
+    filter.FilterID2 = FOC_CAN_ID_SYNC;
+    if(HAL_FDCAN_ConfigFilter(&hfdcan1, &filter) != HAL_OK) return false;
+
+    filter.FilterIndex = 3;
+    filter.FilterID1 = FOC_CAN_ID_PVT + FOC_CAN_Node_Id;
+    filter.FilterID2 = FOC_CAN_ID_PVT + FOC_CAN_Node_Id;
+    if(HAL_FDCAN_ConfigFilter(&hfdcan1, &filter) != HAL_OK) return false;
+
+    if(HAL_FDCAN_ConfigGlobalFilter(&hfdcan1, FDCAN_REJECT, FDCAN_REJECT, FDCAN_REJECT_REMOTE, FDCAN_REJECT_REMOTE) != HAL_OK) return false;
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+// hfdcan1'i verilen modda yeniden kurar ve başlatır
+static bool FOC_CAN_Restart(uint32_t mode){
+    if(hfdcan1.State == HAL_FDCAN_STATE_BUSY){
+        HAL_FDCAN_Stop(&hfdcan1);
+    }
+
+    hfdcan1.Init.Mode = mode;
+    if(HAL_FDCAN_Init(&hfdcan1) != HAL_OK) return false;
+    if(FOC_CAN_Config_Filters() == false) return false;
+
+    // 5 Mbit/s veri fazında transceiver gecikmesi bir bitten uzun olabilir
+    if(HAL_FDCAN_ConfigTxDelayCompensation(&hfdcan1, hfdcan1.Init.DataPrescaler * hfdcan1.Init.DataTimeSeg1, 0) != HAL_OK) return false;
+    if(HAL_FDCAN_EnableTxDelayCompensation(&hfdcan1) != HAL_OK) return false;
+
+    // RX timestamp = TIM3_CNT (SOF anında)
+    if(HAL_FDCAN_EnableTimestampCounter(&hfdcan1, FDCAN_TIMESTAMP_EXTERNAL) != HAL_OK) return false;
+
+    // Loopback testi FIFO'yu kendisi okur, kesme sadece normal modda açılır
+    if(mode == FDCAN_MODE_NORMAL){
+        if(HAL_FDCAN_ActivateNotification(&hfdcan1, FDCAN_IT_RX_FIFO0_NEW_MESSAGE, 0) != HAL_OK) return false;
+    }
+    else{
+        if(HAL_FDCAN_DeactivateNotification(&hfdcan1, FDCAN_IT_RX_FIFO0_NEW_MESSAGE) != HAL_OK) return false;
+    }
+
+    return (HAL_FDCAN_Start(&hfdcan1) == HAL_OK);
+}
+
+// ------------------------------------------------------------------------------
+
+// Boş TX FIFO elemanının başlığını yazar ve veri word'lerinin adresini döndürür (dolu ise 0).
+// Put index'i sadece TXBAR yazılınca ilerler; tüm TX aynı öncelikten (PendSV) yapılmalıdır.
+static volatile uint32_t *FOC_CAN_Tx_Alloc(uint32_t id, uint32_t dlc, uint32_t *pIndex){
+    FDCAN_GlobalTypeDef *can = hfdcan1.Instance;
+
+    if((can->TXFQS & FDCAN_TXFQS_TFQF) != 0U){
+        FOC_CAN_Stats.tx_dropped++;
+        return 0;
+    }
+
+    uint32_t index = (can->TXFQS & FDCAN_TXFQS_TFQPI) >> FDCAN_TXFQS_TFQPI_Pos;
+    volatile uint32_t *elem = (volatile uint32_t *)(SRAMCAN_BASE + FOC_CAN_RAM_TFQSA + (index * FOC_CAN_RAM_ELEM_SIZE));
+
+    elem[0] = id << FOC_CAN_RAM_ID_POS;
+    elem[1] = (dlc << FOC_CAN_RAM_DLC_POS) | FOC_CAN_RAM_BRS | FOC_CAN_RAM_FDF;
+    *pIndex = index;
+
+    return &elem[2];
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_CAN_Tx_Commit(uint32_t index){
+    hfdcan1.Instance->TXBAR = (1UL << index);
+}
+
+// ------------------------------------------------------------------------------
+
+// FOC_Trajectory akış kontrolü geri çağırması (PendSV): durum 8 byte'lık çerçeve ile gönderilir
+static void FOC_CAN_Send_Flow(const FOC_Traj_Status_t *pStatus){
+    uint32_t index;
+    uint32_t words[FOC_CAN_SYNC_SIZE / 4U];
+    volatile uint32_t *data = FOC_CAN_Tx_Alloc(FOC_CAN_ID_FLOW + FOC_CAN_Node_Id, FOC_CAN_RAM_DLC_8, &index);
+
+    if(data == 0){
+        return;
+    }
+
+    memcpy(words, pStatus, sizeof(words));
+    data[0] = words[0];
+    data[1] = words[1];
+    FOC_CAN_Tx_Commit(index);
+    FOC_CAN_Stats.tx_flow++;
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_CAN_Init(FOC_Handle_t *pHandle, uint8_t node_id){
+    FOC_CAN_Handle = pHandle;
+    FOC_CAN_Node_Id = (uint8_t)(node_id % FOC_CAN_MAX_NODES);
+    FOC_CAN_Tx_Sequence = 0;
+    FOC_CAN_Published = 0;
+    FOC_CAN_Armed = 0;
+    FOC_CAN_Sync_Pending = false;
+    FOC_CAN_Sync_Rx.pSetpoint = 0;
+    FOC_CAN_PLL_Reset(&FOC_CAN_Sync_PLL);
+    FOC_CAN_Sync_Error_us = 0.0f;
+    FOC_CAN_Request_Pending = false;
+    memset(&FOC_CAN_Stats, 0, sizeof(FOC_CAN_Stats));
+
+    // TIM3: FDCAN dış timestamp sayacı, serbest sayan 16 bit
+    RCC->APB1ENR1 |= RCC_APB1ENR1_TIM3EN;
+    (void)RCC->APB1ENR1;
+    TIM3->CR1 = 0;
+    TIM3->PSC = FOC_CAN_TS_PRESCALER - 1U;
+    TIM3->ARR = 0xFFFFU;
+    TIM3->EGR = TIM_EGR_UG;
+    TIM3->CR1 = TIM_CR1_CEN;
+
+    FOC_CAN_Tim_Clk_MHz = (float)HAL_RCC_GetPCLK2Freq() * 1.0e-6f;
+    FOC_CAN_TS_Scale = ((float)HAL_RCC_GetPCLK2Freq() / (float)HAL_RCC_GetPCLK1Freq()) * (float)FOC_CAN_TS_PRESCALER;
+
+    FOC_Trajectory_Set_Flow_Callback(FOC_CAN_Send_Flow);
+
+    return FOC_CAN_Restart(FDCAN_MODE_NORMAL);
+}
+
+// ------------------------------------------------------------------------------
+
+// Yayınlanan, mandallanan ve uygulanmayı bekleyen yuvalar dışında bir yuva döndürür.
+// Akım ISR'ı mandallananı bekleyene taşıyabileceği için önce mandallanan, sonra bekleyen okunur.
+static FOC_CAN_Slot_t *FOC_CAN_Free_Slot(void){
+    const FOC_CAN_Setpoint_t *pPublished = FOC_CAN_Published;
+    const FOC_CAN_Setpoint_t *pLatched = FOC_CAN_Sync_Rx.pSetpoint;
+    const FOC_CAN_Setpoint_t *pArmed = FOC_CAN_Armed;
+
+    for(uint32_t i = 0; i < FOC_CAN_SETPOINT_SLOTS; i++){
+        const FOC_CAN_Setpoint_t *p = &FOC_CAN_Slot[i].setpoint;
+        if(p != pPublished && p != pLatched && p != pArmed){
+            return &FOC_CAN_Slot[i];
+        }
+    }
+    return &FOC_CAN_Slot[0]; // Ulaşılamaz: en fazla 3 yuva meşgul olabilir
+}
+
+// ------------------------------------------------------------------------------
+
+// PVT çerçevesi mesaj RAM'inden doğrudan FOC_Trajectory kuyruğuna aktarılır
+static void FOC_CAN_Rx_Pvt(const volatile uint32_t *data){
+    FOC_CAN_Pvt_Header_t header;
+    uint32_t word = data[0];
+
+    memcpy(&header, &word, sizeof(header));
+    if(header.count > FOC_CAN_PVT_POINTS){
+        header.count = FOC_CAN_PVT_POINTS;
+    }
+    if((header.flags & FOC_CAN_PVT_START) != 0U){
+        FOC_Trajectory_Start(header.seq);
+    }
+
+    for(uint32_t i = 0; i < header.count; i++){
+        uint32_t words[sizeof(FOC_Traj_Point_t) / 4U];
+        FOC_Traj_Point_t point;
+        const volatile uint32_t *src = &data[1U + (i * (sizeof(FOC_Traj_Point_t) / 4U))];
+
+        words[0] = src[0];
+        words[1] = src[1];
+        words[2] = src[2];
+        memcpy(&point, words, sizeof(point));
+
+        if(FOC_Trajectory_Push((uint16_t)(header.seq + i), &point) == true){
+            FOC_CAN_Stats.rx_pvt++;
+        }
+        else{
+            FOC_CAN_Stats.rx_pvt_reject++;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+// FDCAN1 interrupt 0 (RX FIFO0 yeni mesaj). Eleman mesaj RAM'inden okunur, HAL kopyası yoktur.
+void FOC_CAN_IRQHandler(void){
+    FDCAN_GlobalTypeDef *can = hfdcan1.Instance;
+
+    can->IR = FDCAN_IR_RF0N;
+
+    while((can->RXF0S & FDCAN_RXF0S_F0FL) != 0U){
+        uint32_t index = (can->RXF0S & FDCAN_RXF0S_F0GI) >> FDCAN_RXF0S_F0GI_Pos;
+        const volatile uint32_t *elem = (const volatile uint32_t *)(SRAMCAN_BASE + FOC_CAN_RAM_RF0SA + (index * FOC_CAN_RAM_ELEM_SIZE));
+        uint32_t id = (elem[0] >> FOC_CAN_RAM_ID_POS) & 0x7FFU;
+        uint32_t dlc = (elem[1] >> FOC_CAN_RAM_DLC_POS) & 0xFU;
+
+        if(FOC_CAN_Handle == 0){
+            // Init öncesi: sadece FIFO boşaltılır
+        }
+        else if(id == FOC_CAN_ID_SYNC){
+            if(dlc >= FOC_CAN_RAM_DLC_8 && FOC_CAN_Sync_Pending == false){
+                FOC_CAN_Sync_Rx.ts_rx = (uint16_t)(elem[1] & FOC_CAN_RAM_RXTS_MASK);
+                FOC_CAN_Sync_Rx.master_tick = elem[2];
+                FOC_CAN_Sync_Rx.apply_tick = elem[3];
+                if(FOC_CAN_Sync_Latch == true){
+                    // Bu SYNC'e kadar gelen son setpoint mandallanır
+                    FOC_CAN_Sync_Rx.pSetpoint = FOC_CAN_Published;
+                    FOC_CAN_Published = 0;
+                }
+                __DMB();
+                FOC_CAN_Sync_Pending = true;
+                FOC_CAN_Stats.rx_sync++;
+            }
+        }
+        // Filtreler sadece kendi ID'lerimizi geçirir, burada sadece uzunluk kontrol edilir
+        else if(dlc == FOC_CAN_RAM_DLC_64){
+            if(id == FOC_CAN_ID_PVT + FOC_CAN_Node_Id){
+                FOC_CAN_Rx_Pvt(&elem[2]);
+            }
+            else if(id == FOC_CAN_Setpoint_Id(FOC_CAN_Node_Id)){
+                FOC_CAN_Slot_t *pSlot = FOC_CAN_Free_Slot();
+                const volatile uint32_t *src = &elem[2U + ((FOC_CAN_Node_Id % FOC_CAN_AXES_PER_FRAME) * (sizeof(FOC_CAN_Setpoint_t) / 4U))];
+
+                for(uint32_t i = 0; i < sizeof(FOC_CAN_Setpoint_t) / 4U; i++){
+                    pSlot->word[i] = src[i];
+                }
+
+                if(FOC_CAN_Published != 0){
+                    FOC_CAN_Stats.rx_overrun++;
+                }
+                __DMB();
+                FOC_CAN_Published = &pSlot->setpoint;  // Yayınla: akım ISR'ı artık bu yuvayı okuyabilir
+                FOC_CAN_Stats.rx_setpoint++;
+            }
+            else{
+                uint8_t command = (uint8_t)(elem[2] & 0xFFU);
+                if(command == FOC_CAN_CMD_ENABLE) FOC_CAN_Handle->config.current_ctrl_mode = true;
+                else if(command == FOC_CAN_CMD_DISABLE) FOC_CAN_Handle->config.current_ctrl_mode = false;
+                else if((command == FOC_CAN_CMD_SCOPE || command == FOC_CAN_CMD_PARAM) && FOC_CAN_Request_Pending == false){
+                    // TX sadece PendSV'den yapılır: istek saklanır, telemetri görevi yanıtlar
+                    for(uint32_t i = 0; i < (FOC_CAN_FRAME_SIZE / 4U) - 1U; i++){
+                        FOC_CAN_Request_Rx[i] = elem[3U + i];
+                    }
+                    FOC_CAN_Request_Command = command;
+                    __DMB();
+                    FOC_CAN_Request_Pending = true;
+                }
+                else if(command == FOC_CAN_CMD_SUBSCRIBE){
+                    uint32_t request[(FOC_CAN_FRAME_SIZE / 4U) - 1U];
+                    FOC_Telem_Ack_t ack;
+                    for(uint32_t i = 0; i < (FOC_CAN_FRAME_SIZE / 4U) - 1U; i++){
+                        request[i] = elem[3U + i];
+                    }
+                    FOC_Telemetry_Subscribe((const uint8_t *)request, sizeof(request), &ack);
+                }
+                FOC_CAN_Stats.rx_command++;
+            }
+        }
+
+        can->RXF0A = index;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+// Setpoint gelince çalışan PVT yörüngesi durur, position_ref_rad tekrar setpoint yolundan gelir
+static void FOC_CAN_Apply_Setpoint(FOC_Handle_t *pHandle, const FOC_CAN_Setpoint_t *pSetpoint){
+    FOC_Trajectory_Stop(pHandle);
+    pHandle->input.T_mot_ref = pSetpoint->torque_ref;
+    pHandle->input.speed_ref_rad_s = pSetpoint->speed_ref;
+    pHandle->input.position_ref_rad = pSetpoint->position_ref;
+
+    pHandle->config.speed_ctrl_mode = (pSetpoint->mode >= FOC_CAN_MODE_SPEED);
+    pHandle->config.position_ctrl_mode = (pSetpoint->mode == FOC_CAN_MODE_POSITION);
+    pHandle->config.current_ctrl_mode = (pSetpoint->mode != FOC_CAN_MODE_DISABLE);
+}
+
+// ------------------------------------------------------------------------------
+
+// SYNC işlenir: faz hatası, bus tick farkı, PLL trim'i ve mandallanan setpoint'in hedef tick'i
+static void FOC_CAN_Sync_Update(uint32_t tick){
+    float tick_len = (float)FOC_PWM_Get_Tick_Length();
+    float now_phase = (float)FOC_PWM_Get_Tick_Phase();
+    uint16_t ts_elapsed = (uint16_t)((uint16_t)TIM3->CNT - FOC_CAN_Sync_Rx.ts_rx);
+    int32_t arr_trim;
+
+    if(FOC_CAN_PLL_Update(&FOC_CAN_Sync_PLL, now_phase, (float)ts_elapsed * FOC_CAN_TS_Scale, tick_len, FOC_PWM_Get_Period(),
+                          tick, FOC_CAN_Sync_Rx.master_tick, &arr_trim) == true){
+        FOC_PWM_Trim_Period(arr_trim);
+    }
+    FOC_CAN_Sync_Error_us = FOC_CAN_Sync_PLL.error / FOC_CAN_Tim_Clk_MHz;
+
+    if(FOC_CAN_Sync_Rx.pSetpoint != 0){
+        FOC_CAN_Armed_Tick = FOC_CAN_PLL_Local_Tick(&FOC_CAN_Sync_PLL, FOC_CAN_Sync_Rx.apply_tick);
+        if((int32_t)(tick - FOC_CAN_Armed_Tick) > 0){
+            FOC_CAN_Stats.sync_late++;
+        }
+        FOC_CAN_Armed = FOC_CAN_Sync_Rx.pSetpoint;
+        FOC_CAN_Sync_Rx.pSetpoint = 0;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+// Akım ISR'ında. FDCAN ISR bu sırada çalışamaz, bu yüzden işaretçi alıp NULL yapmak atomiktir.
+void FOC_CAN_Consume(FOC_Handle_t *pHandle){
+    uint32_t tick = FOC_Scheduler_Get_Tick() + 1U; // Bu ISR'ın sonunda FOC_Scheduler_Tick'in vereceği numara
+
+    if(FOC_CAN_Sync_Pending == true){
+        FOC_CAN_Sync_Update(tick);
+        FOC_CAN_Sync_Pending = false;
+    }
+
+    if(FOC_CAN_Sync_Latch == true){
+        const FOC_CAN_Setpoint_t *pArmed = FOC_CAN_Armed;
+        if(pArmed != 0 && (int32_t)(tick - FOC_CAN_Armed_Tick) >= 0){
+            FOC_CAN_Apply_Setpoint(pHandle, pArmed);
+            FOC_CAN_Armed = 0;
+        }
+        return;
+    }
+
+    FOC_CAN_Armed = 0; // Mandallama kapatıldıysa bekleyen setpoint atılır
+    const FOC_CAN_Setpoint_t *pSetpoint = FOC_CAN_Published;
+    if(pSetpoint != 0){
+        FOC_CAN_Published = 0;
+        FOC_CAN_Apply_Setpoint(pHandle, pSetpoint);
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+// Mandallama kapatılınca bekleyen setpoint bir sonraki akım ISR'ında atılır, sonraki setpoint doğrudan uygulanır
+void FOC_CAN_Set_Sync_Latch(bool enable){
+    FOC_CAN_Sync_Latch = enable;
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_CAN_Put_F32(volatile uint32_t *pWord, float value){
+    uint32_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    *pWord = raw;
+}
+
+// ------------------------------------------------------------------------------
+
+// Bekleyen scope / parametre isteğini işler ve yanıtı 64 byte'lık tek çerçeve ile gönderir (PendSV)
+static void FOC_CAN_Request_Reply(void){
+    uint32_t index;
+    uint32_t response[FOC_CAN_FRAME_SIZE / 4U];
+    bool scope = (FOC_CAN_Request_Command == FOC_CAN_CMD_SCOPE);
+    uint32_t id = (scope ? FOC_CAN_ID_SCOPE : FOC_CAN_ID_PARAM) + FOC_CAN_Node_Id;
+    volatile uint32_t *data = FOC_CAN_Tx_Alloc(id, FOC_CAN_RAM_DLC_64, &index);
+
+    if(data == 0){
+        return; // İstek bekletilir, bir sonraki telemetri görevinde tekrar denenir
+    }
+
+    memset(response, 0, sizeof(response));
+    if(scope == true){
+        FOC_Scope_Request((const uint8_t *)FOC_CAN_Request_Rx, sizeof(FOC_CAN_Request_Rx), (uint8_t *)response, sizeof(response));
+    }
+    else{
+        FOC_Param_Request((const uint8_t *)FOC_CAN_Request_Rx, sizeof(FOC_CAN_Request_Rx), (uint8_t *)response, sizeof(response));
+    }
+    __DMB();
+    FOC_CAN_Request_Pending = false;
+
+    for(uint32_t i = 0; i < FOC_CAN_FRAME_SIZE / 4U; i++){
+        data[i] = response[i];
+    }
+    FOC_CAN_Tx_Commit(index);
+    if(scope == true) FOC_CAN_Stats.tx_scope++;
+    else FOC_CAN_Stats.tx_param++;
+}
+
+// ------------------------------------------------------------------------------
+
+// FOC_Telemetry çıkışı (PendSV): paket en yakın CAN-FD uzunluğuna sıfırla tamamlanır
+bool FOC_CAN_Stream_Sink(const uint8_t *pData, uint16_t length){
+    static const uint8_t fd_length[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+    uint32_t frame[FOC_CAN_FRAME_SIZE / 4U];
+    uint32_t dlc = 0;
+    uint32_t index;
+
+    if(length > FOC_CAN_FRAME_SIZE) return false;
+    while(fd_length[dlc] < length) dlc++;
+
+    volatile uint32_t *data = FOC_CAN_Tx_Alloc(FOC_CAN_ID_STREAM + FOC_CAN_Node_Id, dlc, &index);
+    if(data == 0){
+        return false;
+    }
+
+    memset(frame, 0, sizeof(frame));
+    memcpy(frame, pData, length);
+    for(uint32_t i = 0; i < ((uint32_t)fd_length[dlc] + 3U) / 4U; i++){
+        data[i] = frame[i];
+    }
+    FOC_CAN_Tx_Commit(index);
+    FOC_CAN_Stats.tx_stream++;
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+// PendSV (FOC_Scheduler) içinde çalışır: anlık değerler doğrudan TX FIFO elemanına yazılır (~1 us)
+void FOC_CAN_Telemetry_Task(FOC_Handle_t *pHandle){
+    uint32_t index;
+    volatile uint32_t *data = FOC_CAN_Tx_Alloc(FOC_CAN_ID_TELEMETRY + FOC_CAN_Node_Id, FOC_CAN_RAM_DLC_64, &index);
+
+    if(data == 0){
+        return;
+    }
+
+    uint32_t status = (pHandle->config.current_ctrl_mode ? 0x01U : 0x00U) |
+                      (pHandle->config.speed_ctrl_mode ? 0x02U : 0x00U) |
+                      (pHandle->config.position_ctrl_mode ? 0x04U : 0x00U);
+
+    // FOC_CAN_Telemetry_t yerleşimi, word word
+    data[0] = (uint32_t)FOC_CAN_Tx_Sequence | ((uint32_t)FOC_CAN_Node_Id << 16) | (status << 24);
+    FOC_CAN_Put_F32(&data[1], pHandle->state.i_d);
+    FOC_CAN_Put_F32(&data[2], pHandle->state.i_q);
+    FOC_CAN_Put_F32(&data[3], pHandle->state.i_d_ref);
+    FOC_CAN_Put_F32(&data[4], pHandle->state.i_q_ref);
+    FOC_CAN_Put_F32(&data[5], pHandle->state.u_d);
+    FOC_CAN_Put_F32(&data[6], pHandle->state.u_q);
+    FOC_CAN_Put_F32(&data[7], pHandle->input.w_rad_s);
+    FOC_CAN_Put_F32(&data[8], pHandle->input.Electrical_Angle_rad);
+    FOC_CAN_Put_F32(&data[9], pHandle->input.T_mot_ref);
+    FOC_CAN_Put_F32(&data[10], pHandle->input.U_bat);
+    FOC_CAN_Put_F32(&data[11], pHandle->input.position_rad);
+    FOC_CAN_Put_F32(&data[12], pHandle->state.speed_ref);
+    FOC_CAN_Put_F32(&data[13], pHandle->state.fw_i_d);
+    FOC_CAN_Put_F32(&data[14], FOC_CAN_Sync_Error_us);
+    data[15] = FOC_Scheduler_Get_Tick() + FOC_CAN_Sync_PLL.tick_offset;
+
+    FOC_CAN_Tx_Commit(index);
+    FOC_CAN_Tx_Sequence++;
+    FOC_CAN_Stats.tx_telemetry++;
+
+    if(FOC_CAN_Request_Pending == true){
+        FOC_CAN_Request_Reply();
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+// Dahili loopback: TX çıkışı RX'e bağlanır, bus'a hiçbir şey gönderilmez.
+// 1. Kendi setpoint grubuna 64 byte BRS çerçeve gönderilir -> filtre 0'dan geçmeli, içerik aynı olmalı.
+// 2. Başka bir node'un telemetri ID'si gönderilir -> global filtrede reddedilmeli.
+// Test sonunda FDCAN normal moda döner. Sürücü çalışırken çağrılmamalıdır.
+bool FOC_CAN_Loopback_Test(void){
+    FDCAN_TxHeaderTypeDef tx_header;
+    FDCAN_RxHeaderTypeDef rx_header;
+    uint8_t tx_data[FOC_CAN_FRAME_SIZE];
+    uint8_t rx_data[FOC_CAN_FRAME_SIZE];
+    bool ok = true;
+
+    for(uint32_t i = 0; i < FOC_CAN_FRAME_SIZE; i++){
+        tx_data[i] = (uint8_t)(i * 7U + 3U);
+    }
+
+    if(FOC_CAN_Restart(FDCAN_MODE_INTERNAL_LOOPBACK) == false){
+        FOC_CAN_Restart(FDCAN_MODE_NORMAL);
+        return false;
+    }
+
+    FOC_CAN_Tx_Header(&tx_header, FOC_CAN_Setpoint_Id(FOC_CAN_Node_Id));
+    ok = ok && (HAL_FDCAN_AddMessageToTxFifoQ(&hfdcan1, &tx_header, tx_data) == HAL_OK);
+    FOC_CAN_Tx_Header(&tx_header, FOC_CAN_ID_TELEMETRY + ((FOC_CAN_Node_Id + 1U) % FOC_CAN_MAX_NODES));
+    ok = ok && (HAL_FDCAN_AddMessageToTxFifoQ(&hfdcan1, &tx_header, tx_data) == HAL_OK);
+
+    // İki çerçevenin de gönderilmesini bekle
+    uint32_t start = HAL_GetTick();
+    while(ok && (HAL_FDCAN_GetTxFifoFreeLevel(&hfdcan1) < 3U)){
+        if((HAL_GetTick() - start) > FOC_CAN_LOOPBACK_TIMEOUT_MS) ok = false;
+    }
+
+    // Tam olarak bir çerçeve (setpoint) alınmış olmalı
+    ok = ok && (HAL_FDCAN_GetRxFifoFillLevel(&hfdcan1, FDCAN_RX_FIFO0) == 1U);
+    ok = ok && (HAL_FDCAN_GetRxMessage(&hfdcan1, FDCAN_RX_FIFO0, &rx_header, rx_data) == HAL_OK);
+    ok = ok && (rx_header.Identifier == FOC_CAN_Setpoint_Id(FOC_CAN_Node_Id));
+    ok = ok && (rx_header.DataLength == FDCAN_DLC_BYTES_64);
+    ok = ok && (rx_header.BitRateSwitch == FDCAN_BRS_ON);
+    ok = ok && (rx_header.FDFormat == FDCAN_FD_CAN);
+    ok = ok && (memcmp(tx_data, rx_data, FOC_CAN_FRAME_SIZE) == 0);
+
+    if(FOC_CAN_Restart(FDCAN_MODE_NORMAL) == false){
+        ok = false;
+    }
+
+    return ok;
+}
+
+// ------------------------------------------------------------------------------
+
+const FOC_CAN_Stats_t *FOC_CAN_Get_Stats(void){
+    return &FOC_CAN_Stats;
+}
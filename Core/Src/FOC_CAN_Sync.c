@@ -0,0 +1,95 @@
+// <<---------------------------------------------->>
+// <<-------------Kütüphane Tanımlamaları---------->>
+// <<---------------------------------------------->>
+
+// FOC_CAN SYNC faz kilidi (PLL) hesabı. Register okumaz / yazmaz: FOC_CAN akım ISR'ında TIM1 fazını ve
+// TIM3 timestamp'ini okuyup buraya verir, dönen ARR trim'ini FOC_PWM_Trim_Period ile uygular.
+// Durum FOC_CAN_PLL_t içinde tutulduğu için birden fazla node aynı süreçte simüle edilebilir
+// (Tools/foc_hostsim/sim_sync).
+
+#include "FOC_CAN_Sync.h"
+#include <math.h>
+
+// <<---------------------------------------------->>
+// <<-------------Fonksiyon Tanımlamaları---------->>
+// <<---------------------------------------------->>
+
+void FOC_CAN_PLL_Reset(FOC_CAN_PLL_t *pPll){
+    pPll->integrator = 0.0f;
+    pPll->error = 0.0f;
+    pPll->last_master_tick = 0;
+    pPll->tick_offset = 0;
+    pPll->valid = false;
+    pPll->locked = false;
+}
+
+// ------------------------------------------------------------------------------
+
+// SOF anının, içinde bulunulan tick'in sınırına göre konumu.
+// now_phase: tick sınırından bu yana geçen süre, elapsed: SOF'tan bu yana geçen süre (ikisi de TIM1 sayımı).
+// Dönüş: SOF - en yakın tick sınırı, (-T/2, T/2]. Pozitif: yerel tick SOF'tan önce başlamış (önde).
+// *pSof_Tick: SOF'a en yakın tick sınırının yerel tick numarası.
+static float FOC_CAN_PLL_Phase(float now_phase, float elapsed, float tick_len, uint32_t tick, uint32_t *pSof_Tick){
+    float rel = now_phase - elapsed;
+    int32_t ticks = (int32_t)(rel / tick_len);
+
+    if(rel < (float)ticks * tick_len){
+        ticks--; // Negatif sayılar için taban
+    }
+
+    float error = rel - ((float)ticks * tick_len);
+    if(error > 0.5f * tick_len){
+        error -= tick_len;
+        ticks++;
+    }
+
+    *pSof_Tick = tick + (uint32_t)ticks;
+    return error;
+}
+
+// ------------------------------------------------------------------------------
+
+// tick: içinde bulunulan tick'in (sınırı now_phase kadar önce geçilen) yerel numarası.
+// period: güncel ARR; tick uzunluğu ARR (double-update) veya 2 * ARR olduğundan trim bu orana çevrilir.
+bool FOC_CAN_PLL_Update(FOC_CAN_PLL_t *pPll, float now_phase, float elapsed, float tick_len, uint32_t period,
+                        uint32_t tick, uint32_t master_tick, int32_t *pArr_Trim){
+    uint32_t sof_tick;
+    bool trimmed = false;
+
+    pPll->error = FOC_CAN_PLL_Phase(now_phase, elapsed, tick_len, tick, &sof_tick);
+    uint32_t interval = master_tick - pPll->last_master_tick;
+
+    pPll->tick_offset = master_tick - sof_tick;
+
+    // Tick başına düzeltme: P kısmı faz hatasının KP'sini bir SYNC aralığına yayar,
+    // I kısmı iki saat arasındaki frekans farkını öğrenir
+    if(pPll->valid == true && interval > 0U && interval <= FOC_CAN_SYNC_MAX_TICKS){
+        float per_tick = pPll->error / (float)interval;
+        float trim_max = FOC_CAN_SYNC_TRIM_MAX * tick_len;
+
+        // Yakalama sırasında (başlangıç fazı tick'in yarısına kadar olabilir) integratör faz hatasını frekans farkı
+        // sanıp biriktirir ve kilitten sonra onlarca SYNC süren aşım yapar. Hata ilk kez küçülene kadar sadece P.
+        // Kilitten sonra her SYNC'te beslenir: SOF gecikmesi (jitter) tüm node'larda aynıdır, eşik her SYNC'te
+        // kontrol edilseydi node'lar farklı örnekleri integre eder ve birbirinden uzaklaşırdı.
+        if(pPll->locked == false && fabsf(pPll->error) < FOC_CAN_SYNC_LOCK * tick_len){
+            pPll->locked = true;
+        }
+        if(pPll->locked == true){
+            pPll->integrator += FOC_CAN_SYNC_KI * per_tick;
+        }
+        if(pPll->integrator > trim_max) pPll->integrator = trim_max;
+        else if(pPll->integrator < -trim_max) pPll->integrator = -trim_max;
+
+        float trim = (FOC_CAN_SYNC_KP * per_tick) + pPll->integrator;
+        if(trim > trim_max) trim = trim_max;
+        else if(trim < -trim_max) trim = -trim_max;
+
+        float arr_trim = trim * ((float)period / tick_len);
+        *pArr_Trim = (int32_t)(arr_trim + ((arr_trim >= 0.0f) ? 0.5f : -0.5f));
+        trimmed = true;
+    }
+    pPll->last_master_tick = master_tick;
+    pPll->valid = true;
+
+    return trimmed;
+}
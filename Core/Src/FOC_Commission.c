@@ -0,0 +1,569 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül yeni bir motorun parametrelerini otomatik ölçer ve akım döngüsü PI kazançlarını hesaplar.
+// Ölçülenler: R_phase, L_d, L_q, flux_linkage ve Hall sensör / elektriksel açı tutarlılığı.
+// Sonuçlar config'e yazılır ve flash'ın son sayfasında saklanır, açılışta FOC_Commission_Load ile geri yüklenir.
+// Tüm sekans yaklaşık 10 sn sürer. Motor yüksüz ve serbest dönebilir olmalıdır.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// Her adım akım ISR'ında tick tabanlı bir durum makinesi olarak çalışır, açı bu modül tarafından verilir.
+// 1. R (DC enjeksiyon): rotor 0 açısına kilitlenir, d gerilimi integral ile I_test/2 ve I_test akımına oturtulur.
+//    R = (U2 - U1) / (I2 - I1). İki nokta farkı inverter gerilim düşümünü (ölü zaman, anahtar) iptal eder.
+// 2. L_d (gerilim darbesi): I_test'te oturmuş d eksenine N tick boyunca -U_pulse eklenir.
+//    L * dI = (-U_pulse - R * dI / 2) * N * Ts  ->  L_d
+//    Tick k'de hesaplanan gerilim [k+1, k+2] aralığında uygulandığı için akım 1. ve N+1. tick'te okunur.
+// 3. L_q: d akımı rotoru kilitli tutarken q eksenine +U_pulse / -U_pulse darbesi verilir (ortalama tork sıfır).
+// 4. PI kazançları (kutup-sıfır iptali): Kp = L * bandwidth, Ki = R * bandwidth. Bu adımdan sonra
+//    akım, sürücünün kendi PI'ları ile (zorlanmış açıda, I-f kontrolü) sürülür.
+// 5. Hall kontrolü: w_slow ile FOC_COMM_POLE_REVS elektriksel tur döndürülür, tur başına 6 Hall kenarı beklenir.
+//    Kutup çifti: Hall sensörleri elektriksel açıyı gördüğü için mekanik referans gerekir. Adım boyunca
+//    input.position_rad (mekanik, enkoder) ilerlediyse PP = elektriksel açı ilerlemesi / mekanik yol olur;
+//    Hall kontrolüyle birlikte mekanik tur başına 6 * PP kenar doğrulanmış olur. Yuvarlanan değer
+//    config.pole_pairs'ten farklıysa hata verilir. Kenar sayısı (±1 sınır kenarı) yerine açı kullanılır.
+//    position_rad ilerlemediyse (mekanik sensör yok) kontrol yapılamaz, result.pole_pairs_meas 0 kalır.
+// 6. Akı: w_flux'a rampa, oturunca zorlanmış eksende ortalama alınır. Yük açısından bağımsız olarak
+//    |u - R * i - j * w * L * i| = w * flux  (L = (L_d + L_q) / 2)
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. Açılışta: if(FOC_Commission_Load(&hfoc) == false) { ... devreye alma gerekli ... }
+// 2. FOC_Commission_Start(&hfoc, &settings) ile sekans başlatılır.
+// 3. Akım ölçümü ISR'ı içinde:
+//    if(FOC_Commission_Busy()) FOC_Commission_Step(&hfoc, hall_sector);
+//    else FOC_Current_Controller(&hfoc);
+//    FOC_PWM_Update(&hfoc);
+// 4. main while(1) içinde FOC_Commission_Process() çağrılır. Sekans bitince PWM kapatılır ve sonuç flash'a yazılır.
+// 5. Sonuç ve hata kodu FOC_Commission_Get_Result() ile okunur. FOC_Commission_Abort() sekansı keser.
+//    Ölçüm süresince kapatılan saturation_maps / online_estimation bitişte ve hata / iptalde geri yüklenir.
+
+// Yapılması gereken Konfigürasyonlar:
+// Linker script'te FLASH uzunluğu 126K olmalıdır (son sayfa bu modüle ayrılmıştır).
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_Commission.h"
+#include "FOC_PWM.h"
+#include "FOC_Log.h"
+#include "stm32g4xx_hal.h"
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+#define FOC_COMM_MAGIC   0x464F4331U // "FOC1"
+#define FOC_COMM_VERSION 1U
+
+// Flash kaydı (boyutu 8 byte'ın katı olmalıdır, double-word programlama)
+typedef struct{
+    uint32_t magic;
+    uint32_t version;
+    float R_phase;
+    float L_d;
+    float L_q;
+    float flux_linkage;
+    float Kp_d;
+    float Ki_d;
+    float Kp_q;
+    float Ki_q;
+    uint32_t pole_pairs;
+    uint32_t checksum;
+} FOC_Comm_Record_t;
+
+_Static_assert((sizeof(FOC_Comm_Record_t) % 8U) == 0U, "Flash kaydı double-word hizalı olmalı");
+
+static FOC_Handle_t *FOC_Comm_Handle = 0;
+static FOC_Comm_Settings_t FOC_Comm_Settings;
+static FOC_Comm_Result_t FOC_Comm_Result;
+
+static volatile FOC_Comm_Phase_t FOC_Comm_Phase = FOC_COMM_IDLE;
+static uint32_t FOC_Comm_Tick = 0;    // Aktif adımdaki tick
+static uint32_t FOC_Comm_Settle = 0;  // FOC_COMM_SETTLE_S tick cinsinden
+static uint32_t FOC_Comm_Average = 0; // FOC_COMM_AVERAGE_S tick cinsinden
+static uint32_t FOC_Comm_Ramp = 0;    // FOC_COMM_RAMP_S tick cinsinden
+
+static float FOC_Comm_U_d;      // Açık çevrim d gerilimi
+static float FOC_Comm_U_q;      // Açık çevrim q gerilimi
+static float FOC_Comm_U_1;      // R_LOW ortalama gerilimi
+static float FOC_Comm_I_1;      // R_LOW ortalama akımı
+static float FOC_Comm_I_Start;  // Darbe başı akımı
+static float FOC_Comm_Angle;    // Zorlanmış elektriksel açı
+static float FOC_Comm_Travel;   // Toplam dönülen elektriksel açı
+static float FOC_Comm_W;        // Zorlanmış elektriksel hız
+static uint8_t FOC_Comm_Hall_Prev;
+static float FOC_Comm_Position_Start; // Hall adımı başında input.position_rad
+static bool FOC_Comm_Saved_Sat_Maps;  // Start öncesi config.saturation_maps
+static bool FOC_Comm_Saved_Online_Est; // Start öncesi config.online_estimation
+static bool FOC_Comm_Saved_DTC;        // Start öncesi config.dead_time_comp
+static float FOC_Comm_Acc[4];   // Ortalama birikimleri (u_d, u_q, i_d, i_q)
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+static void FOC_Comm_Next(FOC_Comm_Phase_t phase){
+    FOC_Comm_Phase = phase;
+    FOC_Comm_Result.phase = phase;
+    FOC_Comm_Tick = 0;
+    for(uint32_t i = 0; i < 4U; i++) FOC_Comm_Acc[i] = 0.0f;
+}
+
+// ------------------------------------------------------------------------------
+
+// Start'ta kapatılan model tabanlı eklentileri geri açar. Doyum haritası Kp ölçeklemesi yeni ölçülen
+// nominal endüktansa göre yapılır (haritadaki mutlak L değerleri korunur).
+static void FOC_Comm_Restore(FOC_Handle_t *pHandle){
+    if(pHandle == 0) return;
+
+    if((pHandle->config.L_d > 0.0f) && (pHandle->config.L_q > 0.0f) && (pHandle->sat_map.inv_L_d_nom > 0.0f)){
+        pHandle->sat_map.inv_L_d_nom = 1.0f / pHandle->config.L_d;
+        pHandle->sat_map.inv_L_q_nom = 1.0f / pHandle->config.L_q;
+    }
+    pHandle->config.saturation_maps = FOC_Comm_Saved_Sat_Maps;
+    pHandle->config.online_estimation = FOC_Comm_Saved_Online_Est;
+    pHandle->config.dead_time_comp = FOC_Comm_Saved_DTC;
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_Comm_Fail(FOC_Comm_Error_t error){
+    FOC_Comm_Result.error = error;
+    FOC_Comm_Next(FOC_COMM_ERROR);
+    FOC_Comm_Restore(FOC_Comm_Handle);
+}
+
+// ------------------------------------------------------------------------------
+
+static uint32_t FOC_Comm_Checksum(const FOC_Comm_Record_t *pRecord){
+    const uint32_t *pWord = (const uint32_t *)pRecord;
+    uint32_t hash = 2166136261U; // FNV-1a (kelime bazında)
+
+    for(uint32_t i = 0; i < ((sizeof(FOC_Comm_Record_t) / 4U) - 1U); i++){
+        hash ^= pWord[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+// ------------------------------------------------------------------------------
+
+// Zorlanmış eksende sürücünün PI'ları ile akım kontrolü (i_d = I_test, i_q = 0)
+static void FOC_Comm_Current_Loop(FOC_Handle_t *pHandle){
+    pHandle->state.i_d_ref = FOC_Comm_Settings.I_test;
+    pHandle->state.i_q_ref = 0.0f;
+
+    FOC_Parameter_Schedule(pHandle);
+
+    // Zorlanmış eksen rotor ekseni değil, akı terimi PI integraline bırakılır
+    pHandle->state.u_d_decoupling = -FOC_Comm_W * pHandle->state.L_q_sched * pHandle->state.i_q;
+    pHandle->state.u_q_decoupling =  FOC_Comm_W * pHandle->state.L_d_sched * pHandle->state.i_d;
+
+    FOC_Direct_Current_Control_d(pHandle);
+    FOC_Direct_Current_Control_q(pHandle);
+    FOC_Voltage_Vector_Limit(pHandle);
+}
+
+// ------------------------------------------------------------------------------
+
+// Açıyı ilerletir ve ±pi aralığında tutar
+static void FOC_Comm_Rotate(float Ts){
+    float delta = FOC_Comm_W * Ts;
+
+    FOC_Comm_Angle += delta;
+    FOC_Comm_Travel += delta;
+    if(FOC_Comm_Angle > 3.14159265f) FOC_Comm_Angle -= 6.2831853f;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Commission_Start(FOC_Handle_t *pHandle, const FOC_Comm_Settings_t *pSettings){
+    float Ts = pHandle->config.Ts;
+
+    FOC_Comm_Phase = FOC_COMM_IDLE; // ISR adımı yeniden kurulana kadar çalışmasın
+
+    FOC_Comm_Handle = pHandle;
+    FOC_Comm_Settings = *pSettings;
+    FOC_Comm_Settle = (uint32_t)(FOC_COMM_SETTLE_S / Ts);
+    FOC_Comm_Average = (uint32_t)(FOC_COMM_AVERAGE_S / Ts);
+    FOC_Comm_Ramp = (uint32_t)(FOC_COMM_RAMP_S / Ts);
+
+    FOC_Comm_U_d = 0.0f;
+    FOC_Comm_U_q = 0.0f;
+    FOC_Comm_Angle = 0.0f;
+    FOC_Comm_Travel = 0.0f;
+    FOC_Comm_W = 0.0f;
+    FOC_Comm_Hall_Prev = 0;
+
+    FOC_Comm_Result.R_phase = 0.0f;
+    FOC_Comm_Result.L_d = 0.0f;
+    FOC_Comm_Result.L_q = 0.0f;
+    FOC_Comm_Result.flux_linkage = 0.0f;
+    FOC_Comm_Result.Kp_d = 0.0f;
+    FOC_Comm_Result.Ki_d = 0.0f;
+    FOC_Comm_Result.Kp_q = 0.0f;
+    FOC_Comm_Result.Ki_q = 0.0f;
+    FOC_Comm_Result.hall_edges = 0;
+    FOC_Comm_Result.pole_pairs_meas = 0;
+    FOC_Comm_Result.error = FOC_COMM_OK;
+    FOC_Comm_Result.saved = false;
+
+    // Ölçüm sırasında model tabanlı eklentiler devre dışı, bitişte / hatada FOC_Comm_Restore geri yükler.
+    // Ölü zaman kompanzasyonu SVPWM içinde çalıştığından o da kapatılır, inverter hatası R_LOW / R_HIGH farkıyla düşer.
+    FOC_Comm_Saved_Sat_Maps = pHandle->config.saturation_maps;
+    FOC_Comm_Saved_Online_Est = pHandle->config.online_estimation;
+    FOC_Comm_Saved_DTC = pHandle->config.dead_time_comp;
+    pHandle->config.saturation_maps = false;
+    pHandle->config.online_estimation = false;
+    pHandle->config.dead_time_comp = false;
+    pHandle->state.i_d_memory = 0.0f;
+    pHandle->state.i_q_memory = 0.0f;
+
+    FOC_Comm_Next(FOC_COMM_R_LOW);
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Commission_Step(FOC_Handle_t *pHandle, uint8_t hall_sector){
+    FOC_Comm_Phase_t phase = FOC_Comm_Phase;
+    float Ts = pHandle->config.Ts;
+    uint32_t N = FOC_Comm_Settings.pulse_ticks;
+    uint32_t t = FOC_Comm_Tick++;
+
+    if((phase == FOC_COMM_IDLE) || (phase == FOC_COMM_DONE) || (phase == FOC_COMM_ERROR)){
+        pHandle->output.duty_a = 0.0f;
+        pHandle->output.duty_b = 0.0f;
+        pHandle->output.duty_c = 0.0f;
+        return;
+    }
+
+    pHandle->input.Electrical_Angle_rad = FOC_Comm_Angle;
+    FOC_Clark_Park_Transform(pHandle);
+    FOC_Max_Voltage(pHandle);
+
+    float i_d = pHandle->state.i_d;
+    float i_q = pHandle->state.i_q;
+    float R = FOC_Comm_Result.R_phase;
+
+    switch(phase){
+        case FOC_COMM_R_LOW:
+        case FOC_COMM_R_HIGH:{
+            float target = (phase == FOC_COMM_R_LOW) ? (0.5f * FOC_Comm_Settings.I_test) : FOC_Comm_Settings.I_test;
+
+            FOC_Comm_U_d += FOC_Comm_Settings.ramp_gain * (target - i_d) * Ts;
+            FOC_Comm_U_q = 0.0f;
+
+            if(t >= FOC_Comm_Settle){
+                FOC_Comm_Acc[0] += FOC_Comm_U_d;
+                FOC_Comm_Acc[2] += i_d;
+            }
+            if(t >= (FOC_Comm_Settle + FOC_Comm_Average)){
+                float u = FOC_Comm_Acc[0] / (float)FOC_Comm_Average;
+                float i = FOC_Comm_Acc[2] / (float)FOC_Comm_Average;
+
+                if(i < (0.5f * target)){
+                    FOC_Comm_Fail(FOC_COMM_ERR_NO_CURRENT);
+                }
+                else if(phase == FOC_COMM_R_LOW){
+                    FOC_Comm_U_1 = u;
+                    FOC_Comm_I_1 = i;
+                    FOC_Comm_Next(FOC_COMM_R_HIGH);
+                }
+                else{
+                    float R_meas = (i > FOC_Comm_I_1) ? ((u - FOC_Comm_U_1) / (i - FOC_Comm_I_1)) : 0.0f;
+                    if(R_meas <= 0.0f){
+                        FOC_Comm_Fail(FOC_COMM_ERR_R);
+                    }
+                    else{
+                        FOC_Comm_Result.R_phase = R_meas;
+                        FOC_Comm_Next(FOC_COMM_L_D);
+                    }
+                }
+            }
+            break;
+        }
+
+        case FOC_COMM_L_D:
+            // FOC_Comm_U_d oturmuş I_test gerilimidir, darbe bunun üzerine eklenir
+            FOC_Comm_U_q = 0.0f;
+            if(t == 1U) FOC_Comm_I_Start = i_d;
+            if(t == (N + 1U)){
+                float dI = i_d - FOC_Comm_I_Start;
+                // Akım sıfırı geçerse inverter düşümü yön değiştirir ve ölçüm bozulur (U_pulse çok büyük)
+                if((fabsf(dI) < 1e-3f) || (i_d <= 0.0f)){
+                    FOC_Comm_Fail(FOC_COMM_ERR_L);
+                    break;
+                }
+                FOC_Comm_Result.L_d = ((-FOC_Comm_Settings.U_pulse - (0.5f * R * dI)) * (float)N * Ts) / dI;
+            }
+            if(t >= (N + FOC_Comm_Settle)){
+                FOC_Comm_Next(FOC_COMM_L_Q);
+            }
+            break;
+
+        case FOC_COMM_L_Q:
+            if(t < N) FOC_Comm_U_q = FOC_Comm_Settings.U_pulse;
+            else if(t < (2U * N)) FOC_Comm_U_q = -FOC_Comm_Settings.U_pulse;
+            else FOC_Comm_U_q = 0.0f;
+
+            if(t == 1U) FOC_Comm_I_Start = i_q;
+            if(t == (N + 1U)){
+                float dI = i_q - FOC_Comm_I_Start;
+                if(fabsf(dI) < 1e-3f){
+                    FOC_Comm_Fail(FOC_COMM_ERR_L);
+                    break;
+                }
+                FOC_Comm_Result.L_q = ((FOC_Comm_Settings.U_pulse - (0.5f * R * dI)) * (float)N * Ts) / dI;
+            }
+            if(t >= ((2U * N) + FOC_Comm_Settle)){
+                // Kutup-sıfır iptali ile PI kazançları, bundan sonra sürücünün PI'ları kullanılır
+                float bw = FOC_Comm_Settings.bandwidth;
+
+                FOC_Comm_Result.Kp_d = FOC_Comm_Result.L_d * bw;
+                FOC_Comm_Result.Ki_d = R * bw;
+                FOC_Comm_Result.Kp_q = FOC_Comm_Result.L_q * bw;
+                FOC_Comm_Result.Ki_q = R * bw;
+
+                pHandle->config.R_phase = R;
+                pHandle->config.L_d = FOC_Comm_Result.L_d;
+                pHandle->config.L_q = FOC_Comm_Result.L_q;
+                pHandle->config.Kp_d = FOC_Comm_Result.Kp_d;
+                pHandle->config.Ki_d = FOC_Comm_Result.Ki_d;
+                pHandle->config.Kp_q = FOC_Comm_Result.Kp_q;
+                pHandle->config.Ki_q = FOC_Comm_Result.Ki_q;
+
+                // PI integralleri açık çevrim gerilimle başlatılır, geçişte akım zıplamaz
+                pHandle->state.i_d_memory = FOC_Comm_U_d;
+                pHandle->state.i_q_memory = 0.0f;
+                FOC_Comm_W = FOC_Comm_Settings.w_slow;
+                FOC_Comm_Travel = 0.0f;
+                FOC_Comm_Hall_Prev = hall_sector;
+                FOC_Comm_Position_Start = pHandle->input.position_rad;
+                FOC_Comm_Next(FOC_COMM_POLE_PAIRS);
+            }
+            break;
+
+        case FOC_COMM_POLE_PAIRS:
+            if((hall_sector == 0U) || (hall_sector == 7U)){
+                FOC_Comm_Fail(FOC_COMM_ERR_HALL);
+                break;
+            }
+            if(hall_sector != FOC_Comm_Hall_Prev){
+                FOC_Comm_Hall_Prev = hall_sector;
+                FOC_Comm_Result.hall_edges++;
+            }
+            FOC_Comm_Rotate(Ts);
+            if(FOC_Comm_Travel >= (6.2831853f * (float)FOC_COMM_POLE_REVS)){
+                int32_t expected = (int32_t)(6U * FOC_COMM_POLE_REVS);
+                int32_t diff = (int32_t)FOC_Comm_Result.hall_edges - expected;
+                if((diff > 1) || (diff < -1)){
+                    FOC_Comm_Fail(FOC_COMM_ERR_HALL);
+                    break;
+                }
+
+                // Mekanik yol, beklenenin (config.pole_pairs ile) yarısından azsa sensör yok sayılır
+                float mech = fabsf(pHandle->input.position_rad - FOC_Comm_Position_Start);
+                float expected_mech = (6.2831853f * (float)FOC_COMM_POLE_REVS) / (float)pHandle->config.pole_pairs;
+                if(mech > (0.5f * expected_mech)){
+                    float pp = FOC_Comm_Travel / mech;
+                    FOC_Comm_Result.pole_pairs_meas = (uint8_t)(pp + 0.5f);
+                    if(FOC_Comm_Result.pole_pairs_meas != pHandle->config.pole_pairs){
+                        FOC_Comm_Fail(FOC_COMM_ERR_POLE_PAIRS);
+                        break;
+                    }
+                }
+                FOC_Comm_Next(FOC_COMM_FLUX_RAMP);
+            }
+            break;
+
+        case FOC_COMM_FLUX_RAMP:
+            FOC_Comm_W = FOC_Comm_Settings.w_slow + ((FOC_Comm_Settings.w_flux - FOC_Comm_Settings.w_slow) * (float)t / (float)FOC_Comm_Ramp);
+            FOC_Comm_Rotate(Ts);
+            if(t >= FOC_Comm_Ramp){
+                FOC_Comm_W = FOC_Comm_Settings.w_flux;
+                FOC_Comm_Next(FOC_COMM_FLUX);
+            }
+            break;
+
+        case FOC_COMM_FLUX:
+            FOC_Comm_Rotate(Ts);
+            if(t >= FOC_Comm_Settle){
+                FOC_Comm_Acc[0] += pHandle->state.u_d;
+                FOC_Comm_Acc[1] += pHandle->state.u_q;
+                FOC_Comm_Acc[2] += i_d;
+                FOC_Comm_Acc[3] += i_q;
+            }
+            if(t >= (FOC_Comm_Settle + FOC_Comm_Average)){
+                float inv_n = 1.0f / (float)FOC_Comm_Average;
+                float w = FOC_Comm_W;
+                float L = 0.5f * (FOC_Comm_Result.L_d + FOC_Comm_Result.L_q);
+                float u_d = FOC_Comm_Acc[0] * inv_n;
+                float u_q = FOC_Comm_Acc[1] * inv_n;
+                float i_d_avg = FOC_Comm_Acc[2] * inv_n;
+                float i_q_avg = FOC_Comm_Acc[3] * inv_n;
+                float e_d = u_d - (R * i_d_avg) + (w * L * i_q_avg);
+                float e_q = u_q - (R * i_q_avg) - (w * L * i_d_avg);
+                float flux = (w > 0.0f) ? (sqrtf((e_d * e_d) + (e_q * e_q)) / w) : 0.0f;
+
+                if(flux <= 0.0f){
+                    FOC_Comm_Fail(FOC_COMM_ERR_FLUX);
+                    break;
+                }
+                FOC_Comm_Result.flux_linkage = flux;
+                pHandle->config.flux_linkage = flux;
+                FOC_Comm_Next(FOC_COMM_STOP);
+            }
+            break;
+
+        case FOC_COMM_STOP:
+            FOC_Comm_W = FOC_Comm_Settings.w_flux * (1.0f - ((float)t / (float)FOC_Comm_Ramp));
+            FOC_Comm_Rotate(Ts);
+            if(t >= FOC_Comm_Ramp){
+                pHandle->state.i_d_memory = 0.0f;
+                pHandle->state.i_q_memory = 0.0f;
+                FOC_Comm_Next(FOC_COMM_DONE);
+                FOC_Comm_Restore(pHandle);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if(FOC_Comm_Phase == FOC_COMM_ERROR){
+        pHandle->output.duty_a = 0.0f;
+        pHandle->output.duty_b = 0.0f;
+        pHandle->output.duty_c = 0.0f;
+        return;
+    }
+
+    if(phase >= FOC_COMM_POLE_PAIRS){
+        FOC_Comm_Current_Loop(pHandle);
+    }
+    else{
+        // Açık çevrim gerilim (L_D adımında darbe eklenir), zarf dışına çıkmasın
+        float u_d = FOC_Comm_U_d;
+        if((phase == FOC_COMM_L_D) && (t < N)) u_d -= FOC_Comm_Settings.U_pulse;
+
+        float max_volt = pHandle->state.d_q_max_voltage;
+        float u_sq = (u_d * u_d) + (FOC_Comm_U_q * FOC_Comm_U_q);
+        float k = (u_sq > (max_volt * max_volt)) ? (max_volt / sqrtf(u_sq)) : 1.0f;
+
+        pHandle->state.u_d = u_d * k;
+        pHandle->state.u_q = FOC_Comm_U_q * k;
+    }
+
+    FOC_Inverse_Clark_Park_Transform(pHandle);
+    FOC_SVPWM_Calculation(pHandle);
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Commission_Process(void){
+    if((FOC_Comm_Phase == FOC_COMM_DONE) && (FOC_Comm_Result.saved == false) && (FOC_Comm_Handle != 0)){
+        // Flash silme süresince (~20 ms) ISR'lar da bekler, çıkışlar önce kapatılır
+        FOC_PWM_Stop();
+
+        if(FOC_Commission_Save(FOC_Comm_Handle) == false){
+            FOC_Comm_Result.error = FOC_COMM_ERR_FLASH;
+            LOG_E("devreye alma: flash yazilamadi");
+        }
+        else{
+            LOG_I("devreye alma: sonuclar flash'a yazildi");
+        }
+        FOC_Comm_Result.saved = true;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Commission_Abort(void){
+    if(FOC_Commission_Busy() == false) return;
+
+    FOC_Comm_Fail(FOC_COMM_ERR_ABORTED); // Bir sonraki Step çıkışları sıfırlar
+    if(FOC_Comm_Handle != 0){
+        FOC_Comm_Handle->state.i_d_memory = 0.0f;
+        FOC_Comm_Handle->state.i_q_memory = 0.0f;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Commission_Busy(void){
+    FOC_Comm_Phase_t phase = FOC_Comm_Phase;
+    return (phase != FOC_COMM_IDLE) && (phase != FOC_COMM_DONE) && (phase != FOC_COMM_ERROR);
+}
+
+// ------------------------------------------------------------------------------
+
+const FOC_Comm_Result_t *FOC_Commission_Get_Result(void){
+    return &FOC_Comm_Result;
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Commission_Save(FOC_Handle_t *pHandle){
+    FOC_Comm_Record_t record;
+    FLASH_EraseInitTypeDef erase;
+    uint32_t page_error = 0;
+    bool ok = true;
+
+    record.magic = FOC_COMM_MAGIC;
+    record.version = FOC_COMM_VERSION;
+    record.R_phase = pHandle->config.R_phase;
+    record.L_d = pHandle->config.L_d;
+    record.L_q = pHandle->config.L_q;
+    record.flux_linkage = pHandle->config.flux_linkage;
+    record.Kp_d = pHandle->config.Kp_d;
+    record.Ki_d = pHandle->config.Ki_d;
+    record.Kp_q = pHandle->config.Kp_q;
+    record.Ki_q = pHandle->config.Ki_q;
+    record.pole_pairs = pHandle->config.pole_pairs;
+    record.checksum = FOC_Comm_Checksum(&record);
+
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.Banks = FLASH_BANK_1;
+    erase.Page = FOC_COMM_FLASH_PAGE;
+    erase.NbPages = 1;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+
+    if(HAL_FLASHEx_Erase(&erase, &page_error) != HAL_OK){
+        ok = false;
+    }
+
+    const uint64_t *pData = (const uint64_t *)&record;
+    for(uint32_t i = 0; ok && (i < (sizeof(FOC_Comm_Record_t) / 8U)); i++){
+        if(HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, FOC_COMM_FLASH_ADDR + (i * 8U), pData[i]) != HAL_OK){
+            ok = false;
+        }
+    }
+
+    HAL_FLASH_Lock();
+    return ok;
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Commission_Load(FOC_Handle_t *pHandle){
+    const FOC_Comm_Record_t *pRecord = (const FOC_Comm_Record_t *)FOC_COMM_FLASH_ADDR;
+
+    if((pRecord->magic != FOC_COMM_MAGIC) || (pRecord->version != FOC_COMM_VERSION) ||
+       (pRecord->checksum != FOC_Comm_Checksum(pRecord))){
+        return false;
+    }
+
+    pHandle->config.R_phase = pRecord->R_phase;
+    pHandle->config.L_d = pRecord->L_d;
+    pHandle->config.L_q = pRecord->L_q;
+    pHandle->config.flux_linkage = pRecord->flux_linkage;
+    pHandle->config.Kp_d = pRecord->Kp_d;
+    pHandle->config.Ki_d = pRecord->Ki_d;
+    pHandle->config.Kp_q = pRecord->Kp_q;
+    pHandle->config.Ki_q = pRecord->Ki_q;
+    pHandle->config.pole_pairs = (uint8_t)pRecord->pole_pairs;
+
+    return true;
+}
@@ -6,10 +6,96 @@
 #include "stm32g4xx_ll_cordic.h" // LL kütüphanesini kullandığını varsayıyorum
 #include "math.h"
 
+// <<---------------------------------------------->>
+// <<-------------Tablo Tanımlamaları-------------->>
+// <<---------------------------------------------->>
+
+// Aşırı modülasyon Mod I: istenen temel bileşen m (U_DC'ye normalize, FOC_OVM_M_LINEAR ... FOC_OVM_M_MODE_II)
+// için altıgene kırpılmadan önce uygulanması gereken referans genliği. Kırpma faz korunarak yapılır,
+// kaybolan temel bileşen genliği büyüterek geri kazanılır. Eşit aralıklı, offline hesaplanmıştır.
+static const float FOC_OVM_MODE_I_TABLE[FOC_OVM_TABLE_SIZE] = {
+    0.57735f, 0.58153f, 0.58650f, 0.59227f, 0.59901f, 0.60703f, 0.61703f, 0.63074f, 0.66667f
+};
+#define FOC_OVM_MODE_I_INV_STEP  282.222f // 1 / ((FOC_OVM_M_MODE_II - FOC_OVM_M_LINEAR) / 8)
+
+// Aşırı modülasyon Mod II: istenen temel bileşen m (FOC_OVM_M_MODE_II ... FOC_OVM_M_SIX_STEP) için
+// vektörün altıgen köşesinde tutulacağı açı (rad). 0: altıgen sınırı, pi/6: six-step.
+static const float FOC_OVM_MODE_II_TABLE[FOC_OVM_TABLE_SIZE] = {
+    0.00000f, 0.03426f, 0.07096f, 0.11077f, 0.15468f, 0.20438f, 0.26319f, 0.33962f, 0.52360f
+};
+#define FOC_OVM_MODE_II_INV_STEP 258.706f // 1 / ((FOC_OVM_M_SIX_STEP - FOC_OVM_M_MODE_II) / 8)
+
+// Bu aralıktaki duty rayda kabul edilir (anahtarlanmaz, ölü zaman kompanzasyonu eklenmez)
+#define FOC_DTC_RAIL_DUTY 1.0e-4f
+
+// FCS-MPC: 8 anahtarlama durumunun alpha/beta gerilimleri (U_DC'ye normalize).
+// İndeks bitleri: bit0 = A, bit1 = B, bit2 = C üst anahtarı iletimde.
+static const float FOC_FCS_V_ALPHA[8] = {
+    0.0f, 0.6666667f, -0.3333333f, 0.3333333f, -0.3333333f, 0.3333333f, -0.6666667f, 0.0f
+};
+static const float FOC_FCS_V_BETA[8] = {
+    0.0f, 0.0f, 0.5773503f, 0.5773503f, -0.5773503f, -0.5773503f, 0.0f, 0.0f
+};
+
+// İki durum arasındaki anahtarlama sayısı = popcount(önceki ^ aday)
+static const uint8_t FOC_FCS_SWITCH_COUNT[8] = {0, 1, 1, 2, 1, 2, 2, 3};
+
 // <<---------------------------------------------->>
 // <<-------------Fonksiyon Tanımlamaları---------->>
 // <<---------------------------------------------->>
 
+// Eşit aralıklı tabloda doğrusal interpolasyon. x: tablo başlangıcına göre uzaklık, inv_step: 1 / adım
+static float FOC_Table_Interp(const float *table, uint32_t size, float x, float inv_step){
+    float pos = x * inv_step;
+
+    if(pos <= 0.0f) return table[0];
+    if(pos >= (float)(size - 1U)) return table[size - 1U];
+
+    uint32_t idx = (uint32_t)pos;
+    float frac = pos - (float)idx;
+    return table[idx] + frac * (table[idx + 1U] - table[idx]);
+}
+
+// Eşit aralıklı 2D tabloda bilineer interpolasyon (satır: x, sütun: y). Sabit süreli, döngü yok.
+static float FOC_Table_Interp_2D(const float *table, uint32_t rows, uint32_t cols, float x, float inv_step_x, float y, float inv_step_y){
+    float pos_x = x * inv_step_x;
+    float pos_y = y * inv_step_y;
+
+    if(pos_x < 0.0f) pos_x = 0.0f;
+    if(pos_x > (float)(rows - 1U)) pos_x = (float)(rows - 1U);
+    if(pos_y < 0.0f) pos_y = 0.0f;
+    if(pos_y > (float)(cols - 1U)) pos_y = (float)(cols - 1U);
+
+    // Son hücrede idx + 1 taşmasın diye indeks en fazla (boyut - 2) olur, kesir 1.0'a kadar çıkar
+    uint32_t ix = (uint32_t)pos_x;
+    uint32_t iy = (uint32_t)pos_y;
+    if(ix > rows - 2U) ix = rows - 2U;
+    if(iy > cols - 2U) iy = cols - 2U;
+
+    float fx = pos_x - (float)ix;
+    float fy = pos_y - (float)iy;
+
+    const float *r0 = &table[ix * cols + iy];
+    const float *r1 = r0 + cols;
+
+    float v0 = r0[0] + fy * (r0[1] - r0[0]);
+    float v1 = r1[0] + fy * (r1[1] - r1[0]);
+    return v0 + fx * (v1 - v0);
+}
+
+// ------------------------------------------------------------------------------
+
+// Küçük açı için sin / cos serisi (sin: x^5, cos: x^6 terimine kadar), CORDIC meşgul edilmez.
+// Akım döngüsünün döndürme açıları (w*Ts, 1.5*w*Ts) için: |x| < 0.75 rad'da hata < 3e-5.
+static void FOC_Small_Angle_Cos_Sin(float x, float *cos_value, float *sin_value){
+    float x_sq = x * x;
+
+    *cos_value = 1.0f - x_sq * 0.5f * (1.0f - x_sq * 0.0833333f * (1.0f - x_sq * 0.0333333f));
+    *sin_value = x * (1.0f - x_sq * 0.1666667f * (1.0f - x_sq * 0.05f));
+}
+
+// ------------------------------------------------------------------------------
+
 void FOC_Driver_Init(FOC_Handle_t *pHandle){
     // Girişleri sıfırla
     pHandle->input.i_a_meas = 0.0f;
@@ -18,6 +104,10 @@ void FOC_Driver_Init(FOC_Handle_t *pHandle){
     pHandle->input.Electrical_Angle_rad = 0.0f;
     pHandle->input.T_mot_ref = 0.0f;
     pHandle->input.U_bat = 0.0f;
+    pHandle->input.speed_ref_rad_s = 0.0f;
+    pHandle->input.position_rad = 0.0f;
+    pHandle->input.position_ref_rad = 0.0f;
+    pHandle->input.speed_ff_rad_s = 0.0f;
     
     // State'leri sıfırla
     pHandle->state.i_q_ref = 0.0f;
@@ -26,13 +116,32 @@ void FOC_Driver_Init(FOC_Handle_t *pHandle){
     pHandle->state.i_beta = 0.0f;
     pHandle->state.i_d = 0.0f;
     pHandle->state.i_q = 0.0f;
+    // Zamanlanan parametreler ilk FOC_Parameter_Schedule çağrısına kadar config değerleriyle başlar
+    pHandle->state.L_d_sched = pHandle->config.L_d;
+    pHandle->state.L_q_sched = pHandle->config.L_q;
+    pHandle->state.flux_sched = pHandle->config.flux_linkage;
+    pHandle->state.Kp_d_sched = pHandle->config.Kp_d;
+    pHandle->state.Kp_q_sched = pHandle->config.Kp_q;
     pHandle->state.u_d_decoupling = 0.0f;
     pHandle->state.u_q_decoupling = 0.0f;
     pHandle->state.d_q_max_voltage = 0.0f;
+    pHandle->state.fw_i_d = 0.0f;
+    pHandle->state.fw_integrator = 0.0f;
+    pHandle->state.i_q_limit = 0.0f;
+    pHandle->state.fw_counter = 0;
+    pHandle->state.speed_ref = 0.0f;
+    pHandle->state.speed_integrator = 0.0f;
+    pHandle->state.u_d_applied = 0.0f;
+    pHandle->state.u_q_applied = 0.0f;
+    pHandle->state.fcs_state = 0;
+    pHandle->state.clamp_phase = FOC_CLAMP_NONE;
+    pHandle->state.dpwm_auto = FOC_MOD_SVPWM;
     pHandle->state.i_d_memory = 0.0f;
     pHandle->state.i_q_memory = 0.0f;
     pHandle->state.u_d = 0.0f;
     pHandle->state.u_q = 0.0f;
+    pHandle->state.cos_theta = 1.0f;
+    pHandle->state.sin_theta = 0.0f;
     pHandle->state.u_x = 0.0f;
     pHandle->state.u_y = 0.0f;
     pHandle->state.u_ref_a = 0.0f;
@@ -59,6 +168,8 @@ void FOC_Clark_Park_Transform(FOC_Handle_t *pHandle){
 
     // Park Dönüşümü
     FOC_G4_Cos_Sin_Calculate(alpha_rad, &cos_val, &sin_val);
+    pHandle->state.cos_theta = cos_val;
+    pHandle->state.sin_theta = sin_val;
 
     pHandle->state.i_d =  (pHandle->state.i_alpha * cos_val) + (pHandle->state.i_beta * sin_val);
     pHandle->state.i_q = -(pHandle->state.i_alpha * sin_val) + (pHandle->state.i_beta * cos_val);
@@ -66,15 +177,91 @@ void FOC_Clark_Park_Transform(FOC_Handle_t *pHandle){
 
 // ------------------------------------------------------------------------------
 
+// Akım genliği i_s için MTPA d akımı. dL = L_d - L_q (IPM'de negatif):
+// i_d = (-flux + sqrt(flux^2 + 8 * dL^2 * i_s^2)) / (4 * dL)
+static float FOC_MTPA_I_d(float i_s, float flux_linkage, float dL){
+    if(fabsf(dL) < 1e-9f) return 0.0f; // Yüzey mıknatıslı motor: relüktans torku yok
+
+    return (-flux_linkage + sqrtf(flux_linkage * flux_linkage + 8.0f * dL * dL * i_s * i_s)) / (4.0f * dL);
+}
+
+// i_s akım genliğinde MTPA noktasında üretilen tork: T = 1.5 * PP * (flux * i_q + dL * i_d * i_q)
+static float FOC_MTPA_Torque(float i_s, float pole_pairs, float flux_linkage, float dL, float *i_d, float *i_q){
+    float d = FOC_MTPA_I_d(i_s, flux_linkage, dL);
+    float q_sq = (i_s * i_s) - (d * d);
+    float q = (q_sq > 0.0f) ? sqrtf(q_sq) : 0.0f;
+
+    *i_d = d;
+    *i_q = q;
+    return 1.5f * pole_pairs * (flux_linkage + dL * d) * q;
+}
+
+// MTPA tablosunu motor parametrelerinden hesaplar. Tork ekseninde eşit aralıklı noktalar için
+// gerekli akım genliği ikiye bölme (bisection) ile bulunur; iterasyon sadece burada yapılır, ISR'da yapılmaz.
+void FOC_MTPA_Init(FOC_Handle_t *pHandle){
+    FOC_MTPA_Compute(&pHandle->config, &pHandle->mtpa);
+}
+
+// ------------------------------------------------------------------------------
+
+// Tabloyu ayrı bir hedefe hesaplar (FOC_Param: canlı tabloya dokunmadan hazırlık)
+void FOC_MTPA_Compute(const FOC_Driver_Config_t *pConfig, FOC_MTPA_Table_t *pTable){
+    float I_s_max = pConfig->I_s_max;
+    float pole_pairs = (float)pConfig->pole_pairs;
+    float flux_linkage = pConfig->flux_linkage;
+    float dL = pConfig->L_d - pConfig->L_q;
+    float i_d, i_q;
+
+    pTable->T_max = FOC_MTPA_Torque(I_s_max, pole_pairs, flux_linkage, dL, &i_d, &i_q);
+    pTable->inv_step = (pTable->T_max > 0.0f) ? ((float)(FOC_MTPA_TABLE_SIZE - 1U) / pTable->T_max) : 0.0f;
+
+    for(uint32_t k = 0; k < FOC_MTPA_TABLE_SIZE; k++){
+        float T_target = pTable->T_max * (float)k / (float)(FOC_MTPA_TABLE_SIZE - 1U);
+        float low = 0.0f;
+        float high = I_s_max;
+
+        // MTPA eğrisi boyunca tork akım genliği ile monoton artar
+        for(uint32_t it = 0; it < 32U; it++){
+            float mid = 0.5f * (low + high);
+            if(FOC_MTPA_Torque(mid, pole_pairs, flux_linkage, dL, &i_d, &i_q) < T_target) low = mid;
+            else high = mid;
+        }
+
+        FOC_MTPA_Torque(0.5f * (low + high), pole_pairs, flux_linkage, dL, &i_d, &i_q);
+        pTable->i_d[k] = i_d;
+        pTable->i_q[k] = i_q;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
 void FOC_Torq_Reference_Transform(FOC_Handle_t *pHandle){
     float I_s_max = pHandle->config.I_s_max;
     float T_mot_ref = pHandle->input.T_mot_ref;
     float pole_pairs = (float)pHandle->config.pole_pairs;
     float flux_linkage = pHandle->config.flux_linkage;
 
-    // Torktan akıma geçiş: Iq_ref = (2/3) * (T_ref / (PP * Flux))
-    pHandle->state.i_q_ref = (T_mot_ref * 2.0f) / (3.0f * pole_pairs * flux_linkage);
-    pHandle->state.i_d_ref = 0.0f; // Manyetik akı zayıflatma (Flux Weakening) yoksa 0
+    if(pHandle->config.mtpa == true){
+        // MTPA: |T| -> (i_d, i_q) tablo interpolasyonu, ISR'da kare kök veya iterasyon yok
+        float T_abs = fabsf(T_mot_ref);
+        float i_q_ref = FOC_Table_Interp(pHandle->mtpa.i_q, FOC_MTPA_TABLE_SIZE, T_abs, pHandle->mtpa.inv_step);
+
+        pHandle->state.i_d_ref = FOC_Table_Interp(pHandle->mtpa.i_d, FOC_MTPA_TABLE_SIZE, T_abs, pHandle->mtpa.inv_step);
+        pHandle->state.i_q_ref = (T_mot_ref < 0.0f) ? -i_q_ref : i_q_ref;
+    }
+    else{
+        // Torktan akıma geçiş: Iq_ref = (2/3) * (T_ref / (PP * Flux))
+        pHandle->state.i_q_ref = (T_mot_ref * 2.0f) / (3.0f * pole_pairs * flux_linkage);
+        pHandle->state.i_d_ref = 0.0f; // Manyetik akı zayıflatma (Flux Weakening) yoksa 0
+    }
+
+    if(pHandle->config.flux_weakening == true){
+        // d akımı ve q için kalan akım bütçesi düşük hızda güncellenir.
+        // MTPA açıksa daha negatif olan d akımı kullanılır.
+        FOC_Flux_Weakening(pHandle);
+        pHandle->state.i_d_ref = fminf(pHandle->state.i_d_ref, pHandle->state.fw_i_d);
+        I_s_max = pHandle->state.i_q_limit;
+    }
 
     // Akım Limitleme
     if(pHandle->state.i_q_ref > I_s_max){
@@ -87,11 +274,194 @@ void FOC_Torq_Reference_Transform(FOC_Handle_t *pHandle){
 
 // ------------------------------------------------------------------------------
 
-void FOC_Voltage_Decoupling(FOC_Handle_t *pHandle){
-    float w_rad_s = pHandle->input.w_rad_s;
+// Akı zayıflatma: back-EMF d_q_max_voltage'a yaklaştığında negatif d akımı ile mıknatıs akısı zayıflatılır.
+// Feedforward: R ihmal edilerek sürekli durum gerilim denkleminden gereken d akımı,
+//   (w * L_q * i_q)^2 + (w * (L_d * i_d + flux))^2 = V_max^2  ->  i_d = (sqrt((V_max / w)^2 - (L_q * i_q)^2) - flux) / L_d
+// Geri besleme: PI çıkış genliği |u_dq| ile V_max arasındaki fark integre edilerek parametre hataları düzeltilir.
+// Kare kök ve bölmeler ISR yükünü artırmamak için sadece her fw_decimation döngüde bir hesaplanır.
+void FOC_Flux_Weakening(FOC_Handle_t *pHandle){
+    uint8_t decimation = (pHandle->config.fw_decimation > 0U) ? pHandle->config.fw_decimation : 1U;
+
+    // Gerilim limiti yoksa (U_bat henüz ölçülmedi) V_max = 0 integrali fw_i_d_min'e sürükler, güncelleme atlanır
+    if(pHandle->state.d_q_max_voltage <= 0.0f){
+        pHandle->state.fw_integrator = 0.0f;
+        pHandle->state.fw_i_d = 0.0f;
+        pHandle->state.i_q_limit = pHandle->config.I_s_max;
+        return;
+    }
+
+    if(pHandle->state.fw_counter > 0U){
+        pHandle->state.fw_counter--;
+        return;
+    }
+    pHandle->state.fw_counter = decimation - 1U;
+
+    float I_s_max = pHandle->config.I_s_max;
+    float i_d_min = pHandle->config.fw_i_d_min;
     float L_d = pHandle->config.L_d;
     float L_q = pHandle->config.L_q;
     float flux_linkage = pHandle->config.flux_linkage;
+    float w_abs = fabsf(pHandle->input.w_rad_s);
+    float u_d = pHandle->state.u_d;
+    float u_q = pHandle->state.u_q;
+
+    // d_q_max_voltage bu döngüde FOC_Max_Voltage ile hesaplanır (FOC_Current_Controller sırası)
+    float V_max = pHandle->state.d_q_max_voltage * pHandle->config.fw_voltage_margin;
+
+    if(i_d_min < -I_s_max) i_d_min = -I_s_max;
+
+    // 1. Feedforward
+    float i_d_ff = 0.0f;
+    if(w_abs > 1.0f && L_d > 0.0f){
+        float psi_max = V_max / w_abs;
+        float psi_q = L_q * pHandle->state.i_q_ref;
+        float psi_d_sq = (psi_max * psi_max) - (psi_q * psi_q);
+        float psi_d = (psi_d_sq > 0.0f) ? sqrtf(psi_d_sq) : 0.0f;
+
+        i_d_ff = (psi_d - flux_linkage) / L_d;
+        if(i_d_ff > 0.0f) i_d_ff = 0.0f;
+    }
+
+    // 2. Gerilim geri besleme (gerilim doygunluğa yaklaştıkça integral negatife gider)
+    float u_mag = sqrtf(u_d * u_d + u_q * u_q);
+    float error = V_max - u_mag;
+    float Ts_fw = pHandle->config.Ts * (float)decimation;
+
+    // Anti-windup: integral, toplam d akımını [fw_i_d_min, 0] aralığında tutacak şekilde sınırlanır.
+    // Böylece düşük hızda pozitif yönde birikip hızlanma anında gecikmeye neden olmaz.
+    pHandle->state.fw_integrator += pHandle->config.fw_Ki * error * Ts_fw;
+    if(pHandle->state.fw_integrator > -i_d_ff) pHandle->state.fw_integrator = -i_d_ff;
+    if(pHandle->state.fw_integrator < (i_d_min - i_d_ff)) pHandle->state.fw_integrator = i_d_min - i_d_ff;
+
+    // 3. Toplam d akımı (sadece negatif, fw_i_d_min ile sınırlı)
+    float i_d = i_d_ff + pHandle->state.fw_integrator;
+    if(i_d > 0.0f) i_d = 0.0f;
+    if(i_d < i_d_min) i_d = i_d_min;
+
+    // Akım bütçesi: d ekseni önceliklidir, q eksenine kalan = sqrt(I_s_max^2 - i_d^2)
+    float i_q_sq = (I_s_max * I_s_max) - (i_d * i_d);
+
+    pHandle->state.fw_i_d = i_d;
+    pHandle->state.i_q_limit = (i_q_sq > 0.0f) ? sqrtf(i_q_sq) : 0.0f;
+}
+
+// ------------------------------------------------------------------------------
+
+// Hız PI'ı: mekanik hız hatasından tork referansı (input.T_mot_ref) üretir.
+// Örnekleme süresi Ts * speed_decimation'dır (0 verildiyse FOC_Scheduler_Init config'e 1 yazar).
+// Integral, tork limitine göre kırpılır.
+void FOC_Speed_Controller(FOC_Handle_t *pHandle){
+    float Ts_speed = pHandle->config.Ts * (float)pHandle->config.speed_decimation;
+    float T_limit = pHandle->config.speed_torque_limit;
+
+    if(pHandle->config.speed_ctrl_mode == false){
+        pHandle->state.speed_integrator = 0.0f;
+        return;
+    }
+
+    if(pHandle->config.position_ctrl_mode == false){
+        pHandle->state.speed_ref = pHandle->input.speed_ref_rad_s;
+    }
+
+    float w_mech = pHandle->input.w_rad_s / (float)pHandle->config.pole_pairs;
+    float error = pHandle->state.speed_ref - w_mech;
+
+    pHandle->state.speed_integrator += pHandle->config.Ki_speed * error * Ts_speed;
+    if(pHandle->state.speed_integrator > T_limit) pHandle->state.speed_integrator = T_limit;
+    else if(pHandle->state.speed_integrator < -T_limit) pHandle->state.speed_integrator = -T_limit;
+
+    float T_ref = (pHandle->config.Kp_speed * error) + pHandle->state.speed_integrator;
+    if(T_ref > T_limit) T_ref = T_limit;
+    else if(T_ref < -T_limit) T_ref = -T_limit;
+
+    // 32 bit float yazması atomiktir, akım ISR'ı yarım güncellenmiş değer görmez
+    pHandle->input.T_mot_ref = T_ref;
+}
+
+// ------------------------------------------------------------------------------
+
+// Pozisyon P döngüsü: pozisyon hatasından hız döngüsünün referansını üretir (max_speed_rad_s ile sınırlı).
+void FOC_Position_Controller(FOC_Handle_t *pHandle){
+    float w_limit = pHandle->config.max_speed_rad_s;
+
+    if(pHandle->config.position_ctrl_mode == false){
+        return;
+    }
+
+    float speed_ref = pHandle->input.speed_ff_rad_s + pHandle->config.Kp_position * (pHandle->input.position_ref_rad - pHandle->input.position_rad);
+    if(speed_ref > w_limit) speed_ref = w_limit;
+    else if(speed_ref < -w_limit) speed_ref = -w_limit;
+
+    pHandle->state.speed_ref = speed_ref;
+}
+
+// ------------------------------------------------------------------------------
+
+// Harita eksenlerini kurar ve tüm noktaları sabit config değerleriyle doldurur.
+// Bu haliyle davranış sabit parametrelerle aynıdır; ölçülen değerler daha sonra tablolara yazılır.
+// config.L_d / L_q pozitif değilse Kp ölçeklemesi tanımsızdır: harita kurulmaz, false döner.
+bool FOC_Sat_Map_Init(FOC_Handle_t *pHandle, float i_d_min, float i_q_max){
+    FOC_Sat_Map_t *pMap = &pHandle->sat_map;
+
+    if(!(pHandle->config.L_d > 0.0f) || !(pHandle->config.L_q > 0.0f)){
+        pMap->inv_L_d_nom = 0.0f;
+        pMap->inv_L_q_nom = 0.0f;
+        return false;
+    }
+
+    for(uint32_t d = 0; d < FOC_SAT_MAP_ID_POINTS; d++){
+        for(uint32_t q = 0; q < FOC_SAT_MAP_IQ_POINTS; q++){
+            pMap->L_d[d][q] = pHandle->config.L_d;
+            pMap->L_q[d][q] = pHandle->config.L_q;
+        }
+        pMap->flux[d] = pHandle->config.flux_linkage;
+    }
+
+    pMap->i_d_min = i_d_min;
+    pMap->inv_step_d = (i_d_min < 0.0f) ? ((float)(FOC_SAT_MAP_ID_POINTS - 1U) / -i_d_min) : 0.0f;
+    pMap->inv_step_q = (i_q_max > 0.0f) ? ((float)(FOC_SAT_MAP_IQ_POINTS - 1U) / i_q_max) : 0.0f;
+    pMap->inv_L_d_nom = 1.0f / pHandle->config.L_d;
+    pMap->inv_L_q_nom = 1.0f / pHandle->config.L_q;
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+// Ölçülen akıma göre L_d, L_q, flux ve akım PI Kp kazançlarını zamanlar.
+// Kp = w_c * L olduğu için Kp, L ile orantılı ölçeklenir ve akım döngüsü bant genişliği tüm tork
+// aralığında sabit kalır. Ki = w_c * R endüktanstan bağımsız olduğu için değişmez.
+void FOC_Parameter_Schedule(FOC_Handle_t *pHandle){
+    // Harita kurulmadıysa (FOC_Sat_Map_Init false döndü) Kp sıfırla ölçeklenmesin, sabit parametreler kullanılır
+    if((pHandle->config.saturation_maps == false) || !(pHandle->sat_map.inv_L_d_nom > 0.0f) || !(pHandle->sat_map.inv_L_q_nom > 0.0f)){
+        pHandle->state.L_d_sched = pHandle->config.L_d;
+        pHandle->state.L_q_sched = pHandle->config.L_q;
+        pHandle->state.flux_sched = pHandle->config.flux_linkage;
+        pHandle->state.Kp_d_sched = pHandle->config.Kp_d;
+        pHandle->state.Kp_q_sched = pHandle->config.Kp_q;
+        return;
+    }
+
+    FOC_Sat_Map_t *pMap = &pHandle->sat_map;
+    float x = pHandle->state.i_d - pMap->i_d_min;
+    float y = fabsf(pHandle->state.i_q);
+
+    float L_d = FOC_Table_Interp_2D(&pMap->L_d[0][0], FOC_SAT_MAP_ID_POINTS, FOC_SAT_MAP_IQ_POINTS, x, pMap->inv_step_d, y, pMap->inv_step_q);
+    float L_q = FOC_Table_Interp_2D(&pMap->L_q[0][0], FOC_SAT_MAP_ID_POINTS, FOC_SAT_MAP_IQ_POINTS, x, pMap->inv_step_d, y, pMap->inv_step_q);
+
+    pHandle->state.L_d_sched = L_d;
+    pHandle->state.L_q_sched = L_q;
+    pHandle->state.flux_sched = FOC_Table_Interp(pMap->flux, FOC_SAT_MAP_ID_POINTS, x, pMap->inv_step_d);
+    pHandle->state.Kp_d_sched = pHandle->config.Kp_d * L_d * pMap->inv_L_d_nom;
+    pHandle->state.Kp_q_sched = pHandle->config.Kp_q * L_q * pMap->inv_L_q_nom;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Voltage_Decoupling(FOC_Handle_t *pHandle){
+    float w_rad_s = pHandle->input.w_rad_s;
+    float L_d = pHandle->state.L_d_sched;
+    float L_q = pHandle->state.L_q_sched;
+    float flux_linkage = pHandle->state.flux_sched;
     float i_d = pHandle->state.i_d;
     float i_q = pHandle->state.i_q;
 
@@ -103,15 +473,23 @@ void FOC_Voltage_Decoupling(FOC_Handle_t *pHandle){
 // ------------------------------------------------------------------------------
 
 void FOC_Max_Voltage(FOC_Handle_t *pHandle){
-    // SVPWM kullanıldığı için DC bus voltajının %57.7'si (1/sqrt(3)) kullanılabilir lineer bölge
-    // Modulation Index'e göre bu değişebilir ama genelde:
-    pHandle->state.d_q_max_voltage = pHandle->input.U_bat * 0.57735f;
+    float mod_index = pHandle->config.max_mod_index;
+
+    if(mod_index > FOC_OVM_MI_LINEAR){
+        // Aşırı modülasyon açık: zarf six-step temel bileşenine (2/pi * U_DC) kadar genişler
+        if(mod_index > 1.0f) mod_index = 1.0f;
+        pHandle->state.d_q_max_voltage = pHandle->input.U_bat * mod_index * FOC_OVM_M_SIX_STEP;
+    }
+    else{
+        // SVPWM kullanıldığı için DC bus voltajının %57.7'si (1/sqrt(3)) kullanılabilir lineer bölge
+        pHandle->state.d_q_max_voltage = pHandle->input.U_bat * FOC_OVM_M_LINEAR;
+    }
 }
 
 // ------------------------------------------------------------------------------
 
 void FOC_Direct_Current_Control_d(FOC_Handle_t *pHandle){
-    float Kp = pHandle->config.Kp_d;
+    float Kp = pHandle->state.Kp_d_sched;
     float Ki = pHandle->config.Ki_d;
     float Ts = pHandle->config.Ts;
     float max_volt = pHandle->state.d_q_max_voltage;
@@ -119,6 +497,12 @@ void FOC_Direct_Current_Control_d(FOC_Handle_t *pHandle){
     float error = pHandle->state.i_d_ref - pHandle->state.i_d;
     float proportional = Kp * error;
     
+    // Back-calculation seçiliyse integral ve limitleme FOC_Voltage_Vector_Limit'te yapılır
+    if(pHandle->config.back_calc_aw == true){
+        pHandle->state.u_d = proportional + pHandle->state.i_d_memory + pHandle->state.u_d_decoupling;
+        return;
+    }
+
     // Integral + Anti-Windup (Clamping)
     pHandle->state.i_d_memory += Ki * error * Ts;
     if (pHandle->state.i_d_memory > max_volt) pHandle->state.i_d_memory = max_volt;
@@ -126,7 +510,7 @@ void FOC_Direct_Current_Control_d(FOC_Handle_t *pHandle){
 
     float u_d_out = proportional + pHandle->state.i_d_memory + pHandle->state.u_d_decoupling;
 
-    // Çıkış Limitleme
+    // Çıkış Limitleme (eksen bazında, vektör limiti FOC_Voltage_Vector_Limit'te)
     if(u_d_out > max_volt) u_d_out = max_volt;
     else if(u_d_out < -max_volt) u_d_out = -max_volt;
 
@@ -136,19 +520,31 @@ void FOC_Direct_Current_Control_d(FOC_Handle_t *pHandle){
 // ------------------------------------------------------------------------------
 
 void FOC_Direct_Current_Control_q(FOC_Handle_t *pHandle){
-    float Kp = pHandle->config.Kp_q;
+    float Kp = pHandle->state.Kp_q_sched;
     float Ki = pHandle->config.Ki_q;
     float Ts = pHandle->config.Ts;
     
     // Q ekseni için kalan voltaj limitini hesapla
+    // d_q_max_voltage aşırı modülasyon açıksa genişletilmiş zarfı (max_mod_index) içerir,
+    // böylece q ekseni hexagon köşelerine kadar olan gerilimi kullanabilir.
+    // d önceliği dışındaki modlarda q ekseni tüm gerilimi görür, vektör limiti sonra uygulanır.
     float u_d = pHandle->state.u_d;
     float max_volt_abs = pHandle->state.d_q_max_voltage;
-    float limit_sq = (max_volt_abs * max_volt_abs) - (u_d * u_d);
-    float limit_volts = (limit_sq > 0.0f) ? sqrtf(limit_sq) : 0.0f;
+    float limit_volts = max_volt_abs;
+    if(pHandle->config.voltage_priority == FOC_VLIM_D_PRIORITY){
+        float limit_sq = (max_volt_abs * max_volt_abs) - (u_d * u_d);
+        limit_volts = (limit_sq > 0.0f) ? sqrtf(limit_sq) : 0.0f;
+    }
 
     float error = pHandle->state.i_q_ref - pHandle->state.i_q;
     float proportional = Kp * error;
 
+    // Back-calculation seçiliyse integral ve limitleme FOC_Voltage_Vector_Limit'te yapılır
+    if(pHandle->config.back_calc_aw == true){
+        pHandle->state.u_q = proportional + pHandle->state.i_q_memory + pHandle->state.u_q_decoupling;
+        return;
+    }
+
     // Integral + Anti-Windup
     pHandle->state.i_q_memory += Ki * error * Ts;
     if (pHandle->state.i_q_memory > limit_volts) pHandle->state.i_q_memory = limit_volts;
@@ -165,6 +561,250 @@ void FOC_Direct_Current_Control_q(FOC_Handle_t *pHandle){
 
 // ------------------------------------------------------------------------------
 
+// PI çıkışını (state.u_d, state.u_q) d_q_max_voltage dairesine seçilen önceliğe göre sığdırır.
+// Back-calculation açıksa integral burada güncellenir:
+//   I += Ts * Ki * (e + (u_limitli - u_ham) / Kp)
+// Böylece doygunluk süresince integral limitli çıkışı takip eder ve doygunluktan çıkışta
+// kırpma yöntemindeki gibi fazla birikimi boşaltmak için beklenmez.
+void FOC_Voltage_Vector_Limit(FOC_Handle_t *pHandle){
+    float max_volt = pHandle->state.d_q_max_voltage;
+    float u_d = pHandle->state.u_d;
+    float u_q = pHandle->state.u_q;
+    float limit;
+
+    switch(pHandle->config.voltage_priority){
+        case FOC_VLIM_Q_PRIORITY:{
+            // d ekseni zarfın FOC_VLIM_D_RESERVE oranına kadar yine önceliklidir. u_d tamamen q'ya bırakılırsa
+            // yüksek hızda i_d kontrolsüz büyür, w * L_d * i_d q ekseninin gerilim ihtiyacını artırır ve
+            // i_q ters yönde bir denge noktasına kilitlenir.
+            float reserve = fminf(fabsf(u_d), FOC_VLIM_D_RESERVE * max_volt);
+            limit = sqrtf((max_volt * max_volt) - (reserve * reserve));
+            if(u_q > limit) u_q = limit;
+            else if(u_q < -limit) u_q = -limit;
+            limit = (max_volt * max_volt) - (u_q * u_q);
+            limit = (limit > 0.0f) ? sqrtf(limit) : 0.0f;
+            if(u_d > limit) u_d = limit;
+            else if(u_d < -limit) u_d = -limit;
+            break;
+        }
+        case FOC_VLIM_PROPORTIONAL:
+            limit = (u_d * u_d) + (u_q * u_q);
+            if(limit > max_volt * max_volt){
+                float k = max_volt / sqrtf(limit);
+                u_d *= k;
+                u_q *= k;
+            }
+            break;
+        default:
+            if(u_d > max_volt) u_d = max_volt;
+            else if(u_d < -max_volt) u_d = -max_volt;
+            limit = (max_volt * max_volt) - (u_d * u_d);
+            limit = (limit > 0.0f) ? sqrtf(limit) : 0.0f;
+            if(u_q > limit) u_q = limit;
+            else if(u_q < -limit) u_q = -limit;
+            break;
+    }
+
+    if(pHandle->config.back_calc_aw == true){
+        float Ts = pHandle->config.Ts;
+        float Kp_d = pHandle->state.Kp_d_sched;
+        float Kp_q = pHandle->state.Kp_q_sched;
+        float track_d = (Kp_d > 0.0f) ? ((u_d - pHandle->state.u_d) / Kp_d) : 0.0f;
+        float track_q = (Kp_q > 0.0f) ? ((u_q - pHandle->state.u_q) / Kp_q) : 0.0f;
+
+        pHandle->state.i_d_memory += pHandle->config.Ki_d * Ts * ((pHandle->state.i_d_ref - pHandle->state.i_d) + track_d);
+        pHandle->state.i_q_memory += pHandle->config.Ki_q * Ts * ((pHandle->state.i_q_ref - pHandle->state.i_q) + track_q);
+    }
+
+    pHandle->state.u_d = u_d;
+    pHandle->state.u_q = u_q;
+}
+
+// ------------------------------------------------------------------------------
+
+// Senkron eksende ayrık zamanlı complex-vector PI (FOC_Direct_Current_Control_d/q ile aynı giriş/çıkış).
+// Sürekli zamanda C(s) = Kp + (Ki + j*w*Kp) / s, plant kutbunu (R/L + j*w) iptal eder ve açık çevrimi
+// w_c / s yapar. Ayrık tasarımda sıfır, ZOH'lu plantın ayrık kutbuna z_p = exp(-(R/L + j*w) * Ts) konur:
+//   C(z) = Kp * (z - z_p) / (z - 1)  ->  x[k+1] = x[k] + Kp * (1 - z_p) * e[k],  u[k] = Kp * e[k] + x[k]
+// Kp * a = Ki olduğundan (a = R/L) Kp * (1 - z_p) ~ Kp * (1 - cos) + Ki * Ts * cos + j * (Kp - Ki * Ts) * sin,
+// yani bölme gerekmez. L_d != L_q için çapraz terimler ilgili eksenin Kp'si ile ağırlıklandırılır.
+// w*Ts büyüdükçe ayrı d/q PI + feedforward'ın kararlılığı bozulurken bu yapı kutup iptalini korur.
+// Hesaplanan gerilim bir sonraki periyotta uygulanır (ortalama 1.5 Ts gecikme); çıkış vektörü
+// rotorun bu sürede döneceği açı kadar ileri döndürülerek gecikme kompanzasyonu yapılır.
+void FOC_Complex_Vector_Current_Control(FOC_Handle_t *pHandle){
+    float Ts = pHandle->config.Ts;
+    float Kp_d = pHandle->state.Kp_d_sched;
+    float Kp_q = pHandle->state.Kp_q_sched;
+    float KiTs_d = pHandle->config.Ki_d * Ts;
+    float KiTs_q = pHandle->config.Ki_q * Ts;
+    float max_volt = pHandle->state.d_q_max_voltage;
+
+    // Küçük açı serisi: |w*Ts| < 0.5 rad'da (gecikme açısı 1.5 * w*Ts < 0.75 rad) hata < 3e-5
+    float theta = pHandle->input.w_rad_s * Ts;
+    float c, s;
+    FOC_Small_Angle_Cos_Sin(theta, &c, &s);
+
+    float e_d = pHandle->state.i_d_ref - pHandle->state.i_d;
+    float e_q = pHandle->state.i_q_ref - pHandle->state.i_q;
+
+    // Çıkış: oransal + integral + back-EMF feedforward (çapraz bağlaşım integral tarafından iptal edilir)
+    float u_d = (Kp_d * e_d) + pHandle->state.i_d_memory;
+    float u_q = (Kp_q * e_q) + pHandle->state.i_q_memory + (pHandle->input.w_rad_s * pHandle->state.flux_sched);
+
+    // Gecikme kompanzasyonu: 1.5 * w * Ts kadar döndür
+    float cd, sd;
+    FOC_Small_Angle_Cos_Sin(1.5f * theta, &cd, &sd);
+    float u_d_rot = (u_d * cd) - (u_q * sd);
+    float u_q_rot = (u_d * sd) + (u_q * cd);
+
+    // Vektörel limit (daire), doygunlukta integral büyütülmez (koşullu integrasyon)
+    float u_sq = (u_d_rot * u_d_rot) + (u_q_rot * u_q_rot);
+    bool saturated = (u_sq > max_volt * max_volt);
+    if(saturated){
+        float k = max_volt / sqrtf(u_sq);
+        u_d_rot *= k;
+        u_q_rot *= k;
+    }
+
+    if(saturated == false){
+        pHandle->state.i_d_memory += ((Kp_d * (1.0f - c) + KiTs_d * c) * e_d) - ((Kp_q - KiTs_q) * s * e_q);
+        pHandle->state.i_q_memory += ((Kp_q * (1.0f - c) + KiTs_q * c) * e_q) + ((Kp_d - KiTs_d) * s * e_d);
+    }
+
+    pHandle->state.u_d = u_d_rot;
+    pHandle->state.u_q = u_q_rot;
+}
+
+// ------------------------------------------------------------------------------
+
+// Deadbeat öngörülü akım kontrolü (FOC_Direct_Current_Control_d/q ile aynı giriş/çıkış).
+// Ayrık model (ileri Euler, senkron eksen):
+//   i_d[k+1] = i_d[k] + Ts / L_d * (u_d[k] - R * i_d[k] + w * L_q * i_q[k])
+//   i_q[k+1] = i_q[k] + Ts / L_q * (u_q[k] - R * i_q[k] - w * L_d * i_d[k] - w * flux)
+// Bu periyotta hesaplanan gerilim ancak bir sonraki periyotta uygulanır (tek adım hesaplama gecikmesi).
+// Bu yüzden önce şu an uygulanan gerilimle i[k+1] öngörülür, sonra i[k+2] = i_ref yapacak u[k+1] çözülür.
+// deadbeat_gain < 1 hatanın sadece bir kısmını bir periyotta kapatır (parametre hatalarına karşı daha gürbüz).
+void FOC_Deadbeat_Current_Control(FOC_Handle_t *pHandle){
+    float Ts = pHandle->config.Ts;
+    float R = pHandle->config.R_phase;
+    float L_d = pHandle->state.L_d_sched;
+    float L_q = pHandle->state.L_q_sched;
+    float flux_linkage = pHandle->state.flux_sched;
+    float w = pHandle->input.w_rad_s;
+    float gain = pHandle->config.deadbeat_gain;
+    float max_volt = pHandle->state.d_q_max_voltage;
+    float i_d = pHandle->state.i_d;
+    float i_q = pHandle->state.i_q;
+
+    // 1. Hesaplama gecikmesi kompanzasyonu: şu an uygulanan gerilimle bir sonraki örneği öngör
+    float i_d_pred = i_d + (Ts / L_d) * (pHandle->state.u_d_applied - R * i_d + w * L_q * i_q);
+    float i_q_pred = i_q + (Ts / L_q) * (pHandle->state.u_q_applied - R * i_q - w * L_d * i_d - w * flux_linkage);
+
+    // 2. Öngörülen noktadan referansa bir periyotta ulaşacak gerilim
+    float u_d = (gain * L_d / Ts) * (pHandle->state.i_d_ref - i_d_pred) + R * i_d_pred - w * L_q * i_q_pred;
+    float u_q = (gain * L_q / Ts) * (pHandle->state.i_q_ref - i_q_pred) + R * i_q_pred + w * (L_d * i_d_pred + flux_linkage);
+
+    // 3. d_q_max_voltage'a göre vektörel limit (yön korunur)
+    float u_sq = (u_d * u_d) + (u_q * u_q);
+    if(u_sq > max_volt * max_volt){
+        float k = max_volt / sqrtf(u_sq);
+        u_d *= k;
+        u_q *= k;
+    }
+
+    // Bir sonraki öngörü için gerçekten uygulanacak (limitli) gerilim saklanır
+    pHandle->state.u_d_applied = u_d;
+    pHandle->state.u_q_applied = u_q;
+
+    // Model dönen eksende sabit gerilim varsayar, duran eksende tutulan gerilim için 1.5 * w * Ts ileri döndür
+    float cd, sd;
+    FOC_Small_Angle_Cos_Sin(1.5f * w * Ts, &cd, &sd);
+
+    pHandle->state.u_d = (u_d * cd) - (u_q * sd);
+    pHandle->state.u_q = (u_d * sd) + (u_q * cd);
+}
+
+// ------------------------------------------------------------------------------
+
+// Sonlu kontrol kümeli model öngörülü kontrol (FCS-MPC).
+// Her periyotta 8 anahtarlama durumu deadbeat ile aynı ayrık modelle i[k+2]'ye kadar öngörülür ve
+//   J = (i_d_ref - i_d)^2 + (i_q_ref - i_q)^2 + fcs_switch_weight * anahtarlama_sayısı
+// maliyeti en düşük olan durum bir sonraki periyot boyunca uygulanır (modülatör yok, SVPWM atlanır).
+// Maliyet adaydan bağımsız serbest cevap + aday gerilimin doğrusal katkısı olarak ayrıştırılır;
+// döngü içinde sadece tablo okuma, çarpma-toplama ve bir karşılaştırma kalır.
+// Açı Park dönüşümünden gelir (state.cos_theta / sin_theta), ek CORDIC çağrısı yapılmaz.
+void FOC_FCS_MPC_Control(FOC_Handle_t *pHandle){
+    float Ts = pHandle->config.Ts;
+    float R = pHandle->config.R_phase;
+    float L_d = pHandle->state.L_d_sched;
+    float L_q = pHandle->state.L_q_sched;
+    float flux_linkage = pHandle->state.flux_sched;
+    float w = pHandle->input.w_rad_s;
+    float U_DC = pHandle->input.U_bat;
+    float weight = pHandle->config.fcs_switch_weight;
+    float g_d = Ts / L_d;
+    float g_q = Ts / L_q;
+    uint32_t prev = pHandle->state.fcs_state;
+
+    // Uygulanan gerilim periyot ortasındaki açıyla döndürülür: [k, k+1] için theta + 0.5*w*Ts,
+    // [k+1, k+2] için theta + 1.5*w*Ts (küçük açı serisi)
+    float cd, sd;
+    FOC_Small_Angle_Cos_Sin(0.5f * w * Ts, &cd, &sd);
+    float c1 = (pHandle->state.cos_theta * cd) - (pHandle->state.sin_theta * sd);
+    float s1 = (pHandle->state.sin_theta * cd) + (pHandle->state.cos_theta * sd);
+    // Açı iki katına (w * Ts ileri)
+    float c2d = 1.0f - 2.0f * sd * sd;
+    float s2d = 2.0f * sd * cd;
+    float c2 = (c1 * c2d) - (s1 * s2d);
+    float s2 = (s1 * c2d) + (c1 * s2d);
+
+    // 1. Hesaplama gecikmesi kompanzasyonu: şu an uygulanan durumla i[k+1]
+    float v_a = U_DC * FOC_FCS_V_ALPHA[prev];
+    float v_b = U_DC * FOC_FCS_V_BETA[prev];
+    float v_d = (v_a * c1) + (v_b * s1);
+    float v_q = (v_b * c1) - (v_a * s1);
+    float i_d = pHandle->state.i_d;
+    float i_q = pHandle->state.i_q;
+    float i_d1 = i_d + g_d * (v_d - R * i_d + w * L_q * i_q);
+    float i_q1 = i_q + g_q * (v_q - R * i_q - w * L_d * i_d - w * flux_linkage);
+
+    // 2. Serbest cevap hatası (aday gerilim sıfırken i[k+2] hatası)
+    float e_d0 = pHandle->state.i_d_ref - (i_d1 + g_d * (-R * i_d1 + w * L_q * i_q1));
+    float e_q0 = pHandle->state.i_q_ref - (i_q1 + g_q * (-R * i_q1 - w * L_d * i_d1 - w * flux_linkage));
+
+    // Aday gerilimin (alpha, beta) -> hata katkısı katsayıları
+    float kd_a = g_d * U_DC * c2;
+    float kd_b = g_d * U_DC * s2;
+    float kq_a = -g_q * U_DC * s2;
+    float kq_b = g_q * U_DC * c2;
+
+    // 3. 8 adayın değerlendirilmesi (sabit iterasyon sayısı)
+    uint32_t best = prev;
+    float best_cost = 3.4e38f;
+    for(uint32_t n = 0; n < 8U; n++){
+        float e_d = e_d0 - (kd_a * FOC_FCS_V_ALPHA[n]) - (kd_b * FOC_FCS_V_BETA[n]);
+        float e_q = e_q0 - (kq_a * FOC_FCS_V_ALPHA[n]) - (kq_b * FOC_FCS_V_BETA[n]);
+        float cost = (e_d * e_d) + (e_q * e_q) + (weight * (float)FOC_FCS_SWITCH_COUNT[n ^ prev]);
+
+        best = (cost < best_cost) ? n : best;
+        best_cost = (cost < best_cost) ? cost : best_cost;
+    }
+
+    pHandle->state.fcs_state = (uint8_t)best;
+
+    // Akı zayıflatma ve izleme için seçilen gerilimin dq karşılığı
+    v_a = U_DC * FOC_FCS_V_ALPHA[best];
+    v_b = U_DC * FOC_FCS_V_BETA[best];
+    pHandle->state.u_d = (v_a * c2) + (v_b * s2);
+    pHandle->state.u_q = (v_b * c2) - (v_a * s2);
+
+    pHandle->output.duty_a = (float)(best & 1U);
+    pHandle->output.duty_b = (float)((best >> 1) & 1U);
+    pHandle->output.duty_c = (float)((best >> 2) & 1U);
+}
+
+// ------------------------------------------------------------------------------
+
 void FOC_Inverse_Clark_Park_Transform(FOC_Handle_t *pHandle){
     float u_d = pHandle->state.u_d;
     float u_q = pHandle->state.u_q;
@@ -172,6 +812,8 @@ void FOC_Inverse_Clark_Park_Transform(FOC_Handle_t *pHandle){
     float sin_val, cos_val;
 
     FOC_G4_Cos_Sin_Calculate(alpha_rad, &cos_val, &sin_val);
+    pHandle->state.cos_theta = cos_val;
+    pHandle->state.sin_theta = sin_val;
 
     // Inverse Park (d,q -> alpha, beta)
     pHandle->state.u_x = (u_d * cos_val) - (u_q * sin_val); // Alpha
@@ -180,6 +822,173 @@ void FOC_Inverse_Clark_Park_Transform(FOC_Handle_t *pHandle){
 
 // ------------------------------------------------------------------------------
 
+// Referans vektör altıgenin dışındaysa aşırı modülasyon uygular (Mod I: genlik kompanzasyonlu kırpma,
+// Mod II: köşede tutma). Lineer bölgede vektöre dokunmaz.
+static void FOC_Overmodulation(float *U_alpha, float *U_beta, float U_DC){
+    float a = *U_alpha;
+    float b = *U_beta;
+    float m = sqrtf(a * a + b * b) / U_DC;
+
+    if(m <= FOC_OVM_M_LINEAR) return;
+
+    if(m < FOC_OVM_M_MODE_II){
+        // Mod I: genliği tablodan büyüt, sonra altıgene faz korunarak kırp
+        float scale = FOC_Table_Interp(FOC_OVM_MODE_I_TABLE, FOC_OVM_TABLE_SIZE, m - FOC_OVM_M_LINEAR, FOC_OVM_MODE_I_INV_STEP) / m;
+        a *= scale;
+        b *= scale;
+    }
+    else{
+        // Mod II: vektör köşeye yakınken köşede tutulur, kalan açı kenar boyunca sıkıştırılır
+        float hold = FOC_Table_Interp(FOC_OVM_MODE_II_TABLE, FOC_OVM_TABLE_SIZE, m - FOC_OVM_M_MODE_II, FOC_OVM_MODE_II_INV_STEP);
+        float angle = atan2f(b, a);
+        if(angle < 0.0f) angle += 6.283185482f;
+
+        float base = floorf(angle * 0.9549297f) * 1.0471976f; // 60 derecelik sektör başlangıcı (köşe)
+        float phi = angle - base;
+        float phi_out;
+
+        if(phi < hold) phi_out = 0.0f;
+        else if(phi >= (1.0471976f - hold)) phi_out = 1.0471976f;
+        else phi_out = (phi - hold) * 1.0471976f / (1.0471976f - 2.0f * hold);
+
+        FOC_G4_Cos_Sin_Calculate(base + phi_out, &a, &b); // Birim vektör, altıgene aşağıda ölçeklenir
+    }
+
+    // Altıgen sınırı: faz gerilimleri arasındaki en büyük fark U_DC'yi aşamaz
+    float Va = a;
+    float Vb = (-0.5f * a) + (0.8660254f * b);
+    float Vc = (-0.5f * a) - (0.8660254f * b);
+    float V_max = fmaxf(Va, fmaxf(Vb, Vc));
+    float V_min = fminf(Va, fminf(Vb, Vc));
+    float span = V_max - V_min;
+
+    if(span > U_DC || m >= FOC_OVM_M_MODE_II){
+        float k = U_DC / span;
+        a *= k;
+        b *= k;
+    }
+
+    *U_alpha = a;
+    *U_beta = b;
+}
+
+// ------------------------------------------------------------------------------
+
+// DPWM0/DPWM2 için: referans psi kadar döndürülmüş gibi karar verilir, böylece kenetleme penceresi
+// 30 derece kayar. Dönen değer true ise en yüksek faz üst raya, false ise en düşük faz alt raya kenetlenir.
+static bool FOC_DPWM_Clamp_Max(float U_alpha, float U_beta, float cos_psi, float sin_psi){
+    float a = (U_alpha * cos_psi) - (U_beta * sin_psi);
+    float b = (U_alpha * sin_psi) + (U_beta * cos_psi);
+
+    float Va = a;
+    float Vb = (-0.5f * a) + (0.8660254f * b);
+    float Vc = (-0.5f * a) - (0.8660254f * b);
+
+    // Orta faz negatifse en büyük mutlak değer pozitif taraftadır
+    return (fmaxf(Va, fmaxf(Vb, Vc)) + fminf(Va, fminf(Vb, Vc))) >= 0.0f;
+}
+
+// ------------------------------------------------------------------------------
+
+// DPWM_AUTO için: akım ve gerilim vektörleri arasındaki açıya göre kenetleme penceresini seçer.
+// Pencere akım tepe noktasına ortalandığında kenetlenen faz en büyük akımı taşır, anahtarlama kaybı en aza iner.
+// ±15 derece sınırında histerezis vardır: açı sınırda gürültülü kalırsa seçim her periyot değişip kenetleme
+// penceresini 30 derece ileri geri atlatmaz. Önceki seçim, sınır 3 derece aşılana kadar korunur.
+static FOC_Modulation_t FOC_DPWM_Auto_Select(FOC_Handle_t *pHandle, float U_DC){
+    float u_d = pHandle->state.u_d;
+    float u_q = pHandle->state.u_q;
+    float i_d = pHandle->state.i_d_ref;
+    float i_q = pHandle->state.i_q_ref;
+
+    float mod_index = sqrtf(u_d * u_d + u_q * u_q) / (U_DC * FOC_OVM_M_SIX_STEP);
+    if(mod_index < FOC_DPWM_AUTO_MIN_MI){
+        pHandle->state.dpwm_auto = FOC_MOD_SVPWM;
+        return FOC_MOD_SVPWM; // Düşük indekste DPWM akım dalgalanmasını artırır
+    }
+
+    // cross = |u||i| sin(phi), dot = |u||i| cos(phi), phi = akım açısı - gerilim açısı
+    float cross = (u_d * i_q) - (u_q * i_d);
+    float dot = (u_d * i_d) + (u_q * i_q);
+
+    // Rejeneratif çalışmada akım ters yönlüdür, kenetleme simetrisi nedeniyle -i ile değerlendirilir
+    if(dot < 0.0f){
+        cross = -cross;
+        dot = -dot;
+    }
+
+    FOC_Modulation_t previous = pHandle->state.dpwm_auto;
+    FOC_Modulation_t selected;
+
+    if(previous == FOC_MOD_DPWM0 && cross < -FOC_DPWM_AUTO_TAN_LEAVE * dot) selected = FOC_MOD_DPWM0;
+    else if(previous == FOC_MOD_DPWM2 && cross > FOC_DPWM_AUTO_TAN_LEAVE * dot) selected = FOC_MOD_DPWM2;
+    else if(previous == FOC_MOD_DPWM1 && fabsf(cross) <= FOC_DPWM_AUTO_TAN_ENTER * dot) selected = FOC_MOD_DPWM1;
+    else if(cross < -0.2679492f * dot) selected = FOC_MOD_DPWM0; // phi < -15 derece (akım geride)
+    else if(cross >  0.2679492f * dot) selected = FOC_MOD_DPWM2; // phi > +15 derece (akım ileride)
+    else selected = FOC_MOD_DPWM1;
+
+    pHandle->state.dpwm_auto = selected;
+    return selected;
+}
+
+// ------------------------------------------------------------------------------
+
+// Sıfır geçişinde duty'nin zıplamaması için doğrusal bölgeli işaret fonksiyonu (-1 ... +1)
+static float FOC_Smooth_Sign(float x){
+    if(x > 1.0f) return 1.0f;
+    if(x < -1.0f) return -1.0f;
+    return x;
+}
+
+// Ölü zaman ve anahtar düşümü kompanzasyonu: faz başına ortalama gerilim hatası, kırpılmamış duty'lere eklenir.
+// Kompanzasyon aşırı modülasyon ve sıfır bileşeni seçiminden sonra, duty kırpmasından önce yapılır.
+// Rayda duran faz (DPWM ile kenetlenen faz ya da aşırı modülasyonda altıgen kenarına oturan faz) periyot
+// boyunca anahtarlanmaz; ölü zaman hatası yoktur, sadece iletim düşümü vardır. Bu faz raydan çekilmez
+// (gereksiz bir darbe ve yeni bir ölü zaman hatası üretirdi), düşümü anahtarlanan fazlara ters işaretle
+// eklenerek hat gerilimlerinde karşılanır.
+static void FOC_Dead_Time_Compensation(const FOC_Handle_t *pHandle, float U_DC, float duty[3]){
+    float band = pHandle->config.dtc_current_band;
+    if(band < 0.01f) band = 0.01f;
+
+    // Bir periyottaki ortalama gerilim hatası (duty cinsinden)
+    // Anahtarlanan faz: sign(i) * (Td * fsw + (V_sw + V_d) / (2 * U_DC)), rayda duran faz: sign(i) * (V_sw + V_d) / (2 * U_DC)
+    float drop_error = (pHandle->config.V_switch_drop + pHandle->config.V_diode_drop) / (2.0f * U_DC);
+    float switch_error = (pHandle->config.dead_time * pHandle->config.pwm_frequency) + drop_error;
+    float inv_band = 1.0f / band;
+
+    // Akım yönü referans akımdan alınır, böylece sıfır geçişinde ölçüm gürültüsü kompanzasyonu titretmez
+    float i_d_ref = pHandle->state.i_d_ref;
+    float i_q_ref = pHandle->state.i_q_ref;
+    float i_alpha_ref = (i_d_ref * pHandle->state.cos_theta) - (i_q_ref * pHandle->state.sin_theta);
+    float i_beta_ref  = (i_d_ref * pHandle->state.sin_theta) + (i_q_ref * pHandle->state.cos_theta);
+
+    float i_phase[3];
+    i_phase[0] = i_alpha_ref;
+    i_phase[1] = (-0.5f * i_alpha_ref) + (0.8660254f * i_beta_ref);
+    i_phase[2] = (-0.5f * i_alpha_ref) - (0.8660254f * i_beta_ref);
+
+    // Akım fazdan dışarı akıyorsa gerilim kaybolur -> duty artırılır
+    bool rail[3];
+    float rail_shift = 0.0f;
+    uint8_t rail_count = 0;
+
+    for(uint8_t x = 0; x < 3U; x++){
+        rail[x] = (duty[x] <= FOC_DTC_RAIL_DUTY) || (duty[x] >= (1.0f - FOC_DTC_RAIL_DUTY));
+        if(rail[x]){
+            rail_shift += drop_error * FOC_Smooth_Sign(i_phase[x] * inv_band);
+            rail_count++;
+        }
+    }
+    if(rail_count > 1U) rail_shift *= 0.5f; // İki faz rayda: tek anahtarlanan faz ikisine göre ortalanır
+
+    for(uint8_t x = 0; x < 3U; x++){
+        if(rail[x] == false){
+            duty[x] += (switch_error * FOC_Smooth_Sign(i_phase[x] * inv_band)) - rail_shift;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+
 void FOC_SVPWM_Calculation(FOC_Handle_t *pHandle){
     // Midpoint Clamp Yöntemi (Space Vector Generator)
     float U_alpha = pHandle->state.u_x;
@@ -188,32 +997,87 @@ void FOC_SVPWM_Calculation(FOC_Handle_t *pHandle){
 
     if(U_DC < 1.0f) U_DC = 12.0f; // Sıfıra bölme koruması
 
-    // 1. Inverse Clark ile 3 faz potansiyellerini (Va, Vb, Vc) bul
+    // 1. Inverse Clark ile referansın 3 faz potansiyellerini (Va, Vb, Vc) bul
     float Va = U_alpha;
     float Vb = (-0.5f * U_alpha) + (0.8660254f * U_beta);
     float Vc = (-0.5f * U_alpha) - (0.8660254f * U_beta);
 
-    // 2. Min ve Max faz voltajlarını bul
+    // 2. Min ve Max faz voltajlarını ve fazlarını bul
     float V_max = Va;
     float V_min = Va;
+    uint8_t phase_max = 0;
+    uint8_t phase_min = 0;
+
+    if (Vb > V_max) { V_max = Vb; phase_max = 1; }
+    if (Vc > V_max) { V_max = Vc; phase_max = 2; }
+    if (Vb < V_min) { V_min = Vb; phase_min = 1; }
+    if (Vc < V_min) { V_min = Vc; phase_min = 2; }
+
+    // 3. Kenetlenecek fazı seç
+    // Midpoint clamp her periyotta üç kolu da anahtarlar. DPWM modlarında bir faz raya kenetlenir,
+    // o faz periyot boyunca anahtarlanmaz ve anahtarlama sayısı üçte bir azalır.
+    FOC_Modulation_t modulation = pHandle->config.modulation;
+    bool clamp = true;      // DPWM: bir faz raya kenetlenir
+    bool clamp_max = false; // true: en yüksek faz üst raya, false: en düşük faz alt raya
+
+    if(modulation == FOC_MOD_DPWM_AUTO){
+        modulation = FOC_DPWM_Auto_Select(pHandle, U_DC);
+    }
+
+    switch(modulation){
+        case FOC_MOD_DPWMMIN: clamp_max = false; break;
+        case FOC_MOD_DPWMMAX: clamp_max = true; break;
+        case FOC_MOD_DPWM0:   clamp_max = FOC_DPWM_Clamp_Max(U_alpha, U_beta, 0.8660254f, -0.5f); break; // psi = -30
+        case FOC_MOD_DPWM1:   clamp_max = ((V_max + V_min) >= 0.0f); break;
+        case FOC_MOD_DPWM2:   clamp_max = FOC_DPWM_Clamp_Max(U_alpha, U_beta, 0.8660254f, 0.5f); break;  // psi = +30
+        case FOC_MOD_DPWM3:   clamp_max = ((V_max + V_min) < 0.0f); break;
+        default:              clamp = false; break; // Midpoint (SVPWM)
+    }
+
+    uint8_t clamp_phase = clamp ? (clamp_max ? phase_max : phase_min) : FOC_CLAMP_NONE;
+    pHandle->state.clamp_phase = clamp_phase;
 
-    if (Vb > V_max) V_max = Vb;
-    if (Vc > V_max) V_max = Vc;
-    if (Vb < V_min) V_min = Vb;
-    if (Vc < V_min) V_min = Vc;
+    // 4. Aşırı modülasyon (sadece zarf lineer bölgenin dışına genişletildiyse)
+    if(pHandle->config.max_mod_index > FOC_OVM_MI_LINEAR){
+        FOC_Overmodulation(&U_alpha, &U_beta, U_DC);
+    }
+
+    // 5. Son vektörün faz potansiyelleri ve Zero Sequence Offset
+    // Kenetlenen faz 3. adımda seçilen indekstir, aşırı modülasyon sonrası sıralama değişse de aynı faz kenetlenir.
+    float V[3];
+    V[0] = U_alpha;
+    V[1] = (-0.5f * U_alpha) + (0.8660254f * U_beta);
+    V[2] = (-0.5f * U_alpha) - (0.8660254f * U_beta);
+
+    float V_offset;
+    if(clamp){
+        V_offset = clamp_max ? ((0.5f * U_DC) - V[clamp_phase]) : ((-0.5f * U_DC) - V[clamp_phase]);
+    }
+    else{
+        V_max = fmaxf(V[0], fmaxf(V[1], V[2]));
+        V_min = fminf(V[0], fminf(V[1], V[2]));
+        V_offset = -0.5f * (V_max + V_min);
+    }
 
-    // 3. Zero Sequence Offset (Midpoint) hesapla
-    float V_offset = -0.5f * (V_max + V_min);
+    // 6. Duty Cycle Hesapla (0.0 ile 1.0 arası)
+    float duty[3];
+    duty[0] = ((V[0] + V_offset) / U_DC) + 0.5f;
+    duty[1] = ((V[1] + V_offset) / U_DC) + 0.5f;
+    duty[2] = ((V[2] + V_offset) / U_DC) + 0.5f;
 
-    // 4. Duty Cycle Hesapla (0.0 ile 1.0 arası)
-    pHandle->output.duty_a = ((Va + V_offset) / U_DC) + 0.5f;
-    pHandle->output.duty_b = ((Vb + V_offset) / U_DC) + 0.5f;
-    pHandle->output.duty_c = ((Vc + V_offset) / U_DC) + 0.5f;
+    // 7. Ölü zaman kompanzasyonu, kırpmadan önce
+    if(pHandle->config.dead_time_comp == true){
+        FOC_Dead_Time_Compensation(pHandle, U_DC, duty);
+    }
 
     // Saturation (0-1 arası sınırla)
-    if(pHandle->output.duty_a > 1.0f) pHandle->output.duty_a = 1.0f; else if(pHandle->output.duty_a < 0.0f) pHandle->output.duty_a = 0.0f;
-    if(pHandle->output.duty_b > 1.0f) pHandle->output.duty_b = 1.0f; else if(pHandle->output.duty_b < 0.0f) pHandle->output.duty_b = 0.0f;
-    if(pHandle->output.duty_c > 1.0f) pHandle->output.duty_c = 1.0f; else if(pHandle->output.duty_c < 0.0f) pHandle->output.duty_c = 0.0f;
+    for(uint8_t x = 0; x < 3U; x++){
+        if(duty[x] > 1.0f) duty[x] = 1.0f; else if(duty[x] < 0.0f) duty[x] = 0.0f;
+    }
+
+    pHandle->output.duty_a = duty[0];
+    pHandle->output.duty_b = duty[1];
+    pHandle->output.duty_c = duty[2];
 }
 
 // ------------------------------------------------------------------------------
@@ -256,27 +1120,49 @@ void FOC_Current_Controller(FOC_Handle_t *pHandle){
         // Integralleri resetle ki açılınca zıplamasın
         pHandle->state.i_d_memory = 0.0f;
         pHandle->state.i_q_memory = 0.0f;
+        pHandle->state.fw_integrator = 0.0f;
+        pHandle->state.u_d_applied = 0.0f;
+        pHandle->state.u_q_applied = 0.0f;
+        pHandle->state.fcs_state = 0;
         return;
     }
 
     // 1. Ölçümleri al ve Dönüştür (Clarke & Park)
     FOC_Clark_Park_Transform(pHandle);
 
-    // 2. İstenen torku akıma çevir
+    // 2. Voltaj limiti (akı zayıflatma bu döngünün U_bat değeriyle hesaplanan limiti kullanır)
+    FOC_Max_Voltage(pHandle);
+
+    // 3. İstenen torku akıma çevir
     FOC_Torq_Reference_Transform(pHandle);
 
-    // 3. Voltaj Limitlerini ve Decoupling hesapla
-    FOC_Max_Voltage(pHandle);
+    // 4. Decoupling hesapla (doyuma göre zamanlanmış parametrelerle)
+    FOC_Parameter_Schedule(pHandle);
     FOC_Voltage_Decoupling(pHandle);
 
-    // 4. PI Kontrolcüleri Çalıştır
-    FOC_Direct_Current_Control_d(pHandle);
-    FOC_Direct_Current_Control_q(pHandle);
+    // 5. Akım Regülatörünü Çalıştır
+    switch(pHandle->config.current_regulator){
+        case FOC_REG_COMPLEX_VECTOR:
+            FOC_Complex_Vector_Current_Control(pHandle);
+            break;
+        case FOC_REG_DEADBEAT:
+            FOC_Deadbeat_Current_Control(pHandle);
+            break;
+        case FOC_REG_FCS_MPC:
+            // Anahtarlama durumunu doğrudan seçer, Inverse Park / SVPWM / ölü zaman kompanzasyonu atlanır
+            FOC_FCS_MPC_Control(pHandle);
+            return;
+        default:
+            FOC_Direct_Current_Control_d(pHandle);
+            FOC_Direct_Current_Control_q(pHandle);
+            FOC_Voltage_Vector_Limit(pHandle);
+            break;
+    }
 
-    // 5. Ters Dönüşüm (Inverse Park) -> (u_d, u_q) to (u_alpha, u_beta)
+    // 6. Ters Dönüşüm (Inverse Park) -> (u_d, u_q) to (u_alpha, u_beta)
     FOC_Inverse_Clark_Park_Transform(pHandle);
 
-    // 6. PWM Duty Hesapla (SVPWM)
+    // 7. PWM Duty Hesapla (SVPWM, dead_time_comp açıksa ölü zaman kompanzasyonu dahil)
     FOC_SVPWM_Calculation(pHandle);
 }
 
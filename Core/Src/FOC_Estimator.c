@@ -0,0 +1,309 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül R_phase, L_d, L_q ve flux_linkage parametrelerini çalışma sırasında özyinelemeli en küçük kareler
+// (RLS) ile tahmin eder. Bakır direnci sıcaklıkla ~%40 değişir, mıknatıs akısı ısındıkça azalır;
+// sabit config değerleri decoupling, tork doğruluğu ve gözlemcileri bozar.
+// Hesap ISR'da değil idle döngüde (main while(1)) yapılır, ISR sadece örneği halka tampona kopyalar.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// Senkron eksen gerilim denklemleri, ardışık iki tick [k-1, k] üzerinde:
+//   u_d = R * i_d + L_d * di_d/dt - w * L_q * i_q
+//   u_q = R * i_q + L_q * di_q/dt + w * L_d * i_d + w * flux
+// 1. d ekseni RLS (2 parametre): y = u_d + w * L_q_tahmin * i_q,   phi = [i_d, di_d/dt]        -> R, L_d
+// 2. q ekseni RLS (3 parametre): y = u_q - w * L_d_tahmin * i_d,   phi = [i_q, di_q/dt, w]     -> R, L_q, flux
+//    Yayınlanan R q ekseninden alınır (tork akımı ile daha iyi uyarılır).
+// 3. Sayısal koşullama için her regresör nominal değerle ölçeklenir, parametreler nominale oran (~1.0) olur.
+// 4. Unutma faktörü (forgetting) eski örneklerin ağırlığını azaltır. Uyarım yokken kovaryans büyür;
+//    izi FOC_EST_P_TRACE_MAX'ı aşarsa o adımda unutma uygulanmaz.
+// 5. Tahminler FOC_EST_x_MIN/MAX oranları içindeyse dört değer FOC_Param_Set + FOC_Param_Commit ile tek commit
+//    olarak yayınlanır (en fazla FOC_EST_PUBLISH_MS'de bir). FOC_Param_Process MTPA tablosunu ve doyma haritası
+//    nominal 1/L değerlerini idle'da yeniden hesaplar, akım ISR'ı bankayı tick başında bütün olarak uygular.
+//    Host'un gölge ayarda bekleyen değişikliği varsa yayın ertelenir (host'un commit'ine karışılmaz).
+// NOT: Gerilim olarak ölçülen değil komut gerilimi kullanılır. Ölü zaman kompanzasyonu kapalıysa
+//      inverter hatası R tahminine eklenir (düşük akımda R yüksek görünür).
+// NOT: FOC_PWM varsayılan modda tick k'de hesaplanan gerilim [k+1, k+2] aralığında uygulanır,
+//      bu yüzden [k-1, k] aralığı için k-2'de hesaplanan gerilim kullanılır.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. Config (nominal motor parametreleri ve Ts) doldurulduktan ve FOC_Param_Init'ten sonra:
+//    FOC_Estimator_Init(&hfoc, 4, 0.999f); // 4 tick'te bir örnek, unutma faktörü 0.999
+// 2. config.online_estimation = true ile tahmin ve yayınlama açılır.
+// 3. Akım ölçümü ISR'ı içinde:
+//    FOC_Current_Controller(&hfoc);
+//    FOC_Estimator_Sample(&hfoc);
+// 4. main while(1) içinde FOC_Estimator_Process() çağrılır.
+// 5. Sonuçlar ve sayaçlar FOC_Estimator_Get_Result() ile okunur.
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_Estimator.h"
+#include "FOC_Param.h"
+#include "stm32g4xx_hal.h"
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+#define FOC_EST_BUFFER_MASK (FOC_EST_BUFFER_SIZE - 1U)
+
+static FOC_Handle_t *FOC_Est_Handle = 0;
+
+// ISR -> idle halka tamponu (tek üretici / tek tüketici, kilitsiz)
+static FOC_Est_Sample_t FOC_Est_Buffer[FOC_EST_BUFFER_SIZE];
+static volatile uint32_t FOC_Est_Head = 0; // Sadece ISR yazar
+static volatile uint32_t FOC_Est_Tail = 0; // Sadece idle yazar
+
+// ISR tarafı geçmişi
+static float FOC_Est_U_d_Hist[2]; // [0]: k-1'de, [1]: k-2'de hesaplanan gerilim
+static float FOC_Est_U_q_Hist[2];
+static float FOC_Est_I_d_Prev;
+static float FOC_Est_I_q_Prev;
+static uint32_t FOC_Est_Valid = 0;    // Geçmişin dolu olduğu tick sayısı
+static uint32_t FOC_Est_Counter = 0;  // Decimation sayacı
+static uint32_t FOC_Est_Decimation = 1;
+
+// RLS durumu (parametreler nominale oran)
+static float FOC_Est_Theta_d[2];
+static float FOC_Est_P_d[2 * 2];
+static float FOC_Est_Theta_q[3];
+static float FOC_Est_P_q[3 * 3];
+static float FOC_Est_Lambda = 1.0f;
+
+// Nominal değerler (Init anındaki config)
+static float FOC_Est_R_Nom;
+static float FOC_Est_L_d_Nom;
+static float FOC_Est_L_q_Nom;
+static float FOC_Est_Flux_Nom;
+
+static FOC_Est_Result_t FOC_Est_Result;
+static uint32_t FOC_Est_Publish_Tick = 0; // Son FOC_Param yayınının HAL tick'i
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+// n parametreli RLS adımı (n <= 3), P satır öncelikli n x n simetrik matris
+static void FOC_Est_RLS_Update(float *theta, float *P, const float *phi, float y, uint32_t n, float lambda){
+    float P_phi[3];
+    float K[3];
+    float denom = lambda;
+    float error = y;
+    float trace = 0.0f;
+
+    for(uint32_t i = 0; i < n; i++){
+        P_phi[i] = 0.0f;
+        for(uint32_t j = 0; j < n; j++){
+            P_phi[i] += P[(i * n) + j] * phi[j];
+        }
+        denom += phi[i] * P_phi[i];
+        error -= phi[i] * theta[i];
+    }
+
+    for(uint32_t i = 0; i < n; i++){
+        K[i] = P_phi[i] / denom;
+        theta[i] += K[i] * error;
+        trace += P[(i * n) + i];
+    }
+
+    // Uyarım yoksa kovaryans sınırsız büyümesin
+    float inv_lambda = (trace > FOC_EST_P_TRACE_MAX) ? 1.0f : (1.0f / lambda);
+
+    for(uint32_t i = 0; i < n; i++){
+        for(uint32_t j = i; j < n; j++){
+            float p = (P[(i * n) + j] - (K[i] * P_phi[j])) * inv_lambda;
+            P[(i * n) + j] = p;
+            P[(j * n) + i] = p; // Simetriyi koru
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Estimator_Init(FOC_Handle_t *pHandle, uint8_t decimation, float forgetting){
+    FOC_Est_Handle = pHandle;
+    FOC_Est_Decimation = (decimation == 0U) ? 1U : decimation;
+    FOC_Est_Lambda = forgetting;
+
+    FOC_Est_R_Nom = pHandle->config.R_phase;
+    FOC_Est_L_d_Nom = pHandle->config.L_d;
+    FOC_Est_L_q_Nom = pHandle->config.L_q;
+    FOC_Est_Flux_Nom = pHandle->config.flux_linkage;
+
+    for(uint32_t i = 0; i < 4U; i++) FOC_Est_P_d[i] = 0.0f;
+    for(uint32_t i = 0; i < 9U; i++) FOC_Est_P_q[i] = 0.0f;
+    for(uint32_t i = 0; i < 2U; i++){
+        FOC_Est_Theta_d[i] = 1.0f;
+        FOC_Est_P_d[(i * 2U) + i] = 1.0f;
+    }
+    for(uint32_t i = 0; i < 3U; i++){
+        FOC_Est_Theta_q[i] = 1.0f;
+        FOC_Est_P_q[(i * 3U) + i] = 1.0f;
+    }
+
+    FOC_Est_Valid = 0;
+    FOC_Est_Counter = 0;
+    FOC_Est_Head = 0;
+    FOC_Est_Tail = 0;
+
+    FOC_Est_Result.R_phase = FOC_Est_R_Nom;
+    FOC_Est_Result.L_d = FOC_Est_L_d_Nom;
+    FOC_Est_Result.L_q = FOC_Est_L_q_Nom;
+    FOC_Est_Result.flux_linkage = FOC_Est_Flux_Nom;
+    FOC_Est_Result.sample_count = 0;
+    FOC_Est_Result.overflow_count = 0;
+    FOC_Est_Result.reject_count = 0;
+    FOC_Est_Result.publish_count = 0;
+    FOC_Est_Result.defer_count = 0;
+    FOC_Est_Publish_Tick = HAL_GetTick();
+}
+
+// ------------------------------------------------------------------------------
+
+// ISR tarafı: sadece kopyalama, hesap yok
+void FOC_Estimator_Sample(FOC_Handle_t *pHandle){
+    if((FOC_Est_Handle != pHandle) || (pHandle->config.online_estimation == false)){
+        FOC_Est_Valid = 0;
+        return;
+    }
+
+    if(FOC_Est_Valid >= 2U){
+        FOC_Est_Counter++;
+        if(FOC_Est_Counter >= FOC_Est_Decimation){
+            uint32_t head = FOC_Est_Head;
+            FOC_Est_Counter = 0;
+
+            if((head - FOC_Est_Tail) < FOC_EST_BUFFER_SIZE){
+                FOC_Est_Sample_t *pSample = &FOC_Est_Buffer[head & FOC_EST_BUFFER_MASK];
+                pSample->u_d = FOC_Est_U_d_Hist[1];
+                pSample->u_q = FOC_Est_U_q_Hist[1];
+                pSample->i_d_prev = FOC_Est_I_d_Prev;
+                pSample->i_q_prev = FOC_Est_I_q_Prev;
+                pSample->i_d = pHandle->state.i_d;
+                pSample->i_q = pHandle->state.i_q;
+                pSample->w_rad_s = pHandle->input.w_rad_s;
+
+                __DMB(); // Örnek yazılmadan head yayınlanmasın
+                FOC_Est_Head = head + 1U;
+            }
+            else{
+                FOC_Est_Result.overflow_count++;
+            }
+        }
+    }
+    else{
+        FOC_Est_Valid++;
+    }
+
+    FOC_Est_U_d_Hist[1] = FOC_Est_U_d_Hist[0];
+    FOC_Est_U_q_Hist[1] = FOC_Est_U_q_Hist[0];
+    FOC_Est_U_d_Hist[0] = pHandle->state.u_d;
+    FOC_Est_U_q_Hist[0] = pHandle->state.u_q;
+    FOC_Est_I_d_Prev = pHandle->state.i_d;
+    FOC_Est_I_q_Prev = pHandle->state.i_q;
+}
+
+// ------------------------------------------------------------------------------
+
+// Idle tarafı: tampondaki tüm örnekleri işler, geçerliyse sonucu config'e yayınlar
+void FOC_Estimator_Process(void){
+    FOC_Handle_t *pHandle = FOC_Est_Handle;
+    bool updated = false;
+
+    if(pHandle == 0){
+        return;
+    }
+
+    float Ts = pHandle->config.Ts;
+    float kR = FOC_Est_R_Nom;
+    float kL_d = FOC_Est_L_d_Nom / Ts;
+    float kL_q = FOC_Est_L_q_Nom / Ts;
+
+    while(FOC_Est_Tail != FOC_Est_Head){
+        __DMB(); // head okunduktan sonra örnek okunmalı
+        FOC_Est_Sample_t sample = FOC_Est_Buffer[FOC_Est_Tail & FOC_EST_BUFFER_MASK];
+        FOC_Est_Tail = FOC_Est_Tail + 1U;
+
+        float i_d = 0.5f * (sample.i_d + sample.i_d_prev);
+        float i_q = 0.5f * (sample.i_q + sample.i_q_prev);
+        float w = sample.w_rad_s;
+        float phi[3];
+
+        // d ekseni: [R, L_d]
+        phi[0] = kR * i_d;
+        phi[1] = kL_d * (sample.i_d - sample.i_d_prev);
+        float y_d = sample.u_d + (w * FOC_Est_Theta_q[1] * FOC_Est_L_q_Nom * i_q);
+        FOC_Est_RLS_Update(FOC_Est_Theta_d, FOC_Est_P_d, phi, y_d, 2U, FOC_Est_Lambda);
+
+        // q ekseni: [R, L_q, flux]
+        phi[0] = kR * i_q;
+        phi[1] = kL_q * (sample.i_q - sample.i_q_prev);
+        phi[2] = w * FOC_Est_Flux_Nom;
+        float y_q = sample.u_q - (w * FOC_Est_Theta_d[1] * FOC_Est_L_d_Nom * i_d);
+        FOC_Est_RLS_Update(FOC_Est_Theta_q, FOC_Est_P_q, phi, y_q, 3U, FOC_Est_Lambda);
+
+        FOC_Est_Result.sample_count++;
+        updated = true;
+    }
+
+    if(updated == false){
+        return;
+    }
+
+    float r = FOC_Est_Theta_q[0];
+    float l_d = FOC_Est_Theta_d[1];
+    float l_q = FOC_Est_Theta_q[1];
+    float flux = FOC_Est_Theta_q[2];
+
+    FOC_Est_Result.R_phase = r * FOC_Est_R_Nom;
+    FOC_Est_Result.L_d = l_d * FOC_Est_L_d_Nom;
+    FOC_Est_Result.L_q = l_q * FOC_Est_L_q_Nom;
+    FOC_Est_Result.flux_linkage = flux * FOC_Est_Flux_Nom;
+
+    // Sınır kontrolü: herhangi biri makul aralık dışındaysa hiçbiri yayınlanmaz
+    if((r < FOC_EST_R_MIN) || (r > FOC_EST_R_MAX) ||
+       (l_d < FOC_EST_L_MIN) || (l_d > FOC_EST_L_MAX) ||
+       (l_q < FOC_EST_L_MIN) || (l_q > FOC_EST_L_MAX) ||
+       (flux < FOC_EST_FLUX_MIN) || (flux > FOC_EST_FLUX_MAX)){
+        FOC_Est_Result.reject_count++;
+        return;
+    }
+
+    if(pHandle->config.online_estimation == false){
+        return;
+    }
+
+    uint32_t now = HAL_GetTick();
+    if((now - FOC_Est_Publish_Tick) < FOC_EST_PUBLISH_MS){
+        return;
+    }
+    if(FOC_Param_Get_Status()->staged != 0U){
+        FOC_Est_Result.defer_count++;
+        return;
+    }
+    FOC_Est_Publish_Tick = now;
+
+    // Dört parametre tek commit'te (host birimiyle: mOhm, uH, mWb); türetilmiş değerler FOC_Param_Process'te
+    uint8_t status = FOC_Param_Set(FOC_PARAM_R_PHASE, FOC_Est_Result.R_phase * 1.0e3f);
+    if(status == FOC_PARAM_OK) status = FOC_Param_Set(FOC_PARAM_L_D, FOC_Est_Result.L_d * 1.0e6f);
+    if(status == FOC_PARAM_OK) status = FOC_Param_Set(FOC_PARAM_L_Q, FOC_Est_Result.L_q * 1.0e6f);
+    if(status == FOC_PARAM_OK) status = FOC_Param_Set(FOC_PARAM_FLUX_LINKAGE, FOC_Est_Result.flux_linkage * 1.0e3f);
+    if(status != FOC_PARAM_OK){
+        FOC_Param_Discard(); // Aralık dışı: yarım set gölge ayarda bırakılmaz
+        FOC_Est_Result.reject_count++;
+        return;
+    }
+
+    if(FOC_Param_Commit() == FOC_PARAM_OK){
+        FOC_Est_Result.publish_count++;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+const FOC_Est_Result_t *FOC_Estimator_Get_Result(void){
+    return &FOC_Est_Result;
+}
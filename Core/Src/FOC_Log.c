@@ -0,0 +1,256 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül printf ve LOG_x makrolarının çıktısını FOC_UART bağlantısına bloklamadan taşır.
+// syscalls.c'deki zayıf _write her karakteri __io_putchar ile gönderir; HAL UART'a bağlansaydı printf
+// UART hızında beklerdi (4 Mbit/s'de 100 byte ~250 us, 5 akım tick'i). Burada _write ve LOG_x sadece
+// RAM'deki kilitsiz bir halkaya kayıt ekler; halka main döngüsünde (idle) FOC_UART çerçevelerine boşaltılır,
+// UART'a aktarımı FOC_UART'ın TX DMA'sı yapar. Halka doluysa kayıt atılır ve sayılır, çağıran hiç beklemez.
+// Aynı hat ikili telemetri taşıdığı için metin ham byte olarak değil FOC_UART_TYPE_LOG çerçevesi olarak gider.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// Halka 32 bit word'lerden oluşur. Her kayıt: [başlık][tick][veri ...]. Başlık sıfır olmayan tek bir word'dür:
+// bit 0-9 kayıt uzunluğu (word), bit 10-17 metin uzunluğu (byte), bit 18-19 tür, bit 20-23 seviye,
+// bit 24-26 argüman sayısı. Boş word 0'dır.
+// Çok üreticili ekleme (akım ISR'ı, FDCAN ISR'ı, PendSV, main aynı anda yazabilir):
+// 1. Yer ayırma: baş indeksi LDREX / STREX ile ilerletilir. Araya kesme girerse STREX başarısız olur
+//    (istisna giriş / çıkışı exclusive monitörü temizler) ve döngü yeni baş ile tekrar dener. Kesme
+//    kapatılmaz, BASEPRI değiştirilmez: akım ISR'ı da kayıt eklerken kimseyi geciktirmez.
+// 2. Kayıt halka sonuna sığmazsa kalan word'ler aynı ayırmada PAD kaydı olarak alınır, kayıt başa yazılır.
+// 3. Veri yazılır, __DMB, en son başlık yazılır (commit). Başlık yazılana kadar o word 0 kalır.
+// Tüketici (sadece FOC_Log_Process) kuyruktaki başlık 0 ise durur: yer ayırmış ama henüz yazmamış bir
+// üretici (kesilmiş main veya PendSV) sonraki kayıtların sırasını bozmaz. İşlenen kayıt sıfırlanır ve
+// kuyruk ilerletilir; böylece ayrılan her alan yazılmadan önce 0'dır.
+// Ertelenmiş biçimleme: LOG_x format işaretçisini (flash'taki string literal) ve en fazla 4 argümanı saklar,
+// snprintf idle'da çalışır. ISR maliyeti yer ayırma + 6-7 saklama (~30-40 döngü); newlib'in printf'i ISR'da
+// güvenli de değildir (reent yapısı, float biçimlemede malloc). Argümanlar 32 bit saklanır, float yoktur.
+// printf: newlib stdout'u satır tamponlu kullanır (_isatty 1). Varsayılan tampon malloc ile alınır, 512 byte
+// heap'te bu başarısız olunca stdio tamponsuz çalışır ve _write her karakter için çağrılır. FOC_Log_Init stdout'a
+// FOC_LOG_TEXT_MAX byte'lık statik tampon verir: her satır (veya dolan tampon) tek kayıt olur.
+// printf newlib stdio'su reentrant olmadığından sadece main'den kullanılmalıdır; ISR / PendSV'de LOG_x kullanılır.
+// Boşaltma: her kayıt bir FOC_UART_TYPE_LOG çerçevesidir (FOC_Log_Header_t + metin). FOC_UART TX halkası doluysa
+// kayıt halkada kalır ve bir sonraki idle turunda tekrar denenir (kayıt kaybı yalnızca log halkası dolunca olur).
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. FOC_UART_Init(&hfoc) sonrası FOC_Log_Init() çağrılır.
+// 2. main while(1) içinde FOC_Log_Process() çağrılır.
+// 3. Her bağlamda: LOG_W("akim limiti: %lu mA", (uint32_t)(i * 1000.0f)); main'de ayrıca printf("...\n").
+//    Derlemeye alınacak seviye FOC_LOG_LEVEL ile seçilir (varsayılan INFO, LOG_D kod üretmez).
+// 4. Host: Tools/foc_link/foc_link_dump ve "foc_client log <port>" log çerçevelerini metin olarak yazdırır.
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_Log.h"
+#include "FOC_Scheduler.h"
+#include "FOC_UART.h"
+#include <stdio.h>
+#include <string.h>
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+_Static_assert((FOC_LOG_RING_WORDS & (FOC_LOG_RING_WORDS - 1U)) == 0U, "Log halkası 2'nin kuvveti olmalı");
+_Static_assert(FOC_LOG_RING_WORDS <= 1024U, "Kayıt uzunluğu başlıkta 10 bit");
+_Static_assert(FOC_LOG_TEXT_MAX <= 255U, "Metin uzunluğu başlıkta 8 bit");
+_Static_assert(sizeof(FOC_Log_Header_t) + FOC_LOG_TEXT_MAX <= FOC_UART_MAX_PAYLOAD, "Log kaydı tek çerçeveye sığmalı");
+
+#define FOC_LOG_RING_MASK (FOC_LOG_RING_WORDS - 1U)
+
+#define FOC_LOG_KIND_TEXT     1U
+#define FOC_LOG_KIND_DEFERRED 2U
+#define FOC_LOG_KIND_PAD      3U
+
+#define FOC_LOG_HEADER(words, length, kind, level, argc) \
+    ((uint32_t)(words) | ((uint32_t)(length) << 10) | ((uint32_t)(kind) << 18) | \
+     ((uint32_t)(level) << 20) | ((uint32_t)(argc) << 24))
+#define FOC_LOG_WORDS(header)  ((header) & 0x3FFU)
+#define FOC_LOG_LENGTH(header) (((header) >> 10) & 0xFFU)
+#define FOC_LOG_KIND(header)   (((header) >> 18) & 0x3U)
+#define FOC_LOG_LEVEL_OF(header) (((header) >> 20) & 0xFU)
+#define FOC_LOG_ARGC(header)   (((header) >> 24) & 0x7U)
+
+static uint32_t FOC_Log_Ring[FOC_LOG_RING_WORDS];
+static uint32_t FOC_Log_Head = 0; // Ayrılan alanın sonu (serbest sayan word), üreticiler LDREX / STREX ile ilerletir
+static volatile uint32_t FOC_Log_Tail = 0; // Sadece FOC_Log_Process yazar
+static bool FOC_Log_Ready = false;
+static FOC_Log_Stats_t FOC_Log_Stats;
+static char FOC_Log_Stdout_Buffer[FOC_LOG_TEXT_MAX];
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+// Her bağlamdan güvenli sayaç artırma (üreticiler birbirini kesebilir)
+static inline void FOC_Log_Count(uint32_t *pCounter){
+    uint32_t value;
+    do{
+        value = __LDREXW(pCounter);
+    } while(__STREXW(value + 1U, pCounter) != 0U);
+}
+
+// ------------------------------------------------------------------------------
+
+// words kadar bitişik alan ayırır, yer yoksa 0. Dönen alanın word'leri 0'dır.
+static uint32_t *FOC_Log_Reserve(uint32_t words){
+    uint32_t head;
+    uint32_t pad;
+
+    do{
+        head = __LDREXW(&FOC_Log_Head);
+        pad = FOC_LOG_RING_WORDS - (head & FOC_LOG_RING_MASK);
+        if(pad >= words) pad = 0;
+        if((head + pad + words) - FOC_Log_Tail > FOC_LOG_RING_WORDS){
+            __CLREX();
+            FOC_Log_Count(&FOC_Log_Stats.dropped);
+            return 0;
+        }
+    } while(__STREXW(head + pad + words, &FOC_Log_Head) != 0U);
+
+    if(pad != 0U){
+        *(volatile uint32_t *)&FOC_Log_Ring[head & FOC_LOG_RING_MASK] = FOC_LOG_HEADER(pad, 0U, FOC_LOG_KIND_PAD, 0U, 0U);
+    }
+    return &FOC_Log_Ring[(head + pad) & FOC_LOG_RING_MASK];
+}
+
+// ------------------------------------------------------------------------------
+
+static inline void FOC_Log_Commit(uint32_t *pRecord, uint32_t header){
+    __DMB(); // Veri yazılmadan başlık görünmesin
+    *(volatile uint32_t *)pRecord = header;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Log_Deferred(uint32_t info, const char *pFormat, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3){
+    uint32_t level = info & 0xFU;
+    uint32_t argc = info >> 4;
+    uint32_t words = 3U + argc;
+    uint32_t *pRecord = FOC_Log_Reserve(words);
+
+    if(pRecord == 0) return;
+
+    pRecord[1] = FOC_Scheduler_Get_Tick();
+    pRecord[2] = (uint32_t)pFormat;
+    // Alan argc'ye göre ayrıldı: fazla argümanlar yazılmaz
+    switch(argc){
+        case 4U: pRecord[6] = a3; // fall through
+        case 3U: pRecord[5] = a2; // fall through
+        case 2U: pRecord[4] = a1; // fall through
+        case 1U: pRecord[3] = a0; // fall through
+        default: break;
+    }
+    FOC_Log_Commit(pRecord, FOC_LOG_HEADER(words, 0U, FOC_LOG_KIND_DEFERRED, level, argc));
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Log_Write(uint8_t level, const char *pText, uint32_t length){
+    bool ok = true;
+
+    while(length > 0U){
+        uint32_t n = (length > FOC_LOG_TEXT_MAX) ? FOC_LOG_TEXT_MAX : length;
+        uint32_t words = 2U + ((n + 3U) / 4U);
+        uint32_t *pRecord = FOC_Log_Reserve(words);
+
+        if(pRecord == 0){
+            ok = false;
+        }
+        else{
+            pRecord[1] = FOC_Scheduler_Get_Tick();
+            memcpy(&pRecord[2], pText, n);
+            FOC_Log_Commit(pRecord, FOC_LOG_HEADER(words, n, FOC_LOG_KIND_TEXT, level, 0U));
+        }
+        pText += n;
+        length -= n;
+    }
+    return ok;
+}
+
+// ------------------------------------------------------------------------------
+
+// syscalls.c'deki zayıf _write'ın yerine geçer: printf / puts / fwrite(stdout) buraya gelir.
+// Bloklamaz; halkaya sığmayan kısım atılır ama stdio'nun tekrar denememesi için len döner.
+int _write(int file, char *ptr, int len){
+    (void)file;
+    if(len > 0) FOC_Log_Write(FOC_LOG_LEVEL_PRINT, ptr, (uint32_t)len);
+    return len;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Log_Init(void){
+    setvbuf(stdout, FOC_Log_Stdout_Buffer, _IOLBF, sizeof(FOC_Log_Stdout_Buffer));
+    FOC_Log_Ready = true;
+}
+
+// ------------------------------------------------------------------------------
+
+// Kuyruktaki kaydı çerçeveye çevirir, FOC_UART kabul etmezse false (kayıt halkada kalır)
+static bool FOC_Log_Send(const uint32_t *pRecord, uint32_t header){
+    uint8_t frame[sizeof(FOC_Log_Header_t) + FOC_LOG_TEXT_MAX + 1U]; // + snprintf sonlandırıcısı
+    FOC_Log_Header_t *pHeader = (FOC_Log_Header_t *)frame;
+    char *pText = (char *)&frame[sizeof(FOC_Log_Header_t)];
+    uint32_t length;
+
+    pHeader->tick = pRecord[1];
+    pHeader->level = (uint8_t)FOC_LOG_LEVEL_OF(header);
+
+    if(FOC_LOG_KIND(header) == FOC_LOG_KIND_TEXT){
+        length = FOC_LOG_LENGTH(header);
+        memcpy(pText, &pRecord[2], length);
+    }
+    else{
+        const uint32_t *pArgs = &pRecord[3];
+        uint32_t argc = FOC_LOG_ARGC(header);
+        int n = snprintf(pText, FOC_LOG_TEXT_MAX + 1U, (const char *)pRecord[2],
+                         (argc > 0U) ? pArgs[0] : 0U, (argc > 1U) ? pArgs[1] : 0U,
+                         (argc > 2U) ? pArgs[2] : 0U, (argc > 3U) ? pArgs[3] : 0U);
+        if(n < 0) n = 0;
+        if((uint32_t)n > FOC_LOG_TEXT_MAX){
+            n = (int)FOC_LOG_TEXT_MAX;
+            FOC_Log_Stats.truncated++;
+        }
+        length = (uint32_t)n;
+    }
+
+    return FOC_UART_Send(FOC_UART_TYPE_LOG, frame, (uint16_t)(sizeof(FOC_Log_Header_t) + length));
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Log_Process(void){
+    if(FOC_Log_Ready == false) return;
+
+    uint32_t tail = FOC_Log_Tail;
+    while(tail != *(volatile uint32_t *)&FOC_Log_Head){
+        uint32_t *pRecord = &FOC_Log_Ring[tail & FOC_LOG_RING_MASK];
+        uint32_t header = *(volatile uint32_t *)pRecord;
+
+        if(header == 0U) break; // Ayrılmış ama henüz yazılmamış: sıra korunur
+        __DMB(); // Başlık okunduktan sonra veri okunmalı
+
+        if(FOC_LOG_KIND(header) != FOC_LOG_KIND_PAD){
+            if(FOC_Log_Send(pRecord, header) == false){
+                FOC_Log_Stats.tx_busy++;
+                break;
+            }
+            FOC_Log_Stats.records++;
+        }
+
+        uint32_t words = FOC_LOG_WORDS(header);
+        memset(pRecord, 0, words * sizeof(uint32_t));
+        __DMB(); // Sıfırlanmadan alan üreticilere bırakılmasın
+        tail += words;
+        FOC_Log_Tail = tail;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+const FOC_Log_Stats_t *FOC_Log_Get_Stats(void){
+    return &FOC_Log_Stats;
+}
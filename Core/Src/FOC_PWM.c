@@ -0,0 +1,304 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül FOC_SVPWM_Calculation'ın ürettiği 0.0 - 1.0 arası duty değerlerini TIM1'e aktaran çıkış katıdır.
+// Duty'ler tek geçişte compare değerlerine çevrilir ve CCR1..CCR3 ile ADC tetiği için CCR4,
+// TIM1'in DMA burst (DCR/DMAR) özelliği kullanılarak tek bir DMA işleminde yazılır.
+// CCR register'ları preload modunda olduğu için dört değer de bir sonraki update olayında aynı anda devreye girer.
+// Böylece ISR içinde dört ayrı peripheral yazması yapılmaz ve fazların farklı periyotlara ait duty almasının önüne geçilir.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// 1. TIM1 center-aligned mode 1'de çalışır, varsayılan modda RCR = 1 olduğu için update olayı sadece vadide (CNT = 0) oluşur.
+// 2. CCR4, OC4REF üzerinden TRGO2 olarak ADC'yi tepe noktasında (alt MOSFET'ler iletimdeyken) tetikler.
+// 3. ISR içinde duty'ler FOC_PWM_Burst_Buffer'a yazılır ve EGR.COMG ile yazılımsal bir COM olayı üretilir.
+//    CCPC = 0 olduğu için COM olayı çıkışları etkilemez, sadece DMA isteği üretir.
+// 4. DMA1 Kanal 1 (DMAMUX: TIM1_COM) bu isteği alır ve 4 kelimeyi TIM1->DMAR'a yazar,
+//    timer bu erişimleri DBA = CCR1, DBL = 4 transfer olacak şekilde CCR1..CCR4'e yönlendirir.
+// 5. DMA dairesel (circular) moddadır, her burst sonrası kendini yeniden kurar; CPU müdahalesi gerekmez.
+// 6. Double-update modunda (config.pwm_double_update) RCR = 0 olur ve update olayı hem tepede hem vadide oluşur.
+//    TRGO2 = update olduğu için ADC de iki noktada tetiklenir, FOC_Current_Controller periyotta iki kez çalışır
+//    ve duty'ler her yarım periyotta güncellenir. Kontrol gecikmesi ~1.5 Ts'den ~0.75 Ts'ye iner.
+//    Bu modda config.Ts otomatik olarak yarım periyoda ayarlanır, PI kazançları buna göre seçilmelidir.
+//    NOT: Vadide alt MOSFET'ler kesimde olduğu için bu mod alt kol şöntleri ile değil,
+//    faz üzerindeki (inline) akım sensörleri ile kullanılmalıdır.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. config.pwm_frequency ve config.dead_time doldurulduktan sonra FOC_PWM_Init(&hfoc) çağrılır.
+//    Bu fonksiyon config.Ts değerini de PWM periyoduna göre ayarlar.
+// 2. FOC_PWM_Start() ile sayaç ve çıkışlar açılır.
+// 3. Akım ölçümü ISR'ı içinde:
+//    FOC_Current_Controller(&hfoc);
+//    FOC_PWM_Update(&hfoc);
+// 4. Double-update istendiğinde FOC_PWM_Init akım döngüsünü FOC_Bench_Current_Loop ile ölçer; yarım periyoda
+//    sığmıyorsa tek update'e döner ve config.pwm_double_update false yapılır. Sonuç FOC_PWM_Get_Bench() ile okunur.
+//    FCS-MPC seçiliyse FOC_FCS_MPC_MAX_CYCLES bütçesi FOC_Bench_FCS_MPC ile ölçülür, aşılırsa
+//    config.current_regulator FOC_REG_PI yapılır (FOC_PWM_Get_FCS_Bench). Çalışma anında FCS-MPC'ye geçiş
+//    (FOC_PARAM_CURRENT_REGULATOR) FOC_Param_Process'te aynı ölçümle kontrol edilir.
+//    PI ve deadbeat akım döngüleri de her açılışta FOC_Bench_Regulator ile ölçülür (seçili regülatörden bağımsız),
+//    sonuçlar FOC_PWM_Get_Regulator_Bench(FOC_REG_PI / FOC_REG_DEADBEAT) ile karşılaştırılır.
+//    FOC_PWM_Init bu yüzden config (regülatör, kazançlar) tamamen doldurulduktan sonra çağrılmalıdır.
+
+// Yapılması gereken MX Konfigürasyonlar (STM32G431CBU6):
+// TIM1 CH1/CH1N, CH2/CH2N, CH3/CH3N pinleri alternatif fonksiyon olarak ayarlanmalıdır.
+// Timer ve DMA register'ları bu modül tarafından doğrudan yazılır, MX tarafında TIM1 parametrelerine gerek yoktur.
+// ADC enjekte kanal tetiği: TIM1_TRGO2, yükselen kenar.
+// DMA1 Kanal 1 başka bir çevre birimine atanmamalıdır.
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_PWM.h"
+#include "FOC_Log.h"
+#include "stm32g4xx_hal.h"
+#include "stm32g4xx_ll_dmamux.h"
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+// TIM1 DMA burst adresi: CCR1'in TIM1 başlangıcına göre kelime ofseti (0x34 / 4)
+#define FOC_PWM_DBA_CCR1 13U
+// Double-update bütçe kontrolünde akım döngüsünün ölçüldüğü iterasyon (açının tüm sektörleri iki kez)
+#define FOC_PWM_BENCH_ITERATIONS 720U
+
+static uint32_t FOC_PWM_Burst_Buffer[FOC_PWM_BURST_LENGTH]; // DMA kaynağı: CCR1, CCR2, CCR3, CCR4
+static float FOC_PWM_Period_f = 0.0f;       // ARR (çarpım için float kopyası)
+static uint32_t FOC_PWM_Period = 0;         // ARR
+static uint32_t FOC_PWM_ADC_Trigger = 0;    // CCR4 (ADC tetik noktası)
+static uint32_t FOC_PWM_Nominal_Period = 0; // FOC_PWM_Init'te hesaplanan ARR (trim referansı)
+static bool FOC_PWM_Double_Update = false;
+static FOC_Bench_t FOC_PWM_Bench;           // Double-update açılışındaki akım döngüsü ölçümü
+static FOC_Bench_t FOC_PWM_FCS_Bench;       // FCS-MPC seçiliyse FOC_FCS_MPC_Control ölçümü
+static FOC_Bench_t FOC_PWM_PI_Bench;        // PI regülatörlü akım döngüsü ölçümü
+static FOC_Bench_t FOC_PWM_Deadbeat_Bench;  // Deadbeat regülatörlü akım döngüsü ölçümü
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyon Uygulamaları ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+// Ölü zamanı BDTR.DTG kodlamasına çevirir (CKD = 0, t_DTS = 1 / f_tim)
+static uint32_t FOC_PWM_Dead_Time_To_DTG(float dead_time, float tim_clk){
+    uint32_t ticks = (uint32_t)(dead_time * tim_clk + 0.5f);
+
+    if(ticks < 128U) return ticks;                                    // 0xxxxxxx: DT = DTG * t_DTS
+    if(ticks < 256U) return 0x80U | ((ticks / 2U) - 64U);             // 10xxxxxx: DT = (64 + DTG) * 2 * t_DTS
+    if(ticks < 512U) return 0xC0U | ((ticks / 8U) - 32U);             // 110xxxxx: DT = (32 + DTG) * 8 * t_DTS
+    if(ticks < 1008U) return 0xE0U | ((ticks / 16U) - 32U);           // 111xxxxx: DT = (32 + DTG) * 16 * t_DTS
+    return 0xFFU;                                                     // Maksimum ölü zaman
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+void FOC_PWM_Init(FOC_Handle_t *pHandle){
+    // APB2 bölücüsü 1 olduğu için TIM1 saati PCLK2'ye eşittir
+    float tim_clk = (float)HAL_RCC_GetPCLK2Freq();
+
+    // Center-aligned modda sayaç bir periyotta 0 -> ARR -> 0 gider
+    FOC_PWM_Period = (uint32_t)(tim_clk / (2.0f * pHandle->config.pwm_frequency));
+    FOC_PWM_Period_f = (float)FOC_PWM_Period;
+    FOC_PWM_Nominal_Period = FOC_PWM_Period;
+    FOC_PWM_Double_Update = pHandle->config.pwm_double_update;
+    FOC_PWM_ADC_Trigger = FOC_PWM_Period - 1U - FOC_PWM_ADC_TRIGGER_ADVANCE;
+
+    // Kontrol döngüsü her update olayında bir kez çalışır
+    if(pHandle->config.pwm_double_update == true){
+        pHandle->config.Ts = 0.5f / pHandle->config.pwm_frequency;
+
+        // Akım döngüsü yarım periyoda sığmıyorsa tek update'e dönülür (ölçüm handle'ın kopyasında yapılır)
+        FOC_Bench_Init();
+        if(FOC_Bench_Current_Loop(pHandle, &FOC_PWM_Bench, FOC_PWM_BENCH_ITERATIONS) == false){
+            LOG_W("pwm: akim dongusu %lu cevrim > %lu, double-update kapatildi", FOC_PWM_Bench.max, FOC_PWM_Bench.budget);
+            pHandle->config.pwm_double_update = false;
+            FOC_PWM_Double_Update = false;
+        }
+    }
+    if(pHandle->config.pwm_double_update == false){
+        pHandle->config.Ts = 1.0f / pHandle->config.pwm_frequency;
+    }
+
+    // PI / deadbeat karşılaştırması: ikisi de son Ts bütçesiyle, handle'ın kopyasında ölçülür
+    FOC_Bench_Init();
+    FOC_Bench_Regulator(pHandle, FOC_REG_PI, &FOC_PWM_PI_Bench, FOC_PWM_BENCH_ITERATIONS);
+    FOC_Bench_Regulator(pHandle, FOC_REG_DEADBEAT, &FOC_PWM_Deadbeat_Bench, FOC_PWM_BENCH_ITERATIONS);
+    LOG_I("pwm: akim dongusu PI %lu, deadbeat %lu cevrim (butce %lu)",
+          FOC_PWM_PI_Bench.max, FOC_PWM_Deadbeat_Bench.max, FOC_PWM_PI_Bench.budget);
+
+    // FCS-MPC'nin belgelenen çevrim bütçesi (FOC_FCS_MPC_MAX_CYCLES) hedefte doğrulanır
+    if(pHandle->config.current_regulator == FOC_REG_FCS_MPC){
+        FOC_Bench_Init();
+        if(FOC_Bench_FCS_MPC(pHandle, &FOC_PWM_FCS_Bench, FOC_PWM_BENCH_ITERATIONS) == false){
+            LOG_W("pwm: FCS-MPC %lu cevrim > FOC_FCS_MPC_MAX_CYCLES %lu, PI'ye donuldu", FOC_PWM_FCS_Bench.max, FOC_PWM_FCS_Bench.budget);
+            pHandle->config.current_regulator = FOC_REG_PI;
+        }
+    }
+
+    __HAL_RCC_TIM1_CLK_ENABLE();
+    __HAL_RCC_DMAMUX1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    // << ---- TIM1 ---- >>
+    TIM1->CR1 = 0;
+    TIM1->CR1 = TIM_CR1_CMS_0 | TIM_CR1_ARPE; // Center-aligned mode 1, ARR preload
+    TIM1->PSC = 0;
+    TIM1->ARR = FOC_PWM_Period;
+    TIM1->RCR = (pHandle->config.pwm_double_update == true) ? 0U : 1U; // 0: tepe + vadi, 1: sadece vadi
+
+    // CH1..CH3: PWM mode 1 + preload, CH4: PWM mode 2 + preload (OC4REF tepe noktasında yükselir)
+    TIM1->CCMR1 = (TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1PE) |
+                  (TIM_CCMR1_OC2M_2 | TIM_CCMR1_OC2M_1 | TIM_CCMR1_OC2PE);
+    TIM1->CCMR2 = (TIM_CCMR2_OC3M_2 | TIM_CCMR2_OC3M_1 | TIM_CCMR2_OC3PE) |
+                  (TIM_CCMR2_OC4M_2 | TIM_CCMR2_OC4M_1 | TIM_CCMR2_OC4M_0 | TIM_CCMR2_OC4PE);
+    TIM1->CCER = TIM_CCER_CC1E | TIM_CCER_CC1NE |
+                 TIM_CCER_CC2E | TIM_CCER_CC2NE |
+                 TIM_CCER_CC3E | TIM_CCER_CC3NE;
+
+    TIM1->BDTR = FOC_PWM_Dead_Time_To_DTG(pHandle->config.dead_time, tim_clk) | TIM_BDTR_OSSR | TIM_BDTR_OSSI;
+
+    // TRGO2 = OC4REF (tek güncelleme) veya update (double-update) -> ADC tetiği
+    // CCPC = 0 (COM olayı sadece DMA isteği üretir)
+    if(pHandle->config.pwm_double_update == true){
+        TIM1->CR2 = TIM_CR2_MMS2_1;
+    }
+    else{
+        TIM1->CR2 = (TIM_CR2_MMS2_2 | TIM_CR2_MMS2_1 | TIM_CR2_MMS2_0);
+    }
+
+    // DMA burst: DBA = CCR1, DBL = 4 transfer
+    TIM1->DCR = (FOC_PWM_DBA_CCR1 << TIM_DCR_DBA_Pos) | ((FOC_PWM_BURST_LENGTH - 1U) << TIM_DCR_DBL_Pos);
+    TIM1->DIER = TIM_DIER_COMDE;
+
+    // Başlangıçta %50 duty (sıfır gerilim vektörü)
+    FOC_PWM_Burst_Buffer[0] = FOC_PWM_Period / 2U;
+    FOC_PWM_Burst_Buffer[1] = FOC_PWM_Period / 2U;
+    FOC_PWM_Burst_Buffer[2] = FOC_PWM_Period / 2U;
+    FOC_PWM_Burst_Buffer[3] = FOC_PWM_ADC_Trigger;
+
+    TIM1->CCR1 = FOC_PWM_Burst_Buffer[0];
+    TIM1->CCR2 = FOC_PWM_Burst_Buffer[1];
+    TIM1->CCR3 = FOC_PWM_Burst_Buffer[2];
+    TIM1->CCR4 = FOC_PWM_Burst_Buffer[3];
+
+    // << ---- DMA1 Kanal 1 (Bellek -> TIM1->DMAR) ---- >>
+    DMA1_Channel1->CCR = 0;
+    DMA1_Channel1->CPAR = (uint32_t)&TIM1->DMAR;
+    DMA1_Channel1->CMAR = (uint32_t)FOC_PWM_Burst_Buffer;
+    DMA1_Channel1->CNDTR = FOC_PWM_BURST_LENGTH;
+    DMAMUX1_Channel0->CCR = LL_DMAMUX_REQ_TIM1_COM;
+
+    // Bellekten çevre birimine, 32 bit, bellek adresi artan, dairesel, yüksek öncelik
+    DMA1_Channel1->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_CIRC |
+                         DMA_CCR_PSIZE_1 | DMA_CCR_MSIZE_1 | DMA_CCR_PL_1 |
+                         DMA_CCR_EN;
+
+    // Preload register'larını aktif register'lara aktar, sayaç 0'dan yukarı sayar
+    TIM1->EGR = TIM_EGR_UG;
+    TIM1->SR = 0;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+void FOC_PWM_Start(void){
+    TIM1->BDTR |= TIM_BDTR_MOE;
+    TIM1->CR1 |= TIM_CR1_CEN;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+void FOC_PWM_Stop(void){
+    // MOE temizlenince çıkışlar OSSI'ye göre pasif seviyeye çekilir
+    TIM1->BDTR &= ~TIM_BDTR_MOE;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+// Bu fonksiyon FOC_Current_Controller'dan hemen sonra aynı ISR içinde çağrılmalıdır.
+// Duty -> compare dönüşümü tek geçişte: VMUL + VCVT + USAT, dallanma yok.
+// USAT negatif ve NaN kaynaklı taşmaları 0'a, aşırı değerleri 16 bite sıkıştırır.
+static inline void FOC_PWM_Duty_To_Compare(const FOC_Handle_t *pHandle, uint32_t *pBurst){
+    float period = FOC_PWM_Period_f;
+
+    pBurst[0] = __USAT((int32_t)(pHandle->output.duty_a * period + 0.5f), 16);
+    pBurst[1] = __USAT((int32_t)(pHandle->output.duty_b * period + 0.5f), 16);
+    pBurst[2] = __USAT((int32_t)(pHandle->output.duty_c * period + 0.5f), 16);
+    pBurst[3] = FOC_PWM_ADC_Trigger;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+void FOC_PWM_Update(FOC_Handle_t *pHandle){
+    FOC_PWM_Duty_To_Compare(pHandle, FOC_PWM_Burst_Buffer);
+
+    // Yazılımsal COM olayı -> DMA isteği -> CCR1..CCR4 preload register'larına tek burst
+    TIM1->EGR = TIM_EGR_COMG;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+// FOC_PWM_Update'in aynısı, ancak sonuç pBurst'e yazılır ve TIM1 / DMA'ya dokunulmaz (FOC_Bench_Current_Loop).
+// Aradaki fark tek bir EGR yazmasıdır.
+void FOC_PWM_Compute(const FOC_Handle_t *pHandle, uint32_t *pBurst){
+    FOC_PWM_Duty_To_Compare(pHandle, pBurst);
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+const FOC_Bench_t *FOC_PWM_Get_Bench(void){
+    return &FOC_PWM_Bench;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+const FOC_Bench_t *FOC_PWM_Get_FCS_Bench(void){
+    return &FOC_PWM_FCS_Bench;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+const FOC_Bench_t *FOC_PWM_Get_Regulator_Bench(FOC_Current_Regulator_t regulator){
+    if(regulator == FOC_REG_PI) return &FOC_PWM_PI_Bench;
+    if(regulator == FOC_REG_DEADBEAT) return &FOC_PWM_Deadbeat_Bench;
+    return 0; // Diğer regülatörler açılışta ölçülmez
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+uint32_t FOC_PWM_Get_Period(void){
+    return FOC_PWM_Period;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+uint32_t FOC_PWM_Get_Tick_Length(void){
+    // Sadece vadide update: 0 -> ARR -> 0, tepe + vadi: yarım periyot
+    return (FOC_PWM_Double_Update == true) ? FOC_PWM_Period : (2U * FOC_PWM_Period);
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+// Tick sınırı: vadi (CNT = 0), double-update modunda ayrıca tepe (CNT = ARR)
+uint32_t FOC_PWM_Get_Tick_Phase(void){
+    uint32_t cnt = TIM1->CNT;
+    bool down = ((TIM1->CR1 & TIM_CR1_DIR) != 0U);
+
+    if(FOC_PWM_Double_Update == true){
+        return down ? (FOC_PWM_Period - cnt) : cnt;
+    }
+    return down ? ((2U * FOC_PWM_Period) - cnt) : cnt;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+
+// Akım ISR'ı içinde çağrılmalıdır: ARR, CCR4 ve duty ölçeği aynı update olayında değişir.
+// Birkaç yüz ppm'lik trim config.Ts'i ihmal edilebilir ölçüde değiştirir, Ts güncellenmez.
+void FOC_PWM_Trim_Period(int32_t delta){
+    FOC_PWM_Period = (uint32_t)((int32_t)FOC_PWM_Nominal_Period + delta);
+    FOC_PWM_Period_f = (float)FOC_PWM_Period;
+    FOC_PWM_ADC_Trigger = FOC_PWM_Period - 1U - FOC_PWM_ADC_TRIGGER_ADVANCE;
+    TIM1->ARR = FOC_PWM_Period;
+}
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
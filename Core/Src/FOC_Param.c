@@ -0,0 +1,447 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül çalışma anında parametre ayarı (live tuning) içindir. Kp_q, I_s_max gibi ayarlar doğrudan
+// FOC_Driver_Config_t alanlarına yazılırsa akım ISR'ı aynı anda okurken yarım güncellenmiş bir ayar
+// kümesi görebilir (ör. Kp_q yeni, Ki_q eski) veya MTPA tablosu yeni I_s_max'a göre yarım hesaplanmış olur.
+// Parametreler ID ile adreslenen bir tanımlayıcı tablosundadır (tip, aralık, ölçek, HOT bayrağı); ID tablo
+// indeksidir, arama O(1)'dir. UART (FOC_UART_TYPE_PARAM) ve CAN (FOC_CAN_CMD_PARAM) aynı istekleri taşır.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// Üç aşama:
+// 1. Set: değer aralık kontrolünden geçer ve gölge ayara (staging) yazılır. Canlı ayar değişmez.
+// 2. Commit -> FOC_Param_Process (main döngüsü): gölge ayardaki değişiklikler tek seferde alınır, canlı
+//    ayarın kopyasına işlenir ve türetilmiş değerler bu kopyadan hesaplanır (MTPA tablosu: ~1000 kare kök,
+//    ISR'da veya PendSV'de yapılamaz). Sonuç bir uygulama bankasında toplanır, işaretçisi yayınlanır.
+// 3. FOC_Param_Apply (akım ISR'ının başı): yayınlanan işaretçi alınır ve sıfırlanır (FOC_CAN_Consume ile
+//    aynı yayınla / tüket yöntemi), değişen alanlar ve gerekiyorsa MTPA tablosu yazılır. ISR bir tick
+//    sınırında tüm değişikliği birden görür; hiçbir tick yarım küme ile çalışmaz.
+// Neden canlı ayarın işaretçisi değiştirilmiyor: FOC_Handle_t ayarı değer olarak taşır ve ISR her alanı
+// pHandle->config.x ile okur. İşaretçiye çevirmek her erişime bir yükleme ekler (her tick ISR maliyeti);
+// burada maliyet sadece uygulama tick'indedir.
+// ISR maliyeti: uygulama yokken tek yükleme + karşılaştırma. Uygulama tick'inde değişen alan başına bir
+// saklama ve MTPA değiştiyse 66 word kopyası (~0.5 us, tick bütçesinin %1'inden az).
+// L_d / L_q değişince doyum haritasının Kp ölçekleme paydaları (sat_map.inv_L_x_nom) da bankada hesaplanır ve
+// aynı tick'te yazılır; aksi halde Kp_x_sched eski nominal endüktansa göre ölçeklenir.
+// Sadece değişen alanlar yazılır: bu sırada CAN / UART'tan gelen mod komutları (current_ctrl_mode) eski bir
+// kopya ile ezilmez. FOC_Estimator R / L / flux tahminlerini de Set + Commit ile bu yoldan yayınlar.
+// HOT olmayan parametreler (kutup sayısı, akım regülatörü seçimi) akım döngüsü açıkken reddedilir; Set,
+// hazırlık ve uygulama anında kontrol edilir (motor arada açılırsa commit uygulanmaz, last_error yazılır).
+// Akım regülatörünü FCS-MPC'ye geçiren commit, yayınlanmadan önce commit edilecek ayarla FOC_Bench_FCS_MPC_Config
+// üzerinden ölçülür; FOC_FCS_MPC_MAX_CYCLES aşılırsa commit'in tamamı atılır (FOC_PARAM_ERR_BUDGET).
+// Hız / pozisyon kazançları PendSV'de okunur; bu döngüler tick içinde bittiği sürece (FOC_Scheduler
+// bütçesi) onlar da tek bir tick sınırında değişir.
+// Eşzamanlılık: Set / Commit / Discard gölge ayarı BASEPRI ile FOC_PARAM_IRQ_PRIORITY ve altını maskeleyerek
+// yazar (UART kesmesi, PendSV, main). Akım ISR'ı ve FDCAN ISR'ı maskelenmez; FDCAN ISR'ı bu modülü
+// çağırmaz, CAN istekleri PendSV'de işlenir.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. Ayar doldurulup FOC_MTPA_Init sonrası FOC_Param_Init(&hfoc) çağrılır.
+// 2. Akım ISR'ının başında FOC_CAN_Consume(&hfoc) ile birlikte FOC_Param_Apply(&hfoc) çağrılır.
+// 3. main while(1) içinde FOC_Param_Process() çağrılır.
+// 4. Host: SET (bir veya birkaç parametre) -> COMMIT -> STATUS ile applied == committed beklenir.
+//    Değerler host biriminde gönderilir (tanımlayıcıdaki scale ile: L uH, R mOhm, flux mWb).
+// 5. Yeni parametre: FOC_Param_Id_t'ye (sona) ID, FOC_Param_Table'a aynı indeksle satır eklenir.
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_Param.h"
+#include "FOC_Log.h"
+#include <stddef.h>
+#include <string.h>
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+#define FOC_PARAM_BASEPRI (FOC_PARAM_IRQ_PRIORITY << (8U - __NVIC_PRIO_BITS))
+#define FOC_PARAM_FCS_BENCH_ITERATIONS 720U // FOC_PWM_Init'teki ölçüm ile aynı
+
+typedef struct{
+    uint16_t offset;   // FOC_Driver_Config_t içindeki byte ofseti
+    uint8_t size;
+    uint8_t type;
+    uint8_t flags;
+    float min;         // Ayar biriminde
+    float max;
+    float scale;       // Host değeri = ayar değeri * scale
+    char name[FOC_PARAM_NAME_SIZE];
+} FOC_Param_Desc_t;
+
+#define FOC_PARAM_ENTRY(field, type, flags, min, max, scale, name) \
+    { (uint16_t)offsetof(FOC_Driver_Config_t, field), (uint8_t)sizeof(((FOC_Driver_Config_t *)0)->field), (type), (flags), (min), (max), (scale), name }
+
+#define HOT  FOC_PARAM_FLAG_HOT
+#define MTPA FOC_PARAM_FLAG_MTPA
+
+static const FOC_Param_Desc_t FOC_Param_Table[FOC_PARAM_COUNT] = {
+    [FOC_PARAM_KP_D]               = FOC_PARAM_ENTRY(Kp_d,               FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   1000.0f, 1.0f,   "Kp_d"),
+    [FOC_PARAM_KI_D]               = FOC_PARAM_ENTRY(Ki_d,               FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   1.0e7f,  1.0f,   "Ki_d"),
+    [FOC_PARAM_KP_Q]               = FOC_PARAM_ENTRY(Kp_q,               FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   1000.0f, 1.0f,   "Kp_q"),
+    [FOC_PARAM_KI_Q]               = FOC_PARAM_ENTRY(Ki_q,               FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   1.0e7f,  1.0f,   "Ki_q"),
+    [FOC_PARAM_CURRENT_LIMIT]      = FOC_PARAM_ENTRY(current_limit,      FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   200.0f,  1.0f,   "i_limit"),
+    [FOC_PARAM_I_S_MAX]            = FOC_PARAM_ENTRY(I_s_max,            FOC_PARAM_TYPE_FLOAT, HOT | MTPA, 0.0f,   200.0f,  1.0f,   "I_s_max"),
+    [FOC_PARAM_VOLTAGE_LIMIT]      = FOC_PARAM_ENTRY(voltage_limit,      FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   100.0f,  1.0f,   "u_limit"),
+    [FOC_PARAM_MAX_SPEED]          = FOC_PARAM_ENTRY(max_speed_rad_s,    FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   10000.0f, 1.0f,  "max_speed"),
+    [FOC_PARAM_R_PHASE]            = FOC_PARAM_ENTRY(R_phase,            FOC_PARAM_TYPE_FLOAT, HOT,        1.0e-4f, 100.0f, 1.0e3f, "R_mOhm"),
+    [FOC_PARAM_L_D]                = FOC_PARAM_ENTRY(L_d,                FOC_PARAM_TYPE_FLOAT, HOT | MTPA, 1.0e-7f, 1.0f,   1.0e6f, "L_d_uH"),
+    [FOC_PARAM_L_Q]                = FOC_PARAM_ENTRY(L_q,                FOC_PARAM_TYPE_FLOAT, HOT | MTPA, 1.0e-7f, 1.0f,   1.0e6f, "L_q_uH"),
+    [FOC_PARAM_FLUX_LINKAGE]       = FOC_PARAM_ENTRY(flux_linkage,       FOC_PARAM_TYPE_FLOAT, HOT | MTPA, 1.0e-5f, 1.0f,   1.0e3f, "flux_mWb"),
+    [FOC_PARAM_POLE_PAIRS]         = FOC_PARAM_ENTRY(pole_pairs,         FOC_PARAM_TYPE_UINT,  MTPA,       1.0f,   50.0f,   1.0f,   "pole_pairs"),
+    [FOC_PARAM_DEADBEAT_GAIN]      = FOC_PARAM_ENTRY(deadbeat_gain,      FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   1.0f,    1.0f,   "db_gain"),
+    [FOC_PARAM_FCS_SWITCH_WEIGHT]  = FOC_PARAM_ENTRY(fcs_switch_weight,  FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   100.0f,  1.0f,   "fcs_weight"),
+    [FOC_PARAM_V_SWITCH_DROP]      = FOC_PARAM_ENTRY(V_switch_drop,      FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   5.0f,    1.0f,   "V_switch"),
+    [FOC_PARAM_V_DIODE_DROP]       = FOC_PARAM_ENTRY(V_diode_drop,       FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   5.0f,    1.0f,   "V_diode"),
+    [FOC_PARAM_DTC_CURRENT_BAND]   = FOC_PARAM_ENTRY(dtc_current_band,   FOC_PARAM_TYPE_FLOAT, HOT,        1.0e-3f, 50.0f,  1.0f,   "dtc_band"),
+    [FOC_PARAM_FW_KI]              = FOC_PARAM_ENTRY(fw_Ki,              FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   1.0e6f,  1.0f,   "fw_Ki"),
+    [FOC_PARAM_FW_VOLTAGE_MARGIN]  = FOC_PARAM_ENTRY(fw_voltage_margin,  FOC_PARAM_TYPE_FLOAT, HOT,        0.5f,   1.0f,    1.0f,   "fw_margin"),
+    [FOC_PARAM_FW_I_D_MIN]         = FOC_PARAM_ENTRY(fw_i_d_min,         FOC_PARAM_TYPE_FLOAT, HOT,        -200.0f, 0.0f,   1.0f,   "fw_i_d_min"),
+    [FOC_PARAM_FW_DECIMATION]      = FOC_PARAM_ENTRY(fw_decimation,      FOC_PARAM_TYPE_UINT,  HOT,        1.0f,   100.0f,  1.0f,   "fw_dec"),
+    [FOC_PARAM_KP_SPEED]           = FOC_PARAM_ENTRY(Kp_speed,           FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   100.0f,  1.0f,   "Kp_speed"),
+    [FOC_PARAM_KI_SPEED]           = FOC_PARAM_ENTRY(Ki_speed,           FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   1.0e4f,  1.0f,   "Ki_speed"),
+    [FOC_PARAM_KP_POSITION]        = FOC_PARAM_ENTRY(Kp_position,        FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   1000.0f, 1.0f,   "Kp_pos"),
+    [FOC_PARAM_SPEED_TORQUE_LIMIT] = FOC_PARAM_ENTRY(speed_torque_limit, FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   100.0f,  1.0f,   "T_limit"),
+    [FOC_PARAM_MAX_MOD_INDEX]      = FOC_PARAM_ENTRY(max_mod_index,      FOC_PARAM_TYPE_FLOAT, HOT,        0.0f,   1.0f,    1.0f,   "max_mi"),
+    [FOC_PARAM_FLUX_WEAKENING]     = FOC_PARAM_ENTRY(flux_weakening,     FOC_PARAM_TYPE_BOOL,  HOT,        0.0f,   1.0f,    1.0f,   "fw_on"),
+    [FOC_PARAM_MTPA]               = FOC_PARAM_ENTRY(mtpa,               FOC_PARAM_TYPE_BOOL,  HOT | MTPA, 0.0f,   1.0f,    1.0f,   "mtpa_on"),
+    [FOC_PARAM_DEAD_TIME_COMP]     = FOC_PARAM_ENTRY(dead_time_comp,     FOC_PARAM_TYPE_BOOL,  HOT,        0.0f,   1.0f,    1.0f,   "dtc_on"),
+    [FOC_PARAM_ONLINE_ESTIMATION]  = FOC_PARAM_ENTRY(online_estimation,  FOC_PARAM_TYPE_BOOL,  HOT,        0.0f,   1.0f,    1.0f,   "est_on"),
+    [FOC_PARAM_BACK_CALC_AW]       = FOC_PARAM_ENTRY(back_calc_aw,       FOC_PARAM_TYPE_BOOL,  HOT,        0.0f,   1.0f,    1.0f,   "aw_back"),
+    [FOC_PARAM_MODULATION]         = FOC_PARAM_ENTRY(modulation,         FOC_PARAM_TYPE_UINT,  HOT,        0.0f,   (float)FOC_MOD_DPWM_AUTO, 1.0f, "modulation"),
+    [FOC_PARAM_VOLTAGE_PRIORITY]   = FOC_PARAM_ENTRY(voltage_priority,   FOC_PARAM_TYPE_UINT,  HOT,        0.0f,   (float)FOC_VLIM_PROPORTIONAL, 1.0f, "vlim_prio"),
+    [FOC_PARAM_CURRENT_REGULATOR]  = FOC_PARAM_ENTRY(current_regulator,  FOC_PARAM_TYPE_UINT,  0U,         0.0f,   (float)FOC_REG_FCS_MPC, 1.0f, "regulator"),
+};
+
+#undef HOT
+#undef MTPA
+
+_Static_assert(FOC_PARAM_COUNT <= 64, "Gölge ayar maskesi 64 bit");
+_Static_assert(sizeof(FOC_Param_Msg_t) == 8U, "Parametre mesajı 8 byte olmalı");
+_Static_assert(sizeof(FOC_Param_Msg_t) + sizeof(FOC_Param_Info_t) <= 60U, "Parametre bilgisi tek CAN komut çerçevesine sığmalı");
+
+// Uygulama bankası: Process doldurur, Apply (akım ISR'ı) tüketir
+typedef struct{
+    uint16_t offset;
+    uint8_t size;
+    uint32_t raw;
+} FOC_Param_Item_t;
+
+typedef struct{
+    FOC_Param_Item_t item[FOC_PARAM_COUNT];
+    uint32_t count;
+    uint32_t sequence;
+    bool cold;               // HOT olmayan parametre içerir
+    bool mtpa;               // table uygulanacak
+    bool sat_nom;            // inv_L_x_nom uygulanacak (L_d / L_q değişti, doyum haritası kurulu)
+    float inv_L_d_nom;
+    float inv_L_q_nom;
+    FOC_MTPA_Table_t table;
+} FOC_Param_Bank_t;
+
+static FOC_Handle_t *FOC_Param_Handle = 0;
+
+// Gölge ayar (BASEPRI altında yazılır)
+static uint32_t FOC_Param_Staged_Raw[FOC_PARAM_COUNT];
+static uint64_t FOC_Param_Staged_Mask = 0;
+static volatile bool FOC_Param_Commit_Request = false;
+
+static FOC_Param_Bank_t FOC_Param_Bank;
+static FOC_Driver_Config_t FOC_Param_Scratch;              // Türetilmiş değerler için ayar kopyası
+static FOC_Param_Bank_t *volatile FOC_Param_Published = 0; // Sadece akım ISR'ı sıfırlar
+
+_Static_assert(sizeof(FOC_Param_Staged_Raw) + sizeof(FOC_Param_Bank) + sizeof(FOC_Param_Scratch) <= FOC_PARAM_RAM_BYTES,
+               "FOC_PARAM_RAM_BYTES güncellenmeli");
+static FOC_Param_Status_t FOC_Param_Status;
+static FOC_Bench_t FOC_Param_FCS_Bench; // Son FCS-MPC commit kontrolü (debugger ile okunur)
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+void FOC_Param_Init(FOC_Handle_t *pHandle){
+    FOC_Param_Handle = pHandle;
+    FOC_Param_Staged_Mask = 0;
+    FOC_Param_Commit_Request = false;
+    FOC_Param_Published = 0;
+    memset(&FOC_Param_Status, 0, sizeof(FOC_Param_Status));
+}
+
+// ------------------------------------------------------------------------------
+
+uint8_t FOC_Param_Set(uint16_t id, float value){
+    if(id >= FOC_PARAM_COUNT) return FOC_PARAM_ERR_ID;
+
+    const FOC_Param_Desc_t *pDesc = &FOC_Param_Table[id];
+    float v = value / pDesc->scale;
+    uint32_t raw;
+
+    if(!(v >= pDesc->min && v <= pDesc->max)) return FOC_PARAM_ERR_RANGE; // NaN da reddedilir
+    if((pDesc->flags & FOC_PARAM_FLAG_HOT) == 0U && FOC_Param_Handle->config.current_ctrl_mode == true){
+        return FOC_PARAM_ERR_RUNNING;
+    }
+
+    if(pDesc->type == FOC_PARAM_TYPE_FLOAT) memcpy(&raw, &v, sizeof(raw));
+    else if(pDesc->type == FOC_PARAM_TYPE_BOOL) raw = (v != 0.0f) ? 1U : 0U;
+    else raw = (uint32_t)(v + 0.5f);
+
+    uint32_t basepri = __get_BASEPRI();
+    __set_BASEPRI_MAX(FOC_PARAM_BASEPRI);
+    FOC_Param_Staged_Raw[id] = raw;
+    FOC_Param_Staged_Mask |= (1ULL << id);
+    __set_BASEPRI(basepri);
+
+    return FOC_PARAM_OK;
+}
+
+// ------------------------------------------------------------------------------
+
+uint8_t FOC_Param_Get(uint16_t id, float *pValue){
+    if(id >= FOC_PARAM_COUNT) return FOC_PARAM_ERR_ID;
+
+    const FOC_Param_Desc_t *pDesc = &FOC_Param_Table[id];
+    const uint8_t *pField = (const uint8_t *)&FOC_Param_Handle->config + pDesc->offset;
+    float v;
+
+    if(pDesc->type == FOC_PARAM_TYPE_FLOAT){
+        memcpy(&v, pField, sizeof(v));
+    }
+    else if(pDesc->size == 4U){
+        v = (float)*(const uint32_t *)pField;
+    }
+    else if(pDesc->size == 2U){
+        v = (float)*(const uint16_t *)pField;
+    }
+    else{
+        v = (float)*pField;
+    }
+
+    *pValue = v * pDesc->scale;
+    return FOC_PARAM_OK;
+}
+
+// ------------------------------------------------------------------------------
+
+uint8_t FOC_Param_Commit(void){
+    uint8_t status = FOC_PARAM_OK;
+    uint32_t basepri = __get_BASEPRI();
+    __set_BASEPRI_MAX(FOC_PARAM_BASEPRI);
+
+    if(FOC_Param_Commit_Request == true){
+        status = FOC_PARAM_ERR_BUSY;
+    }
+    else if(FOC_Param_Staged_Mask != 0U){
+        FOC_Param_Status.committed++;
+        FOC_Param_Commit_Request = true;
+    }
+
+    __set_BASEPRI(basepri);
+    return status;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Param_Discard(void){
+    uint32_t basepri = __get_BASEPRI();
+    __set_BASEPRI_MAX(FOC_PARAM_BASEPRI);
+
+    if(FOC_Param_Commit_Request == true){
+        FOC_Param_Commit_Request = false;
+        FOC_Param_Status.committed--;
+    }
+    FOC_Param_Staged_Mask = 0;
+
+    __set_BASEPRI(basepri);
+}
+
+// ------------------------------------------------------------------------------
+
+const FOC_Param_Status_t *FOC_Param_Get_Status(void){
+    uint64_t mask = FOC_Param_Staged_Mask;
+    uint8_t staged = 0;
+
+    while(mask != 0U){
+        mask &= mask - 1U;
+        staged++;
+    }
+    FOC_Param_Status.staged = staged;
+    return &FOC_Param_Status;
+}
+
+// ------------------------------------------------------------------------------
+
+// Commit'i hazırlar: gölge ayar alınır, kopya üzerinde türetilmiş değerler hesaplanır, banka yayınlanır.
+// Önceki banka akım ISR'ı tarafından alınmadan yeni banka hazırlanmaz.
+void FOC_Param_Process(void){
+    if(FOC_Param_Commit_Request == false || FOC_Param_Published != 0) return;
+
+    FOC_Param_Bank_t *pBank = &FOC_Param_Bank;
+    uint64_t mask;
+    bool cold = false;
+
+    uint32_t basepri = __get_BASEPRI();
+    __set_BASEPRI_MAX(FOC_PARAM_BASEPRI);
+
+    mask = FOC_Param_Staged_Mask;
+    for(uint32_t id = 0; id < FOC_PARAM_COUNT; id++){
+        if((mask & (1ULL << id)) != 0U && (FOC_Param_Table[id].flags & FOC_PARAM_FLAG_HOT) == 0U) cold = true;
+    }
+
+    if(cold == true && FOC_Param_Handle->config.current_ctrl_mode == true){
+        // Gölge ayar korunur, motor durdurulunca tekrar commit edilebilir
+        FOC_Param_Status.last_error = FOC_PARAM_ERR_RUNNING;
+        FOC_Param_Status.committed--;
+        FOC_Param_Commit_Request = false;
+        __set_BASEPRI(basepri);
+        LOG_W("param: commit reddedildi, motor calisiyor");
+        return;
+    }
+
+    pBank->count = 0;
+    for(uint32_t id = 0; id < FOC_PARAM_COUNT; id++){
+        if((mask & (1ULL << id)) == 0U) continue;
+        pBank->item[pBank->count].offset = FOC_Param_Table[id].offset;
+        pBank->item[pBank->count].size = FOC_Param_Table[id].size;
+        pBank->item[pBank->count].raw = FOC_Param_Staged_Raw[id];
+        pBank->count++;
+    }
+    pBank->sequence = FOC_Param_Status.committed;
+    FOC_Param_Staged_Mask = 0;
+    FOC_Param_Commit_Request = false;
+
+    __set_BASEPRI(basepri);
+
+    // Türetilmiş değerler: canlı ayarın kopyasına değişiklikler işlenir, hesap kopya üzerinden yapılır
+    pBank->cold = cold;
+    pBank->mtpa = false;
+    memcpy(&FOC_Param_Scratch, &FOC_Param_Handle->config, sizeof(FOC_Param_Scratch));
+    for(uint32_t i = 0; i < pBank->count; i++){
+        memcpy((uint8_t *)&FOC_Param_Scratch + pBank->item[i].offset, &pBank->item[i].raw, pBank->item[i].size);
+    }
+
+    // FCS-MPC'ye geçiş: akım ISR'ı bütçeyi aşacaksa banka yayınlanmaz (gölge ayar zaten alındı, commit atılır)
+    if((mask & (1ULL << FOC_PARAM_CURRENT_REGULATOR)) != 0U && FOC_Param_Scratch.current_regulator == FOC_REG_FCS_MPC){
+        if(FOC_Bench_FCS_MPC_Config(FOC_Param_Handle, &FOC_Param_Scratch, &FOC_Param_FCS_Bench, FOC_PARAM_FCS_BENCH_ITERATIONS) == false){
+            FOC_Param_Status.last_error = FOC_PARAM_ERR_BUDGET;
+            FOC_Param_Status.committed--;
+            LOG_W("param: FCS-MPC %lu cevrim > %lu, commit reddedildi", FOC_Param_FCS_Bench.max, FOC_Param_FCS_Bench.budget);
+            return;
+        }
+    }
+
+    for(uint32_t id = 0; id < FOC_PARAM_COUNT; id++){
+        if((mask & (1ULL << id)) != 0U && (FOC_Param_Table[id].flags & FOC_PARAM_FLAG_MTPA) != 0U) pBank->mtpa = true;
+    }
+    if(pBank->mtpa == true){
+        FOC_MTPA_Compute(&FOC_Param_Scratch, &pBank->table);
+    }
+
+    // Harita kurulmadıysa (inv_L_d_nom = 0) Kp ölçeklenmez, payda kurulu değilken yazılmaz
+    uint64_t L_mask = (1ULL << FOC_PARAM_L_D) | (1ULL << FOC_PARAM_L_Q);
+    pBank->sat_nom = ((mask & L_mask) != 0U) && (FOC_Param_Handle->sat_map.inv_L_d_nom > 0.0f);
+    if(pBank->sat_nom == true){
+        pBank->inv_L_d_nom = 1.0f / FOC_Param_Scratch.L_d;
+        pBank->inv_L_q_nom = 1.0f / FOC_Param_Scratch.L_q;
+    }
+
+    FOC_Param_Status.last_error = FOC_PARAM_OK;
+    __DMB();
+    FOC_Param_Published = pBank; // Yayınla: akım ISR'ı bir sonraki tick'in başında uygular
+}
+
+// ------------------------------------------------------------------------------
+
+// Akım ISR'ı: yayınlanan banka varsa tick başında bütün olarak uygulanır
+void FOC_Param_Apply(FOC_Handle_t *pHandle){
+    FOC_Param_Bank_t *pBank = FOC_Param_Published;
+    if(pBank == 0) return;
+
+    if(pBank->cold == true && pHandle->config.current_ctrl_mode == true){
+        FOC_Param_Status.last_error = FOC_PARAM_ERR_RUNNING;
+        LOG_W("param: commit %lu uygulanmadi, motor calisiyor", pBank->sequence);
+    }
+    else{
+        uint8_t *pConfig = (uint8_t *)&pHandle->config;
+        for(uint32_t i = 0; i < pBank->count; i++){
+            const FOC_Param_Item_t *pItem = &pBank->item[i];
+            if(pItem->size == 4U) *(uint32_t *)(pConfig + pItem->offset) = pItem->raw;
+            else if(pItem->size == 2U) *(uint16_t *)(pConfig + pItem->offset) = (uint16_t)pItem->raw;
+            else *(pConfig + pItem->offset) = (uint8_t)pItem->raw;
+        }
+        if(pBank->mtpa == true){
+            pHandle->mtpa = pBank->table;
+        }
+        if(pBank->sat_nom == true){
+            pHandle->sat_map.inv_L_d_nom = pBank->inv_L_d_nom;
+            pHandle->sat_map.inv_L_q_nom = pBank->inv_L_q_nom;
+        }
+        FOC_Param_Status.applied = pBank->sequence;
+    }
+
+    FOC_Param_Published = 0;
+}
+
+// ------------------------------------------------------------------------------
+
+uint16_t FOC_Param_Request(const uint8_t *pRequest, uint16_t length, uint8_t *pResponse, uint16_t max_length){
+    FOC_Param_Msg_t request;
+    FOC_Param_Msg_t response;
+    uint16_t response_length = sizeof(response);
+    float value = 0.0f;
+
+    if(length < sizeof(request) || max_length < sizeof(response)) return 0;
+    memcpy(&request, pRequest, sizeof(request));
+
+    response = request;
+    response.status = FOC_PARAM_OK;
+
+    switch(request.op){
+        case FOC_PARAM_OP_GET:
+            response.status = FOC_Param_Get(request.id, &value);
+            response.value = value;
+            break;
+        case FOC_PARAM_OP_SET:
+            response.status = FOC_Param_Set(request.id, request.value);
+            break;
+        case FOC_PARAM_OP_COMMIT:
+            response.status = FOC_Param_Commit();
+            break;
+        case FOC_PARAM_OP_DISCARD:
+            FOC_Param_Discard();
+            break;
+        case FOC_PARAM_OP_INFO:{
+            FOC_Param_Info_t info;
+            response.status = FOC_Param_Get(request.id, &value);
+            response.value = value;
+            if(response.status != FOC_PARAM_OK || max_length < sizeof(response) + sizeof(info)) break;
+
+            const FOC_Param_Desc_t *pDesc = &FOC_Param_Table[request.id];
+            info.type = pDesc->type;
+            info.flags = pDesc->flags;
+            info.size = pDesc->size;
+            info.count = FOC_PARAM_COUNT;
+            info.min = pDesc->min * pDesc->scale;
+            info.max = pDesc->max * pDesc->scale;
+            info.scale = pDesc->scale;
+            memcpy(info.name, pDesc->name, FOC_PARAM_NAME_SIZE);
+            memcpy(&pResponse[sizeof(response)], &info, sizeof(info));
+            response_length += sizeof(info);
+            break;
+        }
+        case FOC_PARAM_OP_STATUS:{
+            const FOC_Param_Status_t *pStatus = FOC_Param_Get_Status();
+            if(max_length < sizeof(response) + sizeof(*pStatus)) break;
+            memcpy(&pResponse[sizeof(response)], pStatus, sizeof(*pStatus));
+            response_length += sizeof(*pStatus);
+            break;
+        }
+        default:
+            response.status = FOC_PARAM_ERR_OP;
+            break;
+    }
+
+    memcpy(pResponse, &response, sizeof(response));
+    return response_length;
+}
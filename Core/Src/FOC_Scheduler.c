@@ -0,0 +1,191 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül hız ve pozisyon döngülerini akım döngüsünün tam sayı alt katlarında (örn: 20 kHz / 2 kHz / 1 kHz)
+// çalıştıran deterministik tick zamanlayıcısıdır. Yavaş döngüler akım ISR'ının içinde çalışmaz,
+// böylece akım ISR süresi hangi tick'te olunursa olunsun aynı kalır.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// 1. Akım ISR'ı işini bitirince FOC_Scheduler_Tick() çağırır: tick sayacı artar ve PendSV bekleyen yapılır.
+// 2. PendSV en düşük öncelikte olduğu için akım ISR'ından hemen sonra, bir sonraki akım ISR'ı tarafından
+//    kesilebilecek şekilde çalışır. FOC_Scheduler_Run(), geri sayımı sıfıra inen görevleri çalıştırır.
+//    Her görevin kendi geri sayımı vardır (tick % period kullanılmaz): 32 bit tick taşarken periyot 2'nin
+//    kuvveti değilse kalan zıplar, geri sayım ise sadece geçen tick farkıyla (tick - son tick) ilerler.
+// 3. Görevler faz kaydırmalı yerleştirilir: hız döngüsü phase = 0, pozisyon döngüsü phase = EBOB / 2.
+//    İki periyodun EBOB'u 2 veya daha büyükse iki görev hiçbir tick'te çakışmaz, her tick'in yükü düz kalır.
+//    (Örn: 10 ve 20 tick -> EBOB 10, pozisyon phase = 5: hız 0, 10, 20 ... pozisyon 5, 25, 45 ...)
+// 4. Her tick'in süresi DWT ile ölçülür ve hiperperiyot (periyotların EKOK'u) içindeki dilimine yazılır.
+//    Böylece dilim başına en kötü durum görülebilir. Bütçe config.Ts'dir; akım ISR süresi de bu periyodu
+//    paylaştığı için gerçek pay Ts - (FOC_Bench_Current_Loop max + FOC_BENCH_ISR_HOOK_CYCLES) olarak değerlendirilmelidir.
+// 5. PendSV bir tick'i bitirmeden yeni tick gelirse bekleyen PendSV birleşir ve sadece son tick işlenir;
+//    atlanan tick sayısı FOC_Scheduler_Get_Missed_Ticks() ile okunur.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. config.speed_decimation, config.position_decimation ve hız / pozisyon kazançları doldurulur.
+//    0 verilirse FOC_Scheduler_Init config'e 1 yazar (hız PI'ının Ts * speed_decimation'ı da bunu kullanır).
+// 2. FOC_PWM_Init(&hfoc) (config.Ts ayarlanır) sonrası FOC_Scheduler_Init(&hfoc) çağrılır.
+// 3. Akım ölçümü ISR'ı içinde:
+//    FOC_Current_Controller(&hfoc);
+//    FOC_PWM_Update(&hfoc);
+//    FOC_Scheduler_Tick();
+// 4. stm32g4xx_it.c içindeki PendSV_Handler FOC_Scheduler_Run() çağırır.
+// 5. Tick bazında ölçümler debugger ile FOC_Scheduler_Get_Slot_Bench(slot) üzerinden okunur.
+
+// Yapılması gereken MX Konfigürasyonlar (STM32G431CBU6):
+// NVIC: Pendable request for system service (PendSV) önceliği 15 (en düşük) olmalıdır.
+// Akım ölçümü ISR'ının önceliği PendSV'den yüksek olmalıdır.
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_Scheduler.h"
+#include "stm32g4xx_hal.h"
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+static FOC_Handle_t *FOC_Sched_Handle;
+static FOC_Sched_Entry_t FOC_Sched_Tasks[FOC_SCHED_MAX_TASKS];
+static uint32_t FOC_Sched_Task_Count = 0;
+static uint32_t FOC_Sched_Hyperperiod = 1;
+static uint32_t FOC_Sched_Slot = 0;                // Hiperperiyot içindeki dilim (tick'ten bağımsız sayılır)
+
+static volatile uint32_t FOC_Sched_Tick_Count = 0; // Akım ISR'ı artırır
+static uint32_t FOC_Sched_Last_Tick = 0;           // PendSV'nin en son işlediği tick
+static uint32_t FOC_Sched_Missed_Ticks = 0;
+
+static FOC_Bench_t FOC_Sched_Slot_Bench[FOC_SCHED_MAX_SLOTS]; // Hiperperiyot dilimi başına ölçüm
+static float FOC_Sched_Tick_Period = 0.0f;                    // Bütçe için tick periyodu (sn)
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+static uint32_t FOC_Sched_GCD(uint32_t a, uint32_t b){
+    while(b != 0U){
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Scheduler_Init(FOC_Handle_t *pHandle){
+    // Decimation 0 tek yerde 1'e çekilir, FOC_Speed_Controller örnekleme süresini aynı değerle hesaplar
+    if(pHandle->config.speed_decimation == 0U) pHandle->config.speed_decimation = 1U;
+    if(pHandle->config.position_decimation == 0U) pHandle->config.position_decimation = 1U;
+
+    uint32_t speed_period = pHandle->config.speed_decimation;
+    uint32_t position_period = pHandle->config.position_decimation;
+
+    FOC_Sched_Handle = pHandle;
+    FOC_Sched_Task_Count = 0;
+    FOC_Sched_Hyperperiod = 1;
+    FOC_Sched_Tick_Period = pHandle->config.Ts;
+    FOC_Sched_Missed_Ticks = 0;
+    FOC_Sched_Tick_Count = 0;
+    FOC_Sched_Last_Tick = 0;
+    FOC_Sched_Slot = 0;
+
+    // Pozisyon döngüsü hız döngüsüyle aynı tick'e düşmeyecek şekilde kaydırılır
+    uint32_t position_phase = FOC_Sched_GCD(speed_period, position_period) / 2U;
+
+    FOC_Scheduler_Add_Task(FOC_Speed_Controller, (uint16_t)speed_period, 0U);
+    FOC_Scheduler_Add_Task(FOC_Position_Controller, (uint16_t)position_period, (uint16_t)position_phase);
+
+    // PendSV en düşük öncelik: akım ISR'ı her zaman zamanlayıcıyı kesebilir
+    NVIC_SetPriority(PendSV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Scheduler_Add_Task(FOC_Sched_Task_t task, uint16_t period, uint16_t phase){
+    if((FOC_Sched_Task_Count >= FOC_SCHED_MAX_TASKS) || (period == 0U) || (phase >= period)){
+        return false;
+    }
+
+    FOC_Sched_Tasks[FOC_Sched_Task_Count].task = task;
+    FOC_Sched_Tasks[FOC_Sched_Task_Count].period = period;
+    FOC_Sched_Tasks[FOC_Sched_Task_Count].phase = phase;
+    FOC_Sched_Tasks[FOC_Sched_Task_Count].remaining = (phase > 0U) ? phase : period; // Son işlenen tick'e göre
+    FOC_Sched_Task_Count++;
+
+    // Hiperperiyot = EKOK, dilim ölçümleri yeni hiperperiyoda göre sıfırlanır
+    FOC_Sched_Hyperperiod = (FOC_Sched_Hyperperiod / FOC_Sched_GCD(FOC_Sched_Hyperperiod, period)) * period;
+    for(uint32_t i = 0; i < FOC_SCHED_MAX_SLOTS; i++){
+        FOC_Bench_Reset(&FOC_Sched_Slot_Bench[i], FOC_Sched_Tick_Period);
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+// Akım ISR'ından çağrılır, süresi birkaç çevrimdir
+void FOC_Scheduler_Tick(void){
+    FOC_Sched_Tick_Count++;
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Scheduler_Run(void){
+    uint32_t tick = FOC_Sched_Tick_Count;
+    uint32_t elapsed = tick - FOC_Sched_Last_Tick; // İşaretsiz fark, tick taşmasında da doğru
+
+    if(elapsed == 0U){
+        return;
+    }
+    if(elapsed > 1U){
+        FOC_Sched_Missed_Ticks += elapsed - 1U;
+    }
+    FOC_Sched_Last_Tick = tick;
+    FOC_Sched_Slot = (FOC_Sched_Slot + elapsed) % FOC_Sched_Hyperperiod;
+
+    FOC_Bench_t *pBench = &FOC_Sched_Slot_Bench[FOC_Sched_Slot % FOC_SCHED_MAX_SLOTS];
+
+    FOC_Bench_Start(pBench);
+    for(uint32_t i = 0; i < FOC_Sched_Task_Count; i++){
+        FOC_Sched_Entry_t *pTask = &FOC_Sched_Tasks[i];
+
+        if(elapsed < pTask->remaining){
+            pTask->remaining -= (uint16_t)elapsed;
+            continue;
+        }
+
+        // Atlanan tick'lerde kaçırılan çalışmalar birleşir, faz periyoda göre korunur
+        uint32_t overshoot = (elapsed - pTask->remaining) % pTask->period;
+        pTask->remaining = (uint16_t)(pTask->period - overshoot);
+        pTask->task(FOC_Sched_Handle);
+    }
+    FOC_Bench_Stop(pBench);
+}
+
+// ------------------------------------------------------------------------------
+
+uint32_t FOC_Scheduler_Get_Tick(void){
+    return FOC_Sched_Tick_Count;
+}
+
+// ------------------------------------------------------------------------------
+
+uint32_t FOC_Scheduler_Get_Hyperperiod(void){
+    return FOC_Sched_Hyperperiod;
+}
+
+// ------------------------------------------------------------------------------
+
+uint32_t FOC_Scheduler_Get_Missed_Ticks(void){
+    return FOC_Sched_Missed_Ticks;
+}
+
+// ------------------------------------------------------------------------------
+
+const FOC_Bench_t *FOC_Scheduler_Get_Slot_Bench(uint32_t slot){
+    return &FOC_Sched_Slot_Bench[slot % FOC_SCHED_MAX_SLOTS];
+}
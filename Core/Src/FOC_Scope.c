@@ -0,0 +1,363 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül akım döngüsü sinyallerini her tick (tam ISR hızında) RAM'e kaydeden yerleşik bir osiloskoptur.
+// Akım döngüsü hatalarını görmek için gereken tick bazında veri hiçbir akış (UART / CAN telemetri) hızına sığmaz;
+// bu yüzden önce RAM'e kaydedilir, kayıt bitince UART veya CAN üzerinden yavaşça indirilir.
+// Kanallar FOC_Handle_t içindeki alanlardan byte ofseti ile seçilir. Ofset telemetri sinyal kataloğunda
+// (FOC_Telem_Signals) olmalıdır: alanın tipi oradan alınır, yeni sinyal katalog tablosuna bir satır eklemektir.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// Tampon: 12 KB, kanal sayısına göre bölünür (derinlik = 3072 / kanal sayısı örnek, 4 kanal -> 768 örnek,
+// 20 kHz'de 38 ms). Örnekler [örnek][kanal] sırasıyla halka olarak yazılır.
+// Ön / son tetik: kurulunca (Arm) önce pre_samples örnek toplanır, sonra her örnekte tetik koşulu kontrol edilir.
+// Tetik anında kaydın başlangıcı (tetikten pre_samples önceki örnek) saklanır ve derinlik dolana kadar
+// kayıt sürer; böylece kayıt tetikten önceki ve sonraki olayları birlikte içerir.
+// Tetik: tetik sinyali (kanallardan bağımsız, herhangi bir alan) seviye ile karşılaştırılır; kenar modları
+// bir önceki örneği kullanır. FOC_Scope_Fault() (koruma kodu, komut) ön tetik dolmamış olsa bile her modda
+// tetikler; bu durumda kayıttaki tetik indeksi toplanabilen ön tetik örneği kadardır.
+// Decimation: her 'decimation' tick'te bir örnek alınır, tetik de bu hızda değerlendirilir.
+// ISR maliyeti: kapalıyken (IDLE / DONE) yalnızca durum karşılaştırması; kayıtta kanal başına bir yükleme
+// ve bir saklama + tetik karşılaştırması. Bölme yoktur. U8 / BOOL alanlar (fcs_state, *_ctrl_mode) byte olarak
+// okunup float'a çevrilir (bir dönüşüm komutu); kayıt ve tetik seviyesi her zaman float değerdir.
+// İndirme: kayıt tetik öncesi ilk örnekten başlayacak şekilde doğrusal word ofsetleriyle okunur
+// (ofset = örnek * kanal sayısı + kanal). Halka sarması okuma tarafında çözülür.
+// İstek / yanıt (FOC_Scope_Request) taşıyıcıdan bağımsızdır: FOC_UART (FOC_UART_TYPE_SCOPE) ve
+// FOC_CAN (FOC_CAN_CMD_SCOPE -> FOC_CAN_ID_SCOPE) aynı mesajları taşır.
+// Kayıt sürerken ayarlar değiştirilmez: Configure / Arm önce durumu IDLE yapar, akım ISR'ı araya girerse
+// IDLE görür ve hiçbir şey yazmaz.
+// RAM bütçesi: diğer modüllerin büyük tamponları + stack / heap + pay ile toplam 32 KB'a sığdığı
+// derleme anında _Static_assert ile doğrulanır. Bir modülün tamponu büyütülürse kontrol hata verir.
+// Tamponları .c içinde gizli olan modüller (FOC_Telemetry, FOC_Param) başlıkta bir üst sınır (x_RAM_BYTES)
+// verir; sınırın gerçek tamponları kapsadığı modülün kendi .c dosyasında kontrol edilir.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. FOC_Scope_Init() çağrılır.
+// 2. Akım ISR'ının sonunda, FOC_Current_Controller'dan sonra FOC_Scope_Sample(&hfoc) çağrılır.
+// 3. Ayar örneği (i_q ref / ölçüm, u_q, açı; i_q_ref 2 A'yı yukarı keserse, 1/4 ön tetik):
+//      FOC_Scope_Config_t cfg = {0};
+//      cfg.channel_count = 4; cfg.decimation = 1;
+//      cfg.channel[0] = FOC_SCOPE_SIGNAL(state.i_q_ref); cfg.channel[1] = FOC_SCOPE_SIGNAL(state.i_q);
+//      cfg.channel[2] = FOC_SCOPE_SIGNAL(state.u_q);     cfg.channel[3] = FOC_SCOPE_SIGNAL(input.Electrical_Angle_rad);
+//      cfg.trigger_mode = FOC_SCOPE_TRIG_RISING; cfg.trigger_signal = FOC_SCOPE_SIGNAL(state.i_q_ref);
+//      cfg.trigger_level = 2.0f; cfg.pre_samples = 192;
+//      FOC_Scope_Configure(&cfg); FOC_Scope_Arm();
+// 4. Host aynı ayarı FOC_SCOPE_OP_CONFIG / ARM istekleriyle de yapabilir, INFO ile DONE durumunu bekler
+//    ve READ ile kaydı indirir (UART: 58 word / çerçeve, CAN: 14 word / çerçeve).
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_Scope.h"
+#include "FOC_Scheduler.h"
+#include "FOC_Estimator.h"
+#include "FOC_Trajectory.h"
+#include "FOC_Telemetry.h"
+#include "FOC_Param.h"
+#include "FOC_UART.h"
+#include "FOC_Log.h"
+#include <string.h>
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+#define FOC_SCOPE_BUFFER_WORDS (FOC_SCOPE_BUFFER_BYTES / 4U)
+
+// RAM bütçesi (STM32G431: 32 KB SRAM)
+#define FOC_SCOPE_RAM_SIZE   (32U * 1024U)
+#define FOC_SCOPE_RAM_STACK  (0x400U + 0x200U) // _Min_Stack_Size + _Min_Heap_Size (STM32G431XX_FLASH.ld)
+#define FOC_SCOPE_RAM_MARGIN (4U * 1024U)      // Küçük modül değişkenleri, HAL handle'ları, iç içe ISR stack'i
+#define FOC_SCOPE_RAM_OTHERS (FOC_UART_TX_SIZE + FOC_UART_RX_DMA_SIZE + \
+                              (FOC_LOG_RING_WORDS * sizeof(uint32_t)) + FOC_LOG_TEXT_MAX + \
+                              (FOC_TRAJ_QUEUE_SIZE * sizeof(FOC_Traj_Point_t)) + \
+                              (FOC_EST_BUFFER_SIZE * sizeof(FOC_Est_Sample_t)) + \
+                              (FOC_SCHED_MAX_SLOTS * sizeof(FOC_Bench_t)) + \
+                              FOC_TELEM_RAM_BYTES + FOC_PARAM_RAM_BYTES + \
+                              (2U * sizeof(FOC_Handle_t))) // hfoc + FOC_Benchmark'ın ölçüm kopyası
+
+_Static_assert(FOC_SCOPE_BUFFER_BYTES + FOC_SCOPE_RAM_OTHERS + FOC_SCOPE_RAM_STACK + FOC_SCOPE_RAM_MARGIN <= FOC_SCOPE_RAM_SIZE,
+               "Scope tamponu diğer modüllerle birlikte 32 KB RAM'e sığmıyor, FOC_SCOPE_BUFFER_BYTES küçültülmeli");
+_Static_assert(sizeof(FOC_Scope_Header_t) == 8U, "Scope mesaj başlığı 8 byte olmalı");
+_Static_assert(sizeof(FOC_Scope_Info_t) == 12U, "Scope bilgi yapısı 12 byte olmalı");
+_Static_assert(sizeof(FOC_Scope_Header_t) + sizeof(FOC_Scope_Config_t) <= 60U, "Scope ayarı tek CAN komut çerçevesine sığmalı");
+
+static float FOC_Scope_Buffer[FOC_SCOPE_BUFFER_WORDS];
+
+// Ayarlar (sadece IDLE iken yazılır)
+static uint16_t FOC_Scope_Offset[FOC_SCOPE_MAX_CHANNELS];
+static uint8_t FOC_Scope_Type[FOC_SCOPE_MAX_CHANNELS];  // FOC_TELEM_TYPE_x
+static uint32_t FOC_Scope_Channels = 0;
+static uint32_t FOC_Scope_Depth = 0;       // Kanal başına örnek
+static uint32_t FOC_Scope_Pre = 0;
+static uint32_t FOC_Scope_Decimation = 1;
+static uint32_t FOC_Scope_Trigger_Mode = FOC_SCOPE_TRIG_AUTO;
+static uint16_t FOC_Scope_Trigger_Offset = 0;
+static uint8_t FOC_Scope_Trigger_Type = FOC_TELEM_TYPE_FLOAT;
+static float FOC_Scope_Trigger_Level = 0.0f;
+
+// Kayıt durumu (akım ISR'ı yazar)
+static volatile uint8_t FOC_Scope_State = FOC_SCOPE_STATE_IDLE;
+static volatile bool FOC_Scope_Fault_Flag = false;
+static uint32_t FOC_Scope_Write = 0;       // Bir sonraki örneğin halka indeksi
+static uint32_t FOC_Scope_Filled = 0;      // Toplanan ön tetik örneği
+static uint32_t FOC_Scope_Remaining = 0;   // Tetikten sonra toplanacak örnek
+static uint32_t FOC_Scope_Decim_Count = 1;
+static float FOC_Scope_Previous = 0.0f;    // Kenar tetiği için bir önceki örnek
+static uint32_t FOC_Scope_Start = 0;       // Kaydın ilk örneğinin halka indeksi
+static uint32_t FOC_Scope_Trigger_Sample = 0;
+static uint32_t FOC_Scope_Trigger_Tick = 0;
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+// Alan katalogda olmalı: tip bilinmeyen bir ofset float diye okunursa uint32 / enum / bool alanlar anlamsız kaydedilir
+static inline float FOC_Scope_Load(const FOC_Handle_t *pHandle, uint16_t offset, uint8_t type){
+    const uint8_t *pField = (const uint8_t *)pHandle + offset;
+
+    if(type == FOC_TELEM_TYPE_FLOAT) return *(const float *)pField;
+    return (float)*pField; // FOC_TELEM_TYPE_U8 / BOOL
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Scope_Init(void){
+    FOC_Scope_State = FOC_SCOPE_STATE_IDLE;
+    FOC_Scope_Fault_Flag = false;
+    FOC_Scope_Channels = 0;
+    FOC_Scope_Depth = 0;
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Scope_Configure(const FOC_Scope_Config_t *pConfig){
+    FOC_Scope_Stop();
+
+    if(pConfig->channel_count == 0U || pConfig->channel_count > FOC_SCOPE_MAX_CHANNELS) return false;
+    if(pConfig->decimation == 0U || pConfig->trigger_mode > FOC_SCOPE_TRIG_FAULT) return false;
+    uint8_t trigger_type;
+    uint8_t type[FOC_SCOPE_MAX_CHANNELS];
+    if(FOC_Telemetry_Signal_Type(pConfig->trigger_signal, &trigger_type) == false) return false;
+    for(uint32_t i = 0; i < pConfig->channel_count; i++){
+        if(FOC_Telemetry_Signal_Type(pConfig->channel[i], &type[i]) == false) return false;
+    }
+
+    uint32_t depth = FOC_SCOPE_BUFFER_WORDS / pConfig->channel_count;
+    if(pConfig->pre_samples >= depth) return false;
+
+    for(uint32_t i = 0; i < pConfig->channel_count; i++){
+        FOC_Scope_Offset[i] = pConfig->channel[i];
+        FOC_Scope_Type[i] = type[i];
+    }
+    FOC_Scope_Channels = pConfig->channel_count;
+    FOC_Scope_Depth = depth;
+    FOC_Scope_Pre = pConfig->pre_samples;
+    FOC_Scope_Decimation = pConfig->decimation;
+    FOC_Scope_Trigger_Mode = pConfig->trigger_mode;
+    FOC_Scope_Trigger_Offset = pConfig->trigger_signal;
+    FOC_Scope_Trigger_Type = trigger_type;
+    FOC_Scope_Trigger_Level = pConfig->trigger_level;
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Scope_Arm(void){
+    if(FOC_Scope_Depth == 0U) return false;
+
+    FOC_Scope_Stop();
+    FOC_Scope_Write = 0;
+    FOC_Scope_Filled = 0;
+    FOC_Scope_Decim_Count = 1;
+    FOC_Scope_Trigger_Sample = 0;
+    FOC_Scope_Fault_Flag = false;
+    __DMB();
+    FOC_Scope_State = (FOC_Scope_Pre == 0U) ? FOC_SCOPE_STATE_ARMED : FOC_SCOPE_STATE_PRETRIGGER;
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Scope_Stop(void){
+    FOC_Scope_State = FOC_SCOPE_STATE_IDLE;
+    __DMB();
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Scope_Fault(void){
+    FOC_Scope_Fault_Flag = true;
+}
+
+// ------------------------------------------------------------------------------
+
+static bool FOC_Scope_Condition(float value){
+    float level = FOC_Scope_Trigger_Level;
+    float previous = FOC_Scope_Previous;
+
+    switch(FOC_Scope_Trigger_Mode){
+        case FOC_SCOPE_TRIG_AUTO:    return true;
+        case FOC_SCOPE_TRIG_RISING:  return (previous < level) && (value >= level);
+        case FOC_SCOPE_TRIG_FALLING: return (previous > level) && (value <= level);
+        case FOC_SCOPE_TRIG_EDGE:    return ((previous < level) && (value >= level)) || ((previous > level) && (value <= level));
+        case FOC_SCOPE_TRIG_ABOVE:   return value >= level;
+        case FOC_SCOPE_TRIG_BELOW:   return value <= level;
+        default:                     return false;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Scope_Sample(const FOC_Handle_t *pHandle){
+    uint8_t state = FOC_Scope_State;
+
+    if(state == FOC_SCOPE_STATE_IDLE || state == FOC_SCOPE_STATE_DONE) return;
+    if(--FOC_Scope_Decim_Count != 0U) return;
+    FOC_Scope_Decim_Count = FOC_Scope_Decimation;
+
+    float *pDst = &FOC_Scope_Buffer[FOC_Scope_Write * FOC_Scope_Channels];
+    for(uint32_t i = 0; i < FOC_Scope_Channels; i++){
+        pDst[i] = FOC_Scope_Load(pHandle, FOC_Scope_Offset[i], FOC_Scope_Type[i]);
+    }
+
+    if(state == FOC_SCOPE_STATE_TRIGGERED){
+        if(--FOC_Scope_Remaining == 0U) FOC_Scope_State = FOC_SCOPE_STATE_DONE;
+    }
+    else{
+        float value = FOC_Scope_Load(pHandle, FOC_Scope_Trigger_Offset, FOC_Scope_Trigger_Type);
+        bool fault = FOC_Scope_Fault_Flag;
+
+        if(fault || (state == FOC_SCOPE_STATE_ARMED && FOC_Scope_Condition(value))){
+            // Bu örnek tetik örneğidir, kayıt Filled örnek öncesinden başlar
+            FOC_Scope_Start = (FOC_Scope_Write + FOC_Scope_Depth - FOC_Scope_Filled) % FOC_Scope_Depth;
+            FOC_Scope_Trigger_Sample = FOC_Scope_Filled;
+            FOC_Scope_Trigger_Tick = FOC_Scheduler_Get_Tick();
+            FOC_Scope_Remaining = FOC_Scope_Depth - FOC_Scope_Filled - 1U;
+            FOC_Scope_State = (FOC_Scope_Remaining == 0U) ? FOC_SCOPE_STATE_DONE : FOC_SCOPE_STATE_TRIGGERED;
+        }
+        else if(FOC_Scope_Filled < FOC_Scope_Pre){
+            if(++FOC_Scope_Filled == FOC_Scope_Pre) FOC_Scope_State = FOC_SCOPE_STATE_ARMED;
+        }
+        FOC_Scope_Previous = value;
+    }
+
+    if(++FOC_Scope_Write == FOC_Scope_Depth) FOC_Scope_Write = 0;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Scope_Get_Info(FOC_Scope_Info_t *pInfo){
+    pInfo->state = FOC_Scope_State;
+    pInfo->channel_count = (uint8_t)FOC_Scope_Channels;
+    pInfo->decimation = (uint16_t)FOC_Scope_Decimation;
+    pInfo->depth = (uint16_t)FOC_Scope_Depth;
+    pInfo->trigger_sample = (uint16_t)FOC_Scope_Trigger_Sample;
+    pInfo->trigger_tick = FOC_Scope_Trigger_Tick;
+}
+
+// ------------------------------------------------------------------------------
+
+uint32_t FOC_Scope_Read(uint32_t offset, float *pDst, uint32_t count){
+    uint32_t total = FOC_Scope_Depth * FOC_Scope_Channels;
+
+    if(FOC_Scope_State != FOC_SCOPE_STATE_DONE || offset >= total) return 0;
+    if(count > total - offset) count = total - offset;
+
+    uint32_t sample = offset / FOC_Scope_Channels;
+    uint32_t channel = offset % FOC_Scope_Channels;
+    uint32_t ring = (FOC_Scope_Start + sample) % FOC_Scope_Depth;
+
+    for(uint32_t i = 0; i < count; i++){
+        pDst[i] = FOC_Scope_Buffer[(ring * FOC_Scope_Channels) + channel];
+        if(++channel == FOC_Scope_Channels){
+            channel = 0;
+            if(++ring == FOC_Scope_Depth) ring = 0;
+        }
+    }
+    return count;
+}
+
+// ------------------------------------------------------------------------------
+
+// Taşıyıcıdan bağımsız istek işleyici, yanıt uzunluğunu döner (başlık dahil)
+uint16_t FOC_Scope_Request(const uint8_t *pRequest, uint16_t length, uint8_t *pResponse, uint16_t max_length){
+    FOC_Scope_Header_t request;
+    FOC_Scope_Header_t response;
+    uint16_t data_length = 0;
+    uint8_t *pData = &pResponse[sizeof(FOC_Scope_Header_t)];
+
+    if(length < sizeof(request) || max_length < sizeof(response)) return 0;
+    memcpy(&request, pRequest, sizeof(request));
+
+    response.op = request.op;
+    response.status = FOC_SCOPE_OK;
+    response.count = 0;
+    response.reserved = 0;
+    response.offset = request.offset;
+
+    switch(request.op){
+        case FOC_SCOPE_OP_CONFIG:{
+            FOC_Scope_Config_t config;
+            if(length < sizeof(request) + sizeof(config)){
+                response.status = FOC_SCOPE_ERR_ARG;
+                break;
+            }
+            memcpy(&config, &pRequest[sizeof(request)], sizeof(config));
+            if(FOC_Scope_Configure(&config) == false) response.status = FOC_SCOPE_ERR_ARG;
+            break;
+        }
+        case FOC_SCOPE_OP_ARM:
+            if(FOC_Scope_Arm() == false) response.status = FOC_SCOPE_ERR_STATE;
+            break;
+        case FOC_SCOPE_OP_STOP:
+            FOC_Scope_Stop();
+            break;
+        case FOC_SCOPE_OP_FORCE:
+            FOC_Scope_Fault();
+            break;
+        case FOC_SCOPE_OP_INFO:{
+            FOC_Scope_Info_t info;
+            if(max_length < sizeof(response) + sizeof(info)){
+                response.status = FOC_SCOPE_ERR_ARG;
+                break;
+            }
+            FOC_Scope_Get_Info(&info);
+            memcpy(pData, &info, sizeof(info));
+            data_length = sizeof(info);
+            break;
+        }
+        case FOC_SCOPE_OP_READ:{
+            uint32_t count = request.count;
+            uint32_t room = (max_length - sizeof(response)) / sizeof(float);
+            float words[FOC_SCOPE_MAX_CHANNELS];
+            if(count > room) count = room;
+            if(FOC_Scope_State != FOC_SCOPE_STATE_DONE){
+                response.status = FOC_SCOPE_ERR_STATE;
+                break;
+            }
+            // Yanıt tamponu hizalı olmayabilir, kanal sayısı kadar parçalarla kopyalanır
+            uint32_t done = 0;
+            while(done < count){
+                uint32_t chunk = count - done;
+                if(chunk > FOC_SCOPE_MAX_CHANNELS) chunk = FOC_SCOPE_MAX_CHANNELS;
+                chunk = FOC_Scope_Read(request.offset + done, words, chunk);
+                if(chunk == 0U) break;
+                memcpy(&pData[done * sizeof(float)], words, chunk * sizeof(float));
+                done += chunk;
+            }
+            if(done == 0U && count != 0U) response.status = FOC_SCOPE_ERR_ARG;
+            response.count = (uint8_t)done;
+            data_length = (uint16_t)(done * sizeof(float));
+            break;
+        }
+        default:
+            response.status = FOC_SCOPE_ERR_OP;
+            break;
+    }
+
+    memcpy(pResponse, &response, sizeof(response));
+    return (uint16_t)(sizeof(response) + data_length);
+}
@@ -0,0 +1,383 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül abonelik tabanlı telemetridir. Sabit telemetri çerçevesi yerine host istediği sinyallere abone olur,
+// her sinyal kendi decimation oranıyla örneklenir. Örnekler tamsayıya ölçeklenir, bir önceki örneğe göre
+// farkı alınır ve zigzag + varint ile kodlanarak UART veya CAN üzerinden paketler halinde gönderilir.
+// Sinyaller bir kayıt tablosunda (FOC_Telem_Signals) FOC_Handle_t ofseti, tipi ve ölçeği ile tanımlıdır;
+// yeni sinyal eklemek tabloya bir satır eklemektir. Host tabloyu katalog isteği ile okuyabilir.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// Görev (PendSV) her çalışmada sırası gelen sinyalleri (run % decimation == 0) abonelik sırasıyla okur:
+//   q     = round(değer * scale)   (U8 / BOOL için ham değer)
+//   fark  = q - önceki q           (paketin ilk örneğinde önceki q = 0, yani mutlak değer)
+//   zigzag: (fark << 1) ^ (fark >> 31)  -> küçük pozitif / negatif farklar küçük pozitif sayı olur
+//   varint: 7 bit'lik gruplar, devam biti ile (0 ... 63 arası fark tek byte)
+// Her paket bağımsız çözülür (ilk örnekler mutlak): kaybolan paket sonraki paketleri bozmaz.
+// Paket başlığı ilk çalışmanın tick'ini ve abonelikten bu yana sırasını taşır; host her çalışmada hangi
+// sinyallerin geldiğini decimation'lardan kendisi hesaplar, örnek başına kimlik veya zaman gönderilmez.
+// Bir çalışmanın örnekleri önce ayrı tampona kodlanır, gerçek boyutu pakete sığmıyorsa paket gönderilir ve
+// çalışma yeni pakette mutlak değerlerle yeniden kodlanır. Paket ayrıca runs_per_packet çalışmaya ulaşınca gönderilir.
+// Abonelik, tüm sinyallerin aynı çalışmaya düştüğü en kötü durum (başlık + sinyal başına 5 byte) çıkışın paket
+// boyutuna sığacak kadar sinyalle sınırlıdır: CAN (64 byte) için 10, UART (240 byte) için 16 sinyal.
+// Kazanç: 10 kHz'de i_d, i_q, u_d, u_q, açı ve hız için tipik fark 1 byte'tır; float (4 byte) yerine ~1.2 byte
+// / örnek, çerçeve başlığı paket başına bir kez -> aynı bağlantıda ~3 kat sinyal.
+// Abonelik değişikliği iki aşamalıdır: istek (UART / CAN ISR) bekleyen tabloya yazılır, görev bir sonraki
+// çalışmasında uygular ve nesil numarasını artırır. Görev tabloyu okurken istek tabloyu değiştiremez.
+// İstek kontrolü ve bekleyen tabloya yazma FOC_TELEM_IRQ_PRIORITY (FDCAN) ve altını maskeleyen BASEPRI altında
+// yapılır, UART ve CAN'den aynı anda gelen istekler birbirinin tablosunu bozmaz.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. FOC_Telemetry_Init(&hfoc, 2);                                        // Görev periyodu: 2 tick (10 kHz)
+//    FOC_Telemetry_Set_Sink(FOC_UART_Stream_Sink, FOC_UART_MAX_PAYLOAD);  // veya FOC_CAN_Stream_Sink, FOC_CAN_FRAME_SIZE
+//    FOC_Scheduler_Add_Task(FOC_Telemetry_Task, 2, 1);
+// 2. Host abonelik isteği gönderir (UART: FOC_UART_TYPE_SUBSCRIBE, CAN: FOC_CAN_CMD_SUBSCRIBE):
+//    FOC_Telem_Subscribe_t + count x FOC_Telem_Sub_Entry_t (CAN'da en fazla 10, UART'ta 16 sinyal).
+// 3. Paketler FOC_UART_TYPE_STREAM / FOC_CAN_ID_STREAM ile gelir. Katalog: FOC_UART_TYPE_CATALOG.
+// 4. Yeni sinyal: FOC_Telem_Signals tablosunun sonuna FOC_TELEM_SIGNAL(alan, tip, ölçek, isim) eklenir.
+//    Var olan satırların sırası değiştirilmemelidir (host sinyalleri indeksle seçer).
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_Telemetry.h"
+#include "FOC_Scheduler.h"
+#include <stddef.h>
+#include <string.h>
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+#define FOC_TELEM_VARINT_MAX 5U // 32 bit değerin en uzun varint'i
+#define FOC_TELEM_MAX_RUNS   255U
+#define FOC_TELEM_BASEPRI    (FOC_TELEM_IRQ_PRIORITY << (8U - __NVIC_PRIO_BITS))
+
+typedef struct{
+    uint16_t offset;
+    uint8_t type;
+    float scale;
+    char name[FOC_TELEM_NAME_SIZE];
+} FOC_Telem_Signal_t;
+
+#define FOC_TELEM_SIGNAL(field, type, scale, name) { (uint16_t)offsetof(FOC_Handle_t, field), (type), (scale), name }
+
+// Sinyal kayıt tablosu. Ölçek: akım mA, gerilim 10 mV, hız 0.01 rad/s, açı / pozisyon 0.1 mrad, duty 1e-4
+static const FOC_Telem_Signal_t FOC_Telem_Signals[] = {
+    FOC_TELEM_SIGNAL(input.i_a_meas,             FOC_TELEM_TYPE_FLOAT, 1000.0f,  "i_a"),
+    FOC_TELEM_SIGNAL(input.i_b_meas,             FOC_TELEM_TYPE_FLOAT, 1000.0f,  "i_b"),
+    FOC_TELEM_SIGNAL(input.w_rad_s,              FOC_TELEM_TYPE_FLOAT, 100.0f,   "w"),
+    FOC_TELEM_SIGNAL(input.Electrical_Angle_rad, FOC_TELEM_TYPE_FLOAT, 10000.0f, "angle"),
+    FOC_TELEM_SIGNAL(input.T_mot_ref,            FOC_TELEM_TYPE_FLOAT, 1000.0f,  "T_ref"),
+    FOC_TELEM_SIGNAL(input.U_bat,                FOC_TELEM_TYPE_FLOAT, 100.0f,   "U_bat"),
+    FOC_TELEM_SIGNAL(input.speed_ref_rad_s,      FOC_TELEM_TYPE_FLOAT, 100.0f,   "speed_cmd"),
+    FOC_TELEM_SIGNAL(input.position_rad,         FOC_TELEM_TYPE_FLOAT, 10000.0f, "position"),
+    FOC_TELEM_SIGNAL(input.position_ref_rad,     FOC_TELEM_TYPE_FLOAT, 10000.0f, "position_ref"),
+    FOC_TELEM_SIGNAL(state.i_d_ref,              FOC_TELEM_TYPE_FLOAT, 1000.0f,  "i_d_ref"),
+    FOC_TELEM_SIGNAL(state.i_q_ref,              FOC_TELEM_TYPE_FLOAT, 1000.0f,  "i_q_ref"),
+    FOC_TELEM_SIGNAL(state.i_alpha,              FOC_TELEM_TYPE_FLOAT, 1000.0f,  "i_alpha"),
+    FOC_TELEM_SIGNAL(state.i_beta,               FOC_TELEM_TYPE_FLOAT, 1000.0f,  "i_beta"),
+    FOC_TELEM_SIGNAL(state.i_d,                  FOC_TELEM_TYPE_FLOAT, 1000.0f,  "i_d"),
+    FOC_TELEM_SIGNAL(state.i_q,                  FOC_TELEM_TYPE_FLOAT, 1000.0f,  "i_q"),
+    FOC_TELEM_SIGNAL(state.u_d,                  FOC_TELEM_TYPE_FLOAT, 100.0f,   "u_d"),
+    FOC_TELEM_SIGNAL(state.u_q,                  FOC_TELEM_TYPE_FLOAT, 100.0f,   "u_q"),
+    FOC_TELEM_SIGNAL(state.fw_i_d,               FOC_TELEM_TYPE_FLOAT, 1000.0f,  "fw_i_d"),
+    FOC_TELEM_SIGNAL(state.i_q_limit,            FOC_TELEM_TYPE_FLOAT, 1000.0f,  "i_q_limit"),
+    FOC_TELEM_SIGNAL(state.d_q_max_voltage,      FOC_TELEM_TYPE_FLOAT, 100.0f,   "u_max"),
+    FOC_TELEM_SIGNAL(state.speed_ref,            FOC_TELEM_TYPE_FLOAT, 100.0f,   "speed_ref"),
+    FOC_TELEM_SIGNAL(state.speed_integrator,     FOC_TELEM_TYPE_FLOAT, 1000.0f,  "speed_int"),
+    FOC_TELEM_SIGNAL(state.fcs_state,            FOC_TELEM_TYPE_U8,    1.0f,     "fcs_state"),
+    FOC_TELEM_SIGNAL(output.duty_a,              FOC_TELEM_TYPE_FLOAT, 10000.0f, "duty_a"),
+    FOC_TELEM_SIGNAL(output.duty_b,              FOC_TELEM_TYPE_FLOAT, 10000.0f, "duty_b"),
+    FOC_TELEM_SIGNAL(output.duty_c,              FOC_TELEM_TYPE_FLOAT, 10000.0f, "duty_c"),
+    FOC_TELEM_SIGNAL(config.current_ctrl_mode,   FOC_TELEM_TYPE_BOOL,  1.0f,     "current_on"),
+    FOC_TELEM_SIGNAL(config.speed_ctrl_mode,     FOC_TELEM_TYPE_BOOL,  1.0f,     "speed_on"),
+    FOC_TELEM_SIGNAL(config.position_ctrl_mode,  FOC_TELEM_TYPE_BOOL,  1.0f,     "position_on"),
+};
+
+#define FOC_TELEM_SIGNAL_COUNT (sizeof(FOC_Telem_Signals) / sizeof(FOC_Telem_Signals[0]))
+
+_Static_assert(FOC_TELEM_SIGNAL_COUNT <= 255U, "Sinyal indeksi 1 byte");
+_Static_assert(sizeof(FOC_Telem_Header_t) == 10U, "Paket başlığı 10 byte olmalı");
+_Static_assert(sizeof(FOC_Telem_Catalog_t) == 20U, "Katalog girişi 20 byte olmalı");
+
+typedef struct{
+    const FOC_Telem_Signal_t *pSignal;
+    uint16_t decimation;
+    uint16_t countdown; // 0 olduğunda bu çalışmada örneklenir
+    int32_t last;       // Paket içindeki bir önceki kodlanmış değer
+} FOC_Telem_Sub_t;
+
+static uint16_t FOC_Telem_Period = 1;
+static FOC_Telem_Sink_t FOC_Telem_Sink = 0;
+static uint16_t FOC_Telem_Max_Packet = FOC_TELEM_MAX_PACKET;
+static FOC_Telem_Stats_t FOC_Telem_Stats;
+
+// Görevin kullandığı abonelik (sadece görev yazar)
+static FOC_Telem_Sub_t FOC_Telem_Subs[FOC_TELEM_MAX_SUBS];
+static uint32_t FOC_Telem_Sub_Count = 0;
+static uint32_t FOC_Telem_Runs_Limit = FOC_TELEM_MAX_RUNS;
+static uint8_t FOC_Telem_Generation = 0;
+static uint32_t FOC_Telem_Run = 0;
+
+// Bekleyen abonelik (istek yazar, Pending true iken sadece görev okur)
+static FOC_Telem_Sub_Entry_t FOC_Telem_Pending_Subs[FOC_TELEM_MAX_SUBS];
+static uint32_t FOC_Telem_Pending_Count = 0;
+static uint32_t FOC_Telem_Pending_Runs = 0;
+static volatile bool FOC_Telem_Pending = false;
+
+// Oluşturulan paket ve bir çalışmanın kodlama tamponu
+static uint8_t FOC_Telem_Packet[FOC_TELEM_MAX_PACKET];
+static uint8_t FOC_Telem_Run_Buffer[FOC_TELEM_MAX_SUBS * FOC_TELEM_VARINT_MAX];
+static int32_t FOC_Telem_Values[FOC_TELEM_MAX_SUBS];
+static uint32_t FOC_Telem_Used = 0;   // 0: paket açık değil
+static uint32_t FOC_Telem_Runs = 0;
+static FOC_Telem_Header_t FOC_Telem_Header;
+
+_Static_assert(sizeof(FOC_Telem_Packet) + sizeof(FOC_Telem_Run_Buffer) + sizeof(FOC_Telem_Values) + sizeof(FOC_Telem_Subs) +
+               sizeof(FOC_Telem_Pending_Subs) + sizeof(FOC_Telem_Header) <= FOC_TELEM_RAM_BYTES, "FOC_TELEM_RAM_BYTES güncellenmeli");
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+void FOC_Telemetry_Init(FOC_Handle_t *pHandle, uint16_t period){
+    (void)pHandle; // Sinyaller her çalışmada görevin aldığı handle'dan okunur
+    FOC_Telem_Period = (period == 0U) ? 1U : period;
+    FOC_Telem_Sub_Count = 0;
+    FOC_Telem_Pending = false;
+    FOC_Telem_Used = 0;
+    FOC_Telem_Run = 0;
+    memset(&FOC_Telem_Stats, 0, sizeof(FOC_Telem_Stats));
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Telemetry_Set_Sink(FOC_Telem_Sink_t sink, uint16_t max_packet){
+    FOC_Telem_Max_Packet = (max_packet > FOC_TELEM_MAX_PACKET) ? FOC_TELEM_MAX_PACKET : max_packet;
+    FOC_Telem_Sink = sink;
+}
+
+// ------------------------------------------------------------------------------
+
+uint8_t FOC_Telemetry_Signal_Count(void){
+    return (uint8_t)FOC_TELEM_SIGNAL_COUNT;
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Telemetry_Signal_Type(uint16_t offset, uint8_t *pType){
+    for(uint32_t i = 0; i < FOC_TELEM_SIGNAL_COUNT; i++){
+        if(FOC_Telem_Signals[i].offset == offset){
+            *pType = FOC_Telem_Signals[i].type;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------------------------------------------------
+
+uint8_t FOC_Telemetry_Subscribe(const uint8_t *pRequest, uint16_t length, FOC_Telem_Ack_t *pAck){
+    FOC_Telem_Subscribe_t header;
+    uint8_t status = 0;
+
+    pAck->generation = (uint8_t)(FOC_Telem_Generation + 1U);
+    pAck->period = FOC_Telem_Period;
+
+    // Pending kontrolü ile bekleyen tabloya yazma arasında başka bir istek araya giremez
+    uint32_t basepri = __get_BASEPRI();
+    __set_BASEPRI_MAX(FOC_TELEM_BASEPRI);
+
+    if(FOC_Telem_Pending == true){
+        status = 2;
+    }
+    else if(length < sizeof(header)){
+        status = 1;
+    }
+    else{
+        memcpy(&header, pRequest, sizeof(header));
+        if(header.count > FOC_TELEM_MAX_SUBS || length < sizeof(header) + (header.count * sizeof(FOC_Telem_Sub_Entry_t))){
+            status = 1;
+        }
+        // İlk çalışmada tüm sinyaller mutlak değerle aynı pakete düşer, en kötü durum paket boyutuna sığmalı
+        if(sizeof(FOC_Telem_Header_t) + ((uint32_t)header.count * FOC_TELEM_VARINT_MAX) > FOC_Telem_Max_Packet){
+            status = 1;
+        }
+        for(uint32_t i = 0; status == 0U && i < header.count; i++){
+            FOC_Telem_Sub_Entry_t entry;
+            memcpy(&entry, &pRequest[sizeof(header) + (i * sizeof(entry))], sizeof(entry));
+            if(entry.signal >= FOC_TELEM_SIGNAL_COUNT || entry.decimation == 0U) status = 1;
+            FOC_Telem_Pending_Subs[i] = entry;
+        }
+        if(status == 0U){
+            FOC_Telem_Pending_Count = header.count;
+            FOC_Telem_Pending_Runs = (header.runs_per_packet == 0U) ? FOC_TELEM_MAX_RUNS : header.runs_per_packet;
+            __DMB();
+            FOC_Telem_Pending = true;
+        }
+    }
+    __set_BASEPRI(basepri);
+
+    pAck->status = status;
+    return status;
+}
+
+// ------------------------------------------------------------------------------
+
+// Çıktı: [toplam][first][adet][0] + adet x FOC_Telem_Catalog_t
+uint16_t FOC_Telemetry_Catalog(uint8_t first, uint8_t *pDst, uint16_t max_length){
+    uint32_t used = 4;
+    uint8_t count = 0;
+
+    if(max_length < used) return 0;
+
+    for(uint32_t i = first; i < FOC_TELEM_SIGNAL_COUNT && used + sizeof(FOC_Telem_Catalog_t) <= max_length; i++){
+        FOC_Telem_Catalog_t entry;
+        entry.signal = (uint8_t)i;
+        entry.type = FOC_Telem_Signals[i].type;
+        entry.offset = FOC_Telem_Signals[i].offset;
+        entry.scale = FOC_Telem_Signals[i].scale;
+        memcpy(entry.name, FOC_Telem_Signals[i].name, FOC_TELEM_NAME_SIZE);
+        memcpy(&pDst[used], &entry, sizeof(entry));
+        used += sizeof(entry);
+        count++;
+    }
+
+    pDst[0] = (uint8_t)FOC_TELEM_SIGNAL_COUNT;
+    pDst[1] = first;
+    pDst[2] = count;
+    pDst[3] = 0;
+    return (uint16_t)used;
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_Telem_Apply_Pending(void){
+    for(uint32_t i = 0; i < FOC_Telem_Pending_Count; i++){
+        FOC_Telem_Subs[i].pSignal = &FOC_Telem_Signals[FOC_Telem_Pending_Subs[i].signal];
+        FOC_Telem_Subs[i].decimation = FOC_Telem_Pending_Subs[i].decimation;
+        FOC_Telem_Subs[i].countdown = 0;
+    }
+    FOC_Telem_Sub_Count = FOC_Telem_Pending_Count;
+    FOC_Telem_Runs_Limit = FOC_Telem_Pending_Runs;
+    FOC_Telem_Generation++;
+    FOC_Telem_Run = 0;
+    FOC_Telem_Used = 0; // Eski aboneliğin yarım paketi atılır
+    __DMB();
+    FOC_Telem_Pending = false;
+}
+
+// ------------------------------------------------------------------------------
+
+static int32_t FOC_Telem_Quantize(const FOC_Handle_t *pHandle, const FOC_Telem_Signal_t *pSignal){
+    const uint8_t *pField = (const uint8_t *)pHandle + pSignal->offset;
+
+    if(pSignal->type != FOC_TELEM_TYPE_FLOAT){
+        return (int32_t)*pField;
+    }
+
+    float value = *(const float *)pField * pSignal->scale;
+    if(value >= 2147483000.0f) return INT32_MAX;
+    if(value <= -2147483000.0f) return INT32_MIN;
+    if(value != value) return 0; // NaN
+    return (int32_t)(value + ((value >= 0.0f) ? 0.5f : -0.5f));
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_Telem_Flush(void){
+    if(FOC_Telem_Used == 0U) return;
+
+    FOC_Telem_Header.runs = (uint8_t)FOC_Telem_Runs;
+    memcpy(FOC_Telem_Packet, &FOC_Telem_Header, sizeof(FOC_Telem_Header));
+
+    if(FOC_Telem_Sink((const uint8_t *)FOC_Telem_Packet, (uint16_t)FOC_Telem_Used) == true){
+        FOC_Telem_Stats.packets++;
+        FOC_Telem_Stats.bytes += FOC_Telem_Used;
+    }
+    else{
+        FOC_Telem_Stats.dropped++;
+    }
+    FOC_Telem_Used = 0;
+}
+
+// ------------------------------------------------------------------------------
+
+// Sırası gelen örnekleri paketteki önceki değerlere göre FOC_Telem_Run_Buffer'a kodlar, uzunluğu döner.
+// Önceki değerler değiştirilmez: çalışma pakete sığmazsa yeni pakette mutlak değerlerle tekrar kodlanır.
+static uint32_t FOC_Telem_Encode_Run(uint32_t due){
+    uint32_t length = 0;
+
+    for(uint32_t i = 0; i < FOC_Telem_Sub_Count; i++){
+        if((due & (1UL << i)) == 0U) continue;
+
+        int32_t delta = (int32_t)((uint32_t)FOC_Telem_Values[i] - (uint32_t)FOC_Telem_Subs[i].last);
+        uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+
+        while(zigzag >= 0x80U){
+            FOC_Telem_Run_Buffer[length++] = (uint8_t)(zigzag | 0x80U);
+            zigzag >>= 7;
+        }
+        FOC_Telem_Run_Buffer[length++] = (uint8_t)zigzag;
+    }
+    return length;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Telemetry_Task(FOC_Handle_t *pHandle){
+    if(FOC_Telem_Pending == true) FOC_Telem_Apply_Pending();
+    if(FOC_Telem_Sub_Count == 0U || FOC_Telem_Sink == 0) return;
+
+    // Bu çalışmada örneklenecek sinyaller bir kez okunur (yeniden kodlamada aynı değerler kullanılır)
+    uint32_t due = 0;
+    uint32_t due_count = 0;
+    for(uint32_t i = 0; i < FOC_Telem_Sub_Count; i++){
+        if(FOC_Telem_Subs[i].countdown == 0U){
+            due |= (1UL << i);
+            due_count++;
+            FOC_Telem_Subs[i].countdown = FOC_Telem_Subs[i].decimation;
+            FOC_Telem_Values[i] = FOC_Telem_Quantize(pHandle, FOC_Telem_Subs[i].pSignal);
+        }
+        FOC_Telem_Subs[i].countdown--;
+    }
+
+    uint32_t length = 0;
+    if(FOC_Telem_Used != 0U){
+        length = FOC_Telem_Encode_Run(due);
+        if(FOC_Telem_Used + length > FOC_Telem_Max_Packet){
+            FOC_Telem_Flush();
+        }
+    }
+    if(FOC_Telem_Used == 0U){
+        FOC_Telem_Header.tick = FOC_Scheduler_Get_Tick();
+        FOC_Telem_Header.run = FOC_Telem_Run;
+        FOC_Telem_Header.generation = FOC_Telem_Generation;
+        FOC_Telem_Used = sizeof(FOC_Telem_Header_t);
+        FOC_Telem_Runs = 0;
+        for(uint32_t i = 0; i < FOC_Telem_Sub_Count; i++) FOC_Telem_Subs[i].last = 0;
+
+        // Abonelik sınırı mutlak kodlanmış çalışmanın boş pakete sığmasını garanti eder
+        length = FOC_Telem_Encode_Run(due);
+    }
+
+    memcpy(&FOC_Telem_Packet[FOC_Telem_Used], FOC_Telem_Run_Buffer, length);
+    FOC_Telem_Used += length;
+    for(uint32_t i = 0; i < FOC_Telem_Sub_Count; i++){
+        if((due & (1UL << i)) != 0U) FOC_Telem_Subs[i].last = FOC_Telem_Values[i];
+    }
+    FOC_Telem_Stats.samples += due_count;
+
+    FOC_Telem_Runs++;
+    FOC_Telem_Run++;
+    if(FOC_Telem_Runs >= FOC_Telem_Runs_Limit) FOC_Telem_Flush();
+}
+
+// ------------------------------------------------------------------------------
+
+const FOC_Telem_Stats_t *FOC_Telemetry_Get_Stats(void){
+    return &FOC_Telem_Stats;
+}
@@ -0,0 +1,331 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül host'un seyrek gönderdiği pozisyon-hız-zaman (PVT) noktalarını sürücü üzerindeki bir kuyrukta tutar
+// ve pozisyon döngüsü hızında kübik Hermite interpolasyonu ile düzgün bir pozisyon referansı üretir.
+// Her tick'te bir setpoint göndermek yerine örn. 20 ms aralıklı noktalar gönderilir: 64 byte'lık bir CAN çerçevesi
+// 5 nokta taşır, eksen başına 1 kHz setpoint (1/4 çerçeve / ms) yerine ~10 çerçeve / s -> bus yükü ~25x azalır,
+// 100 ms aralıklı noktalarda ~125x.
+// Kuyruk boşalırsa (underrun) son noktada durulur ve host'a bildirilir; host akış kontrol durumundaki
+// boş yer kadar nokta göndererek kuyruğu taşırmadan dolu tutar.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// 1. Segment: (p0, v0) -> (p1, v1), süre T. s = t / T olmak üzere
+//      p(s) = h00 p0 + h10 T v0 + h01 p1 + h11 T v1
+//      h00 = 2s^3 - 3s^2 + 1,  h10 = s^3 - 2s^2 + s,  h01 = -2s^3 + 3s^2,  h11 = s^3 - s^2
+//    Pozisyon ve hız segment uçlarında süreklidir (C1). Türev hız ileri beslemesi olarak kullanılır:
+//      v(s) = 6 (s^2 - s) (p0 - p1) / T + (3s^2 - 4s + 1) v0 + (3s^2 - 2s) v1
+// 2. Kuyruk tek üretici (FDCAN ISR) / tek tüketici (PendSV görevi), kilitsiz halka tampondur.
+//    Start, tail'e dokunamayan üreticiden gelir: üretici sıfırlama indeksini yazar ve nesil sayacını artırır,
+//    tüketici yeni nesli görünce tail'i bu indekse taşır.
+// 3. Görev her çağrıda zamanı period tick ilerletir, süresi dolan segmentleri atlayarak gerekirse birden fazla
+//    nokta tüketir. Hedef yoksa son noktada hız 0 ile beklenir ve underrun sayılır. Underrun sırasında gelen
+//    ilk nokta, bekleme anından başlayan yeni bir segment olarak oynatılır (zaman sıçraması olmaz).
+//    END bayraklı noktaya ulaşılınca yörünge biter: referans son noktada, hız ileri beslemesi 0 bırakılır ve
+//    görev referansları yazmayı bırakır. Devam etmek için yeni bir Start gerekir.
+// 4. Durdurma: FOC_Trajectory_Stop (setpoint işleyicileri çağırır) durdurma nesil sayacını artırır ve
+//    hız ileri beslemesini sıfırlar. Görev referansları, sayacı kesmeler kapalıyken tekrar kontrol ederek yazar;
+//    böylece görevi kesen bir setpoint'in yazdığı position_ref_rad üzerine yazılmaz.
+// 5. Akış kontrolü: FOC_TRAJ_FLOW_POINTS nokta tüketildikçe, underrun başlangıcında, bitişte, durdurmada
+//    durum (next_seq, boş yer, bayraklar) geri çağırma fonksiyonu ile gönderilir.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. FOC_Trajectory_Init(&hfoc, dec); // dec = config.position_decimation
+//    FOC_Scheduler_Add_Task(FOC_Trajectory_Task, dec, (position_phase + dec - 1) % dec);
+//    (pozisyon döngüsünden bir tick önce çalışırsa referans bir periyot beklemeden kullanılır)
+// 2. config.speed_ctrl_mode ve config.position_ctrl_mode açık olmalıdır.
+// 3. Host önce Start (seq = n), sonra n, n+1, ... sıralı noktaları gönderir. Yörünge çalışırken
+//    input.position_ref_rad ve input.speed_ff_rad_s bu modül tarafından yazılır. END noktasında veya bir
+//    CAN / UART setpoint'i geldiğinde (FOC_Trajectory_Stop) referans setpoint yoluna geri bırakılır.
+// 4. Nokta zamanları SYNC ile hizalı bus tick'i cinsinden seçilirse eksenler birlikte hareket eder.
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_Trajectory.h"
+#include "stm32g4xx_hal.h"
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+#define FOC_TRAJ_QUEUE_MASK (FOC_TRAJ_QUEUE_SIZE - 1U)
+
+// Üretici -> tüketici halka tamponu
+static FOC_Traj_Point_t FOC_Traj_Queue[FOC_TRAJ_QUEUE_SIZE];
+static volatile uint32_t FOC_Traj_Head = 0;        // Sadece üretici yazar
+static volatile uint32_t FOC_Traj_Tail = 0;        // Sadece tüketici yazar
+static volatile uint32_t FOC_Traj_Reset_Index = 0; // Üretici: Start anındaki head
+static volatile uint32_t FOC_Traj_Reset_Gen = 0;   // Üretici: Start sayacı
+static volatile uint16_t FOC_Traj_Next_Seq = 0;    // Üretici: beklenen sıra numarası
+static volatile bool FOC_Traj_Seq_Error = false;   // Üretici
+static volatile uint32_t FOC_Traj_Stop_Gen = 0;    // Setpoint yolu: durdurma sayacı
+static volatile uint32_t FOC_Traj_Reset_Stop_Gen = 0; // Üretici: Start anındaki durdurma sayacı
+
+// Tüketici (interpolatör) durumu
+static uint32_t FOC_Traj_Seen_Gen = 0;
+static uint32_t FOC_Traj_Seen_Stop_Gen = 0;
+static uint16_t FOC_Traj_Period = 1;
+static float FOC_Traj_Ts = 0.0f;        // Akım döngüsü periyodu (sn)
+static float FOC_Traj_P0 = 0.0f;
+static float FOC_Traj_V0 = 0.0f;
+static float FOC_Traj_P1 = 0.0f;
+static float FOC_Traj_V1 = 0.0f;
+static uint32_t FOC_Traj_T = 1;          // Segment süresi (tick)
+static uint32_t FOC_Traj_End_Flag = 0;   // Hedef noktanın bayrakları
+static uint32_t FOC_Traj_t = 0;          // Segment içinde geçen süre (tick)
+static bool FOC_Traj_Have_Target = false;
+static bool FOC_Traj_Running = false;
+static bool FOC_Traj_Underrun = false;
+static bool FOC_Traj_Done = false;
+static uint32_t FOC_Traj_Underrun_Count = 0;
+static uint32_t FOC_Traj_Consumed = 0;   // Son bildirimden bu yana tüketilen nokta
+
+static FOC_Traj_Flow_Callback_t FOC_Traj_Flow_Callback = 0;
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+void FOC_Trajectory_Init(FOC_Handle_t *pHandle, uint16_t period){
+    FOC_Traj_Period = (period == 0U) ? 1U : period;
+    FOC_Traj_Ts = pHandle->config.Ts;
+
+    FOC_Traj_Head = 0;
+    FOC_Traj_Tail = 0;
+    FOC_Traj_Reset_Index = 0;
+    FOC_Traj_Reset_Gen = 0;
+    FOC_Traj_Seen_Gen = 0;
+    FOC_Traj_Stop_Gen = 0;
+    FOC_Traj_Reset_Stop_Gen = 0;
+    FOC_Traj_Seen_Stop_Gen = 0;
+    FOC_Traj_Next_Seq = 0;
+    FOC_Traj_Seq_Error = false;
+
+    FOC_Traj_Have_Target = false;
+    FOC_Traj_Running = false;
+    FOC_Traj_Underrun = false;
+    FOC_Traj_Done = false;
+    FOC_Traj_Underrun_Count = 0;
+    FOC_Traj_Consumed = 0;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Trajectory_Set_Flow_Callback(FOC_Traj_Flow_Callback_t callback){
+    FOC_Traj_Flow_Callback = callback;
+}
+
+// ------------------------------------------------------------------------------
+
+// Üretici: tüketici kuyruğu bir sonraki görev çağrısında bu noktaya kadar boşaltır
+void FOC_Trajectory_Start(uint16_t first_seq){
+    FOC_Traj_Next_Seq = first_seq;
+    FOC_Traj_Seq_Error = false;
+    FOC_Traj_Reset_Index = FOC_Traj_Head;
+    FOC_Traj_Reset_Stop_Gen = FOC_Traj_Stop_Gen;
+    __DMB(); // İndeks nesilden önce görünmeli
+    FOC_Traj_Reset_Gen++;
+}
+
+// ------------------------------------------------------------------------------
+
+// Setpoint yolu (akım ISR'ı / UART / CAN): her bağlamdan çağrılabilir, görev bir sonraki çağrıda durur.
+// Sayaç birden fazla bağlamdan artırılabilir; kayıp artış olsa da değer değiştiği için durdurma kaybolmaz.
+void FOC_Trajectory_Stop(FOC_Handle_t *pHandle){
+    FOC_Traj_Stop_Gen++;
+    pHandle->input.speed_ff_rad_s = 0.0f;
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_Trajectory_Push(uint16_t seq, const FOC_Traj_Point_t *pPoint){
+    uint32_t head = FOC_Traj_Head;
+
+    if(seq != FOC_Traj_Next_Seq){
+        FOC_Traj_Seq_Error = true;
+        return false;
+    }
+    // Start sonrası tail henüz taşınmamış olabilir; boş yer bu durumda olduğundan az görünür
+    if((head - FOC_Traj_Tail) >= FOC_TRAJ_QUEUE_SIZE){
+        return false;
+    }
+
+    FOC_Traj_Queue[head & FOC_TRAJ_QUEUE_MASK] = *pPoint;
+    __DMB(); // Nokta yazılmadan head yayınlanmasın
+    FOC_Traj_Head = head + 1U;
+    FOC_Traj_Next_Seq = (uint16_t)(seq + 1U);
+    FOC_Traj_Seq_Error = false;
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+static bool FOC_Traj_Pop(void){
+    uint32_t tail = FOC_Traj_Tail;
+
+    if(tail == FOC_Traj_Head){
+        return false;
+    }
+    __DMB(); // head okunduktan sonra nokta okunmalı
+
+    const FOC_Traj_Point_t *pPoint = &FOC_Traj_Queue[tail & FOC_TRAJ_QUEUE_MASK];
+    FOC_Traj_P1 = pPoint->position;
+    FOC_Traj_V1 = pPoint->velocity;
+    FOC_Traj_T = pPoint->dt_flags & FOC_TRAJ_DT_MASK;
+    FOC_Traj_End_Flag = pPoint->dt_flags & FOC_TRAJ_FLAG_END;
+    if(FOC_Traj_T == 0U) FOC_Traj_T = 1U;
+
+    FOC_Traj_Tail = tail + 1U;
+    FOC_Traj_Consumed++;
+
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_Traj_Notify(void){
+    FOC_Traj_Status_t status;
+
+    FOC_Traj_Consumed = 0;
+    if(FOC_Traj_Flow_Callback != 0){
+        FOC_Trajectory_Get_Status(&status);
+        FOC_Traj_Flow_Callback(&status);
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+// PendSV (FOC_Scheduler) içinde, pozisyon döngüsü hızında çalışır
+void FOC_Trajectory_Task(FOC_Handle_t *pHandle){
+    bool notify = false;
+
+    // Start: kuyruk sıfırlama noktasına kadar boşaltılır, ölçülen pozisyondan hız 0 ile başlanır
+    uint32_t gen = FOC_Traj_Reset_Gen;
+    if(gen != FOC_Traj_Seen_Gen){
+        __DMB();
+        FOC_Traj_Seen_Gen = gen;
+        FOC_Traj_Seen_Stop_Gen = FOC_Traj_Reset_Stop_Gen; // Start'tan önceki durdurmalar geçersiz
+        FOC_Traj_Tail = FOC_Traj_Reset_Index;
+        FOC_Traj_P0 = pHandle->input.position_rad;
+        FOC_Traj_V0 = 0.0f;
+        FOC_Traj_t = 0;
+        FOC_Traj_Have_Target = false;
+        FOC_Traj_Running = true;
+        FOC_Traj_Underrun = false;
+        FOC_Traj_Done = false;
+        notify = true;
+    }
+
+    // Durdurma: referans setpoint yolunda kalır (Stop hız ileri beslemesini zaten sıfırladı)
+    uint32_t stop_gen = FOC_Traj_Stop_Gen;
+    if(stop_gen != FOC_Traj_Seen_Stop_Gen){
+        FOC_Traj_Seen_Stop_Gen = stop_gen;
+        if(FOC_Traj_Running == true){
+            FOC_Traj_Running = false;
+            FOC_Traj_Have_Target = false;
+            FOC_Traj_Underrun = false;
+            FOC_Traj_Notify();
+        }
+        return;
+    }
+
+    if(FOC_Traj_Running == false){
+        return;
+    }
+
+    FOC_Traj_t += FOC_Traj_Period;
+
+    // Süresi dolan segmentler atlanır, gerekirse birden fazla nokta tüketilir
+    for(;;){
+        if(FOC_Traj_Have_Target == false){
+            if(FOC_Traj_Pop() == false){
+                break;
+            }
+            FOC_Traj_Have_Target = true;
+            if(FOC_Traj_Underrun == true){
+                // Bekleme anından başlayan yeni segment
+                FOC_Traj_Underrun = false;
+                FOC_Traj_t = 0;
+                notify = true;
+            }
+        }
+        if(FOC_Traj_t < FOC_Traj_T){
+            break;
+        }
+        FOC_Traj_t -= FOC_Traj_T;
+        FOC_Traj_P0 = FOC_Traj_P1;
+        FOC_Traj_V0 = FOC_Traj_V1;
+        FOC_Traj_Have_Target = false;
+
+        if(FOC_Traj_End_Flag != 0U){
+            FOC_Traj_V0 = 0.0f;
+            FOC_Traj_Done = true;
+            FOC_Traj_Running = false; // Son referans aşağıda bir kez yazılır, sonra setpoint yoluna bırakılır
+            notify = true;
+            break;
+        }
+    }
+
+    float position;
+    float velocity;
+
+    if(FOC_Traj_Have_Target == true){
+        float T = (float)FOC_Traj_T * FOC_Traj_Ts;
+        float s = (float)FOC_Traj_t / (float)FOC_Traj_T;
+        float s2 = s * s;
+        float s3 = s2 * s;
+        float dp = FOC_Traj_P0 - FOC_Traj_P1;
+
+        position = ((2.0f * s3 - 3.0f * s2 + 1.0f) * FOC_Traj_P0) +
+                   ((s3 - 2.0f * s2 + s) * T * FOC_Traj_V0) +
+                   ((-2.0f * s3 + 3.0f * s2) * FOC_Traj_P1) +
+                   ((s3 - s2) * T * FOC_Traj_V1);
+        velocity = (6.0f * (s2 - s) * dp / T) +
+                   ((3.0f * s2 - 4.0f * s + 1.0f) * FOC_Traj_V0) +
+                   ((3.0f * s2 - 2.0f * s) * FOC_Traj_V1);
+    }
+    else{
+        // Hedef yok: son noktada dur. END'e ulaşılmadıysa underrun.
+        if((FOC_Traj_Done == false) && (FOC_Traj_Underrun == false)){
+            FOC_Traj_Underrun = true;
+            FOC_Traj_Underrun_Count++;
+            notify = true;
+        }
+        FOC_Traj_V0 = 0.0f;
+        FOC_Traj_t = 0;
+        position = FOC_Traj_P0;
+        velocity = 0.0f;
+    }
+
+    // Bu görevi kesen bir setpoint (FOC_Trajectory_Stop) yazdıysa referansların üzerine yazılmaz.
+    // Kontrol ve iki yazma birkaç çevrimdir, akım ISR'ı en fazla bu kadar gecikir.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if(FOC_Traj_Stop_Gen == FOC_Traj_Seen_Stop_Gen){
+        pHandle->input.position_ref_rad = position;
+        pHandle->input.speed_ff_rad_s = velocity;
+    }
+    __set_PRIMASK(primask);
+
+    if(notify == true || FOC_Traj_Consumed >= FOC_TRAJ_FLOW_POINTS){
+        FOC_Traj_Notify();
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_Trajectory_Get_Status(FOC_Traj_Status_t *pStatus){
+    uint32_t used = FOC_Traj_Head - FOC_Traj_Tail;
+
+    pStatus->next_seq = FOC_Traj_Next_Seq;
+    pStatus->free = (uint8_t)((used < FOC_TRAJ_QUEUE_SIZE) ? (FOC_TRAJ_QUEUE_SIZE - used) : 0U);
+    pStatus->flags = (uint8_t)((FOC_Traj_Running ? FOC_TRAJ_STATUS_RUNNING : 0U) |
+                               (FOC_Traj_Underrun ? FOC_TRAJ_STATUS_UNDERRUN : 0U) |
+                               (FOC_Traj_Done ? FOC_TRAJ_STATUS_DONE : 0U) |
+                               (FOC_Traj_Seq_Error ? FOC_TRAJ_STATUS_SEQ_ERROR : 0U));
+    pStatus->underrun_count = FOC_Traj_Underrun_Count;
+}
@@ -0,0 +1,507 @@
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------------------------------Driver Hakkında---------------------------------->>>
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-----------------------------Tanıtım ve Bilgilendirme-------------------------->>>
+// Bu modül USART2 üzerinde 4 Mbit/s, DMA ile çalışan ikili (binary) telemetri ve komut bağlantısıdır.
+// Her iki yön de DMA ile yürür, CPU byte başına kesme almaz. Çerçeveler COBS ile kodlanır ve 0x00 ile
+// ayrılır, bütünlük CRC-32 ile korunur. CRC, STM32 CRC çevre birimi ile hesaplanır.
+// Akım ISR'ı ve FDCAN ISR'ı bu modülü hiç çağırmaz; UART kesmeleri onların altındaki öncelikte çalışır.
+// FOC_UART_Send yanlışlıkla yüksek öncelikli bir bağlamdan çağrılırsa beklemeden false döner.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<-------------------------------------Yöntem------------------------------------>>>
+// Çerçeve (COBS öncesi): [tip][sıra][veri 0 ... 240 byte][CRC-32, little endian]
+// CRC-32 (IEEE 802.3, zlib ile aynı): polinom 0x04C11DB7, başlangıç 0xFFFFFFFF, giriş byte bazında ve
+// çıkış ters çevrilmiş, sonuç 0xFFFFFFFF ile XOR'lanır. Tip, sıra ve veri üzerinden hesaplanır.
+// COBS kodlanmış çerçevede 0x00 hiç geçmez, her çerçeve tek bir 0x00 ile biter. Alıcı bir byte kaçırsa bile
+// bir sonraki 0x00'da yeniden senkron olur. Ek yük: 254 byte'ta 1 byte + ayırıcı.
+// TX: FOC_UART_Send çerçeveyi doğrudan 2 KB'lık TX halkasına kodlar (ara tampon yok) ve DMA boştaysa başlatır.
+// DMA (DMA1 Kanal 3, normal mod) halkanın kuyruk -> baş (veya halka sonu) arasındaki bitişik parçayı USART2->TDR'ye
+// aktarır, parça bitince (TC kesmesi) sıradaki parçayı başlatır. Halka doluysa çerçeve atılır ve sayılır.
+// Üreticiler (main döngüsü, PendSV görevleri) BASEPRI ile sadece FOC_UART_IRQ_PRIORITY ve altını maskeler;
+// akım ISR'ı ve FDCAN ISR'ı kodlama sırasında da gecikmesiz çalışır. CRC çevre birimi de yalnızca bu
+// öncelikte kullanılır (RX kesmeleri ve maskeli TX kodlaması), bu yüzden paylaşım güvenlidir.
+// RX: DMA1 Kanal 2 dairesel modda USART2->RDR'den 512 byte'lık tampona yazar. İşleme üç olayla tetiklenir:
+// hat boşta (IDLE: çerçeve bitti, host durdu), DMA yarım ve tam transfer (sürekli akışta tampon taşmadan önce).
+// İşleme DMA'nın yazma konumunu (CNDTR) okur, yeni byte'ları çerçeve tamponunda 0x00'a kadar toplar,
+// yerinde COBS çözer, CRC'yi kontrol eder ve tipe kayıtlı işleyiciyi çağırır.
+// USART2'nin 8 byte'lık donanım FIFO'su açıktır; DMA veya kesme gecikmesinde byte kaybını önler.
+// Bant genişliği: 4 Mbit/s ~ 400 kB/s. 48 byte telemetri -> 60 byte hatta; 1 kHz'de ~%15 doluluk.
+//  <<<------------------------------------------------------------------------------->>>
+
+//  <<<---------------------------------Kullanımı------------------------------------->>>
+// 1. MX_USART2_UART_Init() sonrası FOC_UART_Init(&hfoc) çağrılır.
+// 2. Telemetri: FOC_Scheduler_Add_Task(FOC_UART_Telemetry_Task, 20, 3); // 20 kHz / 20 = 1 kHz
+// 3. USART2_IRQHandler içinden FOC_UART_IRQHandler(), DMA1_Channel2_IRQHandler içinden FOC_UART_DMA_Rx_IRQHandler(),
+//    DMA1_Channel3_IRQHandler içinden FOC_UART_DMA_Tx_IRQHandler() çağrılır.
+// 4. Başka modüller kendi çerçeve tiplerini FOC_UART_Register_Handler ile kaydeder ve FOC_UART_Send ile gönderir.
+// 5. Abonelik telemetrisi (FOC_Telemetry) için çıkış: FOC_Telemetry_Set_Sink(FOC_UART_Stream_Sink, FOC_UART_MAX_PAYLOAD);
+//    Abonelik, katalog ve parametre (FOC_Param) istekleri FOC_UART_Init'te kaydedilen işleyicilerle karşılanır.
+// 6. Host tarafı: Tools/foc_link (COBS / CRC çözücü kütüphanesi ve pseudo-terminal ile test araçları).
+
+// Yapılması gereken MX Konfigürasyonlar (STM32G431CBU6):
+// USART2: Asynchronous, 4000000 Bit/s, Over Sampling 8, FIFO Mode Enable, saat PCLK1 = 170 MHz.
+// PA2 / PA3 GPIO hızı Medium (4 Mbit/s kenarları için).
+// NVIC: USART2 global interrupt -> Preemption Priority 5, HAL handler çağrısı kapalı
+// DMA1 Kanal 2 (USART2_RX) ve Kanal 3 (USART2_TX) bu modül tarafından register seviyesinde kurulur,
+// MX tarafında DMA isteği eklenmemelidir. Kesme öncelikleri de FOC_UART_Init'te ayarlanır.
+// CRC çevre birimi register seviyesinde kullanılır, HAL CRC modülüne gerek yoktur.
+//  <<<------------------------------------------------------------------------------->>>
+
+#include "FOC_UART.h"
+#include "FOC_Scheduler.h"
+#include "FOC_CAN.h"
+#include "FOC_Scope.h"
+#include "FOC_Telemetry.h"
+#include "FOC_Param.h"
+#include "FOC_Trajectory.h"
+#include "usart.h"
+#include "stm32g4xx_ll_dmamux.h"
+#include <string.h>
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+_Static_assert((FOC_UART_TX_SIZE & (FOC_UART_TX_SIZE - 1U)) == 0U, "TX halkası 2'nin kuvveti olmalı");
+_Static_assert((FOC_UART_RX_DMA_SIZE & (FOC_UART_RX_DMA_SIZE - 1U)) == 0U, "RX DMA tamponu 2'nin kuvveti olmalı");
+_Static_assert(sizeof(FOC_UART_Telemetry_t) == 48U, "Telemetri verisi 48 byte olmalı");
+_Static_assert(sizeof(FOC_UART_Telemetry_t) <= FOC_UART_MAX_PAYLOAD, "Telemetri tek çerçeveye sığmalı");
+
+#define FOC_UART_HEADER_SIZE 2U  // tip + sıra
+#define FOC_UART_CRC_SIZE    4U
+#define FOC_UART_RAW_MAX     (FOC_UART_HEADER_SIZE + FOC_UART_MAX_PAYLOAD + FOC_UART_CRC_SIZE)
+#define FOC_UART_COBS_MAX    (FOC_UART_RAW_MAX + (FOC_UART_RAW_MAX / 254U) + 2U) // + kod byte'ları + ayırıcı
+#define FOC_UART_BASEPRI     (FOC_UART_IRQ_PRIORITY << (8U - __NVIC_PRIO_BITS))
+
+typedef struct{
+    uint8_t type;
+    FOC_UART_Handler_t handler;
+} FOC_UART_Handler_Entry_t;
+
+static FOC_Handle_t *FOC_UART_Handle = 0;
+static FOC_UART_Stats_t FOC_UART_Stats;
+static FOC_UART_Handler_Entry_t FOC_UART_Handlers[FOC_UART_MAX_HANDLERS];
+static uint8_t FOC_UART_Handler_Count = 0;
+
+// TX halkası: baş ve kuyruk serbest sayan indekslerdir, erişimde maskelenir
+static uint8_t FOC_UART_Tx_Ring[FOC_UART_TX_SIZE];
+static uint32_t FOC_UART_Tx_Head = 0;       // Sadece maskeli üretici yazar
+static uint32_t FOC_UART_Tx_Tail = 0;       // Sadece TX DMA kesmesi yazar
+static uint32_t FOC_UART_Tx_Dma_Length = 0; // DMA'daki parça uzunluğu, 0: DMA boşta
+static uint8_t FOC_UART_Tx_Sequence = 0;
+
+// RX: dairesel DMA tamponu ve COBS çözülecek çerçeve tamponu
+static uint8_t FOC_UART_Rx_Dma[FOC_UART_RX_DMA_SIZE];
+static uint32_t FOC_UART_Rx_Tail = 0;
+static uint8_t FOC_UART_Rx_Frame[FOC_UART_COBS_MAX];
+static uint32_t FOC_UART_Rx_Length = 0;
+static bool FOC_UART_Rx_Discard = false; // Çok uzun çerçeve, bir sonraki ayırıcıya kadar atılır
+
+// COBS kodlayıcı durumu (halkaya doğrudan yazar)
+typedef struct{
+    uint32_t pos;      // Bir sonraki veri byte'ının halka indeksi
+    uint32_t code_pos; // Açık bloğun kod byte'ının halka indeksi
+    uint8_t code;      // Açık bloktaki byte sayısı + 1
+} FOC_UART_Cobs_t;
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+static inline void FOC_UART_Crc_Reset(void){
+    CRC->CR |= CRC_CR_RESET;
+}
+
+// ------------------------------------------------------------------------------
+
+static inline void FOC_UART_Crc_Feed(uint8_t data){
+    *(volatile uint8_t *)&CRC->DR = data;
+}
+
+// ------------------------------------------------------------------------------
+
+static inline uint32_t FOC_UART_Crc_Result(void){
+    return CRC->DR ^ 0xFFFFFFFFU;
+}
+
+// ------------------------------------------------------------------------------
+
+// Çağıran bağlamın önceliği UART kesmelerinden yüksek değilse true (thread modu dahil)
+static bool FOC_UART_Context_Ok(void){
+    uint32_t ipsr = __get_IPSR();
+    if(ipsr == 0U) return true;
+    if(ipsr < 4U) return false; // Reset / NMI / HardFault
+    return NVIC_GetPriority((IRQn_Type)((int32_t)ipsr - 16)) >= FOC_UART_IRQ_PRIORITY;
+}
+
+// ------------------------------------------------------------------------------
+
+// DMA boştaysa halkadaki bir sonraki bitişik parçayı gönderir (UART önceliğinde çağrılır)
+static void FOC_UART_Tx_Kick(void){
+    if(FOC_UART_Tx_Dma_Length != 0U || FOC_UART_Tx_Head == FOC_UART_Tx_Tail) return;
+
+    uint32_t start = FOC_UART_Tx_Tail & (FOC_UART_TX_SIZE - 1U);
+    uint32_t length = FOC_UART_Tx_Head - FOC_UART_Tx_Tail;
+    if(start + length > FOC_UART_TX_SIZE) length = FOC_UART_TX_SIZE - start;
+
+    FOC_UART_Tx_Dma_Length = length;
+    DMA1_Channel3->CCR &= ~DMA_CCR_EN;
+    DMA1_Channel3->CMAR = (uint32_t)&FOC_UART_Tx_Ring[start];
+    DMA1_Channel3->CNDTR = length;
+    DMA1_Channel3->CCR |= DMA_CCR_EN;
+}
+
+// ------------------------------------------------------------------------------
+
+static inline void FOC_UART_Cobs_Put(FOC_UART_Cobs_t *pCobs, uint8_t data){
+    if(data == 0U){
+        FOC_UART_Tx_Ring[pCobs->code_pos & (FOC_UART_TX_SIZE - 1U)] = pCobs->code;
+        pCobs->code_pos = pCobs->pos++;
+        pCobs->code = 1U;
+        return;
+    }
+    FOC_UART_Tx_Ring[pCobs->pos++ & (FOC_UART_TX_SIZE - 1U)] = data;
+    if(++pCobs->code == 0xFFU){
+        FOC_UART_Tx_Ring[pCobs->code_pos & (FOC_UART_TX_SIZE - 1U)] = pCobs->code;
+        pCobs->code_pos = pCobs->pos++;
+        pCobs->code = 1U;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_UART_Send(uint8_t type, const void *pPayload, uint16_t length){
+    if(length > FOC_UART_MAX_PAYLOAD) return false;
+    if(FOC_UART_Context_Ok() == false){
+        FOC_UART_Stats.tx_rejected++;
+        return false;
+    }
+
+    const uint8_t *pData = (const uint8_t *)pPayload;
+    uint32_t raw = FOC_UART_HEADER_SIZE + length + FOC_UART_CRC_SIZE;
+    uint32_t worst = raw + (raw / 254U) + 2U;
+
+    uint32_t basepri = __get_BASEPRI();
+    __set_BASEPRI_MAX(FOC_UART_BASEPRI);
+
+    if(FOC_UART_TX_SIZE - (FOC_UART_Tx_Head - FOC_UART_Tx_Tail) < worst){
+        FOC_UART_Stats.tx_dropped++;
+        __set_BASEPRI(basepri);
+        return false;
+    }
+
+    FOC_UART_Cobs_t cobs = { FOC_UART_Tx_Head + 1U, FOC_UART_Tx_Head, 1U };
+    uint8_t sequence = FOC_UART_Tx_Sequence++;
+
+    FOC_UART_Crc_Reset();
+    FOC_UART_Crc_Feed(type);
+    FOC_UART_Cobs_Put(&cobs, type);
+    FOC_UART_Crc_Feed(sequence);
+    FOC_UART_Cobs_Put(&cobs, sequence);
+    for(uint32_t i = 0; i < length; i++){
+        FOC_UART_Crc_Feed(pData[i]);
+        FOC_UART_Cobs_Put(&cobs, pData[i]);
+    }
+    uint32_t crc = FOC_UART_Crc_Result();
+    for(uint32_t i = 0; i < FOC_UART_CRC_SIZE; i++){
+        FOC_UART_Cobs_Put(&cobs, (uint8_t)(crc >> (8U * i)));
+    }
+
+    // Son bloğu kapat ve ayırıcıyı ekle
+    FOC_UART_Tx_Ring[cobs.code_pos & (FOC_UART_TX_SIZE - 1U)] = cobs.code;
+    FOC_UART_Tx_Ring[cobs.pos++ & (FOC_UART_TX_SIZE - 1U)] = 0U;
+
+    FOC_UART_Tx_Head = cobs.pos;
+    FOC_UART_Stats.tx_frames++;
+    FOC_UART_Tx_Kick();
+
+    __set_BASEPRI(basepri);
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_UART_Register_Handler(uint8_t type, FOC_UART_Handler_t handler){
+    for(uint32_t i = 0; i < FOC_UART_Handler_Count; i++){
+        if(FOC_UART_Handlers[i].type == type){
+            FOC_UART_Handlers[i].handler = handler;
+            return true;
+        }
+    }
+    if(FOC_UART_Handler_Count >= FOC_UART_MAX_HANDLERS) return false;
+
+    FOC_UART_Handlers[FOC_UART_Handler_Count].type = type;
+    FOC_UART_Handlers[FOC_UART_Handler_Count].handler = handler;
+    __DMB();
+    FOC_UART_Handler_Count++;
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+// Çerçeve tamponunu yerinde çözer, CRC'yi kontrol eder ve işleyiciyi çağırır
+static void FOC_UART_Rx_Frame_Done(void){
+    uint8_t *pBuffer = FOC_UART_Rx_Frame;
+    uint32_t length = FOC_UART_Rx_Length;
+    uint32_t read = 0;
+    uint32_t write = 0;
+
+    while(read < length){
+        uint8_t code = pBuffer[read++];
+        if(code == 0U || read + code - 1U > length){
+            FOC_UART_Stats.rx_frame_error++;
+            return;
+        }
+        for(uint32_t i = 1; i < code; i++) pBuffer[write++] = pBuffer[read++];
+        if(code != 0xFFU && read < length) pBuffer[write++] = 0U;
+    }
+
+    if(write < FOC_UART_HEADER_SIZE + FOC_UART_CRC_SIZE){
+        FOC_UART_Stats.rx_frame_error++;
+        return;
+    }
+
+    uint32_t data_length = write - FOC_UART_CRC_SIZE;
+    FOC_UART_Crc_Reset();
+    for(uint32_t i = 0; i < data_length; i++) FOC_UART_Crc_Feed(pBuffer[i]);
+    uint32_t crc = (uint32_t)pBuffer[data_length] | ((uint32_t)pBuffer[data_length + 1U] << 8) |
+                   ((uint32_t)pBuffer[data_length + 2U] << 16) | ((uint32_t)pBuffer[data_length + 3U] << 24);
+    if(FOC_UART_Crc_Result() != crc){
+        FOC_UART_Stats.rx_crc_error++;
+        return;
+    }
+    FOC_UART_Stats.rx_frames++;
+
+    for(uint32_t i = 0; i < FOC_UART_Handler_Count; i++){
+        if(FOC_UART_Handlers[i].type == pBuffer[0]){
+            FOC_UART_Handlers[i].handler(&pBuffer[FOC_UART_HEADER_SIZE], (uint16_t)(data_length - FOC_UART_HEADER_SIZE));
+            return;
+        }
+    }
+    FOC_UART_Stats.rx_unknown++;
+}
+
+// ------------------------------------------------------------------------------
+
+// DMA'nın yazdığı yeni byte'ları işler (üç RX kesmesinden, aynı öncelikte çağrılır)
+static void FOC_UART_Rx_Service(void){
+    uint32_t head = (FOC_UART_RX_DMA_SIZE - DMA1_Channel2->CNDTR) & (FOC_UART_RX_DMA_SIZE - 1U);
+
+    while(FOC_UART_Rx_Tail != head){
+        uint8_t data = FOC_UART_Rx_Dma[FOC_UART_Rx_Tail];
+        FOC_UART_Rx_Tail = (FOC_UART_Rx_Tail + 1U) & (FOC_UART_RX_DMA_SIZE - 1U);
+
+        if(data == 0U){
+            if(FOC_UART_Rx_Discard == false && FOC_UART_Rx_Length != 0U) FOC_UART_Rx_Frame_Done();
+            FOC_UART_Rx_Length = 0;
+            FOC_UART_Rx_Discard = false;
+        }
+        else if(FOC_UART_Rx_Length < sizeof(FOC_UART_Rx_Frame)){
+            FOC_UART_Rx_Frame[FOC_UART_Rx_Length++] = data;
+        }
+        else if(FOC_UART_Rx_Discard == false){
+            FOC_UART_Rx_Discard = true;
+            FOC_UART_Stats.rx_overflow++;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_UART_IRQHandler(void){
+    uint32_t isr = USART2->ISR;
+
+    if(isr & (USART_ISR_ORE | USART_ISR_FE | USART_ISR_NE)){
+        USART2->ICR = USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NECF;
+        FOC_UART_Stats.line_error++;
+    }
+    if(isr & USART_ISR_IDLE){
+        USART2->ICR = USART_ICR_IDLECF;
+    }
+    FOC_UART_Rx_Service();
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_UART_DMA_Rx_IRQHandler(void){
+    DMA1->IFCR = DMA_IFCR_CHTIF2 | DMA_IFCR_CTCIF2;
+    FOC_UART_Rx_Service();
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_UART_DMA_Tx_IRQHandler(void){
+    if(DMA1->ISR & DMA_ISR_TCIF3){
+        DMA1->IFCR = DMA_IFCR_CTCIF3;
+        FOC_UART_Tx_Tail += FOC_UART_Tx_Dma_Length;
+        FOC_UART_Tx_Dma_Length = 0;
+        FOC_UART_Tx_Kick();
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_UART_Command_Handler(const uint8_t *pPayload, uint16_t length){
+    if(length < 1U) return;
+    if(pPayload[0] == FOC_UART_CMD_ENABLE) FOC_UART_Handle->config.current_ctrl_mode = true;
+    else if(pPayload[0] == FOC_UART_CMD_DISABLE) FOC_UART_Handle->config.current_ctrl_mode = false;
+}
+
+// ------------------------------------------------------------------------------
+
+// Referanslar moddan önce yazılır: akım ISR'ı araya girerse en fazla bir tick yeni referansı eski modla görür
+static void FOC_UART_Setpoint_Handler(const uint8_t *pPayload, uint16_t length){
+    FOC_CAN_Setpoint_t setpoint;
+    if(length != sizeof(setpoint)) return;
+    memcpy(&setpoint, pPayload, sizeof(setpoint));
+
+    FOC_Trajectory_Stop(FOC_UART_Handle); // Çalışan PVT yörüngesi position_ref_rad'ı artık yazmaz
+    FOC_UART_Handle->input.T_mot_ref = setpoint.torque_ref;
+    FOC_UART_Handle->input.speed_ref_rad_s = setpoint.speed_ref;
+    FOC_UART_Handle->input.position_ref_rad = setpoint.position_ref;
+    __DMB();
+    FOC_UART_Handle->config.speed_ctrl_mode = (setpoint.mode >= FOC_CAN_MODE_SPEED);
+    FOC_UART_Handle->config.position_ctrl_mode = (setpoint.mode == FOC_CAN_MODE_POSITION);
+    FOC_UART_Handle->config.current_ctrl_mode = (setpoint.mode != FOC_CAN_MODE_DISABLE);
+}
+
+// ------------------------------------------------------------------------------
+
+// Scope istekleri UART önceliğinde işlenir, yanıt aynı tipte geri gönderilir
+static void FOC_UART_Scope_Handler(const uint8_t *pPayload, uint16_t length){
+    uint8_t response[FOC_UART_MAX_PAYLOAD];
+    uint16_t response_length = FOC_Scope_Request(pPayload, length, response, sizeof(response));
+
+    if(response_length != 0U){
+        FOC_UART_Send(FOC_UART_TYPE_SCOPE, response, response_length);
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_UART_Subscribe_Handler(const uint8_t *pPayload, uint16_t length){
+    FOC_Telem_Ack_t ack;
+    FOC_Telemetry_Subscribe(pPayload, length, &ack);
+    FOC_UART_Send(FOC_UART_TYPE_SUBSCRIBE, &ack, sizeof(ack));
+}
+
+// ------------------------------------------------------------------------------
+
+// İstek: 1 byte ilk sinyal indeksi. Yanıt: FOC_Telemetry_Catalog çıktısı (en fazla 11 giriş)
+static void FOC_UART_Catalog_Handler(const uint8_t *pPayload, uint16_t length){
+    uint8_t response[FOC_UART_MAX_PAYLOAD];
+    uint8_t first = (length >= 1U) ? pPayload[0] : 0U;
+    uint16_t response_length = FOC_Telemetry_Catalog(first, response, sizeof(response));
+
+    if(response_length != 0U){
+        FOC_UART_Send(FOC_UART_TYPE_CATALOG, response, response_length);
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+static void FOC_UART_Param_Handler(const uint8_t *pPayload, uint16_t length){
+    uint8_t response[FOC_UART_MAX_PAYLOAD];
+    uint16_t response_length = FOC_Param_Request(pPayload, length, response, sizeof(response));
+
+    if(response_length != 0U){
+        FOC_UART_Send(FOC_UART_TYPE_PARAM, response, response_length);
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_UART_Init(FOC_Handle_t *pHandle){
+    FOC_UART_Handle = pHandle;
+    memset(&FOC_UART_Stats, 0, sizeof(FOC_UART_Stats));
+    FOC_UART_Tx_Head = 0;
+    FOC_UART_Tx_Tail = 0;
+    FOC_UART_Tx_Dma_Length = 0;
+    FOC_UART_Rx_Tail = 0;
+    FOC_UART_Rx_Length = 0;
+    FOC_UART_Rx_Discard = false;
+
+    if(FOC_UART_Register_Handler(FOC_UART_TYPE_COMMAND, FOC_UART_Command_Handler) == false) return false;
+    if(FOC_UART_Register_Handler(FOC_UART_TYPE_SETPOINT, FOC_UART_Setpoint_Handler) == false) return false;
+    if(FOC_UART_Register_Handler(FOC_UART_TYPE_SCOPE, FOC_UART_Scope_Handler) == false) return false;
+    if(FOC_UART_Register_Handler(FOC_UART_TYPE_SUBSCRIBE, FOC_UART_Subscribe_Handler) == false) return false;
+    if(FOC_UART_Register_Handler(FOC_UART_TYPE_CATALOG, FOC_UART_Catalog_Handler) == false) return false;
+    if(FOC_UART_Register_Handler(FOC_UART_TYPE_PARAM, FOC_UART_Param_Handler) == false) return false;
+
+    __HAL_RCC_DMAMUX1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    __HAL_RCC_CRC_CLK_ENABLE();
+
+    // << ---- CRC: CRC-32, giriş byte bazında ters, çıkış ters ---- >>
+    CRC->POL = 0x04C11DB7U;
+    CRC->INIT = 0xFFFFFFFFU;
+    CRC->CR = CRC_CR_REV_IN_0 | CRC_CR_REV_OUT;
+
+    // << ---- DMA1 Kanal 2 (USART2->RDR -> bellek, dairesel) ---- >>
+    DMA1_Channel2->CCR = 0;
+    DMA1_Channel2->CPAR = (uint32_t)&USART2->RDR;
+    DMA1_Channel2->CMAR = (uint32_t)FOC_UART_Rx_Dma;
+    DMA1_Channel2->CNDTR = FOC_UART_RX_DMA_SIZE;
+    DMAMUX1_Channel1->CCR = LL_DMAMUX_REQ_USART2_RX;
+    DMA1->IFCR = DMA_IFCR_CGIF2;
+    DMA1_Channel2->CCR = DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_PL_0 | DMA_CCR_EN;
+
+    // << ---- DMA1 Kanal 3 (bellek -> USART2->TDR, parça parça) ---- >>
+    DMA1_Channel3->CCR = 0;
+    DMA1_Channel3->CPAR = (uint32_t)&USART2->TDR;
+    DMAMUX1_Channel2->CCR = LL_DMAMUX_REQ_USART2_TX;
+    DMA1->IFCR = DMA_IFCR_CGIF3;
+    DMA1_Channel3->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_PL_0;
+
+    // << ---- USART2: DMA istekleri, idle ve hata kesmeleri ---- >>
+    USART2->ICR = USART_ICR_IDLECF | USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NECF;
+    USART2->CR3 |= USART_CR3_DMAR | USART_CR3_DMAT | USART_CR3_EIE;
+    USART2->CR1 |= USART_CR1_IDLEIE;
+
+    NVIC_SetPriority(DMA1_Channel2_IRQn, FOC_UART_IRQ_PRIORITY);
+    NVIC_SetPriority(DMA1_Channel3_IRQn, FOC_UART_IRQ_PRIORITY);
+    NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+    NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+
+    return (USART2->CR1 & USART_CR1_FIFOEN) != 0U;
+}
+
+// ------------------------------------------------------------------------------
+
+void FOC_UART_Telemetry_Task(FOC_Handle_t *pHandle){
+    FOC_UART_Telemetry_t telemetry;
+
+    telemetry.tick = FOC_Scheduler_Get_Tick();
+    telemetry.status = (pHandle->config.current_ctrl_mode ? 0x01U : 0x00U) |
+                       (pHandle->config.speed_ctrl_mode ? 0x02U : 0x00U) |
+                       (pHandle->config.position_ctrl_mode ? 0x04U : 0x00U);
+    telemetry.reserved[0] = 0;
+    telemetry.reserved[1] = 0;
+    telemetry.reserved[2] = 0;
+    telemetry.i_d = pHandle->state.i_d;
+    telemetry.i_q = pHandle->state.i_q;
+    telemetry.i_d_ref = pHandle->state.i_d_ref;
+    telemetry.i_q_ref = pHandle->state.i_q_ref;
+    telemetry.u_d = pHandle->state.u_d;
+    telemetry.u_q = pHandle->state.u_q;
+    telemetry.w_rad_s = pHandle->input.w_rad_s;
+    telemetry.electrical_angle = pHandle->input.Electrical_Angle_rad;
+    telemetry.U_bat = pHandle->input.U_bat;
+    telemetry.position_rad = pHandle->input.position_rad;
+
+    FOC_UART_Send(FOC_UART_TYPE_TELEMETRY, &telemetry, sizeof(telemetry));
+}
+
+// ------------------------------------------------------------------------------
+
+bool FOC_UART_Stream_Sink(const uint8_t *pData, uint16_t length){
+    return FOC_UART_Send(FOC_UART_TYPE_STREAM, pData, length);
+}
+
+// ------------------------------------------------------------------------------
+
+const FOC_UART_Stats_t *FOC_UART_Get_Stats(void){
+    return &FOC_UART_Stats;
+}
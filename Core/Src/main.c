@@ -24,6 +24,10 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "FOC_Estimator.h"
+#include "FOC_Commission.h"
+#include "FOC_Param.h"
+#include "FOC_Log.h"
 
 /* USER CODE END Includes */
 
@@ -102,6 +106,14 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
+    // Idle işler: ISR'dan gelen örneklerle parametre tahmini
+    FOC_Estimator_Process();
+    // Devreye alma bitince sonuçları flash'a yazar
+    FOC_Commission_Process();
+    // Parametre commit'ini hazırlar (MTPA tablosu), akım ISR'ı tick başında uygular
+    FOC_Param_Process();
+    // printf / LOG_x kayıtlarını FOC_UART'a boşaltır
+    FOC_Log_Process();
   }
   /* USER CODE END 3 */
 }
@@ -22,6 +22,9 @@
 #include "stm32g4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "FOC_Scheduler.h"
+#include "FOC_CAN.h"
+#include "FOC_UART.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -170,6 +173,7 @@ void DebugMon_Handler(void)
 void PendSV_Handler(void)
 {
   /* USER CODE BEGIN PendSV_IRQn 0 */
+  FOC_Scheduler_Run();
 
   /* USER CODE END PendSV_IRQn 0 */
   /* USER CODE BEGIN PendSV_IRQn 1 */
@@ -198,6 +202,50 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32g4xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles FDCAN1 interrupt 0.
+  */
+void FDCAN1_IT0_IRQHandler(void)
+{
+  /* USER CODE BEGIN FDCAN1_IT0_IRQn 0 */
+  FOC_CAN_IRQHandler();
+
+  /* USER CODE END FDCAN1_IT0_IRQn 0 */
+  /* USER CODE BEGIN FDCAN1_IT0_IRQn 1 */
+
+  /* USER CODE END FDCAN1_IT0_IRQn 1 */
+}
+
+/**
+  * @brief This function handles USART2 global interrupt / USART2 wake-up interrupt through EXTI line 26.
+  */
+void USART2_IRQHandler(void)
+{
+  /* USER CODE BEGIN USART2_IRQn 0 */
+  FOC_UART_IRQHandler();
+
+  /* USER CODE END USART2_IRQn 0 */
+  /* USER CODE BEGIN USART2_IRQn 1 */
+
+  /* USER CODE END USART2_IRQn 1 */
+}
+
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief DMA1 channel2 (USART2_RX, register seviyesinde FOC_UART tarafından kurulur).
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  FOC_UART_DMA_Rx_IRQHandler();
+}
+
+/**
+  * @brief DMA1 channel3 (USART2_TX, register seviyesinde FOC_UART tarafından kurulur).
+  */
+void DMA1_Channel3_IRQHandler(void)
+{
+  FOC_UART_DMA_Tx_IRQHandler();
+}
+
 /* USER CODE END 1 */
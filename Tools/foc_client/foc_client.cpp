@@ -0,0 +1,458 @@
+// foc_client istek / yanıt yürütücüsü ve telemetri çözücüleri.
+
+#include "foc_client.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+extern "C"{
+#include "FOC_Telemetry.h"
+}
+
+namespace foc{
+
+namespace{
+
+using clock_type = std::chrono::steady_clock;
+
+const char *param_error_text(uint8_t status){
+    switch(status){
+        case 0x01U: return "bilinmeyen parametre";
+        case 0x02U: return "değer aralık dışında";
+        case 0x03U: return "akım döngüsü açıkken değiştirilemez";
+        case 0x04U: return "önceki commit henüz uygulanmadı";
+        case 0x05U: return "bilinmeyen istek";
+        case 0x06U: return "FCS-MPC çevrim bütçesini aşıyor";
+        default:    return "hata";
+    }
+}
+
+// Varint okur, veri yetmezse false
+bool read_varint(const uint8_t *&p, const uint8_t *end, uint32_t &value){
+    value = 0;
+    for(unsigned shift = 0; shift < 35U; shift += 7U){
+        if(p >= end) return false;
+        uint8_t byte = *p++;
+        value |= (uint32_t)(byte & 0x7FU) << shift;
+        if((byte & 0x80U) == 0U) return true;
+    }
+    return false;
+}
+
+// Katalog yanıtı: [toplam][ilk][adet][0] + adet x foc_link_catalog_t. Girişler list'e eklenir, adet döner
+uint8_t parse_catalog(const uint8_t *data, size_t length, uint8_t first, std::vector<signal_info> &list){
+    if(length < 4U) throw std::runtime_error("katalog yanıtı alınamadı");
+    uint8_t count = data[2];
+    if(data[1] != first || length < 4U + (count * sizeof(foc_link_catalog_t))){
+        throw std::runtime_error("geçersiz katalog yanıtı");
+    }
+    for(uint8_t i = 0; i < count; i++){
+        foc_link_catalog_t entry;
+        memcpy(&entry, &data[4U + (i * sizeof(entry))], sizeof(entry));
+        signal_info info;
+        info.index = entry.signal;
+        info.type = entry.type;
+        info.scale = entry.scale;
+        info.name.assign(entry.name, strnlen(entry.name, sizeof(entry.name)));
+        list.push_back(info);
+    }
+    return count;
+}
+
+} // namespace
+
+// <<---------------------------------------------->>
+// <<----------------- Katalog -------------------->>
+// <<---------------------------------------------->>
+
+// Core/Src/FOC_Telemetry.c kütüphaneye derlenir: katalog, sürücünün yanıtıyla aynı fonksiyondan okunur
+const std::vector<signal_info> &firmware_catalog(){
+    static const std::vector<signal_info> catalog = []{
+        std::vector<signal_info> list;
+        uint8_t response[FOC_LINK_MAX_PAYLOAD];
+        for(;;){
+            uint8_t first = (uint8_t)list.size();
+            uint16_t length = FOC_Telemetry_Catalog(first, response, sizeof(response));
+            uint8_t count = parse_catalog(response, length, first, list);
+            if(count == 0U || list.size() >= response[0]) break;
+        }
+        return list;
+    }();
+    return catalog;
+}
+
+// ------------------------------------------------------------------------------
+
+bool decode_log(const frame &f, log_entry &entry){
+    foc_link_log_header_t header;
+    if(f.type != FOC_LINK_TYPE_LOG || f.length < sizeof(header)) return false;
+    memcpy(&header, f.payload, sizeof(header));
+    entry.tick = header.tick;
+    entry.level = header.level;
+    entry.text.assign((const char *)f.payload + sizeof(header), f.length - sizeof(header));
+    return true;
+}
+
+// <<---------------------------------------------->>
+// <<------------------- client ------------------->>
+// <<---------------------------------------------->>
+
+client::client(link &l, int timeout_ms) : link_(l), timeout_ms_(timeout_ms), can_(dynamic_cast<can_link *>(&l) != nullptr){
+}
+
+// ------------------------------------------------------------------------------
+
+bool client::request(uint8_t type, const void *payload, size_t length, uint8_t reply_type, frame &reply){
+    if(!link_.send(type, payload, length)) return false;
+
+    bool found = false;
+    auto deadline = clock_type::now() + std::chrono::milliseconds(timeout_ms_);
+    while(!found){
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock_type::now()).count();
+        if(left <= 0) break;
+        bool open = link_.poll([&](const frame &f){
+            if(!found && f.type == reply_type){
+                reply = f;
+                found = true;
+            }
+            else{
+                backlog_.push_back(f);
+            }
+        }, (int)left);
+        if(!open) break;
+    }
+    return found;
+}
+
+// ------------------------------------------------------------------------------
+
+bool client::poll(const frame_sink &sink, int timeout_ms){
+    if(!backlog_.empty()){
+        while(!backlog_.empty()){
+            sink(backlog_.front());
+            backlog_.pop_front();
+        }
+        timeout_ms = 0;
+    }
+    return link_.poll(sink, timeout_ms);
+}
+
+// ------------------------------------------------------------------------------
+
+std::vector<signal_info> client::catalog(){
+    if(!catalog_.empty()) return catalog_;
+    if(can_){
+        catalog_ = firmware_catalog();
+        return catalog_;
+    }
+
+    // Yanıt: [toplam][ilk][adet][0] + adet x foc_link_catalog_t
+    uint8_t first = 0;
+    for(;;){
+        frame reply;
+        if(!request(FOC_LINK_TYPE_CATALOG, &first, 1U, FOC_LINK_TYPE_CATALOG, reply) || reply.length < 4U){
+            throw std::runtime_error("katalog yanıtı alınamadı");
+        }
+        uint8_t total = reply.payload[0];
+        uint8_t count = parse_catalog(reply.payload, reply.length, first, catalog_);
+        first = (uint8_t)(first + count);
+        if(count == 0U || first >= total) break;
+    }
+    return catalog_;
+}
+
+// ------------------------------------------------------------------------------
+
+subscription client::subscribe(const std::vector<std::pair<std::string, uint16_t>> &signals, uint8_t runs_per_packet, uint16_t can_period){
+    std::vector<signal_info> known = catalog();
+    subscription sub;
+    uint8_t request_data[FOC_LINK_MAX_PAYLOAD];
+    foc_link_subscribe_t header = { (uint8_t)signals.size(), runs_per_packet, 0 };
+    size_t length = sizeof(header);
+
+    if(signals.size() > 16U) throw std::invalid_argument("en fazla 16 sinyale abone olunabilir");
+    if(can_ && signals.size() > 14U) throw std::invalid_argument("CAN üzerinden en fazla 14 sinyal");
+
+    memcpy(request_data, &header, sizeof(header));
+    for(const auto &entry : signals){
+        const signal_info *pInfo = nullptr;
+        for(const auto &info : known){
+            if(info.name == entry.first) pInfo = &info;
+        }
+        if(pInfo == nullptr) throw std::invalid_argument("bilinmeyen sinyal: " + entry.first);
+        if(entry.second == 0U) throw std::invalid_argument("decimation 0 olamaz: " + entry.first);
+
+        foc_link_sub_entry_t wire = { pInfo->index, 0, entry.second };
+        memcpy(&request_data[length], &wire, sizeof(wire));
+        length += sizeof(wire);
+        sub.signals.push_back(*pInfo);
+        sub.decimation.push_back(entry.second);
+    }
+
+    if(can_){
+        // Yanıt yok: önceki aboneliğin nesli kısa bir süre dinlenerek öğrenilir, yeni nesil ondan farklı olandır
+        poll([&](const frame &f){
+            if(f.type == FOC_LINK_TYPE_STREAM && f.length >= sizeof(foc_link_stream_header_t)){
+                sub.last_generation = f.payload[9];
+            }
+        }, 50);
+        if(!link_.send(FOC_LINK_TYPE_SUBSCRIBE, request_data, length)) throw std::runtime_error("abonelik gönderilemedi");
+        sub.any_generation = true;
+        sub.period = can_period;
+        return sub;
+    }
+
+    // Önceki istek henüz uygulanmadıysa (durum 2) kısa aralıklarla yeniden denenir
+    for(int attempt = 0; attempt < 20; attempt++){
+        frame reply;
+        foc_link_ack_t ack;
+        if(!request(FOC_LINK_TYPE_SUBSCRIBE, request_data, length, FOC_LINK_TYPE_SUBSCRIBE, reply) || reply.length < sizeof(ack)){
+            throw std::runtime_error("abonelik yanıtı alınamadı");
+        }
+        memcpy(&ack, reply.payload, sizeof(ack));
+        if(ack.status == 1U) throw std::runtime_error("abonelik reddedildi");
+        if(ack.status == 0U){
+            sub.generation = ack.generation;
+            sub.period = (ack.period == 0U) ? 1U : ack.period;
+            return sub;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    throw std::runtime_error("abonelik uygulanmadı (sürücü meşgul)");
+}
+
+// ------------------------------------------------------------------------------
+
+void client::unsubscribe(){
+    foc_link_subscribe_t header = { 0, 0, 0 };
+    frame reply;
+    if(can_) link_.send(FOC_LINK_TYPE_SUBSCRIBE, &header, sizeof(header));
+    else request(FOC_LINK_TYPE_SUBSCRIBE, &header, sizeof(header), FOC_LINK_TYPE_SUBSCRIBE, reply);
+}
+
+// ------------------------------------------------------------------------------
+
+foc_link_param_msg_t client::param_request(uint8_t op, uint16_t id, float value, frame *reply){
+    foc_link_param_msg_t msg = { op, 0, id, value };
+    frame local;
+    frame &f = (reply != nullptr) ? *reply : local;
+
+    // Yanıt aynı op ve id'yi taşır; başka bir isteğin geç yanıtı atlanır
+    for(;;){
+        if(!request(FOC_LINK_TYPE_PARAM, &msg, sizeof(msg), FOC_LINK_TYPE_PARAM, f) || f.length < sizeof(msg)){
+            throw std::runtime_error("parametre yanıtı alınamadı");
+        }
+        foc_link_param_msg_t response;
+        memcpy(&response, f.payload, sizeof(response));
+        if(response.op == op && response.id == id) return response;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+param_info client::param(uint16_t id){
+    frame reply;
+    foc_link_param_msg_t response = param_request(FOC_LINK_PARAM_OP_INFO, id, 0.0f, &reply);
+    foc_link_param_info_t wire;
+
+    if(response.status != 0U) throw std::runtime_error(std::string("parametre ") + std::to_string(id) + ": " + param_error_text(response.status));
+    if(reply.length < sizeof(response) + sizeof(wire)) throw std::runtime_error("kısa parametre bilgisi");
+    memcpy(&wire, &reply.payload[sizeof(response)], sizeof(wire));
+
+    param_info info;
+    info.id = id;
+    info.type = wire.type;
+    info.flags = wire.flags;
+    info.count = wire.count;
+    info.min = wire.min;
+    info.max = wire.max;
+    info.scale = wire.scale;
+    info.value = response.value;
+    info.name.assign(wire.name, strnlen(wire.name, sizeof(wire.name)));
+    return info;
+}
+
+// ------------------------------------------------------------------------------
+
+param_info client::param(const std::string &name){
+    for(const auto &info : params()){
+        if(info.name == name) return info;
+    }
+    throw std::invalid_argument("bilinmeyen parametre: " + name);
+}
+
+// ------------------------------------------------------------------------------
+
+std::vector<param_info> client::params(){
+    std::vector<param_info> list;
+    param_info first = param((uint16_t)0);
+    list.push_back(first);
+    for(uint16_t id = 1; id < first.count; id++){
+        list.push_back(param(id));
+    }
+    return list;
+}
+
+// ------------------------------------------------------------------------------
+
+void client::param_set(uint16_t id, float value){
+    foc_link_param_msg_t response = param_request(FOC_LINK_PARAM_OP_SET, id, value);
+    if(response.status != 0U){
+        param_request(FOC_LINK_PARAM_OP_DISCARD, 0, 0.0f);
+        throw std::runtime_error(std::string("parametre ") + std::to_string(id) + ": " + param_error_text(response.status));
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+foc_link_param_status_t client::param_status(){
+    frame reply;
+    foc_link_param_status_t status;
+    param_request(FOC_LINK_PARAM_OP_STATUS, 0, 0.0f, &reply);
+    if(reply.length < sizeof(foc_link_param_msg_t) + sizeof(status)) throw std::runtime_error("kısa parametre durumu");
+    memcpy(&status, &reply.payload[sizeof(foc_link_param_msg_t)], sizeof(status));
+    return status;
+}
+
+// ------------------------------------------------------------------------------
+
+void client::param_commit(){
+    auto deadline = clock_type::now() + std::chrono::milliseconds(timeout_ms_);
+    foc_link_param_msg_t response;
+
+    // BUSY: önceki commit hâlâ uygulanıyor
+    for(;;){
+        response = param_request(FOC_LINK_PARAM_OP_COMMIT, 0, 0.0f);
+        if(response.status != 0x04U || clock_type::now() > deadline) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if(response.status != 0U) throw std::runtime_error(std::string("commit: ") + param_error_text(response.status));
+
+    // Commit ana döngüde hazırlanır, bir sonraki uygun akım döngüsü tick'inde uygulanır
+    for(;;){
+        foc_link_param_status_t status = param_status();
+        if(status.applied == status.committed) return;
+        if(status.last_error != 0U) throw std::runtime_error(std::string("commit: ") + param_error_text(status.last_error));
+        if(clock_type::now() > deadline) throw std::runtime_error("commit uygulanmadı");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// <<---------------------------------------------->>
+// <<----------------- Çözücüler ------------------>>
+// <<---------------------------------------------->>
+
+uint64_t tick_unwrapper::operator()(uint32_t tick){
+    if(!valid_){
+        last_ = tick;
+        valid_ = true;
+    }
+    else{
+        last_ += (uint64_t)(int64_t)(int32_t)(tick - (uint32_t)last_);
+    }
+    return last_;
+}
+
+// ------------------------------------------------------------------------------
+
+uart_telemetry_decoder::uart_telemetry_decoder()
+    : columns_{ "status", "i_d", "i_q", "i_d_ref", "i_q_ref", "u_d", "u_q", "w_rad_s", "electrical_angle", "U_bat", "position_rad" }{
+}
+
+// ------------------------------------------------------------------------------
+
+bool uart_telemetry_decoder::decode(const frame &f, const row_sink &sink){
+    foc_link_telemetry_t t;
+    if(f.type != FOC_LINK_TYPE_TELEMETRY || f.length != sizeof(t)) return false;
+    memcpy(&t, f.payload, sizeof(t));
+
+    const float values[] = { (float)t.status, t.i_d, t.i_q, t.i_d_ref, t.i_q_ref, t.u_d, t.u_q, t.w_rad_s, t.electrical_angle, t.U_bat, t.position_rad };
+    sink(tick_(t.tick), values);
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+can_telemetry_decoder::can_telemetry_decoder()
+    : columns_{ "status", "i_d", "i_q", "i_d_ref", "i_q_ref", "u_d", "u_q", "w_rad_s", "electrical_angle",
+                "T_mot_ref", "U_bat", "position_rad", "speed_ref", "fw_i_d", "sync_phase_error" }{
+}
+
+// ------------------------------------------------------------------------------
+
+bool can_telemetry_decoder::decode(const frame &f, const row_sink &sink){
+    foc_link_can_telemetry_t t;
+    if(f.type != TYPE_CAN_TELEMETRY || f.length < sizeof(t)) return false;
+    memcpy(&t, f.payload, sizeof(t));
+
+    const float values[] = { (float)t.status, t.i_d, t.i_q, t.i_d_ref, t.i_q_ref, t.u_d, t.u_q, t.w_rad_s, t.electrical_angle,
+                             t.T_mot_ref, t.U_bat, t.position_rad, t.speed_ref, t.fw_i_d, t.sync_phase_error };
+    sink(tick_(t.sample_tick), values);
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+stream_decoder::stream_decoder(const subscription &sub) : sub_(sub), row_(sub.signals.size()){
+    for(const auto &signal : sub_.signals){
+        columns_.push_back(signal.name);
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+// Her paket bağımsızdır: ilk örnekler mutlak, sonrakiler bir önceki örneğe göre zigzag / varint farktır.
+// Bir çalışmada örneklenen sinyaller (run % decimation == 0) abonelik sırasıyla gelir.
+bool stream_decoder::decode(const frame &f, const row_sink &sink){
+    foc_link_stream_header_t header;
+    if(f.type != FOC_LINK_TYPE_STREAM) return false;
+    if(f.length < sizeof(header)){
+        malformed_++;
+        return true;
+    }
+    memcpy(&header, f.payload, sizeof(header));
+
+    if(sub_.any_generation){
+        if((int)header.generation == sub_.last_generation){
+            stale_++;
+            return true;
+        }
+        sub_.generation = header.generation;
+        sub_.any_generation = false;
+    }
+    if(header.generation != sub_.generation){
+        stale_++;
+        return true;
+    }
+
+    const size_t count = sub_.signals.size();
+    int32_t last[16] = { 0 };
+    const uint8_t *p = &f.payload[sizeof(header)];
+    const uint8_t *end = &f.payload[f.length];
+    uint64_t tick = tick_(header.tick);
+
+    for(uint32_t r = 0; r < header.runs; r++){
+        uint32_t run = header.run + r;
+        for(size_t i = 0; i < count; i++){
+            if((run % sub_.decimation[i]) != 0U){
+                row_[i] = NAN;
+                continue;
+            }
+            uint32_t zigzag;
+            if(!read_varint(p, end, zigzag)){
+                malformed_++;
+                return true;
+            }
+            int32_t delta = (int32_t)((zigzag >> 1) ^ (0U - (zigzag & 1U)));
+            last[i] = (int32_t)((uint32_t)last[i] + (uint32_t)delta);
+            row_[i] = (sub_.signals[i].type == FOC_LINK_TELEM_TYPE_FLOAT) ? (float)last[i] / sub_.signals[i].scale : (float)last[i];
+        }
+        sink(tick + ((uint64_t)r * sub_.period), row_.data());
+    }
+    packets_++;
+    return true;
+}
+
+} // namespace foc
@@ -0,0 +1,271 @@
+#ifndef FOC_CLIENT_HPP_
+#define FOC_CLIENT_HPP_
+
+// Host tarafı FOC sürücü istemcisi (C++17, Linux).
+// Sürücüyle UART (foc_link çerçeveleri: seri port, pty veya bellek içi boru) ya da SocketCAN üzerinden konuşur,
+// istek / yanıtları (katalog, abonelik, parametre) yürütür ve telemetri çerçevelerini zaman damgalı satırlara çözer.
+// Kayıt / dışa aktarma: foc_record.hpp, simüle sürücü: foc_sim.hpp.
+
+#include "foc_link.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace foc{
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+// Sadece host içinde kullanılan çerçeve tipleri: CAN ID'lerinden çevrilir, UART tipleriyle çakışmaz
+constexpr uint8_t TYPE_CAN_TELEMETRY = 0x81U; // foc_link_can_telemetry_t
+constexpr uint8_t TYPE_CAN_FLOW      = 0x82U; // FOC_Traj_Status_t
+
+// Sabit boyutlu çerçeve: kuyruklarda bellek ayırmadan kopyalanır (CAN-FD verisi de 240 byte'a sığar)
+struct frame{
+    uint8_t type = 0;
+    uint8_t seq = 0;
+    uint16_t length = 0;
+    uint8_t payload[FOC_LINK_MAX_PAYLOAD];
+};
+
+struct link_stats{
+    uint64_t frames = 0;
+    uint64_t crc_errors = 0;
+    uint64_t frame_errors = 0;
+    uint64_t lost_frames = 0;  // Sıra numarası boşlukları (UART: çerçeve sırası, CAN: telemetri sırası)
+    uint64_t bytes = 0;
+};
+
+using frame_sink = std::function<void(const frame &)>;
+
+// Sürücüye giden / gelen çerçeveler. send ve poll farklı thread'lerden çağrılabilir.
+class link{
+public:
+    virtual ~link() = default;
+    virtual bool send(uint8_t type, const void *payload, size_t length) = 0;
+    // En fazla timeout_ms bekler, gelen her çerçeve için sink çağrılır. Bağlantı kapandıysa false
+    virtual bool poll(const frame_sink &sink, int timeout_ms) = 0;
+    virtual link_stats stats() const = 0;
+};
+
+// Byte akışı: seri port, pty veya bellek içi boru
+class byte_stream{
+public:
+    virtual ~byte_stream() = default;
+    // Okunan byte sayısı, 0: zaman aşımı, < 0: akış kapandı
+    virtual long read(uint8_t *data, size_t size, int timeout_ms) = 0;
+    virtual bool write(const uint8_t *data, size_t size) = 0;
+    virtual void close() = 0;
+};
+
+class fd_stream : public byte_stream{
+public:
+    explicit fd_stream(int fd); // fd'nin sahipliği alınır
+    ~fd_stream() override;
+    // Seri port veya pty'yi ham modda açar (baud 0: hız değiştirilmez). Hata: std::system_error
+    static std::unique_ptr<fd_stream> open(const std::string &path, unsigned baud);
+    long read(uint8_t *data, size_t size, int timeout_ms) override;
+    bool write(const uint8_t *data, size_t size) override;
+    void close() override;
+    // Yazma beklemez: çıkış tamponu doluysa (okuyanı olmayan pty) veri atılır ve sayılır, gerçek UART gibi
+    void set_drop_when_full(bool drop);
+    uint64_t dropped() const { return dropped_; }
+private:
+    int fd_;
+    bool drop_ = false;
+    uint64_t dropped_ = 0;
+};
+
+// Bellek içi boru çifti: first'e yazılan second'dan okunur ve tersi. Dolu boruya yazan bekler
+// (gerçek bağlantıdaki akış kontrolü yerine), böylece simülasyon kayıttan hızlı üretemez.
+std::pair<std::unique_ptr<byte_stream>, std::unique_ptr<byte_stream>> make_memory_pipe(size_t capacity = 1U << 20);
+
+// FOC_UART çerçeveleri (COBS + CRC-32) üzerinden bağlantı
+class uart_link : public link{
+public:
+    explicit uart_link(std::unique_ptr<byte_stream> stream);
+    bool send(uint8_t type, const void *payload, size_t length) override;
+    bool poll(const frame_sink &sink, int timeout_ms) override;
+    link_stats stats() const override;
+    byte_stream &stream() { return *stream_; }
+private:
+    std::unique_ptr<byte_stream> stream_;
+    std::mutex tx_mutex_;
+    uint8_t tx_seq_ = 0;
+    foc_link_decoder_t decoder_;
+    mutable std::mutex stats_mutex_;
+};
+
+// SocketCAN (CAN-FD) bağlantısı. Gelen ID'ler çerçeve tiplerine çevrilir:
+//   0x300 + node -> TYPE_CAN_TELEMETRY, 0x380 -> TYPE_CAN_FLOW, 0x400 -> SCOPE, 0x440 -> PARAM, 0x480 -> STREAM
+// Giden COMMAND / SCOPE / SUBSCRIBE / PARAM, 0x200 + node komut çerçevesine (komut byte 0'da, istek byte 4'ten) yazılır.
+// SETPOINT gönderilmez: setpoint çerçevesi dört ekseni birlikte taşır ve bus master'ındır.
+class can_link : public link{
+public:
+    can_link(const std::string &interface, uint8_t node_id); // Hata: std::system_error
+    ~can_link() override;
+    bool send(uint8_t type, const void *payload, size_t length) override;
+    bool poll(const frame_sink &sink, int timeout_ms) override;
+    link_stats stats() const override;
+private:
+    int fd_;
+    uint8_t node_;
+    link_stats stats_;
+    bool have_seq_ = false;
+    uint16_t next_seq_ = 0;
+    mutable std::mutex stats_mutex_;
+};
+
+// "can:<arayüz>:<node>" veya "<yol>[@baud]" (örn. /dev/ttyACM0@2000000, /dev/pts/5)
+std::unique_ptr<link> open_link(const std::string &spec);
+
+// Sinyal kataloğu girişi (FOC_Telem_Catalog_t)
+struct signal_info{
+    uint8_t index = 0;
+    uint8_t type = FOC_LINK_TELEM_TYPE_FLOAT;
+    float scale = 1.0f;
+    std::string name;
+};
+
+// Firmware'in FOC_Telem_Signals tablosu (kütüphaneye derlenen FOC_Telemetry_Catalog): CAN'da katalog isteği
+// olmadığından kullanılır
+const std::vector<signal_info> &firmware_catalog();
+
+// Kabul edilmiş abonelik: stream_decoder bununla paketleri çözer
+struct subscription{
+    std::vector<signal_info> signals;
+    std::vector<uint16_t> decimation;
+    uint16_t period = 1;        // Görev periyodu (tick), satır tick'i = başlık tick'i + çalışma * period
+    bool any_generation = false; // CAN: yanıt yok, aboneliğin nesli ilk yeni paketten öğrenilir
+    uint8_t generation = 0;
+    int last_generation = -1;    // CAN: abonelikten önce görülen nesil (bu nesil atılır)
+};
+
+struct param_info{
+    uint16_t id = 0;
+    uint8_t type = 0;
+    uint8_t flags = 0;
+    uint8_t count = 0;
+    float min = 0.0f;
+    float max = 0.0f;
+    float scale = 1.0f;
+    float value = 0.0f;
+    std::string name;
+};
+
+// Sürücü log kaydı (FOC_Log): seviye FOC_LINK_LOG_x, PRINT metni satır sonunu kendisi taşır
+struct log_entry{
+    uint32_t tick = 0;
+    uint8_t level = FOC_LINK_LOG_PRINT;
+    std::string text;
+};
+
+// Çerçeve log kaydı değilse false
+bool decode_log(const frame &f, log_entry &entry);
+
+// İstek / yanıt yürütücüsü. Yanıt beklerken gelen diğer çerçeveler kaybolmaz, sonraki poll'da verilir.
+// Hatalar (zaman aşımı, reddedilen istek) std::runtime_error ile bildirilir.
+class client{
+public:
+    explicit client(link &l, int timeout_ms = 500);
+    link &get_link() { return link_; }
+    bool can() const { return can_; }
+
+    // reply_type ile gelen ilk çerçeveyi reply'a yazar, zaman aşımında false
+    bool request(uint8_t type, const void *payload, size_t length, uint8_t reply_type, frame &reply);
+    bool poll(const frame_sink &sink, int timeout_ms);
+
+    std::vector<signal_info> catalog();
+    // (isim, decimation) listesine abone olur. runs_per_packet 0: paket dolana kadar
+    subscription subscribe(const std::vector<std::pair<std::string, uint16_t>> &signals, uint8_t runs_per_packet, uint16_t can_period = 2);
+    void unsubscribe();
+
+    param_info param(uint16_t id);
+    param_info param(const std::string &name);
+    std::vector<param_info> params();
+    void param_set(uint16_t id, float value);
+    // Gölge ayarı uygular, akım ISR'ı uygulayana kadar bekler
+    void param_commit();
+    foc_link_param_status_t param_status();
+
+private:
+    foc_link_param_msg_t param_request(uint8_t op, uint16_t id, float value, frame *reply = nullptr);
+
+    link &link_;
+    int timeout_ms_;
+    bool can_;
+    std::deque<frame> backlog_;
+    std::vector<signal_info> catalog_;
+};
+
+// Telemetri çerçevelerini satırlara çözer. Satır: 64 bit tick + columns() sırasıyla float değerler.
+using row_sink = std::function<void(uint64_t tick, const float *values)>;
+
+class telemetry_decoder{
+public:
+    virtual ~telemetry_decoder() = default;
+    virtual const std::vector<std::string> &columns() const = 0;
+    // Çerçeve bu çözücüye ait değilse false
+    virtual bool decode(const frame &f, const row_sink &sink) = 0;
+};
+
+// 32 bit sürücü tick'ini 64 bite genişletir
+class tick_unwrapper{
+public:
+    uint64_t operator()(uint32_t tick);
+private:
+    bool valid_ = false;
+    uint64_t last_ = 0;
+};
+
+// Sabit UART telemetrisi (FOC_LINK_TYPE_TELEMETRY)
+class uart_telemetry_decoder : public telemetry_decoder{
+public:
+    uart_telemetry_decoder();
+    const std::vector<std::string> &columns() const override { return columns_; }
+    bool decode(const frame &f, const row_sink &sink) override;
+private:
+    std::vector<std::string> columns_;
+    tick_unwrapper tick_;
+};
+
+// Sabit CAN telemetrisi (TYPE_CAN_TELEMETRY)
+class can_telemetry_decoder : public telemetry_decoder{
+public:
+    can_telemetry_decoder();
+    const std::vector<std::string> &columns() const override { return columns_; }
+    bool decode(const frame &f, const row_sink &sink) override;
+private:
+    std::vector<std::string> columns_;
+    tick_unwrapper tick_;
+};
+
+// Abonelik telemetrisi (FOC_LINK_TYPE_STREAM). O çalışmada örneklenmeyen sinyaller NaN.
+class stream_decoder : public telemetry_decoder{
+public:
+    explicit stream_decoder(const subscription &sub);
+    const std::vector<std::string> &columns() const override { return columns_; }
+    bool decode(const frame &f, const row_sink &sink) override;
+    uint64_t packets() const { return packets_; }
+    uint64_t stale() const { return stale_; }         // Başka nesle ait, atılan paket
+    uint64_t malformed() const { return malformed_; } // Kısa / bozuk paket
+private:
+    subscription sub_;
+    std::vector<std::string> columns_;
+    std::vector<float> row_;
+    tick_unwrapper tick_;
+    uint64_t packets_ = 0;
+    uint64_t stale_ = 0;
+    uint64_t malformed_ = 0;
+};
+
+} // namespace foc
+
+#endif /* FOC_CLIENT_HPP_ */
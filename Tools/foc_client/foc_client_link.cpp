@@ -0,0 +1,391 @@
+// foc_client bağlantıları: fd (seri port / pty), bellek içi boru, UART çerçeveleri ve SocketCAN.
+
+#include "foc_client.hpp"
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+
+namespace foc{
+
+// <<---------------------------------------------->>
+// <<----------------- fd_stream ------------------>>
+// <<---------------------------------------------->>
+
+fd_stream::fd_stream(int fd) : fd_(fd){
+}
+
+// ------------------------------------------------------------------------------
+
+fd_stream::~fd_stream(){
+    close();
+}
+
+// ------------------------------------------------------------------------------
+
+std::unique_ptr<fd_stream> fd_stream::open(const std::string &path, unsigned baud){
+    int fd = foc_link_open(path.c_str(), baud);
+    if(fd < 0) throw std::system_error(errno, std::generic_category(), path);
+    return std::make_unique<fd_stream>(fd);
+}
+
+// ------------------------------------------------------------------------------
+
+long fd_stream::read(uint8_t *data, size_t size, int timeout_ms){
+    if(fd_ < 0) return -1;
+
+    struct pollfd pfd = { fd_, POLLIN, 0 };
+    int ready = ::poll(&pfd, 1, timeout_ms);
+    if(ready < 0) return (errno == EINTR) ? 0 : -1;
+    if(ready == 0) return 0;
+
+    ssize_t n = ::read(fd_, data, size);
+    if(n < 0) return (errno == EINTR || errno == EAGAIN) ? 0 : -1;
+    if(n == 0) return -1;
+    return (long)n;
+}
+
+// ------------------------------------------------------------------------------
+
+bool fd_stream::write(const uint8_t *data, size_t size){
+    while(size > 0U){
+        if(fd_ < 0) return false;
+        ssize_t n = ::write(fd_, data, size);
+        if(n < 0){
+            if(errno == EINTR) continue;
+            if(drop_ && (errno == EAGAIN || errno == EWOULDBLOCK)){
+                dropped_ += size;
+                return true;
+            }
+            return false;
+        }
+        data += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+void fd_stream::set_drop_when_full(bool drop){
+    int flags = fcntl(fd_, F_GETFL);
+    if(flags >= 0) fcntl(fd_, F_SETFL, drop ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+    drop_ = drop;
+}
+
+// ------------------------------------------------------------------------------
+
+void fd_stream::close(){
+    if(fd_ >= 0){
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+// <<---------------------------------------------->>
+// <<---------------- memory_pipe ----------------->>
+// <<---------------------------------------------->>
+
+namespace{
+
+// Tek yönlü sınırlı byte kuyruğu
+struct pipe_buffer{
+    explicit pipe_buffer(size_t capacity) : data(capacity){
+    }
+
+    std::mutex mutex;
+    std::condition_variable readable;
+    std::condition_variable writable;
+    std::vector<uint8_t> data;
+    size_t head = 0;  // Okuma
+    size_t used = 0;
+    bool closed = false;
+};
+
+class memory_stream : public byte_stream{
+public:
+    memory_stream(std::shared_ptr<pipe_buffer> rx, std::shared_ptr<pipe_buffer> tx) : rx_(std::move(rx)), tx_(std::move(tx)){
+    }
+
+    ~memory_stream() override{
+        close();
+    }
+
+    long read(uint8_t *data, size_t size, int timeout_ms) override{
+        std::unique_lock<std::mutex> lock(rx_->mutex);
+        auto ready = [this]{ return rx_->used > 0U || rx_->closed; };
+        if(timeout_ms < 0) rx_->readable.wait(lock, ready);
+        else if(!rx_->readable.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready)) return 0;
+        if(rx_->used == 0U) return -1;
+
+        size_t capacity = rx_->data.size();
+        size_t n = std::min(size, rx_->used);
+        for(size_t i = 0; i < n; i++){
+            data[i] = rx_->data[(rx_->head + i) % capacity];
+        }
+        rx_->head = (rx_->head + n) % capacity;
+        rx_->used -= n;
+        rx_->writable.notify_all();
+        return (long)n;
+    }
+
+    bool write(const uint8_t *data, size_t size) override{
+        std::unique_lock<std::mutex> lock(tx_->mutex);
+        size_t capacity = tx_->data.size();
+        while(size > 0U){
+            tx_->writable.wait(lock, [this, capacity]{ return tx_->used < capacity || tx_->closed; });
+            if(tx_->closed) return false;
+
+            size_t n = std::min(size, capacity - tx_->used);
+            size_t tail = (tx_->head + tx_->used) % capacity;
+            for(size_t i = 0; i < n; i++){
+                tx_->data[(tail + i) % capacity] = data[i];
+            }
+            tx_->used += n;
+            data += n;
+            size -= n;
+            tx_->readable.notify_all();
+        }
+        return true;
+    }
+
+    // Kapanış iki yönü de kapatır: karşı uçta bekleyen okuma / yazma döner
+    void close() override{
+        for(pipe_buffer *pBuffer : { rx_.get(), tx_.get() }){
+            std::lock_guard<std::mutex> lock(pBuffer->mutex);
+            pBuffer->closed = true;
+            pBuffer->readable.notify_all();
+            pBuffer->writable.notify_all();
+        }
+    }
+
+private:
+    std::shared_ptr<pipe_buffer> rx_;
+    std::shared_ptr<pipe_buffer> tx_;
+};
+
+} // namespace
+
+std::pair<std::unique_ptr<byte_stream>, std::unique_ptr<byte_stream>> make_memory_pipe(size_t capacity){
+    auto a_to_b = std::make_shared<pipe_buffer>(capacity);
+    auto b_to_a = std::make_shared<pipe_buffer>(capacity);
+    return { std::make_unique<memory_stream>(b_to_a, a_to_b), std::make_unique<memory_stream>(a_to_b, b_to_a) };
+}
+
+// <<---------------------------------------------->>
+// <<----------------- uart_link ------------------>>
+// <<---------------------------------------------->>
+
+uart_link::uart_link(std::unique_ptr<byte_stream> stream) : stream_(std::move(stream)){
+    foc_link_decoder_init(&decoder_);
+}
+
+// ------------------------------------------------------------------------------
+
+bool uart_link::send(uint8_t type, const void *payload, size_t length){
+    uint8_t encoded[FOC_LINK_ENCODED_MAX];
+    std::lock_guard<std::mutex> lock(tx_mutex_);
+
+    size_t n = foc_link_encode(type, tx_seq_, payload, length, encoded, sizeof(encoded));
+    if(n == 0U) return false;
+    tx_seq_++;
+    return stream_->write(encoded, n);
+}
+
+// ------------------------------------------------------------------------------
+
+bool uart_link::poll(const frame_sink &sink, int timeout_ms){
+    uint8_t rx[4096];
+    long n = stream_->read(rx, sizeof(rx), timeout_ms);
+    if(n < 0) return false;
+    if(n == 0) return true;
+
+    auto callback = [](uint8_t type, uint8_t seq, const uint8_t *payload, size_t length, void *ctx){
+        frame f;
+        f.type = type;
+        f.seq = seq;
+        f.length = (uint16_t)length;
+        memcpy(f.payload, payload, length);
+        (*static_cast<const frame_sink *>(ctx))(f);
+    };
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    foc_link_feed(&decoder_, rx, (size_t)n, callback, const_cast<frame_sink *>(&sink));
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+link_stats uart_link::stats() const{
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    link_stats s;
+    s.frames = decoder_.frames;
+    s.crc_errors = decoder_.crc_errors;
+    s.frame_errors = decoder_.frame_errors;
+    s.lost_frames = decoder_.lost_frames;
+    s.bytes = decoder_.bytes;
+    return s;
+}
+
+// <<---------------------------------------------->>
+// <<------------------ can_link ------------------>>
+// <<---------------------------------------------->>
+
+can_link::can_link(const std::string &interface, uint8_t node_id) : node_(node_id){
+    fd_ = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if(fd_ < 0) throw std::system_error(errno, std::generic_category(), "socket(PF_CAN)");
+
+    int enable = 1;
+    if(setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &enable, sizeof(enable)) != 0){
+        int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(), "CAN_RAW_FD_FRAMES");
+    }
+
+    // Sadece bu node'un sürücü -> host ID'leri (0x300 ... 0x4BF aralığında, alt 6 bit node)
+    const uint32_t bases[] = { FOC_LINK_CAN_ID_TELEMETRY, FOC_LINK_CAN_ID_FLOW, FOC_LINK_CAN_ID_SCOPE, FOC_LINK_CAN_ID_PARAM, FOC_LINK_CAN_ID_STREAM };
+    struct can_filter filters[sizeof(bases) / sizeof(bases[0])];
+    for(size_t i = 0; i < sizeof(bases) / sizeof(bases[0]); i++){
+        filters[i].can_id = bases[i] + node_;
+        filters[i].can_mask = CAN_SFF_MASK;
+    }
+    setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FILTER, filters, sizeof(filters));
+
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+    struct sockaddr_can addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    if(ioctl(fd_, SIOCGIFINDEX, &ifr) != 0){
+        int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(), interface);
+    }
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if(bind(fd_, (struct sockaddr *)&addr, sizeof(addr)) != 0){
+        int error = errno;
+        ::close(fd_);
+        throw std::system_error(error, std::generic_category(), interface);
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+can_link::~can_link(){
+    ::close(fd_);
+}
+
+// ------------------------------------------------------------------------------
+
+bool can_link::send(uint8_t type, const void *payload, size_t length){
+    struct canfd_frame cf;
+    memset(&cf, 0, sizeof(cf));
+    cf.can_id = FOC_LINK_CAN_ID_COMMAND + node_;
+    cf.flags = CANFD_BRS;
+    cf.len = CANFD_MAX_DLEN;
+
+    switch(type){
+        case FOC_LINK_TYPE_COMMAND:
+            if(length < 1U) return false;
+            cf.data[0] = static_cast<const uint8_t *>(payload)[0];
+            break;
+        case FOC_LINK_TYPE_SCOPE:     cf.data[0] = FOC_LINK_CAN_CMD_SCOPE; break;
+        case FOC_LINK_TYPE_SUBSCRIBE: cf.data[0] = FOC_LINK_CAN_CMD_SUBSCRIBE; break;
+        case FOC_LINK_TYPE_PARAM:     cf.data[0] = FOC_LINK_CAN_CMD_PARAM; break;
+        default:
+            return false;
+    }
+    if(type != FOC_LINK_TYPE_COMMAND){
+        if(length > CANFD_MAX_DLEN - 4U) return false;
+        memcpy(&cf.data[4], payload, length);
+    }
+
+    ssize_t n = write(fd_, &cf, sizeof(cf));
+    return n == (ssize_t)sizeof(cf);
+}
+
+// ------------------------------------------------------------------------------
+
+bool can_link::poll(const frame_sink &sink, int timeout_ms){
+    struct pollfd pfd = { fd_, POLLIN, 0 };
+    int ready = ::poll(&pfd, 1, timeout_ms);
+    if(ready < 0) return errno == EINTR;
+
+    // Bekleyen tüm çerçeveler tek seferde okunur
+    while(ready > 0){
+        struct canfd_frame cf;
+        ssize_t n = recv(fd_, &cf, sizeof(cf), MSG_DONTWAIT);
+        if(n < 0) return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+        if(n != (ssize_t)CANFD_MTU && n != (ssize_t)CAN_MTU) continue;
+
+        frame f;
+        uint32_t id = cf.can_id & CAN_SFF_MASK;
+        if(id == FOC_LINK_CAN_ID_TELEMETRY + node_) f.type = TYPE_CAN_TELEMETRY;
+        else if(id == FOC_LINK_CAN_ID_FLOW + node_) f.type = TYPE_CAN_FLOW;
+        else if(id == FOC_LINK_CAN_ID_SCOPE + node_) f.type = FOC_LINK_TYPE_SCOPE;
+        else if(id == FOC_LINK_CAN_ID_PARAM + node_) f.type = FOC_LINK_TYPE_PARAM;
+        else if(id == FOC_LINK_CAN_ID_STREAM + node_) f.type = FOC_LINK_TYPE_STREAM;
+        else continue;
+
+        f.length = cf.len;
+        memcpy(f.payload, cf.data, cf.len);
+
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.frames++;
+            stats_.bytes += cf.len;
+            // Telemetri sırası (uint16) boşlukları kayıp çerçeve olarak sayılır
+            if(f.type == TYPE_CAN_TELEMETRY && f.length >= 2U){
+                uint16_t seq = (uint16_t)(f.payload[0] | (f.payload[1] << 8));
+                if(have_seq_) stats_.lost_frames += (uint16_t)(seq - next_seq_);
+                next_seq_ = (uint16_t)(seq + 1U);
+                have_seq_ = true;
+            }
+        }
+        sink(f);
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+link_stats can_link::stats() const{
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return stats_;
+}
+
+// <<---------------------------------------------->>
+// <<----------------- open_link ------------------>>
+// <<---------------------------------------------->>
+
+std::unique_ptr<link> open_link(const std::string &spec){
+    if(spec.compare(0, 4, "can:") == 0){
+        size_t colon = spec.find(':', 4);
+        if(colon == std::string::npos) throw std::invalid_argument("CAN bağlantısı: can:<arayüz>:<node>");
+        std::string interface = spec.substr(4, colon - 4);
+        unsigned long node = std::stoul(spec.substr(colon + 1), nullptr, 0);
+        if(node > 63U) throw std::invalid_argument("CAN node_id 0 ... 63 olmalı");
+        return std::make_unique<can_link>(interface, (uint8_t)node);
+    }
+
+    std::string path = spec;
+    unsigned baud = 0;
+    size_t at = spec.rfind('@');
+    if(at != std::string::npos){
+        path = spec.substr(0, at);
+        baud = (unsigned)std::stoul(spec.substr(at + 1));
+    }
+    return std::make_unique<uart_link>(fd_stream::open(path, baud));
+}
+
+} // namespace foc
@@ -0,0 +1,553 @@
+// foc_client komut satırı aracı.
+// Kullanım:
+//   foc_client record <bağlantı> -o kayit.focrec [-t saniye] [-n satır] [-s i_d,i_q,u_d:2,...] [-r çalışma] [--live N]
+//   foc_client info <kayıt>
+//   foc_client export <kayıt> --csv <dosya | -> | --npy <dizin>
+//   foc_client replay <kayıt> [--speed X] [--to <bağlantı> | --to pty]
+//   foc_client param <bağlantı> list | get <isim> ... | set <isim>=<değer> ...
+//   foc_client log <bağlantı> [-t saniye] -> sürücünün printf / LOG_x çıktısı (FOC_Log)
+//   foc_client sim                 -> simüle sürücüyü bir pty üzerinde çalıştırır, slave yolunu yazar
+// Bağlantı: /dev/ttyACM0[@baud], /dev/pts/N, can:<arayüz>:<node>, sim (bellek içi simüle sürücü, gerçek zamanlı)
+// veya sim:fast (bağlantının izin verdiği en yüksek hızda; kayıt hattının kapasite testi için).
+// -s verilmezse sabit telemetri çerçeveleri (UART veya CAN) kaydedilir, verilirse sinyallere abone olunur.
+// --live N: her N. satır CSV olarak stdout'a yazılır (canlı çizim: foc_client record ... --live 10 | plot aracı).
+
+#include "foc_client.hpp"
+#include "foc_record.hpp"
+#include "foc_sim.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace{
+
+using namespace foc;
+
+std::atomic<bool> g_stop{ false };
+
+void on_signal(int){
+    g_stop.store(true);
+}
+
+// ------------------------------------------------------------------------------
+
+// Bağlantı ve gerekiyorsa onu besleyen bellek içi simüle sürücü
+struct endpoint{
+    std::unique_ptr<foc::link> host;
+    std::unique_ptr<uart_link> drive;
+    std::unique_ptr<sim_drive> sim;
+    std::thread thread;
+    std::atomic<bool> stop{ false };
+
+    ~endpoint(){
+        if(sim){
+            stop.store(true);
+            // Boru kapanınca dolu boruya yazmayı bekleyen simülasyon da döner
+            drive->stream().close();
+            thread.join();
+        }
+    }
+};
+
+std::unique_ptr<endpoint> open_endpoint(const std::string &spec){
+    auto ep = std::make_unique<endpoint>();
+    if(spec == "sim" || spec == "sim:fast"){
+        bool realtime = (spec == "sim");
+        auto pipe = make_memory_pipe();
+        ep->host = std::make_unique<uart_link>(std::move(pipe.first));
+        ep->drive = std::make_unique<uart_link>(std::move(pipe.second));
+        ep->sim = std::make_unique<sim_drive>(*ep->drive);
+        endpoint *p = ep.get();
+        ep->thread = std::thread([p, realtime]{ p->sim->run(p->stop, realtime); });
+    }
+    else{
+        ep->host = open_link(spec);
+    }
+    return ep;
+}
+
+// ------------------------------------------------------------------------------
+
+// Pseudo-terminal açar: master fd döner, slave yolu path'e yazılır. Slave ucu ham moda alınır ve açık tutulur
+// (son slave kapanınca master EIO döner).
+int open_pty(std::string &path, int &slave){
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) throw std::runtime_error("posix_openpt");
+    path = ptsname(master);
+    slave = foc_link_open(path.c_str(), 0);
+    if(slave < 0) throw std::runtime_error("ptsname");
+    return master;
+}
+
+// ------------------------------------------------------------------------------
+
+// "i_d,i_q:2" -> (isim, decimation)
+std::vector<std::pair<std::string, uint16_t>> parse_signals(const std::string &list){
+    std::vector<std::pair<std::string, uint16_t>> signals;
+    size_t start = 0;
+    while(start <= list.size()){
+        size_t comma = list.find(',', start);
+        std::string item = list.substr(start, (comma == std::string::npos) ? std::string::npos : comma - start);
+        if(!item.empty()){
+            uint16_t decimation = 1;
+            size_t colon = item.find(':');
+            if(colon != std::string::npos){
+                decimation = (uint16_t)std::stoul(item.substr(colon + 1));
+                item = item.substr(0, colon);
+            }
+            signals.emplace_back(item, decimation);
+        }
+        if(comma == std::string::npos) break;
+        start = comma + 1;
+    }
+    return signals;
+}
+
+// ------------------------------------------------------------------------------
+
+void print_row(FILE *out, uint64_t tick, const float *values, size_t count){
+    fprintf(out, "%llu", (unsigned long long)tick);
+    for(size_t i = 0; i < count; i++){
+        if(std::isnan(values[i])) fputc(',', out);
+        else fprintf(out, ",%.6g", (double)values[i]);
+    }
+    fputc('\n', out);
+}
+
+// <<---------------------------------------------->>
+// <<------------------- record ------------------->>
+// <<---------------------------------------------->>
+
+// Bağlantıyı bir thread okur ve çerçeveleri kilitsiz kuyruğa koyar; ana thread çözer ve mmap kayda yazar.
+// Okuyan thread disk veya çözme gecikmesinde beklemez: kuyruk (65536 çerçeve) taşarsa atılan çerçeve sayılır.
+int cmd_record(int argc, char **argv){
+    std::string spec;
+    std::string output;
+    std::string signal_list;
+    double seconds = 0.0;
+    uint64_t max_rows = 0;
+    unsigned runs = 0;
+    unsigned live = 0;
+    uint32_t chunk_rows = 65536U;
+    double tick_hz = 20000.0;
+
+    for(int i = 0; i < argc; i++){
+        std::string arg = argv[i];
+        bool has_value = (i + 1 < argc);
+        if(arg == "-o" && has_value) output = argv[++i];
+        else if(arg == "-t" && has_value) seconds = atof(argv[++i]);
+        else if(arg == "-n" && has_value) max_rows = strtoull(argv[++i], nullptr, 0);
+        else if(arg == "-s" && has_value) signal_list = argv[++i];
+        else if(arg == "-r" && has_value) runs = (unsigned)strtoul(argv[++i], nullptr, 0);
+        else if(arg == "--live" && has_value) live = (unsigned)strtoul(argv[++i], nullptr, 0);
+        else if(arg == "--chunk" && has_value) chunk_rows = (uint32_t)strtoul(argv[++i], nullptr, 0);
+        else if(arg == "--tick-hz" && has_value) tick_hz = atof(argv[++i]);
+        else if(spec.empty()) spec = arg;
+        else throw std::invalid_argument("bilinmeyen argüman: " + arg);
+    }
+    if(spec.empty() || output.empty()) throw std::invalid_argument("record <bağlantı> -o <dosya>");
+
+    auto ep = open_endpoint(spec);
+    client cl(*ep->host);
+
+    std::unique_ptr<telemetry_decoder> decoder;
+    stream_decoder *pStream = nullptr;
+    if(!signal_list.empty()){
+        auto sub = cl.subscribe(parse_signals(signal_list), (uint8_t)runs);
+        auto stream = std::make_unique<stream_decoder>(sub);
+        pStream = stream.get();
+        decoder = std::move(stream);
+    }
+    else if(cl.can()){
+        decoder = std::make_unique<can_telemetry_decoder>();
+    }
+    else{
+        decoder = std::make_unique<uart_telemetry_decoder>();
+    }
+
+    recorder rec(output, decoder->columns(), tick_hz, chunk_rows);
+    spsc_queue<frame> queue(65536U);
+    std::atomic<bool> reader_stop{ false };
+    std::atomic<bool> link_closed{ false };
+    std::atomic<uint64_t> dropped{ 0 };
+
+    std::thread reader_thread([&]{
+        while(!reader_stop.load(std::memory_order_relaxed)){
+            bool open = cl.poll([&](const frame &f){
+                if(!queue.push(f)) dropped.fetch_add(1, std::memory_order_relaxed);
+            }, 20);
+            if(!open){
+                link_closed.store(true);
+                break;
+            }
+        }
+    });
+
+    const size_t columns = decoder->columns().size();
+    uint64_t live_count = 0;
+    if(live != 0U){
+        fputs("tick", stdout);
+        for(const auto &name : decoder->columns()) printf(",%s", name.c_str());
+        fputc('\n', stdout);
+    }
+    row_sink sink = [&](uint64_t tick, const float *values){
+        if(max_rows != 0U && rec.rows() >= max_rows) return;
+        rec.append(tick, values);
+        if(live != 0U && (live_count++ % live) == 0U){
+            print_row(stdout, tick, values, columns);
+            fflush(stdout);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t frames = 0;
+    for(;;){
+        frame f;
+        bool got = false;
+        while(queue.pop(f)){
+            decoder->decode(f, sink);
+            frames++;
+            got = true;
+        }
+
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if(g_stop.load() || (seconds > 0.0 && elapsed >= seconds) || (max_rows != 0U && rec.rows() >= max_rows)) break;
+        if(link_closed.load() && queue.size() == 0U) break;
+        if(!got) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    reader_stop.store(true);
+    reader_thread.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if(pStream != nullptr && !link_closed.load()){
+        try{
+            cl.unsubscribe();
+        }
+        catch(const std::exception &){
+        }
+    }
+
+    link_stats ls = ep->host->stats();
+    rec.set_counters(dropped.load(), ls.lost_frames);
+    uint64_t rows = rec.rows();
+    rec.close();
+
+    fprintf(stderr, "%llu satır, %llu çerçeve, %.2f s (%.0f satır/s, %.1f MB/s bağlantı)\n",
+            (unsigned long long)rows, (unsigned long long)frames, elapsed, (double)rows / elapsed, (double)ls.bytes / elapsed / 1e6);
+    fprintf(stderr, "atılan (kuyruk): %llu, kayıp (sıra): %llu, CRC: %llu, çerçeve hatası: %llu\n",
+            (unsigned long long)dropped.load(), (unsigned long long)ls.lost_frames,
+            (unsigned long long)ls.crc_errors, (unsigned long long)ls.frame_errors);
+    if(pStream != nullptr){
+        fprintf(stderr, "abonelik paketi: %llu, eski nesil: %llu, bozuk: %llu\n", (unsigned long long)pStream->packets(),
+                (unsigned long long)pStream->stale(), (unsigned long long)pStream->malformed());
+    }
+    return 0;
+}
+
+// <<---------------------------------------------->>
+// <<---------------- info / export --------------->>
+// <<---------------------------------------------->>
+
+int cmd_info(int argc, char **argv){
+    if(argc < 1) throw std::invalid_argument("info <kayıt>");
+    reader rec(argv[0]);
+    const record_header &h = rec.header();
+
+    printf("satır: %llu, sütun: %u, chunk: %u satır x %llu\n", (unsigned long long)h.row_count, h.column_count, h.chunk_rows,
+           (unsigned long long)h.chunk_count);
+    if(h.row_count > 0U){
+        uint64_t first = rec.tick(0);
+        uint64_t last = rec.tick(h.row_count - 1U);
+        printf("tick: %llu ... %llu", (unsigned long long)first, (unsigned long long)last);
+        if(h.tick_hz > 0.0) printf(" (%.3f s @ %.0f Hz)", (double)(last - first) / h.tick_hz, h.tick_hz);
+        printf("\n");
+    }
+    printf("atılan çerçeve: %llu, kayıp çerçeve: %llu\n", (unsigned long long)h.dropped_frames, (unsigned long long)h.lost_frames);
+    for(size_t c = 0; c < rec.columns().size(); c++){
+        printf("  %2zu %s\n", c, rec.columns()[c].c_str());
+    }
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+
+int cmd_export(int argc, char **argv){
+    if(argc < 3) throw std::invalid_argument("export <kayıt> --csv <dosya | -> | --npy <dizin>");
+    reader rec(argv[0]);
+    std::string mode = argv[1];
+
+    if(mode == "--csv") export_csv(rec, argv[2]);
+    else if(mode == "--npy") export_npy(rec, argv[2]);
+    else throw std::invalid_argument("bilinmeyen biçim: " + mode);
+    return 0;
+}
+
+// <<---------------------------------------------->>
+// <<------------------- replay ------------------->>
+// <<---------------------------------------------->>
+
+// Kayıt, tick zamanlamasıyla (speed katı, 0: beklemeden) yeniden oynatılır. --to verilirse satırlar
+// foc_link_telemetry_t çerçevesine dönüştürülüp gönderilir (foc_link_dump veya başka bir istemci gerçek sürücü
+// gibi dinler), verilmezse CSV olarak stdout'a yazılır. Örneklenmemiş (NaN) değerler bir öncekini korur.
+int cmd_replay(int argc, char **argv){
+    std::string path;
+    std::string to;
+    double speed = 1.0;
+
+    for(int i = 0; i < argc; i++){
+        std::string arg = argv[i];
+        if(arg == "--speed" && i + 1 < argc) speed = atof(argv[++i]);
+        else if(arg == "--to" && i + 1 < argc) to = argv[++i];
+        else if(path.empty()) path = arg;
+        else throw std::invalid_argument("bilinmeyen argüman: " + arg);
+    }
+    if(path.empty()) throw std::invalid_argument("replay <kayıt> [--speed X] [--to <bağlantı> | pty]");
+
+    reader rec(path);
+    const size_t columns = rec.columns().size();
+
+    // Telemetri alanları ve kayıttaki karşılıkları (sabit telemetri veya katalog isimleri)
+    static const char *const field_names[][2] = {
+        { "status", "status" }, { "i_d", "i_d" }, { "i_q", "i_q" }, { "i_d_ref", "i_d_ref" }, { "i_q_ref", "i_q_ref" },
+        { "u_d", "u_d" }, { "u_q", "u_q" }, { "w_rad_s", "w" }, { "electrical_angle", "angle" }, { "U_bat", "U_bat" },
+        { "position_rad", "position" },
+    };
+    constexpr size_t FIELDS = sizeof(field_names) / sizeof(field_names[0]);
+    long field_column[FIELDS];
+    for(size_t k = 0; k < FIELDS; k++){
+        field_column[k] = -1;
+        for(size_t c = 0; c < columns; c++){
+            if(rec.columns()[c] == field_names[k][0] || rec.columns()[c] == field_names[k][1]) field_column[k] = (long)c;
+        }
+    }
+
+    std::unique_ptr<foc::link> out;
+    fd_stream *pPty = nullptr;
+    int master = -1;
+    int slave = -1;
+    if(to == "pty"){
+        std::string slave_path;
+        master = open_pty(slave_path, slave);
+        fprintf(stderr, "%s\n", slave_path.c_str());
+        auto stream = std::make_unique<fd_stream>(master);
+        stream->set_drop_when_full(true);
+        pPty = stream.get();
+        out = std::make_unique<uart_link>(std::move(stream));
+    }
+    else if(!to.empty()){
+        out = open_link(to);
+    }
+    else{
+        fputs("tick", stdout);
+        for(const auto &name : rec.columns()) printf(",%s", name.c_str());
+        fputc('\n', stdout);
+    }
+
+    const double tick_hz = rec.header().tick_hz;
+    const bool paced = (speed > 0.0 && tick_hz > 0.0);
+    const uint64_t first_tick = (rec.rows() > 0U) ? rec.tick(0) : 0U;
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<float> row(columns);
+    float fields[FIELDS] = { 0.0f };
+    uint64_t sent = 0;
+
+    for(size_t k = 0; k < rec.chunk_count() && !g_stop.load(); k++){
+        reader::chunk_view view = rec.chunk(k);
+        for(size_t r = 0; r < view.rows && !g_stop.load(); r++){
+            if(paced){
+                double at = (double)(view.ticks[r] - first_tick) / tick_hz / speed;
+                std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(at)));
+            }
+            for(size_t c = 0; c < columns; c++) row[c] = view.columns[c][r];
+
+            if(!out){
+                print_row(stdout, view.ticks[r], row.data(), columns);
+                continue;
+            }
+            for(size_t f = 0; f < FIELDS; f++){
+                if(field_column[f] >= 0 && !std::isnan(row[(size_t)field_column[f]])) fields[f] = row[(size_t)field_column[f]];
+            }
+            foc_link_telemetry_t t;
+            memset(&t, 0, sizeof(t));
+            t.tick = (uint32_t)view.ticks[r];
+            t.status = (uint8_t)fields[0];
+            memcpy(&t.i_d, &fields[1], sizeof(float) * (FIELDS - 1U));
+            if(!out->send(FOC_LINK_TYPE_TELEMETRY, &t, sizeof(t))) return 1;
+            sent++;
+        }
+    }
+
+    if(out) fprintf(stderr, "%llu çerçeve gönderildi\n", (unsigned long long)sent);
+    if(pPty != nullptr) fprintf(stderr, "okuyan olmadığı için atılan: %llu byte\n", (unsigned long long)pPty->dropped());
+    if(slave >= 0) close(slave);
+    return 0;
+}
+
+// <<---------------------------------------------->>
+// <<------------------- param -------------------->>
+// <<---------------------------------------------->>
+
+void print_param(const param_info &p){
+    printf("%3u %-12s %12.6g  [%g ... %g]%s%s\n", p.id, p.name.c_str(), (double)p.value, (double)p.min, (double)p.max,
+           (p.flags & 0x01U) ? " HOT" : "", (p.flags & 0x02U) ? " MTPA" : "");
+}
+
+// ------------------------------------------------------------------------------
+
+// set: tüm değerler gölge ayara yazılır, sonra tek commit ile aynı akım döngüsü tick'inde uygulanır
+int cmd_param(int argc, char **argv){
+    if(argc < 2) throw std::invalid_argument("param <bağlantı> list | get <isim> ... | set <isim>=<değer> ...");
+    auto ep = open_endpoint(argv[0]);
+    client cl(*ep->host);
+    std::string op = argv[1];
+
+    if(op == "list"){
+        for(const auto &p : cl.params()) print_param(p);
+        return 0;
+    }
+    if(op == "get"){
+        for(int i = 2; i < argc; i++) print_param(cl.param(std::string(argv[i])));
+        return 0;
+    }
+    if(op == "set"){
+        std::vector<param_info> list = cl.params();
+        std::vector<uint16_t> changed;
+        for(int i = 2; i < argc; i++){
+            std::string item = argv[i];
+            size_t eq = item.find('=');
+            if(eq == std::string::npos) throw std::invalid_argument("set <isim>=<değer>");
+            std::string name = item.substr(0, eq);
+            const param_info *pInfo = nullptr;
+            for(const auto &p : list){
+                if(p.name == name) pInfo = &p;
+            }
+            if(pInfo == nullptr) throw std::invalid_argument("bilinmeyen parametre: " + name);
+            cl.param_set(pInfo->id, std::stof(item.substr(eq + 1)));
+            changed.push_back(pInfo->id);
+        }
+        cl.param_commit();
+        for(uint16_t id : changed) print_param(cl.param(id));
+        return 0;
+    }
+    throw std::invalid_argument("bilinmeyen param işlemi: " + op);
+}
+
+// <<---------------------------------------------->>
+// <<-------------------- log --------------------->>
+// <<---------------------------------------------->>
+
+// Satır: "tick S: metin" (S: P printf, E / W / I / D). printf parçaları satır sonuna kadar birleştirilir.
+int cmd_log(int argc, char **argv){
+    std::string spec;
+    double seconds = 0.0;
+
+    for(int i = 0; i < argc; i++){
+        std::string arg = argv[i];
+        if(arg == "-t" && i + 1 < argc) seconds = atof(argv[++i]);
+        else if(spec.empty()) spec = arg;
+        else throw std::invalid_argument("bilinmeyen argüman: " + arg);
+    }
+    if(spec.empty()) throw std::invalid_argument("log <bağlantı> [-t saniye]");
+
+    auto ep = open_endpoint(spec);
+    static const char levels[] = "PEWID";
+    uint64_t count = 0;
+    bool line_open = false;
+    auto start = std::chrono::steady_clock::now();
+
+    auto sink = [&](const frame &f){
+        log_entry entry;
+        if(!decode_log(f, entry)) return;
+        count++;
+        if(entry.level == FOC_LINK_LOG_PRINT){
+            if(!line_open) printf("%10u P: ", entry.tick);
+            fwrite(entry.text.data(), 1, entry.text.size(), stdout);
+            line_open = entry.text.empty() || entry.text.back() != '\n';
+        }
+        else{
+            if(line_open) fputc('\n', stdout);
+            line_open = false;
+            printf("%10u %c: %s\n", entry.tick, (entry.level < 5U) ? levels[entry.level] : '?', entry.text.c_str());
+        }
+        fflush(stdout);
+    };
+
+    while(!g_stop.load()){
+        if(seconds > 0.0 && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= seconds) break;
+        if(!ep->host->poll(sink, 100)) break;
+    }
+    if(line_open) fputc('\n', stdout);
+    fprintf(stderr, "%llu log kaydı\n", (unsigned long long)count);
+    return 0;
+}
+
+// <<---------------------------------------------->>
+// <<-------------------- sim --------------------->>
+// <<---------------------------------------------->>
+
+int cmd_sim(int, char **){
+    std::string slave_path;
+    int slave = -1;
+    int master = open_pty(slave_path, slave);
+    printf("%s\n", slave_path.c_str());
+    fflush(stdout);
+
+    // Gerçek UART gibi: okuyan yokken çıkış atılır, simülasyon (ve SIGINT ile çıkış) beklemez
+    auto stream = std::make_unique<fd_stream>(master);
+    stream->set_drop_when_full(true);
+    uart_link drive(std::move(stream));
+    sim_drive sim(drive);
+    sim.run(g_stop, true);
+
+    const sim_stats &s = sim.stats();
+    fprintf(stderr, "%llu tick, %llu telemetri, %llu abonelik paketi, %llu istek\n", (unsigned long long)s.ticks,
+            (unsigned long long)s.telemetry_frames, (unsigned long long)s.stream_packets, (unsigned long long)s.requests);
+    close(slave);
+    return 0;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------
+
+int main(int argc, char **argv){
+    if(argc < 2){
+        fprintf(stderr, "Kullanım: %s record | info | export | replay | param | log | sim ...\n", argv[0]);
+        return 2;
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    std::string command = argv[1];
+    try{
+        if(command == "record") return cmd_record(argc - 2, argv + 2);
+        if(command == "info") return cmd_info(argc - 2, argv + 2);
+        if(command == "export") return cmd_export(argc - 2, argv + 2);
+        if(command == "replay") return cmd_replay(argc - 2, argv + 2);
+        if(command == "param") return cmd_param(argc - 2, argv + 2);
+        if(command == "log") return cmd_log(argc - 2, argv + 2);
+        if(command == "sim") return cmd_sim(argc - 2, argv + 2);
+    }
+    catch(const std::exception &e){
+        fprintf(stderr, "%s: %s\n", command.c_str(), e.what());
+        return 1;
+    }
+
+    fprintf(stderr, "bilinmeyen komut: %s\n", command.c_str());
+    return 2;
+}
@@ -0,0 +1,374 @@
+// foc_client uçtan uca testi: istemci bellek içi boru üzerinden simüle sürücüye bağlanır. Sürücü tarafındaki
+// katalog, abonelik kodlayıcısı ve parametre modülü firmware'in kendisidir (FOC_Telemetry.c, FOC_Param.c).
+//   Katalog:   istekle okunan katalog firmware_catalog() ile aynı, FOC_Telemetry_Signal_Count kadar giriş
+//              (240 byte yanıta 11 giriş sığar, sayfalama da denenir).
+//   Abonelik:  satır tick'leri periyot aralıklı ve boşluksuz, decimation'a göre NaN deseni, değerler modelle
+//              ölçek çözünürlüğünde aynı; paket kaybı / bozuk paket / eski nesil yok.
+//   Parametre: liste FOC_PARAM_COUNT, set commit'e kadar canlı değeri değiştirmez, commit sonrası değer ve
+//              durum (committed == applied), aralık dışı değer ve motor çalışırken HOT olmayan parametre reddi,
+//              MTPA bayraklı parametre (türetilmiş tablo ile). i_limit commit'i i_q_limit sinyalinde bir kez ve
+//              geri dönmeden görülür.
+//   Kayıt:     canlı satırlar .focrec'e yazılır (birden fazla chunk), reader ile bit bit aynı okunur;
+//              foc_client replay çıktısı (CSV) canlı satırlarla aynı.
+// Çıkış kodu: kontrollerden biri kalırsa 1.
+
+#include "foc_client.hpp"
+#include "foc_record.hpp"
+#include "foc_sim.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+extern "C"{
+#include "FOC_Param.h"
+#include "FOC_Telemetry.h"
+}
+
+using namespace foc;
+
+namespace{
+
+constexpr float TWO_PI = 6.28318531f;
+constexpr uint16_t PERIOD = 2U;          // sim_options::stream_period
+constexpr size_t LIVE_ROWS = 5000U;
+constexpr uint32_t CHUNK_ROWS = 1024U;
+const char *const RECORD_PATH = "foc_client_test.focrec";
+
+bool check(bool ok, const char *format, ...) __attribute__((format(printf, 2, 3)));
+bool check(bool ok, const char *format, ...){
+    va_list args;
+
+    printf("%s: ", ok ? "PASS" : "FAIL");
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+    printf("\n");
+    return ok;
+}
+
+// Bellek içi boru, sürücü ucunda kendi thread'inde bağlantının izin verdiği hızda çalışan simüle sürücü
+struct test_drive{
+    std::unique_ptr<uart_link> host;
+    std::unique_ptr<uart_link> drive;
+    std::unique_ptr<sim_drive> sim;
+    std::thread thread;
+    std::atomic<bool> stop{ false };
+
+    test_drive(){
+        // Küçük boru: sürücü istemcinin en fazla birkaç bin tick önünde koşar, commit'in etkisi yakın satırlarda görülür
+        auto pipe = make_memory_pipe(1U << 14);
+        host = std::make_unique<uart_link>(std::move(pipe.first));
+        drive = std::make_unique<uart_link>(std::move(pipe.second));
+        sim_options options;
+        options.stream_period = PERIOD;
+        sim = std::make_unique<sim_drive>(*drive, options);
+        thread = std::thread([this]{ sim->run(stop, false); });
+    }
+
+    ~test_drive(){
+        stop.store(true);
+        drive->stream().close();
+        thread.join();
+    }
+};
+
+struct row{
+    uint64_t tick;
+    std::vector<float> values;
+};
+
+// En az count satır toplanana kadar (en fazla 10 s) okur. Son paketin satırları da alınır (boşluk kalmaz)
+bool collect(client &cl, stream_decoder &decoder, size_t count, std::vector<row> &rows){
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    const size_t columns = decoder.columns().size();
+
+    while(rows.size() < count && std::chrono::steady_clock::now() < deadline){
+        bool open = cl.poll([&](const frame &f){
+            decoder.decode(f, [&](uint64_t tick, const float *values){
+                rows.push_back({ tick, std::vector<float>(values, values + columns) });
+            });
+        }, 20);
+        if(!open) return false;
+    }
+    return rows.size() >= count;
+}
+
+bool same_value(float a, float b){
+    if(std::isnan(a) || std::isnan(b)) return std::isnan(a) && std::isnan(b);
+    return a == b;
+}
+
+// <<---------------------------------------------->>
+// <<------------------ Katalog ------------------->>
+// <<---------------------------------------------->>
+
+bool test_catalog(client &cl){
+    bool ok = true;
+    std::vector<signal_info> remote = cl.catalog();
+    const std::vector<signal_info> &local = firmware_catalog();
+
+    ok &= check(remote.size() == FOC_Telemetry_Signal_Count() && local.size() == remote.size(),
+                "katalog %zu giris, firmware_catalog %zu, FOC_Telemetry_Signal_Count %u", remote.size(), local.size(),
+                (unsigned)FOC_Telemetry_Signal_Count());
+
+    size_t mismatch = 0;
+    for(size_t i = 0; i < remote.size() && i < local.size(); i++){
+        if(remote[i].index != i || local[i].index != i || remote[i].name != local[i].name || remote[i].type != local[i].type ||
+           remote[i].scale != local[i].scale || remote[i].name.empty()){
+            mismatch++;
+        }
+    }
+    ok &= check(mismatch == 0U, "katalog girisleri firmware_catalog ile ayni (%zu farkli)", mismatch);
+    return ok;
+}
+
+// <<---------------------------------------------->>
+// <<----------------- Parametre ------------------>>
+// <<---------------------------------------------->>
+
+bool rejected(client &cl, uint16_t id, float value){
+    try{
+        cl.param_set(id, value);
+    }
+    catch(const std::runtime_error &){
+        return true;
+    }
+    return false;
+}
+
+bool test_params(client &cl){
+    bool ok = true;
+    std::vector<param_info> list = cl.params();
+
+    size_t bad = 0;
+    for(size_t i = 0; i < list.size(); i++){
+        if(list[i].id != i || list[i].count != FOC_PARAM_COUNT || list[i].name.empty() || !(list[i].min <= list[i].max)) bad++;
+    }
+    ok &= check(list.size() == FOC_PARAM_COUNT && bad == 0U, "parametre listesi %zu / %u, %zu gecersiz", list.size(),
+                (unsigned)FOC_PARAM_COUNT, bad);
+
+    // Set commit'e kadar sadece gölge ayarda
+    float before = cl.param(FOC_PARAM_KP_Q).value;
+    cl.param_set(FOC_PARAM_KP_Q, 1.25f);
+    cl.param_set(FOC_PARAM_L_D, 120.0f); // MTPA: Process tabloyu yeniden hesaplar
+    foc_link_param_status_t status = cl.param_status();
+    float staged = cl.param(FOC_PARAM_KP_Q).value;
+    ok &= check(status.staged == 2U && staged == before, "set: %u gölge, canli Kp_q %g (once %g)", (unsigned)status.staged,
+                (double)staged, (double)before);
+
+    cl.param_commit();
+    status = cl.param_status();
+    float kp = cl.param(FOC_PARAM_KP_Q).value;
+    float l_d = cl.param(FOC_PARAM_L_D).value;
+    ok &= check(kp == 1.25f && std::fabs(l_d - 120.0f) < 1e-3f && status.committed == 1U && status.applied == 1U && status.staged == 0U,
+                "commit: Kp_q %g, L_d_uH %g, committed %u applied %u staged %u", (double)kp, (double)l_d,
+                (unsigned)status.committed, (unsigned)status.applied, (unsigned)status.staged);
+
+    const param_info &r = list[FOC_PARAM_R_PHASE];
+    ok &= check(rejected(cl, FOC_PARAM_R_PHASE, r.max * 2.0f) && rejected(cl, FOC_PARAM_R_PHASE, NAN) &&
+                rejected(cl, FOC_PARAM_COUNT, 0.0f), "aralik disi / NaN / bilinmeyen ID reddedildi");
+
+    // HOT olmayan parametre motor çalışırken reddedilir, durunca kabul edilir
+    uint8_t command = FOC_LINK_CMD_ENABLE;
+    cl.get_link().send(FOC_LINK_TYPE_COMMAND, &command, 1U);
+    bool running = rejected(cl, FOC_PARAM_CURRENT_REGULATOR, 1.0f);
+    command = FOC_LINK_CMD_DISABLE;
+    cl.get_link().send(FOC_LINK_TYPE_COMMAND, &command, 1U);
+    cl.param_set(FOC_PARAM_CURRENT_REGULATOR, 1.0f);
+    cl.param_commit();
+    float regulator = cl.param(FOC_PARAM_CURRENT_REGULATOR).value;
+    ok &= check(running && regulator == 1.0f, "regulator: calisirken red %s, durunca %g", running ? "evet" : "hayir",
+                (double)regulator);
+    return ok;
+}
+
+// <<---------------------------------------------->>
+// <<----------------- Abonelik ------------------->>
+// <<---------------------------------------------->>
+
+enum{ C_I_Q = 0, C_ANGLE, C_LIMIT, C_FCS, C_COUNT };
+
+bool test_stream(client &cl, std::vector<row> &rows, std::vector<std::string> &columns){
+    bool ok = true;
+    subscription sub = cl.subscribe({ { "i_q", 1 }, { "angle", 4 }, { "i_q_limit", 1 }, { "fcs_state", 3 } }, 0);
+    stream_decoder decoder(sub);
+    columns = decoder.columns();
+
+    ok &= check(sub.period == PERIOD && sub.signals.size() == C_COUNT, "abonelik kabul edildi: periyot %u, nesil %u",
+                (unsigned)sub.period, (unsigned)sub.generation);
+
+    // i_limit commit'i akış sürerken: i_q_limit bir kez değişir ve geri dönmez
+    float limit_before = cl.param(FOC_PARAM_CURRENT_LIMIT).value;
+    std::vector<row> head;
+    bool received = collect(cl, decoder, 200U, head);
+    if(!check(received, "ilk %zu satir", head.size())) return false;
+    cl.param_set(FOC_PARAM_CURRENT_LIMIT, 12.5f);
+    cl.param_commit();
+    rows = head;
+    received = collect(cl, decoder, head.size() + LIVE_ROWS, rows);
+    if(!check(received, "%zu satir alindi", rows.size())) return false;
+
+    size_t gaps = 0;
+    size_t pattern = 0;
+    size_t value_err = 0;
+    size_t changes = 0;
+    size_t limit_err = 0;
+    const uint64_t first = rows.front().tick;
+    for(size_t n = 0; n < rows.size(); n++){
+        const row &r = rows[n];
+        if(n > 0U && r.tick != rows[n - 1U].tick + PERIOD) gaps++;
+
+        uint64_t run = (r.tick - first) / PERIOD;
+        if(std::isnan(r.values[C_I_Q]) || std::isnan(r.values[C_LIMIT]) || std::isnan(r.values[C_ANGLE]) != (run % 4U != 0U) ||
+           std::isnan(r.values[C_FCS]) != (run % 3U != 0U)){
+            pattern++;
+            continue;
+        }
+
+        // Model: i_q = 0.05 sin(2 pi 50 t) (setpoint yok), fcs_state = (tick / 3) % 8. i_q 1 mA çözünürlükle kodlanır
+        float t = (float)r.tick / 20000.0f;
+        float i_q = 0.05f * sinf(TWO_PI * 50.0f * t);
+        if(std::fabs(r.values[C_I_Q] - i_q) > 0.6e-3f) value_err++;
+        if(run % 3U == 0U && r.values[C_FCS] != (float)((r.tick / 3U) % 8U)) value_err++;
+
+        if(n > 0U && r.values[C_LIMIT] != rows[n - 1U].values[C_LIMIT]) changes++;
+        if(r.values[C_LIMIT] != limit_before && r.values[C_LIMIT] != 12.5f) limit_err++;
+    }
+    ok &= check(gaps == 0U && pattern == 0U, "tick araligi %u, bosluk %zu, decimation deseni hatasi %zu", (unsigned)PERIOD,
+                gaps, pattern);
+    ok &= check(value_err == 0U, "i_q ve fcs_state modelle ayni (%zu hata)", value_err);
+    ok &= check(changes == 1U && limit_err == 0U && rows.front().values[C_LIMIT] == limit_before && rows.back().values[C_LIMIT] == 12.5f,
+                "i_q_limit %g -> %g, %zu degisim", (double)limit_before, (double)rows.back().values[C_LIMIT], changes);
+
+    link_stats ls = cl.get_link().stats();
+    ok &= check(decoder.malformed() == 0U && decoder.stale() == 0U && ls.lost_frames == 0U && ls.crc_errors == 0U,
+                "%llu paket: bozuk %llu, eski nesil %llu, kayip cerceve %llu, CRC %llu", (unsigned long long)decoder.packets(),
+                (unsigned long long)decoder.malformed(), (unsigned long long)decoder.stale(),
+                (unsigned long long)ls.lost_frames, (unsigned long long)ls.crc_errors);
+    cl.unsubscribe();
+    return ok;
+}
+
+// <<---------------------------------------------->>
+// <<--------------- Kayıt / replay --------------->>
+// <<---------------------------------------------->>
+
+// replay CSV'sinin bir alanı (boş: NaN)
+float csv_value(const std::string &field){
+    return field.empty() ? NAN : strtof(field.c_str(), nullptr);
+}
+
+bool test_record(const std::vector<row> &rows, const std::vector<std::string> &columns){
+    bool ok = true;
+    {
+        recorder rec(RECORD_PATH, columns, 20000.0, CHUNK_ROWS);
+        for(const row &r : rows) rec.append(r.tick, r.values.data());
+        rec.close();
+    }
+
+    reader rec(RECORD_PATH);
+    size_t diff = 0;
+    for(size_t n = 0; n < rows.size() && n < rec.rows(); n++){
+        if(rec.tick(n) != rows[n].tick) diff++;
+        for(size_t c = 0; c < columns.size(); c++){
+            if(!same_value(rec.value(c, n), rows[n].values[c])) diff++;
+        }
+    }
+    ok &= check(rec.rows() == rows.size() && rec.columns() == columns && rec.chunk_count() > 1U && diff == 0U,
+                "kayit: %llu satir, %zu chunk, %zu fark", (unsigned long long)rec.rows(), rec.chunk_count(), diff);
+
+    // Replay: kayıt CSV olarak (%.6g) geri oynatılır
+    FILE *pipe = popen((std::string("./foc_client replay ") + RECORD_PATH + " --speed 0").c_str(), "r");
+    if(pipe == nullptr) return check(false, "foc_client replay calistirilamadi");
+
+    std::vector<row> replayed;
+    std::string header;
+    char line[1024];
+    while(fgets(line, sizeof(line), pipe) != nullptr){
+        std::string text(line);
+        if(!text.empty() && text.back() == '\n') text.pop_back();
+        if(header.empty()){
+            header = text;
+            continue;
+        }
+        std::vector<std::string> fields;
+        size_t start = 0;
+        for(;;){
+            size_t comma = text.find(',', start);
+            fields.push_back(text.substr(start, comma - start));
+            if(comma == std::string::npos) break;
+            start = comma + 1U;
+        }
+        row r{ strtoull(fields[0].c_str(), nullptr, 10), {} };
+        for(size_t c = 1; c < fields.size(); c++) r.values.push_back(csv_value(fields[c]));
+        replayed.push_back(r);
+    }
+    int status = pclose(pipe);
+
+    std::string expected = "tick";
+    for(const auto &name : columns) expected += "," + name;
+    diff = 0;
+    for(size_t n = 0; n < rows.size() && n < replayed.size(); n++){
+        if(replayed[n].tick != rows[n].tick || replayed[n].values.size() != columns.size()){
+            diff++;
+            continue;
+        }
+        for(size_t c = 0; c < columns.size(); c++){
+            float a = replayed[n].values[c];
+            float b = rows[n].values[c];
+            if(std::isnan(a) != std::isnan(b) || (!std::isnan(a) && std::fabs(a - b) > 1e-5f * std::fmax(1.0f, std::fabs(b)))) diff++;
+        }
+    }
+    ok &= check(status == 0 && header == expected && replayed.size() == rows.size() && diff == 0U,
+                "replay: %zu satir, %zu fark, baslik %s", replayed.size(), diff, (header == expected) ? "ayni" : header.c_str());
+
+    unlink(RECORD_PATH);
+    return ok;
+}
+
+} // namespace
+
+int main(){
+    bool ok = true;
+
+    try{
+        test_drive drive;
+        client cl(*drive.host, 2000);
+        std::vector<row> rows;
+        std::vector<std::string> columns;
+
+        ok &= test_catalog(cl);
+        ok &= test_params(cl);
+        ok &= test_stream(cl, rows, columns);
+        if(!rows.empty()) ok &= test_record(rows, columns);
+    }
+    catch(const std::exception &e){
+        ok = check(false, "istisna: %s", e.what());
+    }
+
+    // Firmware modülleri tek örnekli: ikinci sürücü reddedilir, ilki kapanınca yenisi kurulabilir
+    {
+        auto pipe = make_memory_pipe();
+        uart_link drive(std::move(pipe.second));
+        sim_drive first(drive);
+        bool second_rejected = false;
+        try{
+            sim_drive second(drive);
+        }
+        catch(const std::logic_error &){
+            second_rejected = true;
+        }
+        ok &= check(second_rejected, "ikinci sim_drive reddedildi");
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,309 @@
+// foc_client sütunlu kayıt: mmap ile yazma / okuma, CSV ve .npy dışa aktarma.
+
+#include "foc_record.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace foc{
+
+namespace{
+
+const char RECORD_MAGIC[8] = "FOCREC1";
+
+size_t chunk_size(uint32_t columns, uint32_t chunk_rows){
+    return (size_t)chunk_rows * (sizeof(uint64_t) + ((size_t)columns * sizeof(float)));
+}
+
+[[noreturn]] void throw_errno(const std::string &what){
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+} // namespace
+
+// <<---------------------------------------------->>
+// <<------------------ recorder ------------------>>
+// <<---------------------------------------------->>
+
+recorder::recorder(const std::string &path, const std::vector<std::string> &columns, double tick_hz, uint32_t chunk_rows){
+    if(columns.empty() || columns.size() > RECORD_MAX_COLUMNS) throw std::invalid_argument("kayıt sütun sayısı 1 ... 80 olmalı");
+    if(chunk_rows == 0U || (chunk_rows % RECORD_ROW_ALIGN) != 0U) throw std::invalid_argument("chunk_rows 1024'ün katı olmalı");
+
+    columns_ = (uint32_t)columns.size();
+    chunk_rows_ = chunk_rows;
+    chunk_bytes_ = chunk_size(columns_, chunk_rows_);
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd_ < 0) throw_errno(path);
+    if(ftruncate(fd_, (off_t)RECORD_HEADER_SIZE) != 0) throw_errno(path);
+
+    void *map = mmap(nullptr, RECORD_HEADER_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if(map == MAP_FAILED) throw_errno(path);
+    header_ = static_cast<record_header *>(map);
+
+    memset(header_, 0, sizeof(*header_));
+    memcpy(header_->magic, RECORD_MAGIC, sizeof(RECORD_MAGIC));
+    header_->version = RECORD_VERSION;
+    header_->header_size = (uint32_t)RECORD_HEADER_SIZE;
+    header_->column_count = columns_;
+    header_->chunk_rows = chunk_rows_;
+    header_->tick_hz = tick_hz;
+    for(size_t i = 0; i < columns.size(); i++){
+        strncpy(header_->names[i], columns[i].c_str(), RECORD_NAME_SIZE - 1U);
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+recorder::~recorder(){
+    close();
+}
+
+// ------------------------------------------------------------------------------
+
+void recorder::map_chunk(uint64_t index){
+    off_t offset = (off_t)(RECORD_HEADER_SIZE + (index * chunk_bytes_));
+
+    int error = posix_fallocate(fd_, offset, (off_t)chunk_bytes_);
+    if(error != 0){
+        errno = error;
+        throw_errno("kayıt chunk'ı ayrılamadı");
+    }
+    void *map = mmap(nullptr, chunk_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, offset);
+    if(map == MAP_FAILED) throw_errno("kayıt chunk'ı eşlenemedi");
+
+    // Sıralı yazılır, okunmaz
+    madvise(map, chunk_bytes_, MADV_SEQUENTIAL);
+    chunk_ = static_cast<uint8_t *>(map);
+    row_in_chunk_ = 0;
+    header_->chunk_count = index + 1U;
+}
+
+// ------------------------------------------------------------------------------
+
+void recorder::unmap_chunk(){
+    if(chunk_ == nullptr) return;
+    msync(chunk_, chunk_bytes_, MS_ASYNC);
+    munmap(chunk_, chunk_bytes_);
+    chunk_ = nullptr;
+}
+
+// ------------------------------------------------------------------------------
+
+void recorder::append(uint64_t tick, const float *values){
+    if(header_ == nullptr) throw std::logic_error("kayıt kapalı");
+
+    if(chunk_ == nullptr || row_in_chunk_ == chunk_rows_){
+        unmap_chunk();
+        map_chunk(header_->chunk_count);
+    }
+
+    uint64_t *ticks = reinterpret_cast<uint64_t *>(chunk_);
+    float *column = reinterpret_cast<float *>(chunk_ + ((size_t)chunk_rows_ * sizeof(uint64_t)));
+    ticks[row_in_chunk_] = tick;
+    for(uint32_t c = 0; c < columns_; c++){
+        column[((size_t)c * chunk_rows_) + row_in_chunk_] = values[c];
+    }
+    row_in_chunk_++;
+    header_->row_count++;
+}
+
+// ------------------------------------------------------------------------------
+
+void recorder::set_counters(uint64_t dropped_frames, uint64_t lost_frames){
+    header_->dropped_frames = dropped_frames;
+    header_->lost_frames = lost_frames;
+}
+
+// ------------------------------------------------------------------------------
+
+void recorder::close(){
+    if(header_ == nullptr) return;
+    unmap_chunk();
+    msync(header_, RECORD_HEADER_SIZE, MS_SYNC);
+    munmap(header_, RECORD_HEADER_SIZE);
+    header_ = nullptr;
+    ::close(fd_);
+    fd_ = -1;
+}
+
+// <<---------------------------------------------->>
+// <<------------------- reader ------------------->>
+// <<---------------------------------------------->>
+
+reader::reader(const std::string &path){
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if(fd_ < 0) throw_errno(path);
+
+    struct stat st;
+    if(fstat(fd_, &st) != 0) throw_errno(path);
+    size_ = (size_t)st.st_size;
+    if(size_ < RECORD_HEADER_SIZE){
+        ::close(fd_);
+        throw std::runtime_error(path + ": kayıt dosyası değil");
+    }
+
+    void *map = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if(map == MAP_FAILED){
+        ::close(fd_);
+        throw_errno(path);
+    }
+    map_ = static_cast<const uint8_t *>(map);
+    header_ = reinterpret_cast<const record_header *>(map_);
+
+    if(memcmp(header_->magic, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0 || header_->version != RECORD_VERSION ||
+       header_->column_count == 0U || header_->column_count > RECORD_MAX_COLUMNS || header_->chunk_rows == 0U){
+        munmap(const_cast<uint8_t *>(map_), size_);
+        ::close(fd_);
+        throw std::runtime_error(path + ": kayıt dosyası değil");
+    }
+
+    chunk_bytes_ = chunk_size(header_->column_count, header_->chunk_rows);
+    uint64_t available = (uint64_t)((size_ - RECORD_HEADER_SIZE) / chunk_bytes_);
+    if(((header_->row_count + header_->chunk_rows - 1U) / header_->chunk_rows) > available){
+        munmap(const_cast<uint8_t *>(map_), size_);
+        ::close(fd_);
+        throw std::runtime_error(path + ": kayıt dosyası kesik");
+    }
+
+    for(uint32_t c = 0; c < header_->column_count; c++){
+        columns_.emplace_back(header_->names[c], strnlen(header_->names[c], RECORD_NAME_SIZE));
+    }
+    column_ptrs_.resize(header_->column_count);
+    madvise(const_cast<uint8_t *>(map_), size_, MADV_SEQUENTIAL);
+}
+
+// ------------------------------------------------------------------------------
+
+reader::~reader(){
+    munmap(const_cast<uint8_t *>(map_), size_);
+    ::close(fd_);
+}
+
+// ------------------------------------------------------------------------------
+
+const uint8_t *reader::chunk_base(uint64_t index) const{
+    return map_ + RECORD_HEADER_SIZE + (index * chunk_bytes_);
+}
+
+// ------------------------------------------------------------------------------
+
+uint64_t reader::tick(uint64_t row) const{
+    const uint8_t *base = chunk_base(row / header_->chunk_rows);
+    return reinterpret_cast<const uint64_t *>(base)[row % header_->chunk_rows];
+}
+
+// ------------------------------------------------------------------------------
+
+float reader::value(size_t column, uint64_t row) const{
+    const uint8_t *base = chunk_base(row / header_->chunk_rows);
+    const float *values = reinterpret_cast<const float *>(base + ((size_t)header_->chunk_rows * sizeof(uint64_t)));
+    return values[(column * header_->chunk_rows) + (row % header_->chunk_rows)];
+}
+
+// ------------------------------------------------------------------------------
+
+size_t reader::chunk_count() const{
+    return (size_t)((header_->row_count + header_->chunk_rows - 1U) / header_->chunk_rows);
+}
+
+// ------------------------------------------------------------------------------
+
+reader::chunk_view reader::chunk(size_t index) const{
+    const uint8_t *base = chunk_base(index);
+    const float *values = reinterpret_cast<const float *>(base + ((size_t)header_->chunk_rows * sizeof(uint64_t)));
+    uint64_t first = (uint64_t)index * header_->chunk_rows;
+
+    for(uint32_t c = 0; c < header_->column_count; c++){
+        column_ptrs_[c] = values + ((size_t)c * header_->chunk_rows);
+    }
+
+    chunk_view view;
+    view.ticks = reinterpret_cast<const uint64_t *>(base);
+    view.columns = column_ptrs_.data();
+    view.rows = (size_t)std::min<uint64_t>(header_->chunk_rows, header_->row_count - first);
+    return view;
+}
+
+// <<---------------------------------------------->>
+// <<--------------- Dışa aktarma ----------------->>
+// <<---------------------------------------------->>
+
+void export_csv(const reader &rec, const std::string &path){
+    FILE *out = (path == "-") ? stdout : fopen(path.c_str(), "w");
+    if(out == nullptr) throw_errno(path);
+
+    fputs("tick", out);
+    for(const auto &name : rec.columns()){
+        fprintf(out, ",%s", name.c_str());
+    }
+    fputc('\n', out);
+
+    const size_t columns = rec.columns().size();
+    for(size_t k = 0; k < rec.chunk_count(); k++){
+        reader::chunk_view view = rec.chunk(k);
+        for(size_t r = 0; r < view.rows; r++){
+            fprintf(out, "%llu", (unsigned long long)view.ticks[r]);
+            for(size_t c = 0; c < columns; c++){
+                float v = view.columns[c][r];
+                if(std::isnan(v)) fputc(',', out);
+                else fprintf(out, ",%.9g", (double)v);
+            }
+            fputc('\n', out);
+        }
+    }
+
+    if(out != stdout && fclose(out) != 0) throw_errno(path);
+}
+
+// ------------------------------------------------------------------------------
+
+namespace{
+
+// NPY 1.0: sihirli sayı + sürüm + başlık uzunluğu + 64 byte'a hizalanmış sözlük
+void write_npy_header(FILE *out, const char *descr, uint64_t rows){
+    char dict[128];
+    int n = snprintf(dict, sizeof(dict), "{'descr': '%s', 'fortran_order': False, 'shape': (%llu,), }", descr, (unsigned long long)rows);
+    size_t total = 10U + (size_t)n + 1U;
+    size_t pad = (64U - (total % 64U)) % 64U;
+    uint16_t header_len = (uint16_t)((size_t)n + pad + 1U);
+
+    fwrite("\x93NUMPY\x01\x00", 1, 8, out);
+    uint8_t len[2] = { (uint8_t)(header_len & 0xFFU), (uint8_t)(header_len >> 8) };
+    fwrite(len, 1, 2, out);
+    fwrite(dict, 1, (size_t)n, out);
+    for(size_t i = 0; i < pad; i++) fputc(' ', out);
+    fputc('\n', out);
+}
+
+} // namespace
+
+void export_npy(const reader &rec, const std::string &dir){
+    if(mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) throw_errno(dir);
+
+    // Sütun -1: tick
+    for(long c = -1; c < (long)rec.columns().size(); c++){
+        std::string name = (c < 0) ? std::string("tick") : rec.columns()[(size_t)c];
+        std::string path = dir + "/" + name + ".npy";
+        FILE *out = fopen(path.c_str(), "wb");
+        if(out == nullptr) throw_errno(path);
+
+        write_npy_header(out, (c < 0) ? "<u8" : "<f4", rec.rows());
+        for(size_t k = 0; k < rec.chunk_count(); k++){
+            reader::chunk_view view = rec.chunk(k);
+            if(c < 0) fwrite(view.ticks, sizeof(uint64_t), view.rows, out);
+            else fwrite(view.columns[c], sizeof(float), view.rows, out);
+        }
+        if(fclose(out) != 0) throw_errno(path);
+    }
+}
+
+} // namespace foc
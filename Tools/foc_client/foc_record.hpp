@@ -0,0 +1,153 @@
+#ifndef FOC_RECORD_HPP_
+#define FOC_RECORD_HPP_
+
+// Sütunlu telemetri kaydı (.focrec), okuyucu ve dışa aktarma.
+// Dosya: 4096 byte başlık + sabit satırlı chunk'lar. Chunk içinde önce chunk_rows x uint64 tick, sonra her sütun
+// için chunk_rows x float (sütun bazında bitişik). Sadece yazılan chunk eşlenir (mmap), yeri önceden ayrılır
+// (posix_fallocate: disk dolarsa SIGBUS yerine açık hata), biten chunk msync(MS_ASYNC) ile çekirdeğe bırakılır.
+// Böylece bellek kullanımı kayıt uzunluğundan bağımsızdır ve çok GB'lık kayıtlarda yazma sistem çağrısı yoktur.
+// Başlıktaki satır sayısı her satırda güncellenir: yarıda kesilen kayıt da son satırına kadar okunabilir.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace foc{
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+constexpr uint32_t RECORD_VERSION = 1U;
+constexpr size_t RECORD_HEADER_SIZE = 4096U;
+constexpr size_t RECORD_NAME_SIZE = 48U;
+constexpr size_t RECORD_MAX_COLUMNS = 80U;
+constexpr uint32_t RECORD_ROW_ALIGN = 1024U; // Chunk'ların sayfa hizalı olması için chunk_rows bunun katı
+
+struct record_header{
+    char magic[8];             // "FOCREC1"
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t column_count;
+    uint32_t chunk_rows;
+    uint64_t row_count;
+    uint64_t chunk_count;      // Dosyada yeri ayrılmış chunk
+    double tick_hz;            // Tick -> saniye (0: bilinmiyor)
+    uint64_t dropped_frames;   // Kayıt kuyruğu dolduğu için atılan çerçeve
+    uint64_t lost_frames;      // Bağlantıda kaybolan çerçeve (sıra boşlukları)
+    char names[RECORD_MAX_COLUMNS][RECORD_NAME_SIZE];
+    uint8_t reserved[RECORD_HEADER_SIZE - 64U - (RECORD_MAX_COLUMNS * RECORD_NAME_SIZE)];
+};
+
+static_assert(sizeof(record_header) == RECORD_HEADER_SIZE, "Kayıt başlığı 4096 byte olmalı");
+
+// <<---------------------------------------------->>
+// <<------------- Sınıf Tanımlamaları ------------>>
+// <<---------------------------------------------->>
+
+// Tek üretici / tek tüketici kilitsiz kuyruk: bağlantıyı okuyan thread diske yazan thread'i hiç beklemez.
+// Kapasite 2'nin kuvveti olmalı, dolu kuyruğa push false döner (çağıran atılan çerçeveyi sayar).
+template <typename T>
+class spsc_queue{
+public:
+    explicit spsc_queue(size_t capacity) : slots_(capacity), mask_(capacity - 1U){
+    }
+
+    bool push(const T &item){
+        size_t head = head_.load(std::memory_order_relaxed);
+        if(head - tail_.load(std::memory_order_acquire) >= slots_.size()) return false;
+        slots_[head & mask_] = item;
+        head_.store(head + 1U, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &item){
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if(tail == head_.load(std::memory_order_acquire)) return false;
+        item = slots_[tail & mask_];
+        tail_.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const{
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_{ 0 };
+    alignas(64) std::atomic<size_t> tail_{ 0 };
+};
+
+// Hatalar std::system_error / std::runtime_error ile bildirilir
+class recorder{
+public:
+    recorder(const std::string &path, const std::vector<std::string> &columns, double tick_hz = 0.0, uint32_t chunk_rows = 65536U);
+    ~recorder();
+    recorder(const recorder &) = delete;
+    recorder &operator=(const recorder &) = delete;
+
+    void append(uint64_t tick, const float *values);
+    void set_counters(uint64_t dropped_frames, uint64_t lost_frames);
+    uint64_t rows() const { return header_->row_count; }
+    void close();
+
+private:
+    void map_chunk(uint64_t index);
+    void unmap_chunk();
+
+    int fd_ = -1;
+    record_header *header_ = nullptr;
+    uint8_t *chunk_ = nullptr;
+    size_t chunk_bytes_ = 0;
+    uint32_t columns_ = 0;
+    uint32_t chunk_rows_ = 0;
+    uint32_t row_in_chunk_ = 0;
+};
+
+// Kaydı salt okunur eşler (tüm dosya)
+class reader{
+public:
+    explicit reader(const std::string &path);
+    ~reader();
+    reader(const reader &) = delete;
+    reader &operator=(const reader &) = delete;
+
+    const record_header &header() const { return *header_; }
+    uint64_t rows() const { return header_->row_count; }
+    const std::vector<std::string> &columns() const { return columns_; }
+    uint64_t tick(uint64_t row) const;
+    float value(size_t column, uint64_t row) const;
+
+    // Chunk bazında bitişik erişim: ticks[n], column(c)[n]
+    struct chunk_view{
+        const uint64_t *ticks;
+        const float *const *columns;
+        size_t rows;
+    };
+    size_t chunk_count() const;
+    chunk_view chunk(size_t index) const;
+
+private:
+    const uint8_t *chunk_base(uint64_t index) const;
+
+    int fd_ = -1;
+    const uint8_t *map_ = nullptr;
+    size_t size_ = 0;
+    const record_header *header_ = nullptr;
+    size_t chunk_bytes_ = 0;
+    std::vector<std::string> columns_;
+    mutable std::vector<const float *> column_ptrs_;
+};
+
+// path "-": stdout. NaN (o satırda örneklenmemiş) boş alan olarak yazılır.
+void export_csv(const reader &rec, const std::string &path);
+// dir altına tick.npy (<u8) ve her sütun için <isim>.npy (<f4): numpy.load / numpy.memmap ile okunur
+void export_npy(const reader &rec, const std::string &dir);
+
+} // namespace foc
+
+#endif /* FOC_RECORD_HPP_ */
@@ -0,0 +1,353 @@
+// foc_client simüle sürücü.
+
+#include "foc_sim.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+extern "C"{
+#include "FOC_Log.h"
+#include "FOC_Param.h"
+#include "FOC_Scheduler.h"
+#include "FOC_Telemetry.h"
+}
+
+// Host tipleri firmware yapılarının kopyasıdır: boyutlar ayrılırsa derleme durur
+static_assert(sizeof(foc_link_catalog_t) == sizeof(FOC_Telem_Catalog_t), "foc_link_catalog_t != FOC_Telem_Catalog_t");
+static_assert(sizeof(foc_link_stream_header_t) == sizeof(FOC_Telem_Header_t), "foc_link_stream_header_t != FOC_Telem_Header_t");
+static_assert(sizeof(foc_link_subscribe_t) == sizeof(FOC_Telem_Subscribe_t), "foc_link_subscribe_t != FOC_Telem_Subscribe_t");
+static_assert(sizeof(foc_link_sub_entry_t) == sizeof(FOC_Telem_Sub_Entry_t), "foc_link_sub_entry_t != FOC_Telem_Sub_Entry_t");
+static_assert(sizeof(foc_link_ack_t) == sizeof(FOC_Telem_Ack_t), "foc_link_ack_t != FOC_Telem_Ack_t");
+static_assert(sizeof(foc_link_param_msg_t) == sizeof(FOC_Param_Msg_t), "foc_link_param_msg_t != FOC_Param_Msg_t");
+static_assert(sizeof(foc_link_param_info_t) == sizeof(FOC_Param_Info_t), "foc_link_param_info_t != FOC_Param_Info_t");
+static_assert(sizeof(foc_link_param_status_t) == sizeof(FOC_Param_Status_t), "foc_link_param_status_t != FOC_Param_Status_t");
+static_assert(sizeof(foc_link_log_header_t) == sizeof(FOC_Log_Header_t), "foc_link_log_header_t != FOC_Log_Header_t");
+
+namespace foc{
+
+namespace{
+
+constexpr float TWO_PI = 6.28318531f;
+constexpr float R_PHASE = 0.05f;
+constexpr float L_PHASE = 100e-6f;
+constexpr float FLUX = 0.007f;
+
+// Firmware modülleri tek örnekli: handle ve onu süren sim_drive modül düzeyinde
+FOC_Handle_t sim_handle;
+sim_drive *sim_active = nullptr;
+uint32_t sim_tick = 0;
+
+bool sim_sink(const uint8_t *pData, uint16_t length){
+    return (sim_active != nullptr) && sim_active->stream(pData, length);
+}
+
+// Varsayılan motor ayarı (FOC_Param'ın canlı değerleri)
+void sim_config(FOC_Driver_Config_t &c){
+    c.Kp_d = 0.5f;
+    c.Ki_d = 500.0f;
+    c.Kp_q = 0.5f;
+    c.Ki_q = 500.0f;
+    c.current_limit = 20.0f;
+    c.I_s_max = 20.0f;
+    c.voltage_limit = 24.0f;
+    c.max_speed_rad_s = 1000.0f;
+    c.R_phase = R_PHASE;
+    c.L_d = 80e-6f;
+    c.L_q = L_PHASE;
+    c.flux_linkage = FLUX;
+    c.pole_pairs = 7U;
+    c.deadbeat_gain = 0.8f;
+    c.fcs_switch_weight = 0.1f;
+    c.V_switch_drop = 0.1f;
+    c.V_diode_drop = 0.7f;
+    c.dtc_current_band = 0.5f;
+    c.fw_Ki = 100.0f;
+    c.fw_voltage_margin = 0.95f;
+    c.fw_i_d_min = -10.0f;
+    c.fw_decimation = 10U;
+    c.Kp_speed = 0.05f;
+    c.Ki_speed = 1.0f;
+    c.Kp_position = 20.0f;
+    c.speed_torque_limit = 1.0f;
+    c.max_mod_index = 0.95f;
+    c.dead_time_comp = true;
+    c.back_calc_aw = true;
+    c.pwm_frequency = 20000.0f;
+    c.Ts = 1.0f / 20000.0f;
+}
+
+} // namespace
+
+// <<---------------------------------------------->>
+// <<------------- Firmware bağlantısı ------------>>
+// <<---------------------------------------------->>
+
+// FOC_Scheduler, FOC_Log ve FOC_Benchmark yerine: firmware modüllerinin kullandığı fonksiyonlar
+extern "C" uint32_t FOC_Scheduler_Get_Tick(void){
+    return sim_tick;
+}
+
+// Host'ta DWT çevrim saymaz: FCS-MPC commit'inin bütçe kontrolü her zaman geçer
+extern "C" bool FOC_Bench_FCS_MPC_Config(const FOC_Handle_t *pHandle, const FOC_Driver_Config_t *pConfig, FOC_Bench_t *pBench, uint32_t iterations){
+    (void)pHandle;
+    (void)pConfig;
+    (void)iterations;
+    pBench->count = 0;
+    pBench->max = 0;
+    pBench->budget = FOC_FCS_MPC_MAX_CYCLES;
+    pBench->overrun_count = 0;
+    return true;
+}
+
+extern "C" void FOC_Log_Deferred(uint32_t info, const char *pFormat, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3){
+    char text[FOC_LOG_TEXT_MAX + 1U];
+
+    // Firmware format'ları 32 bit long içindir (%lu): host'ta unsigned long olarak verilir
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+    snprintf(text, sizeof(text), pFormat, (unsigned long)a0, (unsigned long)a1, (unsigned long)a2, (unsigned long)a3);
+#pragma GCC diagnostic pop
+    if(sim_active != nullptr) sim_active->log((uint8_t)(info & 0x0FU), "%s", text);
+}
+
+// <<---------------------------------------------->>
+// <<------------------- Kurulum ------------------>>
+// <<---------------------------------------------->>
+
+sim_drive::sim_drive(link &l, const sim_options &options) : link_(l), options_(options){
+    if(sim_active != nullptr) throw std::logic_error("aynı anda tek sim_drive olabilir (firmware modülleri tek örnekli)");
+
+    memset(&setpoint_, 0, sizeof(setpoint_));
+    memset(&telemetry_, 0, sizeof(telemetry_));
+    if(options_.stream_period == 0U) options_.stream_period = 1U;
+    if(options_.max_packet > FOC_LINK_MAX_PAYLOAD) options_.max_packet = FOC_LINK_MAX_PAYLOAD;
+
+    memset(&sim_handle, 0, sizeof(sim_handle));
+    sim_config(sim_handle.config);
+    sim_tick = 0;
+    sim_active = this;
+
+    FOC_Param_Init(&sim_handle);
+    FOC_Telemetry_Init(&sim_handle, options_.stream_period);
+    FOC_Telemetry_Set_Sink(sim_sink, options_.max_packet);
+}
+
+// ------------------------------------------------------------------------------
+
+sim_drive::~sim_drive(){
+    FOC_Telemetry_Set_Sink(nullptr, FOC_TELEM_MAX_PACKET);
+    sim_active = nullptr;
+}
+
+// ------------------------------------------------------------------------------
+
+void sim_drive::send(uint8_t type, const void *payload, size_t length){
+    if(open_ && !link_.send(type, payload, length)) open_ = false;
+}
+
+// ------------------------------------------------------------------------------
+
+// FOC_Log çerçevesi (LOG_x): tick + seviye + en fazla FOC_LOG_TEXT_MAX (120) byte metin
+void sim_drive::log(uint8_t level, const char *format, ...){
+    uint8_t payload[sizeof(foc_link_log_header_t) + FOC_LOG_TEXT_MAX + 1U];
+    foc_link_log_header_t header = { (uint32_t)tick_, level };
+    memcpy(payload, &header, sizeof(header));
+
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf((char *)payload + sizeof(header), FOC_LOG_TEXT_MAX + 1U, format, args);
+    va_end(args);
+    if(n < 0) return;
+    if(n > (int)FOC_LOG_TEXT_MAX) n = (int)FOC_LOG_TEXT_MAX;
+    send(FOC_LINK_TYPE_LOG, payload, sizeof(header) + (size_t)n);
+}
+
+// ------------------------------------------------------------------------------
+
+bool sim_drive::stream(const uint8_t *data, uint16_t length){
+    send(FOC_LINK_TYPE_STREAM, data, length);
+    return open_;
+}
+
+// <<---------------------------------------------->>
+// <<------------------ İstekler ------------------>>
+// <<---------------------------------------------->>
+
+void sim_drive::handle(const frame &f){
+    FOC_Driver_Config_t &config = sim_handle.config;
+    stats_.requests++;
+
+    switch(f.type){
+        case FOC_LINK_TYPE_COMMAND:
+            if(f.length >= 1U && f.payload[0] == FOC_LINK_CMD_ENABLE) config.current_ctrl_mode = true;
+            else if(f.length >= 1U && f.payload[0] == FOC_LINK_CMD_DISABLE) config.current_ctrl_mode = false;
+            log(FOC_LINK_LOG_INFO, "komut 0x%02x: surucu %s", (f.length >= 1U) ? f.payload[0] : 0U,
+                config.current_ctrl_mode ? "acik" : "kapali");
+            break;
+        case FOC_LINK_TYPE_SETPOINT:
+            if(f.length == sizeof(setpoint_)){
+                memcpy(&setpoint_, f.payload, sizeof(setpoint_));
+                config.current_ctrl_mode = (setpoint_.mode != FOC_LINK_MODE_DISABLE);
+            }
+            break;
+        case FOC_LINK_TYPE_SUBSCRIBE:
+            handle_subscribe(f);
+            break;
+        case FOC_LINK_TYPE_CATALOG:
+            handle_catalog(f);
+            break;
+        case FOC_LINK_TYPE_PARAM:
+            handle_param(f);
+            break;
+        default:
+            break;
+    }
+    config.speed_ctrl_mode = config.current_ctrl_mode && setpoint_.mode >= FOC_LINK_MODE_SPEED;
+    config.position_ctrl_mode = config.current_ctrl_mode && setpoint_.mode == FOC_LINK_MODE_POSITION;
+}
+
+// ------------------------------------------------------------------------------
+
+// Bekleyen tabloya yazılır, FOC_Telemetry_Task'ın bir sonraki çalışmasında uygulanır
+void sim_drive::handle_subscribe(const frame &f){
+    FOC_Telem_Ack_t ack;
+    FOC_Telemetry_Subscribe(f.payload, f.length, &ack);
+    send(FOC_LINK_TYPE_SUBSCRIBE, &ack, sizeof(ack));
+}
+
+// ------------------------------------------------------------------------------
+
+void sim_drive::handle_catalog(const frame &f){
+    uint8_t response[FOC_LINK_MAX_PAYLOAD];
+    uint8_t first = (f.length >= 1U) ? f.payload[0] : 0U;
+    uint16_t length = FOC_Telemetry_Catalog(first, response, sizeof(response));
+    send(FOC_LINK_TYPE_CATALOG, response, length);
+}
+
+// ------------------------------------------------------------------------------
+
+// Commit FOC_Param_Process (ana döngü) ile hazırlanır, bir sonraki tick'in başında FOC_Param_Apply ile uygulanır
+void sim_drive::handle_param(const frame &f){
+    uint8_t response[sizeof(FOC_Param_Msg_t) + sizeof(FOC_Param_Info_t)];
+    uint16_t length = FOC_Param_Request(f.payload, f.length, response, sizeof(response));
+    if(length != 0U) send(FOC_LINK_TYPE_PARAM, response, length);
+}
+
+// <<---------------------------------------------->>
+// <<------------------ Model --------------------->>
+// <<---------------------------------------------->>
+
+// I_q referansını takip eden sentetik akım, hız ve açı (foc_link_pty ile aynı biçim) ve bunlardan türetilen sinyaller.
+// Değerler telemetri tablosunun okuduğu handle alanlarına yazılır.
+void sim_drive::update_model(){
+    const float dt = 1.0f / (float)options_.tick_hz;
+    const float t = (float)tick_ * dt;
+    FOC_Driver_Input_t &in = sim_handle.input;
+    FOC_Driver_State_t &st = sim_handle.state;
+    FOC_Driver_Output_t &out = sim_handle.output;
+    const bool enabled = sim_handle.config.current_ctrl_mode;
+
+    float i_q_ref = enabled ? setpoint_.torque_ref * 10.0f : 0.0f;
+    in.T_mot_ref = enabled ? setpoint_.torque_ref : 0.0f;
+    in.speed_ref_rad_s = setpoint_.speed_ref;
+    in.position_ref_rad = setpoint_.position_ref;
+    st.i_d_ref = 0.0f;
+    st.i_q_ref = i_q_ref;
+    st.i_q = i_q_ref + 0.05f * sinf(TWO_PI * 50.0f * t);
+    st.i_d = 0.02f * cosf(TWO_PI * 50.0f * t);
+    in.w_rad_s += (100.0f * i_q_ref - in.w_rad_s) * 0.001f;
+    in.Electrical_Angle_rad = fmodf(in.Electrical_Angle_rad + in.w_rad_s * dt, TWO_PI);
+    in.position_rad += in.w_rad_s * dt / (float)sim_handle.config.pole_pairs;
+    in.U_bat = 24.0f - 0.05f * st.i_q + 0.02f * sinf(TWO_PI * 300.0f * t);
+
+    float c = cosf(in.Electrical_Angle_rad);
+    float s = sinf(in.Electrical_Angle_rad);
+    st.i_alpha = st.i_d * c - st.i_q * s;
+    st.i_beta = st.i_d * s + st.i_q * c;
+    in.i_a_meas = st.i_alpha;
+    in.i_b_meas = -0.5f * st.i_alpha + 0.8660254f * st.i_beta;
+    st.u_d = R_PHASE * st.i_d - in.w_rad_s * L_PHASE * st.i_q;
+    st.u_q = R_PHASE * st.i_q + in.w_rad_s * (L_PHASE * st.i_d + FLUX);
+    st.d_q_max_voltage = in.U_bat * 0.57735f;
+    st.i_q_limit = sim_handle.config.current_limit;
+    st.fw_i_d = 0.0f;
+    st.speed_ref = setpoint_.speed_ref;
+    st.speed_integrator += (setpoint_.speed_ref - in.w_rad_s) * dt * 0.01f;
+
+    float u_alpha = st.u_d * c - st.u_q * s;
+    float u_beta = st.u_d * s + st.u_q * c;
+    float scale = (in.U_bat > 1.0f) ? 1.0f / in.U_bat : 0.0f;
+    out.duty_a = 0.5f + u_alpha * scale;
+    out.duty_b = 0.5f + (-0.5f * u_alpha + 0.8660254f * u_beta) * scale;
+    out.duty_c = 0.5f + (-0.5f * u_alpha - 0.8660254f * u_beta) * scale;
+    st.fcs_state = (uint8_t)((tick_ / 3U) % 8U);
+}
+
+// <<---------------------------------------------->>
+// <<------------------ Çalışma ------------------->>
+// <<---------------------------------------------->>
+
+bool sim_drive::step(uint32_t ticks){
+    // İstekler ISR'daki gibi tick'ler arasında işlenir
+    if(!link_.poll([this](const frame &f){ handle(f); }, 0)) open_ = false;
+
+    for(uint32_t n = 0; n < ticks && open_; n++){
+        // Ana döngü commit'i hazırlar, akım ISR'ı tick başında uygular
+        FOC_Param_Process();
+        FOC_Param_Apply(&sim_handle);
+
+        update_model();
+        sim_tick = (uint32_t)tick_;
+        if((tick_ % options_.stream_period) == 0U) FOC_Telemetry_Task(&sim_handle);
+
+        if(options_.telemetry_divider != 0U && (tick_ % options_.telemetry_divider) == 0U){
+            const FOC_Driver_Config_t &c = sim_handle.config;
+            telemetry_.tick = (uint32_t)tick_;
+            telemetry_.status = (uint8_t)((c.current_ctrl_mode ? 0x01U : 0U) | (c.speed_ctrl_mode ? 0x02U : 0U) |
+                                          (c.position_ctrl_mode ? 0x04U : 0U));
+            telemetry_.i_d = sim_handle.state.i_d;
+            telemetry_.i_q = sim_handle.state.i_q;
+            telemetry_.i_d_ref = sim_handle.state.i_d_ref;
+            telemetry_.i_q_ref = sim_handle.state.i_q_ref;
+            telemetry_.u_d = sim_handle.state.u_d;
+            telemetry_.u_q = sim_handle.state.u_q;
+            telemetry_.w_rad_s = sim_handle.input.w_rad_s;
+            telemetry_.electrical_angle = sim_handle.input.Electrical_Angle_rad;
+            telemetry_.U_bat = sim_handle.input.U_bat;
+            telemetry_.position_rad = sim_handle.input.position_rad;
+            send(FOC_LINK_TYPE_TELEMETRY, &telemetry_, sizeof(telemetry_));
+            stats_.telemetry_frames++;
+        }
+
+        tick_++;
+        stats_.ticks++;
+    }
+
+    const FOC_Telem_Stats_t *pStream = FOC_Telemetry_Get_Stats();
+    stats_.stream_packets = pStream->packets;
+    stats_.stream_samples = pStream->samples;
+    stats_.stream_bytes = pStream->bytes;
+    return open_;
+}
+
+// ------------------------------------------------------------------------------
+
+void sim_drive::run(const std::atomic<bool> &stop, bool realtime){
+    // 1 ms'lik dilimler: gerçek zamanlıda her dilimden sonra bir sonraki ms'ye kadar beklenir
+    const uint32_t slice = (options_.tick_hz + 999U) / 1000U;
+    auto next = std::chrono::steady_clock::now();
+
+    while(!stop.load(std::memory_order_relaxed) && open_){
+        if(!step(slice)) break;
+        if(realtime){
+            next += std::chrono::milliseconds(1);
+            std::this_thread::sleep_until(next);
+        }
+    }
+}
+
+} // namespace foc
@@ -0,0 +1,83 @@
+#ifndef FOC_SIM_HPP_
+#define FOC_SIM_HPP_
+
+// Simüle sürücü: bir bağlantının sürücü ucunda FOC_UART'ın host'a gösterdiği davranışı taklit eder.
+// Katalog, abonelik ve parametre istekleri firmware'in kendi modülleriyle karşılanır: Core/Src/FOC_Telemetry.c,
+// FOC_Param.c ve FOC_Driver.c foc_hostsim'in register taklitleriyle (../foc_hostsim/stub) kütüphaneye derlenir,
+// sentetik motor modeli bir FOC_Handle_t'ye yazar, FOC_Telemetry_Task paketleri bu handle'dan kodlar.
+// Firmware modülleri tek örneklidir (modül statikleri): bir süreçte aynı anda tek sim_drive olabilir.
+// İstemciyi kart olmadan test etmek için: bellek içi boru (make_memory_pipe) veya pty üzerinden çalışır.
+
+#include "foc_client.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace foc{
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+struct sim_options{
+    uint32_t tick_hz = 20000U;          // Akım döngüsü / FOC_Scheduler tick'i
+    uint16_t stream_period = 2U;        // Telemetri görevinin periyodu (tick): 10 kHz
+    uint32_t telemetry_divider = 20U;   // Sabit telemetri her N tick'te bir (1 kHz), 0: kapalı
+    uint16_t max_packet = FOC_LINK_MAX_PAYLOAD;
+};
+
+struct sim_stats{
+    uint64_t ticks = 0;
+    uint64_t telemetry_frames = 0;
+    uint64_t stream_packets = 0;
+    uint64_t stream_samples = 0;
+    uint64_t stream_bytes = 0;
+    uint64_t requests = 0;
+};
+
+// <<---------------------------------------------->>
+// <<------------- Sınıf Tanımlamaları ------------>>
+// <<---------------------------------------------->>
+
+class sim_drive{
+public:
+    // Başka bir sim_drive varken std::logic_error
+    explicit sim_drive(link &l, const sim_options &options = sim_options());
+    ~sim_drive();
+    sim_drive(const sim_drive &) = delete;
+    sim_drive &operator=(const sim_drive &) = delete;
+
+    // ticks kadar ilerler: bekleyen istekleri işler, telemetri ve abonelik paketlerini gönderir.
+    // Bağlantı kapandıysa false
+    bool step(uint32_t ticks);
+    // stop true olana kadar çalışır. realtime false: bağlantının (dolu boru beklemesi) izin verdiği hızda
+    void run(const std::atomic<bool> &stop, bool realtime);
+    const sim_stats &stats() const { return stats_; }
+    uint64_t tick() const { return tick_; }
+
+    // FOC_Log çerçevesi (LOG_x): firmware modüllerinin LOG_x kayıtları da buradan gönderilir
+    void log(uint8_t level, const char *format, ...) __attribute__((format(printf, 3, 4)));
+    // FOC_Telemetry çıkışı (FOC_UART_Stream_Sink karşılığı)
+    bool stream(const uint8_t *data, uint16_t length);
+
+private:
+    void handle(const frame &f);
+    void handle_subscribe(const frame &f);
+    void handle_catalog(const frame &f);
+    void handle_param(const frame &f);
+    void update_model();
+    void send(uint8_t type, const void *payload, size_t length);
+
+    link &link_;
+    sim_options options_;
+    sim_stats stats_;
+    bool open_ = true;
+    uint64_t tick_ = 0;
+
+    // Model (motor durumu firmware handle'ında, foc_sim.cpp)
+    foc_link_setpoint_t setpoint_;
+    foc_link_telemetry_t telemetry_;
+};
+
+} // namespace foc
+
+#endif /* FOC_SIM_HPP_ */
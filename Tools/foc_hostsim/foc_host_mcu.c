@@ -0,0 +1,48 @@
+// Host derlemesinde stub/stm32g4xx.h'ta bildirilen register taklitleri.
+// CORDIC: cosine fonksiyonu, q1.31 giriş (açı / pi) ve iki sonuç (cos, sin), donanımdaki gibi sınırlı.
+
+#include "stm32g4xx_hal.h"
+#include <math.h>
+
+uint32_t SystemCoreClock = 170000000UL;
+
+CORDIC_TypeDef foc_host_cordic;
+DWT_Type foc_host_dwt;
+CoreDebug_Type foc_host_core_debug;
+SCB_Type foc_host_scb;
+uint32_t foc_host_basepri;
+uint32_t foc_host_primask;
+uint32_t foc_host_ms;
+
+static uint32_t foc_host_cordic_phase;
+
+// ------------------------------------------------------------------------------
+
+static int32_t foc_host_q31(double value){
+    double scaled = value * 2147483648.0;
+
+    if(scaled > 2147483647.0) return INT32_MAX;
+    if(scaled < -2147483648.0) return INT32_MIN;
+    return (int32_t)lrint(scaled);
+}
+
+// ------------------------------------------------------------------------------
+
+uint32_t foc_host_cordic_read(void){
+    if(foc_host_cordic_phase == 0U){
+        double angle = (double)(int32_t)foc_host_cordic.WDATA * (M_PI / 2147483648.0);
+
+        foc_host_cordic.RDATA_[0] = (uint32_t)foc_host_q31(cos(angle));
+        foc_host_cordic.RDATA_[1] = (uint32_t)foc_host_q31(sin(angle));
+    }
+
+    uint32_t index = foc_host_cordic_phase;
+    foc_host_cordic_phase ^= 1U;
+    return index;
+}
+
+// ------------------------------------------------------------------------------
+
+uint32_t HAL_GetTick(void){
+    return foc_host_ms;
+}
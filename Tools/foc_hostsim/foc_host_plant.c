@@ -0,0 +1,242 @@
+// İnverter + PMSM modeli (bkz. foc_host_plant.h)
+
+#include "foc_host_plant.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+// ------------------------------------------------------------------------------
+
+void foc_host_plant_init(foc_host_plant_t *pPlant){
+    *pPlant = (foc_host_plant_t){0};
+    pPlant->R = 0.1;
+    pPlant->L_d = 100e-6;
+    pPlant->L_q = 120e-6;
+    pPlant->flux = 0.005;
+    pPlant->pole_pairs = 15;
+    pPlant->U_DC = 24.0;
+    pPlant->f_pwm = 20000.0;
+    pPlant->dead_time = 1.0e-6;
+    pPlant->V_sw = 0.05;
+    pPlant->V_d = 0.7;
+    pPlant->substeps = 50;
+}
+
+// ------------------------------------------------------------------------------
+
+// Akım döngüsü bant genişliği bandwidth_hz: Kp = w_c * L, Ki = w_c * R (plant kutbu iptali)
+void foc_host_handle_init(FOC_Handle_t *pHandle, const foc_host_plant_t *pPlant, double bandwidth_hz){
+    double w_c = 2.0 * M_PI * bandwidth_hz;
+    FOC_Driver_Config_t *pConfig = &pHandle->config;
+
+    *pHandle = (FOC_Handle_t){0};
+    pConfig->pole_pairs = (uint8_t)pPlant->pole_pairs;
+    pConfig->R_phase = (float)pPlant->R;
+    pConfig->L_d = (float)pPlant->L_d;
+    pConfig->L_q = (float)pPlant->L_q;
+    pConfig->flux_linkage = (float)pPlant->flux;
+    pConfig->voltage_limit = (float)pPlant->U_DC;
+    pConfig->current_limit = 30.0f;
+    pConfig->I_s_max = 30.0f;
+    pConfig->max_speed_rad_s = 1000.0f;
+    pConfig->Kp_d = (float)(w_c * pPlant->L_d);
+    pConfig->Ki_d = (float)(w_c * pPlant->R);
+    pConfig->Kp_q = (float)(w_c * pPlant->L_q);
+    pConfig->Ki_q = (float)(w_c * pPlant->R);
+    pConfig->Ts = (float)(1.0 / pPlant->f_pwm);
+    pConfig->deadbeat_gain = 1.0f;
+    pConfig->fcs_switch_weight = 0.01f;
+    pConfig->pwm_frequency = (float)pPlant->f_pwm;
+    pConfig->dead_time = (float)pPlant->dead_time;
+    pConfig->V_switch_drop = (float)pPlant->V_sw;
+    pConfig->V_diode_drop = (float)pPlant->V_d;
+    pConfig->dtc_current_band = 0.2f;
+    pConfig->max_mod_index = FOC_OVM_MI_LINEAR;
+    pConfig->current_ctrl_mode = true;
+
+    FOC_Driver_Init(pHandle);
+}
+
+// ------------------------------------------------------------------------------
+
+float foc_host_torque(const foc_host_plant_t *pPlant, double i_q){
+    return (float)(1.5 * (double)pPlant->pole_pairs * pPlant->flux * i_q);
+}
+
+// ------------------------------------------------------------------------------
+
+void foc_host_plant_phase_currents(const foc_host_plant_t *pPlant, double *i_a, double *i_b, double *i_c){
+    double c = cos(pPlant->theta);
+    double s = sin(pPlant->theta);
+    double i_alpha = (pPlant->i_d * c) - (pPlant->i_q * s);
+    double i_beta = (pPlant->i_d * s) + (pPlant->i_q * c);
+
+    *i_a = i_alpha;
+    *i_b = (-0.5 * i_alpha) + (0.8660254037844386 * i_beta);
+    *i_c = (-0.5 * i_alpha) - (0.8660254037844386 * i_beta);
+}
+
+// ------------------------------------------------------------------------------
+
+void foc_host_plant_reset_stats(foc_host_plant_t *pPlant){
+    pPlant->transitions = 0;
+    pPlant->switch_loss = 0.0;
+}
+
+// ------------------------------------------------------------------------------
+
+// Senkron eksen türevleri, (v_alpha, v_beta) substep boyunca sabit
+static void foc_host_plant_derivative(const foc_host_plant_t *pPlant, double i_d, double i_q, double theta,
+                                      double v_alpha, double v_beta, double *d_i_d, double *d_i_q){
+    double c = cos(theta);
+    double s = sin(theta);
+    double v_d = (v_alpha * c) + (v_beta * s);
+    double v_q = -(v_alpha * s) + (v_beta * c);
+    double w = pPlant->w;
+
+    *d_i_d = (v_d - (pPlant->R * i_d) + (w * pPlant->L_q * i_q)) / pPlant->L_d;
+    *d_i_q = (v_q - (pPlant->R * i_q) - (w * pPlant->L_d * i_d) - (w * pPlant->flux)) / pPlant->L_q;
+}
+
+// ------------------------------------------------------------------------------
+
+void foc_host_plant_period(foc_host_plant_t *pPlant, const float duty[3], double *pSample){
+    double T = 1.0 / pPlant->f_pwm;
+    double dt = T / (double)pPlant->substeps;
+    double U = pPlant->U_DC;
+    double current[3];
+    double d[3];
+
+    foc_host_plant_phase_currents(pPlant, &current[0], &current[1], &current[2]);
+    pPlant->v_alpha_mean = 0.0;
+    pPlant->v_beta_mean = 0.0;
+
+    // Geçiş sayımı: periyot ortasında bir darbe (0 < d < 1) iki geçiş, sınırda seviye değişimi bir geçiş
+    for(uint32_t x = 0; x < 3; x++){
+        d[x] = (duty[x] < 0.0f) ? 0.0 : ((duty[x] > 1.0f) ? 1.0 : (double)duty[x]);
+        uint8_t start = (d[x] >= 1.0) ? 1U : 0U;
+        uint32_t count = ((d[x] > 0.0) && (d[x] < 1.0)) ? 2U : 0U;
+        if(start != pPlant->last_level[x]) count++;
+        pPlant->last_level[x] = start;
+        pPlant->transitions += count;
+        pPlant->switch_loss += (double)count * U * fabs(current[x]);
+    }
+
+    for(uint32_t j = 0; j < pPlant->substeps; j++){
+        double t0 = (double)j * dt;
+        double t1 = t0 + dt;
+        double v[3];
+
+        if(pSample != 0) pSample[j] = current[0];
+
+        for(uint32_t x = 0; x < 3; x++){
+            bool positive = (current[x] >= 0.0); // Fazdan dışarı
+            double on = 0.0;
+            double off = 0.0;
+
+            if(d[x] >= 1.0){
+                off = T;
+            }
+            else if(d[x] > 0.0){
+                // Ölü zamanda akım yönüne göre diyot iletir: pozitif akımda yükselen kenar, negatifte düşen kenar gecikir
+                on = 0.5 * T * (1.0 - d[x]);
+                off = 0.5 * T * (1.0 + d[x]);
+                if(positive) on += pPlant->dead_time;
+                else off += pPlant->dead_time;
+            }
+
+            double overlap = fmin(off, t1) - fmax(on, t0);
+            double frac = (overlap > 0.0) ? (overlap / dt) : 0.0;
+
+            if(positive) v[x] = (frac * (U - pPlant->V_sw)) - ((1.0 - frac) * pPlant->V_d);
+            else v[x] = (frac * (U + pPlant->V_d)) + ((1.0 - frac) * pPlant->V_sw);
+        }
+
+        // Yıldız bağlı motor: ortak mod düşer
+        double v_alpha = ((2.0 * v[0]) - v[1] - v[2]) / 3.0;
+        double v_beta = (v[1] - v[2]) * 0.5773502691896258;
+        pPlant->v_alpha_mean += v_alpha / (double)pPlant->substeps;
+        pPlant->v_beta_mean += v_beta / (double)pPlant->substeps;
+
+        // Orta nokta (RK2) integrasyonu
+        double k1_d, k1_q, k2_d, k2_q;
+        foc_host_plant_derivative(pPlant, pPlant->i_d, pPlant->i_q, pPlant->theta, v_alpha, v_beta, &k1_d, &k1_q);
+        foc_host_plant_derivative(pPlant, pPlant->i_d + (0.5 * dt * k1_d), pPlant->i_q + (0.5 * dt * k1_q),
+                                  pPlant->theta + (0.5 * dt * pPlant->w), v_alpha, v_beta, &k2_d, &k2_q);
+        pPlant->i_d += dt * k2_d;
+        pPlant->i_q += dt * k2_q;
+        pPlant->theta += dt * pPlant->w;
+        if(pPlant->theta >= 2.0 * M_PI) pPlant->theta -= 2.0 * M_PI;
+        else if(pPlant->theta < 0.0) pPlant->theta += 2.0 * M_PI;
+        pPlant->time += dt;
+
+        foc_host_plant_phase_currents(pPlant, &current[0], &current[1], &current[2]);
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+void foc_host_plant_measure(const foc_host_plant_t *pPlant, FOC_Handle_t *pHandle){
+    double i_a, i_b, i_c;
+
+    foc_host_plant_phase_currents(pPlant, &i_a, &i_b, &i_c);
+    pHandle->input.i_a_meas = (float)i_a;
+    pHandle->input.i_b_meas = (float)i_b;
+    pHandle->input.Electrical_Angle_rad = (float)pPlant->theta;
+    pHandle->input.w_rad_s = (float)pPlant->w;
+    pHandle->input.U_bat = (float)pPlant->U_DC;
+}
+
+// ------------------------------------------------------------------------------
+
+void foc_host_run_period(foc_host_plant_t *pPlant, FOC_Handle_t *pHandle, float duty_applied[3], double *pSample){
+    foc_host_plant_measure(pPlant, pHandle);
+    FOC_Current_Controller(pHandle);
+
+    // Bu periyotta bir önceki ISR'ın yazdığı duty'ler uygulanır
+    foc_host_plant_period(pPlant, duty_applied, pSample);
+
+    duty_applied[0] = pHandle->output.duty_a;
+    duty_applied[1] = pHandle->output.duty_b;
+    duty_applied[2] = pHandle->output.duty_c;
+}
+
+// ------------------------------------------------------------------------------
+
+double foc_host_harmonic(const double *x, uint32_t n, uint32_t k){
+    double re = 0.0;
+    double im = 0.0;
+
+    for(uint32_t i = 0; i < n; i++){
+        double phase = 2.0 * M_PI * (double)k * (double)i / (double)n;
+        re += x[i] * cos(phase);
+        im -= x[i] * sin(phase);
+    }
+    return 2.0 * sqrt((re * re) + (im * im)) / (double)n;
+}
+
+// ------------------------------------------------------------------------------
+
+double foc_host_thd(const double *x, uint32_t n, uint32_t cycles, uint32_t max_order){
+    double fundamental = foc_host_harmonic(x, n, cycles);
+    double sum = 0.0;
+
+    for(uint32_t h = 2; h <= max_order; h++){
+        double a = foc_host_harmonic(x, n, h * cycles);
+        sum += a * a;
+    }
+    return (fundamental > 0.0) ? (sqrt(sum) / fundamental) : 0.0;
+}
+
+// ------------------------------------------------------------------------------
+
+bool foc_host_check(bool ok, const char *pFormat, ...){
+    va_list args;
+
+    printf("%s: ", ok ? "PASS" : "FAIL");
+    va_start(args, pFormat);
+    vprintf(pFormat, args);
+    va_end(args);
+    printf("\n");
+    return ok;
+}
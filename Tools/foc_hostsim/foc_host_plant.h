@@ -0,0 +1,71 @@
+#ifndef FOC_HOST_PLANT_H_
+#define FOC_HOST_PLANT_H_
+
+// Host simülasyonları için inverter + PMSM modeli ve ortak yardımcılar.
+// İnverter anahtarlama seviyesinde modellenir: merkez hizalı taşıyıcı, ölü zaman (akım yönüne göre kenar
+// kayması), anahtar / diyot iletim düşümleri. Motor senkron eksende, hız sabit (dinamometre) kabul edilir.
+// Akım örneği periyot başında (taşıyıcı vadisi, sıfır vektörün ortası) alınır; ISR'ın hesapladığı duty bir
+// sonraki periyotta uygulanır (TIM1 preload), firmware ile aynı 1.5 Ts ortalama gecikme.
+
+#include "FOC_Driver.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct{
+    // Motor
+    double R;
+    double L_d;
+    double L_q;
+    double flux;
+    uint32_t pole_pairs;
+
+    // İnverter
+    double U_DC;
+    double f_pwm;
+    double dead_time;
+    double V_sw;        // Anahtar iletim düşümü
+    double V_d;         // Diyot iletim düşümü
+    uint32_t substeps;  // Periyot başına integrasyon adımı
+
+    // Durum
+    double i_d;
+    double i_q;
+    double theta;       // Elektriksel açı
+    double w;           // Elektriksel hız (sabit)
+    double time;
+    double v_alpha_mean; // Son periyodun ortalama motor gerilimi (ölü zaman ve düşümler dahil)
+    double v_beta_mean;
+
+    // Anahtarlama istatistiği (foc_host_plant_reset_stats ile sıfırlanır)
+    uint64_t transitions;   // Toplam kol geçişi
+    double switch_loss;     // Sum(U_DC * |i|) geçiş başına (anahtarlama kaybıyla orantılı, E = k * U * I)
+    uint8_t last_level[3];  // Bir önceki periyodun son seviyesi (periyot sınırındaki geçişler için)
+} foc_host_plant_t;
+
+// Varsayılan test motoru / inverteri (15 kutup çifti, 24 V, 20 kHz) ve handle ayarı
+void foc_host_plant_init(foc_host_plant_t *pPlant);
+void foc_host_handle_init(FOC_Handle_t *pHandle, const foc_host_plant_t *pPlant, double bandwidth_hz);
+float foc_host_torque(const foc_host_plant_t *pPlant, double i_q); // i_q'yu isteyen T_mot_ref (MTPA kapalı)
+
+// Bir PWM periyodu: duty'ler [0, 1], merkez hizalı. pSample != 0 ise periyot içindeki faz A akımı
+// substeps örnekle yazılır (THD / dalgalanma analizi için).
+void foc_host_plant_period(foc_host_plant_t *pPlant, const float duty[3], double *pSample);
+
+// Periyot başı ölçümü: i_a, i_b, açı, hız ve U_bat handle girişlerine yazılır
+void foc_host_plant_measure(const foc_host_plant_t *pPlant, FOC_Handle_t *pHandle);
+
+void foc_host_plant_phase_currents(const foc_host_plant_t *pPlant, double *i_a, double *i_b, double *i_c);
+void foc_host_plant_reset_stats(foc_host_plant_t *pPlant);
+
+// Kapalı çevrim adım: ölç, FOC_Current_Controller, bir önceki duty ile periyodu simüle et (1 periyot gecikme)
+void foc_host_run_period(foc_host_plant_t *pPlant, FOC_Handle_t *pHandle, float duty_applied[3], double *pSample);
+
+// x[0..n-1] için k. harmoniğin genliği (n örnek tam periyot sayısını kapsamalı, k: pencerede çevrim sayısı)
+double foc_host_harmonic(const double *x, uint32_t n, uint32_t k);
+// Temel bileşen pencerede cycles çevrim; 2..max_order harmonikleri ile THD (oran)
+double foc_host_thd(const double *x, uint32_t n, uint32_t cycles, uint32_t max_order);
+
+// Geçti / kaldı raporu: ok ise "PASS", değilse "FAIL" satırı yazar, ok döner
+bool foc_host_check(bool ok, const char *pFormat, ...);
+
+#endif /* FOC_HOST_PLANT_H_ */
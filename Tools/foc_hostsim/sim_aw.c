@@ -0,0 +1,256 @@
+// Anti-windup ve gerilim vektörü önceliği basamak testleri (FOC_Direct_Current_Control_d/q, FOC_Voltage_Vector_Limit)
+// İnverter ideal (ölü zaman ve düşüm yok), her öncelik (d, q, orantılı) integral kırpma ve back-calculation ile.
+// 1. Kalıcı doygunluk: 2400 rad/s (back-EMF 12 V, lineer zarf 13.9 V), i_q 5 A -> 20 A (ulaşılamaz, 5 ms) -> 5 A.
+//    Doygunluğun son 2 ms'sindeki ortalama i_q / i_d, çıkışta 5 A ± %5 bandına girip kalma süresi (toparlanma)
+//    ve ilk 0.25 ms sonrasındaki en büyük sapma raporlanır.
+//    Geçti: back-calculation her öncelikte toparlanmayı kırpmanın en az yarısına indirir ve 1 ms içinde
+//    toparlanır, sapma < %25 (ayrık PI + decoupling bu w * Ts'de doygunluk olmadan da ~%20 aşım yapar,
+//    bkz. sim_cv); q önceliği doygunlukta ters yönde i_q'ya kilitlenmez.
+// 2. Akı zayıflatma: 2400 rad/s, sabit i_d = -10 A, i_q referansı 25 A (ulaşılamaz), back-calculation.
+//    Geçti: d önceliği i_d'yi referansın %5'i içinde tutar ve üç öncelik içinde en fazla i_q'yu üretir.
+// 3. Geçici doygunluk: 1500 rad/s, bant genişliği 2000 rad/s, 0 -> 15 A basamak (kalıcı durumda ulaşılabilir).
+//    Geçti: back-calculation her öncelikte aşımı kırpmaya göre azaltır, referans 1 ms içinde %2'ye oturur.
+
+#include "foc_host_plant.h"
+#include <math.h>
+#include <stdio.h>
+
+#define SIM_LOW_A   5.0
+#define SIM_HIGH_A  20.0
+#define SIM_PRE_MS  2U
+#define SIM_SAT_MS  5U
+#define SIM_POST_MS 15U     // Kırpmada integralin boşalması ~5 ms sürer
+
+#define SIM_FW_ID_A 10.0
+#define SIM_FW_IQ_A 25.0
+
+#define SIM_STEP_A  15.0
+
+typedef struct{
+    const char *name;
+    FOC_Voltage_Priority_t priority;
+} sim_priority_t;
+
+static const sim_priority_t sim_priorities[] = {
+    { "d",        FOC_VLIM_D_PRIORITY },
+    { "q",        FOC_VLIM_Q_PRIORITY },
+    { "orantili", FOC_VLIM_PROPORTIONAL },
+};
+#define SIM_PRIORITY_COUNT (sizeof(sim_priorities) / sizeof(sim_priorities[0]))
+
+typedef struct{
+    double i_q_sat;     // Doygunlukta ortalama i_q
+    double i_d_sat;     // Doygunlukta ortalama i_d
+    double recovery_ms; // Bandına kalıcı giriş süresi (-1: girmedi)
+    double deviation;   // Çıkışta 5 A'dan en büyük sapma, orana
+} sim_aw_t;
+
+// ------------------------------------------------------------------------------
+
+static void sim_setup(foc_host_plant_t *pPlant, FOC_Handle_t *pHandle, double w, double bw,
+                      FOC_Voltage_Priority_t priority, bool back_calc){
+    foc_host_plant_init(pPlant);
+    pPlant->w = w;
+    pPlant->dead_time = 0.0; // İdeal inverter (ölü zaman için bkz. sim_dtc)
+    pPlant->V_sw = 0.0;
+    pPlant->V_d = 0.0;
+    foc_host_handle_init(pHandle, pPlant, bw);
+    pHandle->config.voltage_priority = priority;
+    pHandle->config.back_calc_aw = back_calc;
+    pHandle->config.max_speed_rad_s = 5000.0f;
+    pHandle->state.i_q_limit = pHandle->config.I_s_max;
+}
+
+// Plant verilen akımdayken integralleri R * i'ye kurar ve ilk duty'yi hesaplar
+// (0.5 / 0.5 / 0.5 ile başlamak yüksek hızda akımı bir periyotta çökertir ve ölçümü karıştırır)
+static void sim_start(foc_host_plant_t *pPlant, FOC_Handle_t *pHandle, double i_d, double i_q, float duty[3]){
+    pPlant->i_d = i_d;
+    pPlant->i_q = i_q;
+    pHandle->state.i_d_memory = (float)(pPlant->R * i_d);
+    pHandle->state.i_q_memory = (float)(pPlant->R * i_q);
+    pHandle->input.T_mot_ref = foc_host_torque(pPlant, i_q);
+    foc_host_plant_measure(pPlant, pHandle);
+    FOC_Current_Controller(pHandle);
+    duty[0] = pHandle->output.duty_a;
+    duty[1] = pHandle->output.duty_b;
+    duty[2] = pHandle->output.duty_c;
+}
+
+// ------------------------------------------------------------------------------
+
+static sim_aw_t sim_saturation(FOC_Voltage_Priority_t priority, bool back_calc){
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    float duty[3];
+    sim_aw_t r = {0};
+
+    sim_setup(&plant, &h, 2400.0, 1000.0, priority, back_calc);
+    sim_start(&plant, &h, 0.0, SIM_LOW_A, duty);
+
+    uint32_t per_ms = (uint32_t)(plant.f_pwm / 1000.0);
+    uint32_t sat_start = SIM_PRE_MS * per_ms;
+    uint32_t sat_end = sat_start + (SIM_SAT_MS * per_ms);
+    uint32_t total = sat_end + (SIM_POST_MS * per_ms);
+    uint32_t avg_start = sat_end - (2U * per_ms);
+    uint32_t last_out = sat_end;  // Banddan son çıkılan periyot
+    double deviation = 0.0;
+
+    for(uint32_t k = 0; k < total; k++){
+        double i_q_ref = (k >= sat_start && k < sat_end) ? SIM_HIGH_A : SIM_LOW_A;
+        h.input.T_mot_ref = foc_host_torque(&plant, i_q_ref);
+        foc_host_run_period(&plant, &h, duty, 0);
+
+        if(k >= avg_start && k < sat_end){
+            r.i_q_sat += plant.i_q;
+            r.i_d_sat += plant.i_d;
+        }
+        if(k >= sat_end){
+            double e = fabs(plant.i_q - SIM_LOW_A);
+            if(e > 0.05 * SIM_LOW_A) last_out = k + 1U;
+            if(k > sat_end + per_ms / 4U && e > deviation) deviation = e; // İlk iniş hariç
+        }
+    }
+
+    r.i_q_sat /= (double)(sat_end - avg_start);
+    r.i_d_sat /= (double)(sat_end - avg_start);
+    r.recovery_ms = (last_out >= total) ? -1.0 : ((double)(last_out - sat_end) / (double)per_ms);
+    r.deviation = deviation / SIM_LOW_A;
+    return r;
+}
+
+// ------------------------------------------------------------------------------
+
+// Akı zayıflatma bölgesinde kalıcı doygunluk. Dönen değer son 2 ms ortalama i_q, *pI_d ortalama i_d
+static double sim_flux_weakening(FOC_Voltage_Priority_t priority, double *pI_d){
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    float duty[3];
+    double i_q_sum = 0.0, i_d_sum = 0.0;
+
+    sim_setup(&plant, &h, 2400.0, 1000.0, priority, true);
+    // Sabit d akımı: fw_counter her periyot 1'e kurulur, fw_i_d verilen değerde kalır (bkz. sim_dpwm)
+    h.config.flux_weakening = true;
+    h.state.fw_i_d = (float)-SIM_FW_ID_A;
+    h.state.fw_counter = 1;
+    sim_start(&plant, &h, -SIM_FW_ID_A, SIM_LOW_A, duty);
+
+    uint32_t per_ms = (uint32_t)(plant.f_pwm / 1000.0);
+    uint32_t total = 10U * per_ms;
+    for(uint32_t k = 0; k < total; k++){
+        h.state.fw_counter = 1;
+        h.input.T_mot_ref = foc_host_torque(&plant, SIM_FW_IQ_A);
+        foc_host_run_period(&plant, &h, duty, 0);
+
+        if(k >= total - (2U * per_ms)){
+            i_q_sum += plant.i_q;
+            i_d_sum += plant.i_d;
+        }
+    }
+
+    *pI_d = i_d_sum / (2.0 * per_ms);
+    return i_q_sum / (2.0 * per_ms);
+}
+
+// ------------------------------------------------------------------------------
+
+// Geçici doygunluk. Dönen değer aşım (orana), *pSettle_ms referansın %2'sine kalıcı giriş süresi
+static double sim_transient(FOC_Voltage_Priority_t priority, bool back_calc, double *pSettle_ms){
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    float duty[3] = { 0.5f, 0.5f, 0.5f };
+    double i_q_max = 0.0;
+
+    sim_setup(&plant, &h, 1500.0, 2000.0, priority, back_calc);
+
+    uint32_t per_ms = (uint32_t)(plant.f_pwm / 1000.0);
+    uint32_t pre = 5U * per_ms;
+    uint32_t total = pre + (5U * per_ms);
+    uint32_t last_out = pre;
+    for(uint32_t k = 0; k < total; k++){
+        h.input.T_mot_ref = (k < pre) ? 0.0f : foc_host_torque(&plant, SIM_STEP_A);
+        foc_host_run_period(&plant, &h, duty, 0);
+
+        if(k < pre) continue;
+        if(plant.i_q > i_q_max) i_q_max = plant.i_q;
+        if(fabs(plant.i_q - SIM_STEP_A) > 0.02 * SIM_STEP_A) last_out = k + 1U;
+    }
+
+    *pSettle_ms = (last_out >= total) ? -1.0 : ((double)(last_out - pre) / (double)per_ms);
+    return (i_q_max - SIM_STEP_A) / SIM_STEP_A;
+}
+
+// ------------------------------------------------------------------------------
+
+static bool sim_saturation_suite(void){
+    bool ok = true;
+
+    printf("Kalici doygunluk: 2400 rad/s, i_q %.0f A -> %.0f A -> %.0f A\n", SIM_LOW_A, SIM_HIGH_A, SIM_LOW_A);
+    printf("  %-9s %6s %9s %9s %12s %9s\n", "oncelik", "aw", "i_q_sat", "i_d_sat", "toparlanma", "sapma_%");
+    for(uint32_t p = 0; p < SIM_PRIORITY_COUNT; p++){
+        sim_aw_t r[2];
+        for(uint32_t b = 0; b < 2U; b++){
+            r[b] = sim_saturation(sim_priorities[p].priority, b == 1U);
+            printf("  %-9s %6s %9.2f %9.2f %10.3fms %9.1f\n", sim_priorities[p].name, b ? "back" : "kirp", r[b].i_q_sat,
+                   r[b].i_d_sat, r[b].recovery_ms, 100.0 * r[b].deviation);
+        }
+
+        bool faster = (r[1].recovery_ms >= 0.0) &&
+                      ((r[0].recovery_ms < 0.0) || (r[1].recovery_ms <= 0.5 * r[0].recovery_ms));
+        ok &= foc_host_check(faster && r[1].recovery_ms <= 1.0 && r[1].deviation < 0.25,
+                             "%s onceligi toparlanma back-calc %.3f ms, kirpma %.3f ms, sapma %.1f %%",
+                             sim_priorities[p].name, r[1].recovery_ms, r[0].recovery_ms, 100.0 * r[1].deviation);
+        if(sim_priorities[p].priority == FOC_VLIM_Q_PRIORITY){
+            ok &= foc_host_check(r[0].i_q_sat > 0.0 && r[1].i_q_sat > 0.0, "q onceligi doygunlukta i_q %.2f / %.2f A (> 0)",
+                                 r[0].i_q_sat, r[1].i_q_sat);
+        }
+    }
+    return ok;
+}
+
+// ------------------------------------------------------------------------------
+
+static bool sim_flux_weakening_suite(void){
+    double i_q[SIM_PRIORITY_COUNT], i_d[SIM_PRIORITY_COUNT];
+    bool ok = true;
+
+    printf("Aki zayiflatma: 2400 rad/s, i_d = -%.0f A, i_q referansi %.0f A (back-calc)\n", SIM_FW_ID_A, SIM_FW_IQ_A);
+    printf("  %-9s %9s %9s\n", "oncelik", "i_q", "i_d");
+    for(uint32_t p = 0; p < SIM_PRIORITY_COUNT; p++){
+        i_q[p] = sim_flux_weakening(sim_priorities[p].priority, &i_d[p]);
+        printf("  %-9s %9.2f %9.2f\n", sim_priorities[p].name, i_q[p], i_d[p]);
+    }
+
+    ok &= foc_host_check(fabs(i_d[0] + SIM_FW_ID_A) < 0.05 * SIM_FW_ID_A, "d onceligi i_d %.2f A", i_d[0]);
+    ok &= foc_host_check(i_q[0] > i_q[1] && i_q[0] > i_q[2], "d onceligi i_q %.2f A > q %.2f A, orantili %.2f A",
+                         i_q[0], i_q[1], i_q[2]);
+    return ok;
+}
+
+// ------------------------------------------------------------------------------
+
+static bool sim_transient_suite(void){
+    bool ok = true;
+
+    printf("Gecici doygunluk: 1500 rad/s, 0 -> %.0f A\n", SIM_STEP_A);
+    printf("  %-9s %9s %9s %10s\n", "oncelik", "asim_kirp", "asim_back", "oturma");
+    for(uint32_t p = 0; p < SIM_PRIORITY_COUNT; p++){
+        double settle_clamp, settle_back;
+        double os_clamp = sim_transient(sim_priorities[p].priority, false, &settle_clamp);
+        double os_back = sim_transient(sim_priorities[p].priority, true, &settle_back);
+
+        printf("  %-9s %8.1f%% %8.1f%% %8.3fms\n", sim_priorities[p].name, 100.0 * os_clamp, 100.0 * os_back, settle_back);
+        ok &= foc_host_check(os_back < os_clamp && settle_back >= 0.0 && settle_back <= 1.0,
+                             "%s onceligi asim %.1f %% -> %.1f %%, oturma %.3f ms", sim_priorities[p].name,
+                             100.0 * os_clamp, 100.0 * os_back, settle_back);
+    }
+    return ok;
+}
+
+// ------------------------------------------------------------------------------
+
+int main(void){
+    bool ok = sim_saturation_suite();
+    ok &= sim_flux_weakening_suite();
+    ok &= sim_transient_suite();
+    return ok ? 0 : 1;
+}
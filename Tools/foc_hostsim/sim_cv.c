@@ -0,0 +1,101 @@
+// Complex-vector akım regülatörü simülasyonu (FOC_Complex_Vector_Current_Control)
+// Yüksek elektriksel hızda (w * Ts 0.05 ... 0.45) i_q basamak cevabı, ayrık d/q PI + decoupling (FOC_REG_PI)
+// ile karşılaştırılır. Motor: akı 2 mWb (48 V barada 9000 rad/s'de back-EMF 18 V), diğerleri varsayılan;
+// inverter ideal (ölü zaman ve düşüm yok).
+// Her hızda 0 -> 5 A basamak; yükselme süresi (%10-%90), aşım, d ekseni çapraz bağlaşım tepesi ve
+// son 2 ms'deki ortalama hata raporlanır.
+// Geçti: complex-vector her hızda kararlı (hata < %2), aşım < %10 ve d ekseni tepesi < basamağın %25'i;
+// w * Ts >= 0.3'te d ekseni tepesi PI'dan küçük.
+
+#include "foc_host_plant.h"
+#include <math.h>
+#include <stdio.h>
+
+#define SIM_STEP_A     5.0
+#define SIM_PRE_MS     5U      // Basamaktan önce 0 A'da oturma
+#define SIM_POST_MS    10U
+
+typedef struct{
+    double rise_ms;
+    double overshoot;   // Basamağa oranla
+    double i_d_peak;    // Basamağa oranla
+    double error;       // Son 2 ms ortalama |i_q - ref| / basamak
+} sim_step_t;
+
+// ------------------------------------------------------------------------------
+
+static sim_step_t sim_step(FOC_Current_Regulator_t regulator, double w){
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    float duty[3] = { 0.5f, 0.5f, 0.5f };
+    sim_step_t r = {0};
+
+    foc_host_plant_init(&plant);
+    plant.flux = 0.002;
+    plant.U_DC = 48.0;
+    plant.w = w;
+    plant.dead_time = 0.0; // İdeal inverter: ölçüm regülatör dinamiğini gösterir (ölü zaman için bkz. sim_dtc)
+    plant.V_sw = 0.0;
+    plant.V_d = 0.0;
+    foc_host_handle_init(&h, &plant, 1000.0);
+    h.config.current_regulator = regulator;
+    h.config.max_speed_rad_s = 20000.0f;
+    h.state.i_q_limit = h.config.I_s_max;
+
+    uint32_t per_ms = (uint32_t)(plant.f_pwm / 1000.0);
+    uint32_t pre = SIM_PRE_MS * per_ms;
+    uint32_t total = pre + (SIM_POST_MS * per_ms);
+    uint32_t tail = 2U * per_ms;
+    double t10 = -1.0, t90 = -1.0;
+    double i_q_max = 0.0;
+    double error_sum = 0.0;
+
+    for(uint32_t k = 0; k < total; k++){
+        h.input.T_mot_ref = (k < pre) ? 0.0f : foc_host_torque(&plant, SIM_STEP_A);
+        foc_host_run_period(&plant, &h, duty, 0);
+
+        if(k < pre) continue;
+
+        double t_ms = (double)(k - pre) / (double)per_ms;
+        if(t10 < 0.0 && plant.i_q >= 0.1 * SIM_STEP_A) t10 = t_ms;
+        if(t90 < 0.0 && plant.i_q >= 0.9 * SIM_STEP_A) t90 = t_ms;
+        if(plant.i_q > i_q_max) i_q_max = plant.i_q;
+        if(fabs(plant.i_d) > r.i_d_peak) r.i_d_peak = fabs(plant.i_d);
+        if(k >= total - tail) error_sum += fabs(plant.i_q - SIM_STEP_A);
+    }
+
+    r.rise_ms = (t10 >= 0.0 && t90 >= 0.0) ? (t90 - t10) : -1.0;
+    r.overshoot = (i_q_max - SIM_STEP_A) / SIM_STEP_A;
+    r.i_d_peak /= SIM_STEP_A;
+    r.error = error_sum / tail / SIM_STEP_A;
+    return r;
+}
+
+// ------------------------------------------------------------------------------
+
+int main(void){
+    static const double speeds[] = { 1000.0, 3000.0, 6000.0, 9000.0 }; // w * Ts = 0.05, 0.15, 0.30, 0.45
+    bool ok = true;
+
+    printf("%8s %6s %6s %9s %9s %9s %9s\n", "w_rad_s", "wTs", "reg", "yuk_ms", "asim_%", "i_d_%", "hata_%");
+    for(uint32_t x = 0; x < sizeof(speeds) / sizeof(speeds[0]); x++){
+        double w = speeds[x];
+        double wTs = w / 20000.0;
+        sim_step_t pi = sim_step(FOC_REG_PI, w);
+        sim_step_t cv = sim_step(FOC_REG_COMPLEX_VECTOR, w);
+
+        printf("%8.0f %6.2f %6s %9.3f %9.1f %9.1f %9.2f\n", w, wTs, "PI", pi.rise_ms, 100.0 * pi.overshoot,
+               100.0 * pi.i_d_peak, 100.0 * pi.error);
+        printf("%8.0f %6.2f %6s %9.3f %9.1f %9.1f %9.2f\n", w, wTs, "CV", cv.rise_ms, 100.0 * cv.overshoot,
+               100.0 * cv.i_d_peak, 100.0 * cv.error);
+
+        ok &= foc_host_check(cv.error < 0.02 && cv.overshoot < 0.10 && cv.i_d_peak < 0.25,
+                             "wTs = %.2f CV hata %.2f %%, asim %.1f %%, i_d tepe %.1f %%", wTs, 100.0 * cv.error,
+                             100.0 * cv.overshoot, 100.0 * cv.i_d_peak);
+        if(wTs >= 0.3){
+            ok &= foc_host_check(cv.i_d_peak < pi.i_d_peak, "wTs = %.2f i_d tepe CV %.1f %% < PI %.1f %%", wTs,
+                                 100.0 * cv.i_d_peak, 100.0 * pi.i_d_peak);
+        }
+    }
+    return ok ? 0 : 1;
+}
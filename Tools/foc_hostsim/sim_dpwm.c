@@ -0,0 +1,171 @@
+// DPWM anahtarlama kaybı simülasyonu (FOC_SVPWM_Calculation, FOC_DPWM_Auto_Select)
+// 1. Kapalı çevrim PI akım kontrolü, üç çalışma noktası (farklı güç faktörü açıları), her modülasyon için:
+//    kol geçişi / periyot ve anahtarlama kaybı (Sum U_DC * |i| geçiş başına, SVPWM'e oranla).
+//    Geçti: her DPWM modu geçişleri üçte bir azaltır, DPWM_AUTO her noktada SVPWM kaybının %70'inin altında
+//    ve sabit DPWM0/1/2 modlarının en iyisinden en fazla %5 kötü, akım referansı her modda izlenir.
+// 2. Histerezis: akım - gerilim açısı ±15 derece sınırında ±1 derece gürültüyle tutulur.
+//    Geçti: DPWM_AUTO seçimi histerezisle en fazla 2 kez değişir (histerezissiz karar yüzlerce kez değişir).
+
+#include "foc_host_plant.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SETTLE_PERIODS  400U
+#define MEASURE_PERIODS 3000U
+
+typedef struct{
+    const char *name;
+    FOC_Modulation_t modulation;
+} sim_mode_t;
+
+static const sim_mode_t sim_modes[] = {
+    { "SVPWM",   FOC_MOD_SVPWM },
+    { "DPWMMIN", FOC_MOD_DPWMMIN },
+    { "DPWMMAX", FOC_MOD_DPWMMAX },
+    { "DPWM0",   FOC_MOD_DPWM0 },
+    { "DPWM1",   FOC_MOD_DPWM1 },
+    { "DPWM2",   FOC_MOD_DPWM2 },
+    { "DPWM3",   FOC_MOD_DPWM3 },
+    { "AUTO",    FOC_MOD_DPWM_AUTO },
+};
+#define SIM_MODE_COUNT (sizeof(sim_modes) / sizeof(sim_modes[0]))
+
+typedef struct{
+    double transitions; // Periyot başına
+    double loss;
+    double i_q_mean;
+    double phi_deg;     // Akım açısı - gerilim açısı
+} sim_result_t;
+
+// ------------------------------------------------------------------------------
+
+static sim_result_t sim_run(FOC_Modulation_t modulation, double w, double i_d, double i_q){
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    float duty[3] = { 0.5f, 0.5f, 0.5f };
+    sim_result_t result = {0};
+
+    foc_host_plant_init(&plant);
+    plant.w = w;
+    foc_host_handle_init(&h, &plant, 1000.0);
+    h.config.modulation = modulation;
+    h.input.T_mot_ref = foc_host_torque(&plant, i_q);
+
+    // Sabit d akımı: akı zayıflatma açılır ve fw_counter her periyot 1'e kurulur. FOC_Flux_Weakening
+    // hesaplamayı atlar, fw_i_d burada verilen değerde kalır ve i_d_ref = min(0, fw_i_d) olur.
+    h.config.flux_weakening = (i_d < 0.0);
+    h.state.fw_i_d = (float)i_d;
+    h.state.i_q_limit = h.config.I_s_max;
+
+    double phi_sum = 0.0;
+    for(uint32_t k = 0; k < SETTLE_PERIODS + MEASURE_PERIODS; k++){
+        h.state.fw_counter = 1; // Akı zayıflatma hesaplaması atlanır, fw_i_d sabit kalır
+        if(k == SETTLE_PERIODS) foc_host_plant_reset_stats(&plant);
+        foc_host_run_period(&plant, &h, duty, 0);
+
+        if(k >= SETTLE_PERIODS){
+            double phi = atan2(h.state.i_q_ref, h.state.i_d_ref) - atan2(h.state.u_q, h.state.u_d);
+            if(phi > M_PI) phi -= 2.0 * M_PI;
+            if(phi < -M_PI) phi += 2.0 * M_PI;
+            phi_sum += phi;
+            result.i_q_mean += plant.i_q;
+        }
+    }
+
+    result.transitions = (double)plant.transitions / MEASURE_PERIODS;
+    result.loss = plant.switch_loss / MEASURE_PERIODS;
+    result.i_q_mean /= MEASURE_PERIODS;
+    result.phi_deg = phi_sum / MEASURE_PERIODS * 180.0 / M_PI;
+    return result;
+}
+
+// ------------------------------------------------------------------------------
+
+static bool sim_losses(void){
+    static const struct{ double w; double i_d; double i_q; } points[] = {
+        { 2000.0,   0.0,  10.0 }, // Akım gerilimden biraz geride
+        { 2000.0, -12.0,   6.0 }, // Akım ileride (akı zayıflatma benzeri)
+        { 2000.0,   0.0, -10.0 }, // Rejeneratif
+    };
+    bool ok = true;
+
+    for(uint32_t p = 0; p < sizeof(points) / sizeof(points[0]); p++){
+        sim_result_t r[SIM_MODE_COUNT];
+
+        printf("w = %.0f rad/s, i_d = %.1f A, i_q = %.1f A\n", points[p].w, points[p].i_d, points[p].i_q);
+        printf("  %-8s %10s %10s %10s %10s\n", "mod", "phi_deg", "gecis/Ts", "kayip", "i_q_ort");
+        for(uint32_t m = 0; m < SIM_MODE_COUNT; m++){
+            r[m] = sim_run(sim_modes[m].modulation, points[p].w, points[p].i_d, points[p].i_q);
+            printf("  %-8s %10.1f %10.2f %10.3f %10.2f\n", sim_modes[m].name, r[m].phi_deg, r[m].transitions,
+                   r[m].loss / r[0].loss, r[m].i_q_mean);
+        }
+
+        double best_fixed = fmin(r[3].loss, fmin(r[4].loss, r[5].loss));
+        double auto_loss = r[SIM_MODE_COUNT - 1].loss;
+        for(uint32_t m = 1; m < SIM_MODE_COUNT; m++){
+            ok &= foc_host_check(r[m].transitions <= 0.70 * r[0].transitions, "%s gecis orani %.2f (<= 0.70)",
+                                 sim_modes[m].name, r[m].transitions / r[0].transitions);
+        }
+        for(uint32_t m = 0; m < SIM_MODE_COUNT; m++){
+            ok &= foc_host_check(fabs(r[m].i_q_mean - points[p].i_q) < 0.05 * fabs(points[p].i_q), "%s i_q izleme %.2f A",
+                                 sim_modes[m].name, r[m].i_q_mean);
+        }
+        ok &= foc_host_check(auto_loss <= 0.70 * r[0].loss, "AUTO kayip / SVPWM %.3f (<= 0.70)", auto_loss / r[0].loss);
+        ok &= foc_host_check(auto_loss <= 1.05 * best_fixed, "AUTO kayip / en iyi DPWM0-2 %.3f (<= 1.05)", auto_loss / best_fixed);
+    }
+    return ok;
+}
+
+// ------------------------------------------------------------------------------
+
+// Akım açısı, gerilim açısına göre (15 + offset_deg) derece ± 1 derece gürültü
+static bool sim_hysteresis(double boundary_deg){
+    FOC_Handle_t h;
+    foc_host_plant_t plant;
+    uint32_t changes = 0;
+    uint32_t naive_changes = 0;
+    FOC_Modulation_t previous;
+    int naive_previous = -1;
+
+    foc_host_plant_init(&plant);
+    foc_host_handle_init(&h, &plant, 1000.0);
+    h.config.modulation = FOC_MOD_DPWM_AUTO;
+    h.input.U_bat = (float)plant.U_DC;
+
+    srand(1);
+    double u = 0.8 * plant.U_DC * FOC_OVM_M_LINEAR;
+    for(uint32_t k = 0; k < 10000U; k++){
+        double theta = 2.0 * M_PI * (double)k / 400.0;
+        double noise = ((double)rand() / RAND_MAX - 0.5) * 2.0 * M_PI / 180.0;
+        double phi = (boundary_deg * M_PI / 180.0) + noise;
+
+        h.state.u_d = 0.0f;
+        h.state.u_q = (float)u;
+        h.state.i_d_ref = (float)(-10.0 * sin(phi));
+        h.state.i_q_ref = (float)(10.0 * cos(phi));
+        h.state.u_x = (float)(-u * sin(theta));
+        h.state.u_y = (float)(u * cos(theta));
+
+        previous = h.state.dpwm_auto;
+        FOC_SVPWM_Calculation(&h);
+        if(k > 0 && h.state.dpwm_auto != previous) changes++;
+
+        int naive = (phi > 15.0 * M_PI / 180.0) ? 2 : ((phi < -15.0 * M_PI / 180.0) ? 0 : 1);
+        if(naive_previous >= 0 && naive != naive_previous) naive_changes++;
+        naive_previous = naive;
+    }
+
+    printf("sinir %+.0f derece: histerezisli %u, histerezissiz %u secim degisimi / 10000 periyot\n",
+           boundary_deg, changes, naive_changes);
+    return foc_host_check(changes <= 2U && naive_changes > 100U, "DPWM_AUTO histerezis (%+.0f derece)", boundary_deg);
+}
+
+// ------------------------------------------------------------------------------
+
+int main(void){
+    bool ok = sim_losses();
+    ok &= sim_hysteresis(15.0);
+    ok &= sim_hysteresis(-15.0);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+// Ölü zaman kompanzasyonu THD simülasyonu (config.dead_time_comp)
+// Düşük hızda kapalı çevrim PI akım kontrolü; ölü zaman ve iletim düşümleri inverter modelinde.
+// Faz A akımı periyot içinde substeps örnekle kaydedilir, tam elektriksel turlar üzerinden 2..40.
+// harmoniklerle THD hesaplanır. Kompanzasyon kapalı / açık, üç çalışma noktası (akım, hız).
+// Geçti: her noktada kompanzasyon THD'yi en az yarıya indirir ve temel bileşen referansın %2'si içinde.
+
+#include "foc_host_plant.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIM_CYCLES       2U     // Ölçülen elektriksel tur
+#define SIM_SETTLE_CYCLE 1U     // Oturma için atlanan tur
+#define SIM_MAX_ORDER    40U
+
+// ------------------------------------------------------------------------------
+
+// Dönen değer THD (oran), *pFundamental faz akımının temel bileşen genliği
+static double sim_thd(double w, double i_q, bool dtc, double *pFundamental){
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    float duty[3] = { 0.5f, 0.5f, 0.5f };
+
+    foc_host_plant_init(&plant);
+    plant.w = w;
+    foc_host_handle_init(&h, &plant, 1000.0);
+    h.config.dead_time_comp = dtc;
+    h.input.T_mot_ref = foc_host_torque(&plant, i_q);
+    h.state.i_q_limit = h.config.I_s_max;
+
+    // Tam tur sayısı periyot cinsinden tam sayı olmayabilir, en yakın periyoda yuvarlanır
+    uint32_t periods_per_cycle = (uint32_t)lround((2.0 * M_PI / w) * plant.f_pwm);
+    uint32_t periods = SIM_CYCLES * periods_per_cycle;
+    uint32_t n = periods * plant.substeps;
+    double *pSamples = malloc(sizeof(double) * n);
+    if(pSamples == 0) return -1.0;
+
+    for(uint32_t k = 0; k < SIM_SETTLE_CYCLE * periods_per_cycle; k++){
+        h.state.fw_counter = 1;
+        foc_host_run_period(&plant, &h, duty, 0);
+    }
+    for(uint32_t k = 0; k < periods; k++){
+        h.state.fw_counter = 1;
+        foc_host_run_period(&plant, &h, duty, &pSamples[k * plant.substeps]);
+    }
+
+    double thd = foc_host_thd(pSamples, n, SIM_CYCLES, SIM_MAX_ORDER);
+    *pFundamental = foc_host_harmonic(pSamples, n, SIM_CYCLES);
+    free(pSamples);
+    return thd;
+}
+
+// ------------------------------------------------------------------------------
+
+int main(void){
+    static const struct{ double w; double i_q; } points[] = {
+        { 125.66371, 2.0 },  // 20 Hz elektriksel, 15 kutup çiftinde 80 rpm
+        { 125.66371, 5.0 },
+        { 314.15927, 2.0 },  // 50 Hz
+    };
+    bool ok = true;
+
+    printf("%10s %8s %10s %10s %12s\n", "w_rad_s", "i_q", "THD_kapali", "THD_acik", "I1_acik");
+    for(uint32_t p = 0; p < sizeof(points) / sizeof(points[0]); p++){
+        double i1_off, i1_on;
+        double thd_off = sim_thd(points[p].w, points[p].i_q, false, &i1_off);
+        double thd_on = sim_thd(points[p].w, points[p].i_q, true, &i1_on);
+
+        printf("%10.1f %8.1f %9.2f%% %9.2f%% %12.3f\n", points[p].w, points[p].i_q, 100.0 * thd_off, 100.0 * thd_on, i1_on);
+        ok &= foc_host_check(thd_on > 0.0 && thd_on < 0.5 * thd_off, "w = %.0f rad/s, i_q = %.1f A: THD %.2f %% -> %.2f %%",
+                             points[p].w, points[p].i_q, 100.0 * thd_off, 100.0 * thd_on);
+        ok &= foc_host_check(fabs(i1_on - points[p].i_q) < 0.02 * points[p].i_q, "w = %.0f rad/s temel bilesen %.3f A",
+                             points[p].w, i1_on);
+    }
+    return ok ? 0 : 1;
+}
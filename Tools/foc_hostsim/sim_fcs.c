@@ -0,0 +1,174 @@
+// FCS-MPC ile PI + SVPWM karşılaştırması (FOC_FCS_MPC_Control, FOC_REG_PI)
+// Varsayılan inverter (ölü zaman ve düşümler dahil), PI tarafında ölü zaman kompanzasyonu açık.
+// Her durumda:
+//   Kararlı durum: 50 Hz elektriksel, i_q 5 A. Faz A akımının THD'si (2..40. harmonik), temel bileşen ve
+//   kol geçişi / ms (anahtarlama frekansı göstergesi; SVPWM periyot başına 6 geçiş yapar).
+//   Basamak: 0 -> 5 A, %90'a ulaşma süresi ve aşım.
+// FCS-MPC bir durumu bütün örnekleme periyodu boyunca uygular, akım periyot başına U_DC * Ts / L mertebesinde
+// adımlar. Varsayılan motorda (L 0.1 mH) 20 kHz'de bu ~7 A'dir ve 5 A referans için fazla kabadır.
+// Karşılaştırma bu yüzden üç şekilde yapılır:
+//   1. Aynı örnekleme hızı (20 kHz), varsayılan motor.
+//      Geçti: FCS-MPC 10 kat az anahtarlar, PI + SVPWM THD'si daha düşük.
+//   2. Yaklaşık aynı anahtarlama hızı (FCS-MPC 200 kHz örnekleme), varsayılan motor.
+//      Geçti: geçiş / ms PI'nın ±%25'i içinde, FCS-MPC temel bileşeni %2 içinde, THD PI'nın 1.5 katından
+//      düşük ve %90 süresi PI'nın yarısından kısa.
+//   3. Aynı örnekleme hızı (20 kHz), 10 kat endüktanslı motor (L 1 mH).
+//      Geçti: FCS-MPC temel bileşeni %2 içinde, THD < %5; anahtarlama ağırlığı geçişleri azaltır.
+// 200 kHz örnekleme sadece modelin davranışını gösterir, firmware'de ISR bütçesi (FOC_FCS_MPC_MAX_CYCLES +
+// Clarke / Park) bu hızda doğrulanmamıştır.
+
+#include "foc_host_plant.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define SIM_W           314.15927 // 50 Hz elektriksel
+#define SIM_I_Q         5.0
+#define SIM_CYCLES      2U
+#define SIM_MAX_ORDER   40U
+#define SIM_STEP_MS     5U
+
+typedef struct{
+    const char *name;
+    FOC_Current_Regulator_t regulator;
+    float switch_weight;
+    double L_scale;     // Varsayılan motor endüktansının katı
+    double f_s;         // Örnekleme / karar hızı (PI için PWM frekansı)
+} sim_case_t;
+
+enum{
+    SIM_PI = 0,
+    SIM_FCS_20K,
+    SIM_FCS_200K,
+    SIM_PI_1MH,
+    SIM_FCS_1MH,
+    SIM_FCS_1MH_W,
+    SIM_CASE_COUNT
+};
+
+static const sim_case_t sim_cases[SIM_CASE_COUNT] = {
+    [SIM_PI]        = { "PI+SVPWM",    FOC_REG_PI,      0.0f,  1.0,  20000.0 },
+    [SIM_FCS_20K]   = { "FCS",         FOC_REG_FCS_MPC, 0.0f,  1.0,  20000.0 },
+    [SIM_FCS_200K]  = { "FCS",         FOC_REG_FCS_MPC, 0.0f,  1.0,  200000.0 },
+    [SIM_PI_1MH]    = { "PI+SVPWM",    FOC_REG_PI,      0.0f,  10.0, 20000.0 },
+    [SIM_FCS_1MH]   = { "FCS",         FOC_REG_FCS_MPC, 0.0f,  10.0, 20000.0 },
+    [SIM_FCS_1MH_W] = { "FCS w=0.05",  FOC_REG_FCS_MPC, 0.05f, 10.0, 20000.0 },
+};
+
+typedef struct{
+    double thd;
+    double fundamental;
+    double transitions_ms; // Kol geçişi / ms
+    double t90_ms;         // Basamakta %90'a ulaşma süresi
+    double overshoot;
+} sim_fcs_t;
+
+// ------------------------------------------------------------------------------
+
+static void sim_setup(foc_host_plant_t *pPlant, FOC_Handle_t *pHandle, const sim_case_t *pCase){
+    foc_host_plant_init(pPlant);
+    pPlant->w = SIM_W;
+    pPlant->L_d *= pCase->L_scale;
+    pPlant->L_q *= pCase->L_scale;
+    pPlant->f_pwm = pCase->f_s;
+    foc_host_handle_init(pHandle, pPlant, 1000.0);
+    pHandle->config.current_regulator = pCase->regulator;
+    pHandle->config.fcs_switch_weight = pCase->switch_weight;
+    pHandle->config.dead_time_comp = (pCase->regulator == FOC_REG_PI); // FCS-MPC kompanzasyonu atlar
+    pHandle->state.i_q_limit = pHandle->config.I_s_max;
+}
+
+// ------------------------------------------------------------------------------
+
+static bool sim_steady(const sim_case_t *pCase, sim_fcs_t *pResult){
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    float duty[3] = { 0.5f, 0.5f, 0.5f };
+
+    sim_setup(&plant, &h, pCase);
+    h.input.T_mot_ref = foc_host_torque(&plant, SIM_I_Q);
+
+    uint32_t periods_per_cycle = (uint32_t)lround((2.0 * M_PI / SIM_W) * plant.f_pwm);
+    uint32_t periods = SIM_CYCLES * periods_per_cycle;
+    uint32_t n = periods * plant.substeps;
+    double *pSamples = malloc(sizeof(double) * n);
+    if(pSamples == 0) return false;
+
+    for(uint32_t k = 0; k < periods_per_cycle; k++){
+        foc_host_run_period(&plant, &h, duty, 0);
+    }
+    foc_host_plant_reset_stats(&plant);
+    for(uint32_t k = 0; k < periods; k++){
+        foc_host_run_period(&plant, &h, duty, &pSamples[k * plant.substeps]);
+    }
+
+    pResult->thd = foc_host_thd(pSamples, n, SIM_CYCLES, SIM_MAX_ORDER);
+    pResult->fundamental = foc_host_harmonic(pSamples, n, SIM_CYCLES);
+    pResult->transitions_ms = (double)plant.transitions / (double)periods * (plant.f_pwm / 1000.0);
+    free(pSamples);
+    return true;
+}
+
+// ------------------------------------------------------------------------------
+
+static void sim_step(const sim_case_t *pCase, sim_fcs_t *pResult){
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    float duty[3] = { 0.5f, 0.5f, 0.5f };
+    double i_q_max = 0.0;
+
+    sim_setup(&plant, &h, pCase);
+
+    uint32_t per_ms = (uint32_t)(plant.f_pwm / 1000.0);
+    uint32_t pre = per_ms;
+    uint32_t total = pre + (SIM_STEP_MS * per_ms);
+    pResult->t90_ms = -1.0;
+    for(uint32_t k = 0; k < total; k++){
+        h.input.T_mot_ref = (k < pre) ? 0.0f : foc_host_torque(&plant, SIM_I_Q);
+        foc_host_run_period(&plant, &h, duty, 0);
+
+        if(k < pre) continue;
+        if(pResult->t90_ms < 0.0 && plant.i_q >= 0.9 * SIM_I_Q) pResult->t90_ms = (double)(k + 1U - pre) / (double)per_ms;
+        if(plant.i_q > i_q_max) i_q_max = plant.i_q;
+    }
+    pResult->overshoot = (i_q_max - SIM_I_Q) / SIM_I_Q;
+}
+
+// ------------------------------------------------------------------------------
+
+int main(void){
+    sim_fcs_t r[SIM_CASE_COUNT];
+    bool ok = true;
+
+    printf("%-11s %6s %8s %8s %8s %10s %8s %8s\n", "regulator", "L_mH", "fs_kHz", "THD_%", "I1", "gecis/ms", "t90_ms", "asim_%");
+    for(uint32_t m = 0; m < SIM_CASE_COUNT; m++){
+        const sim_case_t *pCase = &sim_cases[m];
+        if(sim_steady(pCase, &r[m]) == false) return 1;
+        sim_step(pCase, &r[m]);
+        printf("%-11s %6.2f %8.0f %8.2f %8.3f %10.1f %8.3f %8.1f\n", pCase->name, 0.1 * pCase->L_scale, pCase->f_s / 1000.0,
+               100.0 * r[m].thd, r[m].fundamental, r[m].transitions_ms, r[m].t90_ms, 100.0 * r[m].overshoot);
+    }
+
+    // 1. Aynı örnekleme hızı
+    ok &= foc_host_check(r[SIM_FCS_20K].transitions_ms < 0.1 * r[SIM_PI].transitions_ms && r[SIM_PI].thd < r[SIM_FCS_20K].thd,
+                         "20 kHz: FCS gecis %.1f / ms, THD %.2f %%; PI gecis %.1f / ms, THD %.2f %%",
+                         r[SIM_FCS_20K].transitions_ms, 100.0 * r[SIM_FCS_20K].thd, r[SIM_PI].transitions_ms, 100.0 * r[SIM_PI].thd);
+
+    // 2. Yaklaşık aynı anahtarlama hızı
+    const sim_fcs_t *pFast = &r[SIM_FCS_200K];
+    ok &= foc_host_check(fabs(pFast->transitions_ms - r[SIM_PI].transitions_ms) < 0.25 * r[SIM_PI].transitions_ms,
+                         "200 kHz FCS gecis %.1f / ms ~ PI %.1f / ms", pFast->transitions_ms, r[SIM_PI].transitions_ms);
+    ok &= foc_host_check(fabs(pFast->fundamental - SIM_I_Q) < 0.02 * SIM_I_Q && pFast->thd < 1.5 * r[SIM_PI].thd,
+                         "200 kHz FCS temel bilesen %.3f A, THD %.2f %% (PI %.2f %%)", pFast->fundamental,
+                         100.0 * pFast->thd, 100.0 * r[SIM_PI].thd);
+    ok &= foc_host_check(pFast->t90_ms > 0.0 && pFast->t90_ms < 0.5 * r[SIM_PI].t90_ms, "200 kHz FCS t90 %.3f ms < PI %.3f ms / 2",
+                         pFast->t90_ms, r[SIM_PI].t90_ms);
+
+    // 3. Yüksek endüktanslı motor
+    ok &= foc_host_check(fabs(r[SIM_FCS_1MH].fundamental - SIM_I_Q) < 0.02 * SIM_I_Q && r[SIM_FCS_1MH].thd < 0.05,
+                         "L 1 mH FCS temel bilesen %.3f A, THD %.2f %%", r[SIM_FCS_1MH].fundamental, 100.0 * r[SIM_FCS_1MH].thd);
+    ok &= foc_host_check(r[SIM_FCS_1MH_W].transitions_ms < r[SIM_FCS_1MH].transitions_ms,
+                         "L 1 mH anahtarlama agirligi gecis %.1f -> %.1f / ms", r[SIM_FCS_1MH].transitions_ms,
+                         r[SIM_FCS_1MH_W].transitions_ms);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+// Aşırı modülasyon ve ölü zaman kompanzasyonu simülasyonu (FOC_SVPWM_Calculation)
+// 1. Temel bileşen doğruluğu: max_mod_index = 1.0, referans genliği m = |u| / U_DC 0.55 ... 0.635 taranır.
+//    Her genlikte bir elektriksel tur 720 açıda SVPWM çağrılır, duty'lerden ideal (kayıpsız) inverter
+//    gerilimi kurulur ve temel bileşeni referansla karşılaştırılır.
+//    Geçti: genlik hatası her noktada %0.2'nin altında (maksimum hata raporlanır).
+// 2. Ölü zaman kompanzasyonu: inverter modeli (ölü zaman, iletim düşümleri) akım referansa sabitlenmiş
+//    halde sürülür, gerçek ortalama gerilimin temel bileşeni ideal modülatörünkiyle karşılaştırılır.
+//    Lineer, Mod I ve Mod II noktalarında SVPWM ve DPWM1 için: kompanzasyon kapalı, eski yöntem (kırpılmış
+//    duty'lere sonradan eklenen düzeltme) ve FOC_SVPWM_Calculation içindeki kompanzasyon (kırpmadan önce).
+//    Geçti: lineer bölgede hata kompanzasyonsuz durumun dörtte birinden küçük. Aşırı modülasyonda vektör
+//    altıgen sınırında olduğundan kayıp gerilim dışarı itilerek geri kazanılamaz; orada kompanzasyon hatayı
+//    azaltmalı, eski yöntemden en fazla 0.5 puan kötü olmalı ve geçiş sayısını artırmamalı.
+//    DPWM'de kenetlenen faz kompanzasyonla raydan ayrılmaz.
+//    Modelde V_sw = V_d alınır: farklı düşümlerde faz hatası -sign(i) * (V_sw + V_d) / 2 + (d - 1/2) * (V_d - V_sw)
+//    olur, ikinci terim akım yönünden bağımsız bir kazanç hatasıdır (akım döngüsü karşılar) ve ölçümü karıştırır.
+
+#include "foc_host_plant.h"
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+
+#define SIM_ANGLES 720U
+
+typedef enum{
+    SIM_DTC_OFF = 0,
+    SIM_DTC_POST,   // Eski yöntem: SVPWM kırptıktan sonra duty'lere eklenir
+    SIM_DTC_ON      // config.dead_time_comp
+} sim_dtc_t;
+
+// ------------------------------------------------------------------------------
+
+static void sim_handle(FOC_Handle_t *pHandle, const foc_host_plant_t *pPlant, FOC_Modulation_t modulation, bool dtc){
+    foc_host_handle_init(pHandle, pPlant, 1000.0);
+    pHandle->config.max_mod_index = 1.0f;
+    pHandle->config.modulation = modulation;
+    pHandle->config.dead_time_comp = dtc;
+    pHandle->input.U_bat = (float)pPlant->U_DC;
+}
+
+// ------------------------------------------------------------------------------
+
+// Önceki firmware sürümündeki FOC_Dead_Time_Compensation: SVPWM'den sonra, kenetlenen faz hariç
+static void sim_dtc_post(const FOC_Handle_t *pHandle, float duty[3]){
+    const FOC_Driver_Config_t *pConfig = &pHandle->config;
+    float duty_error = (pConfig->dead_time * pConfig->pwm_frequency) +
+                       ((pConfig->V_switch_drop + pConfig->V_diode_drop) / (2.0f * pHandle->input.U_bat));
+    float i_alpha = (pHandle->state.i_d_ref * pHandle->state.cos_theta) - (pHandle->state.i_q_ref * pHandle->state.sin_theta);
+    float i_beta = (pHandle->state.i_d_ref * pHandle->state.sin_theta) + (pHandle->state.i_q_ref * pHandle->state.cos_theta);
+    float i_phase[3] = {
+        i_alpha,
+        (-0.5f * i_alpha) + (0.8660254f * i_beta),
+        (-0.5f * i_alpha) - (0.8660254f * i_beta)
+    };
+
+    for(uint8_t x = 0; x < 3U; x++){
+        if(x == pHandle->state.clamp_phase) continue;
+        float sign = fmaxf(-1.0f, fminf(1.0f, i_phase[x] / pConfig->dtc_current_band));
+        duty[x] = fmaxf(0.0f, fminf(1.0f, duty[x] + (duty_error * sign)));
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+// Akım açısı theta + pi/2 (i_q), gerilim açısı theta + pi/2 + phi. Modülatörün ideal (kayıpsız)
+// inverterdeki ve inverter modelindeki temel bileşeni (referans açısına göre, kompleks) yazılır,
+// periyot başına kol geçişi döner.
+static double sim_fundamental(FOC_Modulation_t modulation, sim_dtc_t dtc, double m, double i_q, double phi,
+                            double complex *pIdeal, double complex *pReal){
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    double complex ideal = 0.0;
+    double complex real = 0.0;
+
+    foc_host_plant_init(&plant);
+    plant.V_sw = 0.5 * (plant.V_sw + plant.V_d); // Eşit düşüm (bkz. dosya başı)
+    plant.V_d = plant.V_sw;
+    sim_handle(&h, &plant, modulation, dtc == SIM_DTC_ON);
+    double U = plant.U_DC;
+
+    for(uint32_t k = 0; k < SIM_ANGLES; k++){
+        double theta = 2.0 * M_PI * (double)k / SIM_ANGLES;
+        double angle = theta + (0.5 * M_PI) + phi;
+        float duty[3];
+
+        h.state.i_d_ref = 0.0f;
+        h.state.i_q_ref = (float)i_q;
+        h.state.cos_theta = (float)cos(theta);
+        h.state.sin_theta = (float)sin(theta);
+        h.state.u_x = (float)(m * U * cos(angle));
+        h.state.u_y = (float)(m * U * sin(angle));
+        FOC_SVPWM_Calculation(&h);
+
+        duty[0] = h.output.duty_a;
+        duty[1] = h.output.duty_b;
+        duty[2] = h.output.duty_c;
+
+        double complex e = cexp(-I * angle);
+        double v_alpha = U * ((2.0 * duty[0]) - duty[1] - duty[2]) / 3.0;
+        double v_beta = U * (duty[1] - duty[2]) * 0.5773502691896258;
+        ideal += (v_alpha + (I * v_beta)) * e;
+
+        if(dtc == SIM_DTC_POST) sim_dtc_post(&h, duty);
+
+        // Akım periyot boyunca referansta tutulur (hız sıfır), sadece inverter gerilim hatası ölçülür
+        plant.w = 0.0;
+        plant.theta = theta;
+        plant.i_d = 0.0;
+        plant.i_q = i_q;
+        foc_host_plant_period(&plant, duty, 0);
+        real += (plant.v_alpha_mean + (I * plant.v_beta_mean)) * e;
+    }
+
+    *pIdeal = ideal / SIM_ANGLES;
+    *pReal = real / SIM_ANGLES;
+    return (double)plant.transitions / SIM_ANGLES;
+}
+
+// ------------------------------------------------------------------------------
+
+static bool sim_accuracy(void){
+    double max_error = 0.0;
+    double max_error_m = 0.0;
+
+    printf("%8s %12s %10s\n", "m", "V1 / (m U)", "hata_%");
+    for(uint32_t n = 0; n <= 17U; n++){
+        double m = 0.55 + (0.005 * (double)n);
+        double complex ideal, real;
+
+        sim_fundamental(FOC_MOD_SVPWM, SIM_DTC_OFF, m, 0.0, 0.0, &ideal, &real);
+
+        double ratio = cabs(ideal) / (m * 24.0);
+        double error = fabs(ratio - 1.0);
+        printf("%8.3f %12.5f %10.3f\n", m, ratio, 100.0 * error);
+        if(error > max_error){
+            max_error = error;
+            max_error_m = m;
+        }
+    }
+
+    return foc_host_check(max_error < 0.002, "OVM temel bilesen hatasi en fazla %.3f %% (m = %.3f, < 0.2 %%)",
+                          100.0 * max_error, max_error_m);
+}
+
+// ------------------------------------------------------------------------------
+
+static bool sim_compensation(void){
+    static const struct{ const char *name; FOC_Modulation_t modulation; } modes[] = {
+        { "SVPWM", FOC_MOD_SVPWM },
+        { "DPWM1", FOC_MOD_DPWM1 },
+    };
+    static const double points[] = { 0.40, 0.59, 0.62 }; // Lineer, Mod I, Mod II
+    bool ok = true;
+
+    printf("%6s %6s %10s %10s %10s %8s %8s %8s\n", "mod", "m", "kapali", "eski", "yeni", "gecis_k", "gecis_e", "gecis_y");
+    for(uint32_t x = 0; x < sizeof(modes) / sizeof(modes[0]); x++){
+        for(uint32_t p = 0; p < sizeof(points) / sizeof(points[0]); p++){
+            double complex ideal, real[3], unused;
+            double error[3];
+            double transitions[3];
+            double m = points[p];
+
+            // Hedef her durumda kompanzasyonsuz modülatörün ideal temel bileşenidir
+            transitions[SIM_DTC_OFF] = sim_fundamental(modes[x].modulation, SIM_DTC_OFF, m, 10.0, 0.35, &ideal, &real[SIM_DTC_OFF]);
+            transitions[SIM_DTC_POST] = sim_fundamental(modes[x].modulation, SIM_DTC_POST, m, 10.0, 0.35, &unused, &real[SIM_DTC_POST]);
+            transitions[SIM_DTC_ON] = sim_fundamental(modes[x].modulation, SIM_DTC_ON, m, 10.0, 0.35, &unused, &real[SIM_DTC_ON]);
+            for(uint32_t d = 0; d < 3U; d++) error[d] = cabs(real[d] - ideal) / cabs(ideal);
+
+            printf("%6s %6.2f %9.2f%% %9.2f%% %9.2f%% %8.2f %8.2f %8.2f\n", modes[x].name, m, 100.0 * error[SIM_DTC_OFF],
+                   100.0 * error[SIM_DTC_POST], 100.0 * error[SIM_DTC_ON], transitions[SIM_DTC_OFF],
+                   transitions[SIM_DTC_POST], transitions[SIM_DTC_ON]);
+            if(m < FOC_OVM_M_LINEAR){
+                ok &= foc_host_check(error[SIM_DTC_ON] < 0.25 * error[SIM_DTC_OFF], "%s m = %.2f gerilim hatasi %.2f %% (kapali %.2f %%)",
+                                     modes[x].name, m, 100.0 * error[SIM_DTC_ON], 100.0 * error[SIM_DTC_OFF]);
+            }
+            else{
+                ok &= foc_host_check(error[SIM_DTC_ON] < error[SIM_DTC_OFF] && error[SIM_DTC_ON] < error[SIM_DTC_POST] + 0.005 &&
+                                     transitions[SIM_DTC_ON] <= transitions[SIM_DTC_OFF],
+                                     "%s m = %.2f gerilim hatasi %.2f %% (kapali %.2f %%, eski %.2f %%), gecis/Ts %.2f (kapali %.2f, eski %.2f)",
+                                     modes[x].name, m, 100.0 * error[SIM_DTC_ON], 100.0 * error[SIM_DTC_OFF],
+                                     100.0 * error[SIM_DTC_POST], transitions[SIM_DTC_ON], transitions[SIM_DTC_OFF],
+                                     transitions[SIM_DTC_POST]);
+            }
+        }
+    }
+
+    // DPWM1: kenetlenen faz kompanzasyonla raydan ayrılmamalı (her periyotta bir faz 0 veya 1)
+    foc_host_plant_t plant;
+    FOC_Handle_t h;
+    uint32_t unclamped = 0;
+
+    foc_host_plant_init(&plant);
+    sim_handle(&h, &plant, FOC_MOD_DPWM1, true);
+    for(uint32_t k = 0; k < SIM_ANGLES; k++){
+        double theta = 2.0 * M_PI * (double)k / SIM_ANGLES;
+        h.state.i_d_ref = 0.0f;
+        h.state.i_q_ref = 10.0f;
+        h.state.cos_theta = (float)cos(theta);
+        h.state.sin_theta = (float)sin(theta);
+        h.state.u_x = (float)(0.5 * plant.U_DC * cos(theta + 1.92));
+        h.state.u_y = (float)(0.5 * plant.U_DC * sin(theta + 1.92));
+        FOC_SVPWM_Calculation(&h);
+
+        float d[3] = { h.output.duty_a, h.output.duty_b, h.output.duty_c };
+        if(h.state.clamp_phase > 2U || (d[h.state.clamp_phase] != 0.0f && d[h.state.clamp_phase] != 1.0f)) unclamped++;
+    }
+    ok &= foc_host_check(unclamped == 0U, "DPWM1 kenetlenen faz kompanzasyonla rayda (%u / %u periyot disarida)",
+                         unclamped, SIM_ANGLES);
+    return ok;
+}
+
+// ------------------------------------------------------------------------------
+
+int main(void){
+    bool ok = sim_accuracy();
+    ok &= sim_compensation();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+// Çok node'lu SYNC faz kilidi simülasyonu (FOC_CAN_PLL_Update, FOC_CAN_PLL_Local_Tick)
+// Her node'un kendi FOC_CAN_PLL_t'si ve kendi saati vardır: TIM1 170 MHz * (1 + ppm), TIM3 timestamp bunun yarısı
+// (FOC_CAN_TS_PRESCALER 2), başlangıç fazı ve yerel tick sayacı rastgele (bir node'un sayacı 32 bit taşmadan hemen önce).
+// Akım ISR'ı tick'in ortasından 1.5 us sonra çalışır. FOC_CAN_Consume ile aynı sırada şunları yapar:
+//   - bekleyen SYNC'i işler. Faz TIM1 sayımı, SOF'tan geçen süre TIM3 farkı olarak tam sayıya yuvarlanır.
+//   - dönen ARR trim'i bir sonraki tick'ten itibaren geçerli olur (preload).
+//   - mandallanan setpoint'i apply_tick'in yerel karşılığında uygular.
+// Master ideal saatle bus tick sınırında SYNC gönderir. SOF buna göre 0 ... jitter kadar gecikir
+// (bus meşgul). Node'lar SOF'u 0 ... 100 ns yayılım gecikmesiyle görür. SYNC 8 byte BRS (~50 us) olduğundan
+// FDCAN ISR'ı SOF'tan ~50 us sonra çalışır, işleme ilk 1-2 tick içinde olur.
+// Her SYNC'in apply_tick'i master_tick + aralık / 2'dir.
+// Geçti (her durumda):
+//   - node'ların uyguladığı tick'in sınırları arasındaki fark (yayılma) jitter yokken en geç 10., jitter ile
+//     en geç 20. SYNC'ten itibaren < 1 us. Jitter ile node'lar yakalamadan farklı SYNC'lerde çıkabilir, aradaki
+//     integratör farkı integratörün yavaş kutbuyla söner.
+//   - tüm node'lar setpoint'i aynı bus tick'inde (apply_tick) uygular, geç işlenen SYNC yoktur,
+//   - jitter yokken her node'un faz hatası < 1 us ve kilitten sonraki ortalama tick uzunluğu trim'i kristal
+//     hatasının ±5 ppm'i içinde. ARR trim'i 1 sayım (~235 ppm) adımlı olduğundan P + I tick'ler arasında titreşir,
+//     integratörün kendisi değil uygulanan ortalama trim kontrol edilir.
+
+#include "foc_host_plant.h"
+#include "FOC_CAN_Sync.h"
+#include <math.h>
+#include <stdio.h>
+
+#define SIM_NODES        4U
+#define SIM_SYNCS        200U
+#define SIM_TIM1_HZ      170.0e6
+#define SIM_ARR          4250U    // 20 kHz merkez hizalı
+#define SIM_ISR_DELAY    255.0    // Tick ortasından sonra ISR (TIM1 sayımı, 1.5 us)
+#define SIM_READ_SKEW    60.0e-9  // TIM1 ve TIM3 okumaları arasındaki süre
+#define SIM_FRAME_S      50.5e-6  // SOF -> FDCAN ISR
+#define SIM_PROP_MAX_S   100.0e-9
+#define SIM_LOCK_SYNC    10U
+#define SIM_SPREAD_US    1.0
+#define SIM_PPM_TOL      5.0
+
+typedef struct{
+    const char *name;
+    bool double_update;
+    uint32_t interval;  // SYNC aralığı (tick)
+    double jitter_s;    // SOF gecikmesi üst sınırı
+    uint32_t lock_sync; // Yayılma bu SYNC'ten itibaren < SIM_SPREAD_US olmalı
+} sim_case_t;
+
+static const sim_case_t sim_cases[] = {
+    { "tek update",    false, 20U, 0.0,     10U },
+    { "tek update J",  false, 20U, 20.0e-6, 20U },
+    { "double update", true,  40U, 0.0,     10U },
+};
+
+static const double sim_ppm[SIM_NODES] = { 50.0, -30.0, 10.0, -80.0 };
+
+typedef struct{
+    double t_sof;
+    double t_ready;     // FDCAN ISR, Sync_Pending = true
+    uint32_t master_tick;
+    uint32_t apply_tick;
+} sim_sync_t;
+
+typedef struct{
+    double error_us[SIM_SYNCS];
+    double apply_t[SIM_SYNCS];     // Uygulanan tick'in başlangıç anı
+    uint32_t apply_bus[SIM_SYNCS]; // Uygulandığı tick'in bus numarası (yerel + tick_offset)
+    bool applied[SIM_SYNCS];
+    uint32_t late;
+    double ppm_trim;     // SIM_LOCK_SYNC'ten sonra uygulanan ortalama tick uzunluğu trim'i
+} sim_node_result_t;
+
+// ------------------------------------------------------------------------------
+
+static uint32_t sim_rng = 0x2545F491U;
+
+static double sim_rand(void){ // [0, 1)
+    sim_rng ^= sim_rng << 13;
+    sim_rng ^= sim_rng >> 17;
+    sim_rng ^= sim_rng << 5;
+    return (double)sim_rng / 4294967296.0;
+}
+
+// ------------------------------------------------------------------------------
+
+static uint32_t sim_tick_counts(const sim_case_t *pCase, uint32_t arr){
+    return pCase->double_update ? arr : (2U * arr);
+}
+
+// ------------------------------------------------------------------------------
+
+// Bir node'u baştan sona simüle eder. SYNC'ler node'dan bağımsız olduğu için node'lar sırayla çalıştırılabilir.
+static void sim_node(const sim_case_t *pCase, const sim_sync_t *pSyncs, double ppm, uint32_t tick0, sim_node_result_t *pResult){
+    FOC_CAN_PLL_t pll;
+    double f = SIM_TIM1_HZ * (1.0 + (ppm * 1.0e-6));
+    double prop = sim_rand() * SIM_PROP_MAX_S;
+    double ts0 = sim_rand() * 65536.0;                 // TIM3'ün başlangıç değeri
+    uint32_t arr = SIM_ARR;                            // Bu tick'te geçerli ARR
+    uint32_t period = SIM_ARR;                         // FOC_PWM_Period (trim hemen yazılır)
+    double t_b = -sim_rand() * (double)sim_tick_counts(pCase, arr) / f; // Başlangıç fazı rastgele
+    uint32_t tick = tick0;
+    uint32_t next = 0;                                 // İşlenecek SYNC
+    uint32_t armed_tick = 0;
+    int32_t armed = -1;                                // Bekleyen setpoint'in SYNC indeksi
+    double trim_sum = 0.0;
+    uint32_t trim_ticks = 0;
+    double t_end = pSyncs[SIM_SYNCS - 1U].t_ready + (double)pCase->interval * (double)sim_tick_counts(pCase, arr) / f;
+
+    FOC_CAN_PLL_Reset(&pll);
+    for(uint32_t s = 0; s < SIM_SYNCS; s++) pResult->applied[s] = false;
+    pResult->late = 0;
+
+    while(t_b < t_end){
+        float tick_len = (float)sim_tick_counts(pCase, period);
+        double t_isr = t_b + ((0.5 * tick_len) + SIM_ISR_DELAY) / f;
+
+        // FOC_CAN_Consume: tick, bu ISR'ın sonunda scheduler'ın vereceği numaradır (tick sınırı t_b)
+        if(next < SIM_SYNCS && pSyncs[next].t_ready <= t_isr){
+            const sim_sync_t *pSync = &pSyncs[next];
+            float now_phase = (float)floor((t_isr - t_b) * f);
+            uint16_t ts_rx = (uint16_t)(uint32_t)floor(((pSync->t_sof + prop) * 0.5 * f) + ts0);
+            uint16_t ts_now = (uint16_t)(uint32_t)floor(((t_isr + SIM_READ_SKEW) * 0.5 * f) + ts0);
+            float elapsed = (float)(uint16_t)(ts_now - ts_rx) * (float)FOC_CAN_TS_PRESCALER;
+            int32_t arr_trim;
+
+            if(FOC_CAN_PLL_Update(&pll, now_phase, elapsed, tick_len, period, tick, pSync->master_tick, &arr_trim) == true){
+                period = (uint32_t)((int32_t)SIM_ARR + arr_trim);
+            }
+            pResult->error_us[next] = (double)pll.error / (SIM_TIM1_HZ * 1.0e-6);
+
+            armed_tick = FOC_CAN_PLL_Local_Tick(&pll, pSync->apply_tick);
+            if((int32_t)(tick - armed_tick) > 0) pResult->late++;
+            armed = (int32_t)next;
+            next++;
+        }
+        if(armed >= 0 && (int32_t)(tick - armed_tick) >= 0){
+            pResult->apply_t[armed] = t_b;
+            pResult->apply_bus[armed] = tick + pll.tick_offset;
+            pResult->applied[armed] = true;
+            armed = -1;
+        }
+
+        if(next > SIM_LOCK_SYNC){
+            trim_sum += (double)sim_tick_counts(pCase, arr) / (double)sim_tick_counts(pCase, SIM_ARR) - 1.0;
+            trim_ticks++;
+        }
+        t_b += (double)sim_tick_counts(pCase, arr) / f;
+        arr = period; // ARR preload: yeni değer bir sonraki update olayında
+        tick++;
+    }
+    pResult->ppm_trim = 1.0e6 * trim_sum / (double)trim_ticks;
+}
+
+// ------------------------------------------------------------------------------
+
+static bool sim_run(const sim_case_t *pCase){
+    static sim_sync_t syncs[SIM_SYNCS];
+    static sim_node_result_t r[SIM_NODES];
+    static const uint32_t tick0[SIM_NODES] = { 0U, 123456U, 0xFFFFFF00U, 77U };
+    double T0 = (double)sim_tick_counts(pCase, SIM_ARR) / SIM_TIM1_HZ; // Master tick
+    uint32_t m0 = 1000U;
+    bool ok = true;
+
+    for(uint32_t s = 0; s < SIM_SYNCS; s++){
+        uint32_t m = m0 + (s * pCase->interval);
+        syncs[s].master_tick = m;
+        syncs[s].apply_tick = m + (pCase->interval / 2U);
+        syncs[s].t_sof = ((double)m * T0) + (sim_rand() * pCase->jitter_s);
+        syncs[s].t_ready = syncs[s].t_sof + SIM_FRAME_S;
+    }
+    for(uint32_t n = 0; n < SIM_NODES; n++){
+        sim_node(pCase, syncs, sim_ppm[n], tick0[n], &r[n]);
+    }
+
+    // Yayılma: node'ların aynı setpoint'i uyguladığı tick sınırları
+    double spread[SIM_SYNCS];
+    bool same_tick = true;
+    uint32_t late = 0;
+    for(uint32_t s = 0; s < SIM_SYNCS; s++){
+        double t_min = INFINITY, t_max = -INFINITY;
+        for(uint32_t n = 0; n < SIM_NODES; n++){
+            if(r[n].applied[s] == false || r[n].apply_bus[s] != syncs[s].apply_tick) same_tick = false;
+            if(r[n].apply_t[s] < t_min) t_min = r[n].apply_t[s];
+            if(r[n].apply_t[s] > t_max) t_max = r[n].apply_t[s];
+        }
+        spread[s] = (t_max - t_min) * 1.0e6;
+    }
+    for(uint32_t n = 0; n < SIM_NODES; n++) late += r[n].late;
+
+    uint32_t lock = SIM_SYNCS;
+    for(uint32_t s = SIM_SYNCS; s > 0U && spread[s - 1U] < SIM_SPREAD_US; s--) lock = s - 1U;
+    double spread_max = 0.0;
+    for(uint32_t s = lock; s < SIM_SYNCS; s++) if(spread[s] > spread_max) spread_max = spread[s];
+
+    printf("== %s, SYNC / %u tick, jitter %.0f us\n", pCase->name, pCase->interval, pCase->jitter_s * 1.0e6);
+    printf("%6s %12s", "SYNC", "yayilma_us");
+    for(uint32_t n = 0; n < SIM_NODES; n++) printf("   hata%u_us", n);
+    printf("\n");
+    for(uint32_t s = 0; s < SIM_SYNCS; s++){
+        if(s >= 12U && (s % 40U) != 0U && s != SIM_SYNCS - 1U) continue;
+        printf("%6u %12.3f", s, spread[s]);
+        for(uint32_t n = 0; n < SIM_NODES; n++) printf(" %10.3f", r[n].error_us[s]);
+        printf("\n");
+    }
+
+    ok &= foc_host_check(lock <= pCase->lock_sync, "%s: yayilma %u. SYNC'ten itibaren < %.1f us (en fazla %.3f us)", pCase->name,
+                         lock, SIM_SPREAD_US, spread_max);
+    ok &= foc_host_check(same_tick && late == 0U, "%s: tum node'lar apply_tick'te uyguluyor, gec SYNC %u", pCase->name, late);
+    if(pCase->jitter_s == 0.0){
+        double err_max = 0.0;
+        bool ppm_ok = true;
+        for(uint32_t n = 0; n < SIM_NODES; n++){
+            for(uint32_t s = SIM_LOCK_SYNC; s < SIM_SYNCS; s++) if(fabs(r[n].error_us[s]) > err_max) err_max = fabs(r[n].error_us[s]);
+            if(fabs(r[n].ppm_trim - sim_ppm[n]) > SIM_PPM_TOL) ppm_ok = false;
+        }
+        ok &= foc_host_check(err_max < SIM_SPREAD_US, "%s: %u. SYNC'ten sonra faz hatasi en fazla %.3f us", pCase->name,
+                             SIM_LOCK_SYNC, err_max);
+        ok &= foc_host_check(ppm_ok, "%s: ortalama trim %+.1f / %+.1f / %+.1f / %+.1f ppm (kristal %+.0f / %+.0f / %+.0f / %+.0f)",
+                             pCase->name, r[0].ppm_trim, r[1].ppm_trim, r[2].ppm_trim, r[3].ppm_trim,
+                             sim_ppm[0], sim_ppm[1], sim_ppm[2], sim_ppm[3]);
+    }
+    return ok;
+}
+
+// ------------------------------------------------------------------------------
+
+int main(void){
+    bool ok = true;
+
+    for(uint32_t c = 0; c < sizeof(sim_cases) / sizeof(sim_cases[0]); c++){
+        ok &= sim_run(&sim_cases[c]);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+#ifndef FOC_HOSTSIM_STM32G4XX_H_
+#define FOC_HOSTSIM_STM32G4XX_H_
+
+// Host derlemesi için stm32g4xx.h yerine geçer: Core/Src altındaki FOC modüllerinin kullandığı
+// register ve CMSIS tanımlarının en küçük alt kümesi. Donanım davranışı foc_host_mcu.c'de taklit edilir.
+// Sadece -Istub ile Core/Inc'ten önce aranacak şekilde kullanılır, hedef derlemeye girmez.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define __IO volatile
+#define __NVIC_PRIO_BITS 4U
+
+typedef enum{
+    PendSV_IRQn = -2,
+    SysTick_IRQn = -1,
+    FDCAN1_IT0_IRQn = 21,
+    FDCAN1_IT1_IRQn = 22,
+    TIM1_UP_TIM16_IRQn = 25,
+    USART2_IRQn = 38
+} IRQn_Type;
+
+extern uint32_t SystemCoreClock;
+
+// <<---------------------------------------------->>
+// <<------------------- CORDIC ------------------->>
+// <<---------------------------------------------->>
+
+// Cosine fonksiyonu, q1.31, NARGS = 1, NRES = 2 varsayılır (WDATA: açı / pi, RDATA: cos sonra sin).
+// RDATA okuması bir fonksiyon çağrısına bağlanır: ilk okuma WDATA'dan iki sonucu hesaplar ve cos'u,
+// ikinci okuma sin'i verir. Böylece FOC_G4_Cos_Sin_Calculate değiştirilmeden çalışır.
+typedef struct{
+    __IO uint32_t CSR;
+    __IO uint32_t WDATA;
+    __IO uint32_t RDATA_[2];
+} CORDIC_TypeDef;
+
+extern CORDIC_TypeDef foc_host_cordic;
+uint32_t foc_host_cordic_read(void);
+
+#define CORDIC (&foc_host_cordic)
+#define RDATA RDATA_[foc_host_cordic_read()]
+
+// <<---------------------------------------------->>
+// <<----------------- Çekirdek ------------------->>
+// <<---------------------------------------------->>
+
+// DWT->CYCCNT host'ta çevrim saymaz (sabit kalır), FOC_Bench ölçümleri host'ta anlamsızdır
+typedef struct{
+    __IO uint32_t CTRL;
+    __IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct{
+    __IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct{
+    __IO uint32_t ICSR;
+} SCB_Type;
+
+extern DWT_Type foc_host_dwt;
+extern CoreDebug_Type foc_host_core_debug;
+extern SCB_Type foc_host_scb;
+
+#define DWT (&foc_host_dwt)
+#define CoreDebug (&foc_host_core_debug)
+#define SCB (&foc_host_scb)
+
+#define DWT_CTRL_CYCCNTENA_Msk           (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk       (1UL << 24)
+#define SCB_ICSR_PENDSVSET_Msk           (1UL << 28)
+
+// BASEPRI / PRIMASK host'ta sadece değer olarak tutulur (tek iş parçacığı, kesme yok)
+extern uint32_t foc_host_basepri;
+extern uint32_t foc_host_primask;
+
+static inline void __disable_irq(void){ foc_host_primask = 1U; }
+static inline void __enable_irq(void){ foc_host_primask = 0U; }
+static inline uint32_t __get_PRIMASK(void){ return foc_host_primask; }
+static inline void __set_PRIMASK(uint32_t value){ foc_host_primask = value; }
+static inline uint32_t __get_BASEPRI(void){ return foc_host_basepri; }
+static inline void __set_BASEPRI(uint32_t value){ foc_host_basepri = value & 0xFFU; }
+static inline void __set_BASEPRI_MAX(uint32_t value){
+    value &= 0xFFU;
+    if((value != 0U) && ((foc_host_basepri == 0U) || (value < foc_host_basepri))) foc_host_basepri = value;
+}
+static inline uint32_t __get_IPSR(void){ return 0U; }
+
+static inline void __DMB(void){ __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __DSB(void){ __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+static inline void __ISB(void){ __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+// Tek iş parçacığında LDREX / STREX rezervasyonu her zaman başarılıdır
+static inline uint32_t __LDREXW(volatile uint32_t *addr){ return *addr; }
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *addr){ *addr = value; return 0U; }
+static inline void __CLREX(void){ }
+
+static inline uint32_t __USAT(int32_t value, uint32_t bits){
+    int32_t max = (int32_t)((1UL << bits) - 1UL);
+    return (uint32_t)((value < 0) ? 0 : ((value > max) ? max : value));
+}
+
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t priority){ (void)irq; (void)priority; }
+static inline void NVIC_EnableIRQ(IRQn_Type irq){ (void)irq; }
+static inline void NVIC_DisableIRQ(IRQn_Type irq){ (void)irq; }
+
+#endif /* FOC_HOSTSIM_STM32G4XX_H_ */
@@ -0,0 +1,17 @@
+#ifndef FOC_HOSTSIM_STM32G4XX_HAL_H_
+#define FOC_HOSTSIM_STM32G4XX_HAL_H_
+
+// Host derlemesi için stm32g4xx_hal.h yerine geçer (bkz. stub/stm32g4xx.h)
+
+#include "stm32g4xx.h"
+
+typedef enum{
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+uint32_t HAL_GetTick(void); // foc_host_mcu.c: foc_host_ms
+
+#endif /* FOC_HOSTSIM_STM32G4XX_HAL_H_ */
@@ -0,0 +1,8 @@
+#ifndef FOC_HOSTSIM_STM32G4XX_LL_CORDIC_H_
+#define FOC_HOSTSIM_STM32G4XX_LL_CORDIC_H_
+
+// Host derlemesi için boş: CORDIC register taklidi stub/stm32g4xx.h içindedir
+
+#include "stm32g4xx.h"
+
+#endif /* FOC_HOSTSIM_STM32G4XX_LL_CORDIC_H_ */
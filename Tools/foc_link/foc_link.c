@@ -0,0 +1,187 @@
+// Host tarafı FOC_UART çerçeve kodlayıcı / çözücü kütüphanesi (POSIX).
+// CRC-32 yazılımla (tablo) hesaplanır ve sürücüdeki CRC çevre birimi ayarıyla aynı sonucu verir (zlib crc32).
+
+#define _DEFAULT_SOURCE
+#include "foc_link.h"
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Özel Değişkenler ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+static uint32_t foc_link_crc_table[256];
+static int foc_link_crc_ready = 0;
+
+//  <<<------------------------------------------------------------------------------->>>
+//  <<<------ Fonksiyonlar ------>>>
+//  <<<------------------------------------------------------------------------------->>>
+
+static void foc_link_crc_init(void){
+    for(uint32_t i = 0; i < 256U; i++){
+        uint32_t c = i;
+        for(int k = 0; k < 8; k++) c = (c & 1U) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+        foc_link_crc_table[i] = c;
+    }
+    foc_link_crc_ready = 1;
+}
+
+// ------------------------------------------------------------------------------
+
+uint32_t foc_link_crc32(const uint8_t *data, size_t length){
+    if(!foc_link_crc_ready) foc_link_crc_init();
+    uint32_t crc = 0xFFFFFFFFU;
+    for(size_t i = 0; i < length; i++) crc = foc_link_crc_table[(crc ^ data[i]) & 0xFFU] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFU;
+}
+
+// ------------------------------------------------------------------------------
+
+size_t foc_link_encode(uint8_t type, uint8_t seq, const void *payload, size_t length, uint8_t *out, size_t out_size){
+    uint8_t raw[FOC_LINK_RAW_MAX];
+    if(length > FOC_LINK_MAX_PAYLOAD) return 0;
+
+    raw[0] = type;
+    raw[1] = seq;
+    if(length) memcpy(&raw[2], payload, length);
+    uint32_t crc = foc_link_crc32(raw, length + 2U);
+    for(int i = 0; i < 4; i++) raw[length + 2U + (size_t)i] = (uint8_t)(crc >> (8 * i));
+    size_t raw_length = length + 6U;
+
+    if(out_size < raw_length + (raw_length / 254U) + 2U) return 0;
+
+    size_t pos = 1;
+    size_t code_pos = 0;
+    uint8_t code = 1;
+    for(size_t i = 0; i < raw_length; i++){
+        if(raw[i] == 0U){
+            out[code_pos] = code;
+            code_pos = pos++;
+            code = 1;
+            continue;
+        }
+        out[pos++] = raw[i];
+        if(++code == 0xFFU){
+            out[code_pos] = code;
+            code_pos = pos++;
+            code = 1;
+        }
+    }
+    out[code_pos] = code;
+    out[pos++] = 0U;
+    return pos;
+}
+
+// ------------------------------------------------------------------------------
+
+void foc_link_decoder_init(foc_link_decoder_t *dec){
+    memset(dec, 0, sizeof(*dec));
+}
+
+// ------------------------------------------------------------------------------
+
+static int foc_link_frame_done(foc_link_decoder_t *dec, foc_link_frame_cb cb, void *ctx){
+    uint8_t *buf = dec->buffer;
+    size_t length = dec->length;
+    size_t read = 0;
+    size_t write = 0;
+
+    while(read < length){
+        uint8_t code = buf[read++];
+        if(code == 0U || read + code - 1U > length){
+            dec->frame_errors++;
+            return 0;
+        }
+        for(uint8_t i = 1; i < code; i++) buf[write++] = buf[read++];
+        if(code != 0xFFU && read < length) buf[write++] = 0U;
+    }
+    if(write < 6U){
+        dec->frame_errors++;
+        return 0;
+    }
+
+    size_t data_length = write - 4U;
+    uint32_t crc = (uint32_t)buf[data_length] | ((uint32_t)buf[data_length + 1U] << 8) |
+                   ((uint32_t)buf[data_length + 2U] << 16) | ((uint32_t)buf[data_length + 3U] << 24);
+    if(foc_link_crc32(buf, data_length) != crc){
+        dec->crc_errors++;
+        return 0;
+    }
+
+    if(dec->have_seq) dec->lost_frames += (uint8_t)(buf[1] - dec->next_seq);
+    dec->next_seq = (uint8_t)(buf[1] + 1U);
+    dec->have_seq = 1;
+    dec->frames++;
+    if(cb) cb(buf[0], buf[1], &buf[2], data_length - 2U, ctx);
+    return 1;
+}
+
+// ------------------------------------------------------------------------------
+
+size_t foc_link_feed(foc_link_decoder_t *dec, const uint8_t *data, size_t length, foc_link_frame_cb cb, void *ctx){
+    size_t found = 0;
+    dec->bytes += length;
+
+    for(size_t i = 0; i < length; i++){
+        uint8_t b = data[i];
+        if(b == 0U){
+            if(!dec->discard && dec->length != 0U) found += (size_t)foc_link_frame_done(dec, cb, ctx);
+            dec->length = 0;
+            dec->discard = 0;
+        }
+        else if(dec->length < sizeof(dec->buffer)){
+            dec->buffer[dec->length++] = b;
+        }
+        else if(!dec->discard){
+            dec->discard = 1;
+            dec->frame_errors++;
+        }
+    }
+    return found;
+}
+
+// ------------------------------------------------------------------------------
+
+static speed_t foc_link_speed(unsigned baud){
+    switch(baud){
+        case 115200U:  return B115200;
+        case 921600U:  return B921600;
+#ifdef B2000000
+        case 2000000U: return B2000000;
+#endif
+#ifdef B3000000
+        case 3000000U: return B3000000;
+#endif
+#ifdef B4000000
+        case 4000000U: return B4000000;
+#endif
+        default:       return 0;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+int foc_link_open(const char *path, unsigned baud){
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if(fd < 0) return -1;
+
+    struct termios tio;
+    if(tcgetattr(fd, &tio) == 0){
+        cfmakeraw(&tio);
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+        if(baud != 0U){
+            speed_t speed = foc_link_speed(baud);
+            if(speed == 0){
+                close(fd);
+                return -1;
+            }
+            cfsetispeed(&tio, speed);
+            cfsetospeed(&tio, speed);
+        }
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
@@ -0,0 +1,221 @@
+#ifndef FOC_LINK_H_
+#define FOC_LINK_H_
+
+// Host tarafı FOC_UART çerçeve kodlayıcı / çözücü kütüphanesi.
+// Çerçeve (COBS öncesi): [tip][sıra][veri][CRC-32 LE], COBS kodlanmış ve 0x00 ile biten.
+// Sabitler ve yapılar Core/Inc/FOC_UART.h ile aynı tutulmalıdır.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// <<---------------------------------------------->>
+// <<----------- Değişken tanımlamaları ----------->>
+// <<---------------------------------------------->>
+
+#define FOC_LINK_MAX_PAYLOAD   240U
+#define FOC_LINK_RAW_MAX       (2U + FOC_LINK_MAX_PAYLOAD + 4U)
+#define FOC_LINK_ENCODED_MAX   (FOC_LINK_RAW_MAX + (FOC_LINK_RAW_MAX / 254U) + 2U)
+
+#define FOC_LINK_TYPE_TELEMETRY 0x01U
+#define FOC_LINK_TYPE_COMMAND   0x02U
+#define FOC_LINK_TYPE_SETPOINT  0x03U
+#define FOC_LINK_TYPE_SCOPE     0x04U // FOC_Scope_Header_t (8 byte) + veri, istek / yanıt
+#define FOC_LINK_TYPE_STREAM    0x05U // Abonelik telemetrisi: 10 byte başlık + zigzag / varint farklar
+#define FOC_LINK_TYPE_SUBSCRIBE 0x06U // İstek: 4 byte başlık + sinyal girişleri, yanıt 4 byte
+#define FOC_LINK_TYPE_CATALOG   0x07U // İstek: 1 byte ilk indeks, yanıt 4 byte + 20 byte'lık girişler
+#define FOC_LINK_TYPE_PARAM     0x08U // 8 byte FOC_Param_Msg_t + veri, istek / yanıt
+#define FOC_LINK_TYPE_LOG       0x09U // Sürücü -> host: 5 byte başlık + metin (printf / LOG_x)
+
+#define FOC_LINK_CMD_ENABLE  0x01U
+#define FOC_LINK_CMD_DISABLE 0x02U
+
+#define FOC_LINK_MODE_DISABLE  0U
+#define FOC_LINK_MODE_TORQUE   1U
+#define FOC_LINK_MODE_SPEED    2U
+#define FOC_LINK_MODE_POSITION 3U
+
+typedef struct __attribute__((packed)){
+    uint32_t tick;
+    uint8_t status;
+    uint8_t reserved[3];
+    float i_d;
+    float i_q;
+    float i_d_ref;
+    float i_q_ref;
+    float u_d;
+    float u_q;
+    float w_rad_s;
+    float electrical_angle;
+    float U_bat;
+    float position_rad;
+} foc_link_telemetry_t;
+
+// FOC_CAN_Setpoint_t ile aynı 16 byte
+typedef struct __attribute__((packed)){
+    uint8_t mode;
+    uint8_t sequence;
+    uint16_t reserved;
+    float torque_ref;
+    float speed_ref;
+    float position_ref;
+} foc_link_setpoint_t;
+
+// Abonelik telemetrisi (FOC_Telemetry.h ile aynı)
+#define FOC_LINK_TELEM_NAME_SIZE  12U
+#define FOC_LINK_TELEM_TYPE_FLOAT 0U
+#define FOC_LINK_TELEM_TYPE_U8    1U
+#define FOC_LINK_TELEM_TYPE_BOOL  2U
+
+typedef struct __attribute__((packed)){
+    uint8_t count;
+    uint8_t runs_per_packet;
+    uint16_t reserved;
+} foc_link_subscribe_t;
+
+typedef struct __attribute__((packed)){
+    uint8_t signal;
+    uint8_t reserved;
+    uint16_t decimation;
+} foc_link_sub_entry_t;
+
+typedef struct __attribute__((packed)){
+    uint8_t status;
+    uint8_t generation;
+    uint16_t period;
+} foc_link_ack_t;
+
+typedef struct __attribute__((packed)){
+    uint32_t tick;
+    uint32_t run;
+    uint8_t runs;
+    uint8_t generation;
+} foc_link_stream_header_t;
+
+typedef struct __attribute__((packed)){
+    uint8_t signal;
+    uint8_t type;
+    uint16_t offset;
+    float scale;
+    char name[FOC_LINK_TELEM_NAME_SIZE];
+} foc_link_catalog_t;
+
+// Parametre istekleri (FOC_Param.h ile aynı)
+#define FOC_LINK_PARAM_NAME_SIZE 12U
+#define FOC_LINK_PARAM_OP_GET     0x01U
+#define FOC_LINK_PARAM_OP_SET     0x02U
+#define FOC_LINK_PARAM_OP_COMMIT  0x03U
+#define FOC_LINK_PARAM_OP_DISCARD 0x04U
+#define FOC_LINK_PARAM_OP_INFO    0x05U
+#define FOC_LINK_PARAM_OP_STATUS  0x06U
+
+typedef struct __attribute__((packed)){
+    uint8_t op;
+    uint8_t status;
+    uint16_t id;
+    float value;
+} foc_link_param_msg_t;
+
+typedef struct __attribute__((packed)){
+    uint8_t type;
+    uint8_t flags;
+    uint8_t size;
+    uint8_t count;
+    float min;
+    float max;
+    float scale;
+    char name[FOC_LINK_PARAM_NAME_SIZE];
+} foc_link_param_info_t;
+
+typedef struct __attribute__((packed)){
+    uint32_t committed;
+    uint32_t applied;
+    uint8_t staged;
+    uint8_t last_error;
+    uint16_t reserved;
+} foc_link_param_status_t;
+
+// Log kaydı (FOC_Log.h ile aynı): başlıktan sonra '\0' olmadan metin
+#define FOC_LINK_LOG_PRINT 0U // printf çıktısı, satır sonu metnin içinde
+#define FOC_LINK_LOG_ERROR 1U
+#define FOC_LINK_LOG_WARN  2U
+#define FOC_LINK_LOG_INFO  3U
+#define FOC_LINK_LOG_DEBUG 4U
+
+typedef struct __attribute__((packed)){
+    uint32_t tick;
+    uint8_t level;
+} foc_link_log_header_t;
+
+// CAN-FD (FOC_CAN.h ile aynı): ID = taban + node_id, komutlar 0x200 + node_id çerçevesinin byte 0'ında
+#define FOC_LINK_CAN_ID_COMMAND   0x200U
+#define FOC_LINK_CAN_ID_TELEMETRY 0x300U
+#define FOC_LINK_CAN_ID_FLOW      0x380U
+#define FOC_LINK_CAN_ID_SCOPE     0x400U
+#define FOC_LINK_CAN_ID_PARAM     0x440U
+#define FOC_LINK_CAN_ID_STREAM    0x480U
+#define FOC_LINK_CAN_CMD_SCOPE     0x03U
+#define FOC_LINK_CAN_CMD_SUBSCRIBE 0x04U
+#define FOC_LINK_CAN_CMD_PARAM     0x05U
+
+typedef struct __attribute__((packed)){
+    uint16_t sequence;
+    uint8_t node_id;
+    uint8_t status;
+    float i_d;
+    float i_q;
+    float i_d_ref;
+    float i_q_ref;
+    float u_d;
+    float u_q;
+    float w_rad_s;
+    float electrical_angle;
+    float T_mot_ref;
+    float U_bat;
+    float position_rad;
+    float speed_ref;
+    float fw_i_d;
+    float sync_phase_error;
+    uint32_t sample_tick;
+} foc_link_can_telemetry_t;
+
+typedef void (*foc_link_frame_cb)(uint8_t type, uint8_t seq, const uint8_t *payload, size_t length, void *ctx);
+
+typedef struct{
+    uint8_t buffer[FOC_LINK_ENCODED_MAX];
+    size_t length;
+    int discard;             // Çok uzun çerçeve, bir sonraki 0x00'a kadar atılır
+    int have_seq;
+    uint8_t next_seq;
+    // İstatistikler
+    uint64_t frames;
+    uint64_t crc_errors;
+    uint64_t frame_errors;   // COBS hatası, kısa veya çok uzun çerçeve
+    uint64_t lost_frames;    // Sıra numarasındaki boşluklardan hesaplanan kayıp çerçeve
+    uint64_t bytes;
+} foc_link_decoder_t;
+
+// <<---------------------------------------------->>
+// <<------------- Fonksiyon Tanımlamaları -------->>
+// <<---------------------------------------------->>
+
+uint32_t foc_link_crc32(const uint8_t *data, size_t length);
+
+// Çerçeveyi out'a kodlar (ayırıcı dahil), yazılan byte sayısını döner. Yer yetmezse 0.
+size_t foc_link_encode(uint8_t type, uint8_t seq, const void *payload, size_t length, uint8_t *out, size_t out_size);
+
+void foc_link_decoder_init(foc_link_decoder_t *dec);
+// Byte akışını besler, her geçerli çerçeve için cb çağrılır. Döndürdüğü değer bulunan geçerli çerçeve sayısıdır.
+size_t foc_link_feed(foc_link_decoder_t *dec, const uint8_t *data, size_t length, foc_link_frame_cb cb, void *ctx);
+
+// Seri port veya pseudo-terminal'i ham modda açar (baud 0: hız değiştirilmez). Hata: -1
+int foc_link_open(const char *path, unsigned baud);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FOC_LINK_H_ */
@@ -0,0 +1,111 @@
+// FOC_UART bağlantısını (seri port veya foc_link_pty) dinler ve çerçeveleri yazdırır.
+// Kullanım: ./foc_link_dump <port> [baud] [enable | disable | torque <Nm>] [-n <çerçeve sayısı>]
+//   baud verilmezse 4000000 (pseudo-terminal'de yok sayılır).
+
+#define _DEFAULT_SOURCE
+#include "foc_link.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct{
+    unsigned long printed;
+    unsigned long limit;
+} foc_link_dump_t;
+
+// ------------------------------------------------------------------------------
+
+static void foc_link_dump_frame(uint8_t type, uint8_t seq, const uint8_t *payload, size_t length, void *ctx){
+    foc_link_dump_t *dump = (foc_link_dump_t *)ctx;
+
+    if(type == FOC_LINK_TYPE_TELEMETRY && length == sizeof(foc_link_telemetry_t)){
+        foc_link_telemetry_t t;
+        memcpy(&t, payload, sizeof(t));
+        printf("%u,%u,%u,%.4f,%.4f,%.4f,%.4f,%.3f,%.3f,%.3f,%.4f,%.2f,%.4f\n",
+               seq, t.tick, t.status, t.i_d, t.i_q, t.i_d_ref, t.i_q_ref, t.u_d, t.u_q,
+               t.w_rad_s, t.electrical_angle, t.U_bat, t.position_rad);
+    }
+    else if(type == FOC_LINK_TYPE_LOG && length >= sizeof(foc_link_log_header_t)){
+        static const char levels[] = "PEWID";
+        foc_link_log_header_t h;
+        memcpy(&h, payload, sizeof(h));
+        int text_length = (int)(length - sizeof(h));
+        const char *text = (const char *)payload + sizeof(h);
+        // printf çıktısı satır sonunu kendisi taşır, LOG_x kayıtları tek satırdır
+        if(text_length > 0 && text[text_length - 1] == '\n') text_length--;
+        printf("# log %u %c: %.*s\n", h.tick, (h.level < 5U) ? levels[h.level] : '?', text_length, text);
+    }
+    else{
+        printf("# tip 0x%02X, sıra %u, %zu byte\n", type, seq, length);
+    }
+    dump->printed++;
+}
+
+// ------------------------------------------------------------------------------
+
+static int foc_link_dump_send(int fd, uint8_t type, const void *payload, size_t length){
+    uint8_t frame[FOC_LINK_ENCODED_MAX];
+    size_t n = foc_link_encode(type, 0, payload, length, frame, sizeof(frame));
+    return (n != 0U && write(fd, frame, n) == (ssize_t)n) ? 0 : -1;
+}
+
+// ------------------------------------------------------------------------------
+
+int main(int argc, char **argv){
+    if(argc < 2){
+        fprintf(stderr, "kullanım: %s <port> [baud] [enable | disable | torque <Nm>] [-n <çerçeve>]\n", argv[0]);
+        return 2;
+    }
+
+    unsigned baud = 4000000U;
+    int arg = 2;
+    if(arg < argc && argv[arg][0] >= '0' && argv[arg][0] <= '9') baud = (unsigned)strtoul(argv[arg++], NULL, 0);
+
+    int fd = foc_link_open(argv[1], baud);
+    if(fd < 0) fd = foc_link_open(argv[1], 0); // pseudo-terminal hız ayarını desteklemeyebilir
+    if(fd < 0){
+        perror(argv[1]);
+        return 1;
+    }
+
+    foc_link_dump_t dump = { 0, 0 };
+    for(; arg < argc; arg++){
+        if(strcmp(argv[arg], "enable") == 0){
+            uint8_t cmd = FOC_LINK_CMD_ENABLE;
+            foc_link_dump_send(fd, FOC_LINK_TYPE_COMMAND, &cmd, 1);
+        }
+        else if(strcmp(argv[arg], "disable") == 0){
+            uint8_t cmd = FOC_LINK_CMD_DISABLE;
+            foc_link_dump_send(fd, FOC_LINK_TYPE_COMMAND, &cmd, 1);
+        }
+        else if(strcmp(argv[arg], "torque") == 0 && arg + 1 < argc){
+            foc_link_setpoint_t sp;
+            memset(&sp, 0, sizeof(sp));
+            sp.mode = FOC_LINK_MODE_TORQUE;
+            sp.torque_ref = strtof(argv[++arg], NULL);
+            foc_link_dump_send(fd, FOC_LINK_TYPE_SETPOINT, &sp, sizeof(sp));
+        }
+        else if(strcmp(argv[arg], "-n") == 0 && arg + 1 < argc){
+            dump.limit = strtoul(argv[++arg], NULL, 0);
+        }
+    }
+
+    printf("seq,tick,status,i_d,i_q,i_d_ref,i_q_ref,u_d,u_q,w_rad_s,angle,U_bat,position\n");
+
+    foc_link_decoder_t dec;
+    foc_link_decoder_init(&dec);
+    uint8_t buffer[4096];
+    while(dump.limit == 0U || dump.printed < dump.limit){
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if(n <= 0) break;
+        foc_link_feed(&dec, buffer, (size_t)n, foc_link_dump_frame, &dump);
+    }
+
+    fprintf(stderr, "# çerçeve %llu, CRC hatası %llu, çerçeve hatası %llu, kayıp %llu, byte %llu\n",
+            (unsigned long long)dec.frames, (unsigned long long)dec.crc_errors,
+            (unsigned long long)dec.frame_errors, (unsigned long long)dec.lost_frames,
+            (unsigned long long)dec.bytes);
+    close(fd);
+    return 0;
+}
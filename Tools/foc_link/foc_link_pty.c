@@ -0,0 +1,116 @@
+// Sürücü yerine geçen pseudo-terminal: FOC_UART ile aynı çerçevelerde 1 kHz sentetik telemetri gönderir,
+// gelen komut / setpoint çerçevelerini çözer ve telemetriye yansıtır.
+// Kullanım: ./foc_link_pty            -> slave yolunu yazar (örn. /dev/pts/5)
+//           ./foc_link_dump /dev/pts/5 -> gerçek kart yerine bu uca bağlanır
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 600
+#include "foc_link.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct{
+    foc_link_telemetry_t telemetry;
+    foc_link_setpoint_t setpoint;
+    unsigned commands;
+} foc_link_sim_t;
+
+// ------------------------------------------------------------------------------
+
+static void foc_link_pty_frame(uint8_t type, uint8_t seq, const uint8_t *payload, size_t length, void *ctx){
+    foc_link_sim_t *sim = (foc_link_sim_t *)ctx;
+    (void)seq;
+
+    if(type == FOC_LINK_TYPE_COMMAND && length >= 1U){
+        if(payload[0] == FOC_LINK_CMD_ENABLE) sim->telemetry.status |= 0x01U;
+        else if(payload[0] == FOC_LINK_CMD_DISABLE) sim->telemetry.status &= (uint8_t)~0x01U;
+        sim->commands++;
+    }
+    else if(type == FOC_LINK_TYPE_SETPOINT && length == sizeof(foc_link_setpoint_t)){
+        memcpy(&sim->setpoint, payload, sizeof(sim->setpoint));
+        sim->telemetry.status = (uint8_t)((sim->setpoint.mode != FOC_LINK_MODE_DISABLE ? 0x01U : 0x00U) |
+                                          (sim->setpoint.mode >= FOC_LINK_MODE_SPEED ? 0x02U : 0x00U) |
+                                          (sim->setpoint.mode == FOC_LINK_MODE_POSITION ? 0x04U : 0x00U));
+        sim->commands++;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+int main(int argc, char **argv){
+    unsigned rate_hz = (argc > 1) ? (unsigned)strtoul(argv[1], NULL, 0) : 1000U;
+    if(rate_hz == 0U) rate_hz = 1000U;
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0){
+        perror("posix_openpt");
+        return 1;
+    }
+    // Slave ucu da ham moda alınır (pty varsayılanı satır düzenleme ve 0x0A -> 0x0D 0x0A çevirisidir)
+    const char *slave_path = ptsname(master);
+    int slave = foc_link_open(slave_path, 0);
+    if(slave < 0){
+        perror("ptsname");
+        return 1;
+    }
+    printf("%s\n", slave_path);
+    fflush(stdout);
+
+    foc_link_sim_t sim;
+    memset(&sim, 0, sizeof(sim));
+    sim.telemetry.U_bat = 24.0f;
+
+    foc_link_decoder_t dec;
+    foc_link_decoder_init(&dec);
+
+    uint8_t seq = 0;
+    uint8_t frame[FOC_LINK_ENCODED_MAX];
+    uint8_t rx[256];
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    for(;;){
+        // Telemetri: I_q referansı takip eden sentetik bir akım ve dönen açı
+        float t = (float)sim.telemetry.tick / (float)rate_hz;
+        float i_q_ref = (sim.telemetry.status & 0x01U) ? sim.setpoint.torque_ref * 10.0f : 0.0f;
+        sim.telemetry.i_q_ref = i_q_ref;
+        sim.telemetry.i_q = i_q_ref + 0.05f * sinf(2.0f * 3.14159265f * 50.0f * t);
+        sim.telemetry.i_d = 0.02f * cosf(2.0f * 3.14159265f * 50.0f * t);
+        sim.telemetry.w_rad_s = 100.0f * i_q_ref;
+        sim.telemetry.electrical_angle = fmodf(sim.telemetry.electrical_angle + sim.telemetry.w_rad_s / (float)rate_hz, 6.2831853f);
+        sim.telemetry.position_rad += sim.telemetry.w_rad_s / (float)rate_hz;
+
+        size_t length = foc_link_encode(FOC_LINK_TYPE_TELEMETRY, seq++, &sim.telemetry, sizeof(sim.telemetry), frame, sizeof(frame));
+        if(write(master, frame, length) < 0) break;
+        sim.telemetry.tick++;
+
+        // Bir sonraki periyoda kadar gelen çerçeveleri işle
+        next.tv_nsec += 1000000000L / (long)rate_hz;
+        if(next.tv_nsec >= 1000000000L){
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        for(;;){
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            long wait_ms = (next.tv_sec - now.tv_sec) * 1000L + (next.tv_nsec - now.tv_nsec) / 1000000L;
+            if(wait_ms < 0) break;
+            struct pollfd pfd = { master, POLLIN, 0 };
+            if(poll(&pfd, 1, (int)wait_ms) <= 0) break;
+            ssize_t n = read(master, rx, sizeof(rx));
+            if(n <= 0) break;
+            foc_link_feed(&dec, rx, (size_t)n, foc_link_pty_frame, &sim);
+        }
+    }
+
+    close(slave);
+    close(master);
+    return 0;
+}